@@ -73,6 +73,13 @@ extern "C"
 	// Type definition for callbacks that should execute on BzPeri's dedicated GLib run loop.
 	typedef void (*BZPRunLoopCallback)(void *pUserData);
 
+	// One entry of a `bzpRunLoopInvokeBatch()` call.
+	typedef struct BZPRunLoopInvocation
+	{
+		BZPRunLoopCallback callback;
+		void *pUserData;
+	} BZPRunLoopInvocation;
+
 	// GLib-hidden poll-descriptor record for integrating the manual BzPeri run loop into a host poll/select loop.
 	//
 	// `events` and `revents` use the same bit layout as the native platform `poll(2)` API.
@@ -83,6 +90,19 @@ extern "C"
 		unsigned short revents;
 	} BZPPollFD;
 
+	// Scheduling settings for the internal server thread created by the threaded `bzpStart*()` variants.
+	//
+	// Zero-initialize the struct and set only the fields you need; zero values keep what the thread inherits from its creator.
+	typedef struct BZPServerThreadOptions
+	{
+		const char *pName;                     // thread name (truncated to 15 bytes); NULL or "" uses "bzp-server"
+		unsigned long long cpuAffinityMask;    // bit N allows CPU N; 0 keeps the inherited affinity
+		int setNice;                           // non-zero applies `nice`
+		int nice;                              // -20..19; negative values need CAP_SYS_NICE or RLIMIT_NICE
+		int realtimePriority;                  // 1..99 runs the thread under SCHED_FIFO; 0 keeps the inherited policy
+		int lockStack;                         // non-zero locks the thread stack in RAM (bounded by RLIMIT_MEMLOCK)
+	} BZPServerThreadOptions;
+
 	// Controls how BzPeri interacts with process-global GLib print/log handlers.
 	enum BZPGLibLogCaptureMode
 	{
@@ -144,6 +164,35 @@ extern "C"
 		BZP_GLIB_LOG_CAPTURE_DOMAINS_SET_INVALID_DOMAINS = 1
 	};
 
+	enum BZPServerThreadOptionsSetResult
+	{
+		BZP_SERVER_THREAD_OPTIONS_SET_OK = 0,
+		BZP_SERVER_THREAD_OPTIONS_SET_INVALID_OPTIONS = 1
+	};
+
+	enum BZPEventStreamStartResult
+	{
+		BZP_EVENT_STREAM_START_OK = 0,
+		BZP_EVENT_STREAM_START_ALREADY_ACTIVE = 1,
+		BZP_EVENT_STREAM_START_FAILED = 2
+	};
+
+	enum BZPDataPlaneStartResult
+	{
+		BZP_DATA_PLANE_START_OK = 0,
+		BZP_DATA_PLANE_START_ALREADY_ACTIVE = 1,
+		BZP_DATA_PLANE_START_INVALID_ARGUMENT = 2,
+		BZP_DATA_PLANE_START_FAILED = 3
+	};
+
+	// One value fed through the shared-memory data plane (see `bzpStartDataPlane()`).
+	typedef struct BZPDataPlaneSlotConfig
+	{
+		const char *pName;                     // name producers and data getters use; at most 47 bytes
+		const char *pObjectPath;               // characteristic notified when the value changes; NULL for read-only values
+		unsigned int maxValueBytes;            // 1..512; 0 selects 512
+	} BZPDataPlaneSlotConfig;
+
 	enum BZPGLibLogCapturePauseResult
 	{
 		BZP_GLIB_LOG_CAPTURE_PAUSE_OK = 0,
@@ -203,6 +252,66 @@ extern "C"
 	int bzpHasSleepInhibitor();
 	enum BZPQueryResult bzpHasSleepInhibitorEx(int *pHasInhibitor);
 
+	// Time-to-advertise after the most recent system resume: milliseconds from logind's `PrepareForSleep(false)` until BlueZ
+	// accepted the primary advertisement again, or -1 when no resume has restored advertising yet.
+	int bzpGetLastResumeTimeToAdvertiseMs();
+	enum BZPQueryResult bzpGetLastResumeTimeToAdvertiseMsEx(int *pMilliseconds);
+
+	// BlueZ signals delivered to the running server. `filtered` were dropped before being unpacked (other adapters' objects, or
+	// property changes such as RSSI that cannot affect a connection) and `handled` were passed on to connection or adapter
+	// tracking. Returns BZP_QUERY_FAILED while no server is running.
+	typedef struct BZPBluezSignalStats
+	{
+		unsigned long long received;
+		unsigned long long filtered;
+		unsigned long long handled;
+	} BZPBluezSignalStats;
+
+	enum BZPQueryResult bzpGetBluezSignalStats(BZPBluezSignalStats *pStats);
+
+	// Configure scheduling for the internal server thread (and any other thread BzPeri starts on its own behalf).
+	//
+	// Settings are copied and take effect the next time a threaded `bzpStart*()` variant creates the server thread; manual-mode
+	// hosts own the pumping thread and configure it themselves. Passing NULL restores the defaults. Settings the host lacks the
+	// privilege for (typically SCHED_FIFO, negative nice values and stack locking) are logged as warnings and skipped; startup
+	// still proceeds.
+	void bzpSetServerThreadOptions(const BZPServerThreadOptions *pOptions);
+	enum BZPServerThreadOptionsSetResult bzpSetServerThreadOptionsEx(const BZPServerThreadOptions *pOptions);
+
+	// Host a Unix-socket endpoint that streams run-state changes, D-Bus dispatch records and update-queue stats to live
+	// inspectors (`bzp-standalone inspect --live --pid <pid>`).
+	//
+	// `pSocketPath` may be NULL for the per-process default `$XDG_RUNTIME_DIR/bzperi/events-<pid>.sock`. The socket is created
+	// owner-only. Every subscriber gets `subscriberBufferBytes` of buffering (0 selects 64 KiB); a subscriber that falls
+	// behind loses events, never the server, and is told how many it missed. The stream runs on its own thread until
+	// `bzpStopEventStream()` or process exit, independent of `bzpStart*()`/`bzpShutdown*()`.
+	int bzpStartEventStream(const char *pSocketPath, unsigned int subscriberBufferBytes);
+	enum BZPEventStreamStartResult bzpStartEventStreamEx(const char *pSocketPath, unsigned int subscriberBufferBytes);
+	void bzpStopEventStream();
+	int bzpIsEventStreamActive();
+
+	// Serve a shared-memory channel that lets other processes feed characteristic values without a socket round trip.
+	//
+	// BzPeri creates a sealed memfd with one seqlock slot per entry in `pSlots` and hands it, with an eventfd doorbell, to any
+	// process that connects to `pSocketPath` (NULL for `$XDG_RUNTIME_DIR/bzperi/dataplane-<pid>.sock`, owner-only). Producers use
+	// the `bzp-producer` C library (`BzPeriDataPlaneProducer.h`); the layout itself is defined in `<bzp/DataPlaneLayout.h>`.
+	// Whenever slots change, BzPeri queues one `bzpNotifyUpdatedCharacteristic()` per changed slot that has an object path, so
+	// bursts to the same slot collapse into one notification. The data plane runs on its own thread until `bzpStopDataPlane()`
+	// or process exit.
+	int bzpStartDataPlane(const char *pSocketPath, const BZPDataPlaneSlotConfig *pSlots, unsigned int slotCount);
+	enum BZPDataPlaneStartResult bzpStartDataPlaneEx(const char *pSocketPath, const BZPDataPlaneSlotConfig *pSlots, unsigned int slotCount);
+	void bzpStopDataPlane();
+	int bzpIsDataPlaneActive();
+
+	// Newest value of a data plane slot, for use inside a `BZPServerDataGetter`: returns a NUL-terminated copy owned by BzPeri, or
+	// NULL when the slot is unknown or no producer has written it yet. The pointer stays valid until the next call for the same
+	// name or `bzpStopDataPlane()`, so only call this from the server thread (which is where data getters run).
+	const void *bzpGetDataPlaneValue(const char *pName);
+
+	// Copy the newest value of a data plane slot into `pBuffer` from any thread. Returns the value length (the copy is truncated
+	// to `bufferBytes`), or -1 when the slot is unknown, unwritten or stayed mid-write.
+	int bzpReadDataPlaneValue(const char *pName, void *pBuffer, unsigned int bufferBytes);
+
 	// Configure how BzPeri captures GLib process-global print/log handlers.
 	//
 	// `AUTOMATIC` (default): startup/shutdown install and restore the handlers automatically.
@@ -299,6 +408,130 @@ extern "C"
 	//   * Any other failure, as deemed by the delegate handler
 	typedef int (*BZPServerDataSetter)(const char *pName, const void *pData);
 
+	// -----------------------------------------------------------------------------------------------------------------------------
+	// TYPED DATA STORE
+	// -----------------------------------------------------------------------------------------------------------------------------
+
+	// A handle-based alternative to matching names inside the data delegates above.
+	//
+	// Register each value once with `bzpDataRegister()` and keep the returned handle; reads and writes through the handle index a
+	// fixed table, carry explicit lengths and are safe from any thread. Each slot is a seqlock, so a writer never blocks readers
+	// (concurrent writers to the same slot take turns). A slot registered with a characteristic object path queues
+	// `bzpNotifyUpdatedCharacteristic()` whenever a write changes its bytes, so hosts no longer pair every write with a notify.
+	//
+	// Existing services keep using `getDataValue()` / `setDataPointer()` by name: pass `bzpDataStoreGetter` and
+	// `bzpDataStoreSetter` as the delegates to `bzpStart()` and those calls are served from the store. Registered slots live for
+	// the rest of the process.
+	enum BZPDataSlotType
+	{
+		BZP_DATA_SLOT_FIXED = 0,               // every write is exactly `sizeBytes` (e.g. a uint8_t level)
+		BZP_DATA_SLOT_TEXT = 1                 // up to `sizeBytes` bytes without a terminator; getters see a NUL-terminated string
+	};
+
+	enum BZPDataStoreResult
+	{
+		BZP_DATA_STORE_OK = 0,
+		BZP_DATA_STORE_INVALID_ARGUMENT = 1,
+		BZP_DATA_STORE_UNKNOWN_HANDLE = 2,
+		BZP_DATA_STORE_SIZE_MISMATCH = 3,      // wrong length for a fixed slot, or too long for a text slot
+		BZP_DATA_STORE_CONFLICT = 4,           // the name is registered with a different type, size or object path
+		BZP_DATA_STORE_FULL = 5,               // 256 slots are registered already
+		BZP_DATA_STORE_EMPTY = 6,              // nothing has been written yet
+		BZP_DATA_STORE_BUSY = 7                // writes kept overlapping the read
+	};
+
+	// Register `pName` (sizes of 1..512 bytes; `pObjectPath` may be NULL) and return its handle, or -1 on failure. Registering the
+	// same slot again returns the same handle.
+	int bzpDataRegister(const char *pName, enum BZPDataSlotType type, unsigned int sizeBytes, const char *pObjectPath);
+	enum BZPDataStoreResult bzpDataRegisterEx(const char *pName, enum BZPDataSlotType type, unsigned int sizeBytes,
+		const char *pObjectPath, int *pHandle);
+
+	// Handle registered for `pName`, or -1. Look handles up once; this takes a lock and hashes the name.
+	int bzpDataFind(const char *pName);
+
+	// Registered size of a slot, or 0 for an unknown handle.
+	unsigned int bzpDataSize(int handle);
+
+	// Store a new value. Returns non-zero on success.
+	int bzpDataWrite(int handle, const void *pData, unsigned int length);
+	enum BZPDataStoreResult bzpDataWriteEx(int handle, const void *pData, unsigned int length);
+
+	// Copy the newest value into `pBuffer` (truncated to `bufferBytes`). Returns its full length, or -1 when nothing can be read.
+	int bzpDataRead(int handle, void *pBuffer, unsigned int bufferBytes);
+	enum BZPDataStoreResult bzpDataReadEx(int handle, void *pBuffer, unsigned int bufferBytes, unsigned int *pLength);
+
+	// `BZPServerDataGetter` / `BZPServerDataSetter` implementations backed by the store.
+	//
+	// The getter returns a NUL-terminated copy owned by the slot that stays valid until the next getter call for the same name.
+	// The setter expects `sizeBytes` bytes for fixed slots and a NUL-terminated string for text slots, and does not queue an
+	// update itself because it runs inside the characteristic's own write handler.
+	const void *bzpDataStoreGetter(const char *pName);
+	int bzpDataStoreSetter(const char *pName, const void *pData);
+
+	// -----------------------------------------------------------------------------------------------------------------------------
+	// WRITE INGESTION
+	// -----------------------------------------------------------------------------------------------------------------------------
+
+	// High-rate writes delivered to an application thread instead of a handler on the server thread.
+	//
+	// A characteristic declared with `onWriteIngest(name)` answers every WriteValue by copying the payload into the next packet
+	// of a preallocated single-producer/single-consumer ring named `name` and replying immediately. One application thread per
+	// ring drains it with `bzpReadIngest()`, sleeping on `bzpGetIngestFD()` between batches:
+	//
+	//     BZPIngestPacket packets[32];
+	//     for (;;) {
+	//         poll(&(struct pollfd){bzpGetIngestFD(handle), POLLIN, 0}, 1, -1);
+	//         int count;
+	//         while ((count = bzpReadIngest(handle, packets, 32)) > 0)
+	//             for (int i = 0; i < count; ++i) parse(packets[i].pData, packets[i].length);
+	//     }
+	//
+	// The descriptor becomes readable once a packet arrives after `bzpReadIngest()` returned 0, so always drain until it does.
+	// When the ring is full the newest packet is dropped and counted, and the write is answered with `org.bluez.Error.Failed`.
+	// C++ consumers can iterate batches as spans with `bzp::IngestReader` (`<bzp/IngestReader.h>`).
+	enum BZPIngestResult
+	{
+		BZP_INGEST_OK = 0,
+		BZP_INGEST_INVALID_ARGUMENT = 1,
+		BZP_INGEST_UNKNOWN_HANDLE = 2,
+		BZP_INGEST_CONFLICT = 3,               // the name is registered with a different shape
+		BZP_INGEST_FULL = 4,                   // 64 rings are registered already
+		BZP_INGEST_RING_FULL = 5,              // the consumer is behind; the packet was dropped
+		BZP_INGEST_PACKET_TOO_LARGE = 6,
+		BZP_INGEST_FAILED = 7
+	};
+
+	typedef struct BZPIngestPacket
+	{
+		const void *pData;                     // points into the ring; valid until the next bzpReadIngest() for this ring
+		unsigned int length;
+	} BZPIngestPacket;
+
+	typedef struct BZPIngestStats
+	{
+		unsigned long long received;           // packets accepted into the ring
+		unsigned long long dropped;            // packets lost because the ring was full
+		unsigned long long oversized;          // packets rejected for exceeding packetBytes
+		unsigned int queued;                   // packets accepted but not yet released by the consumer
+		unsigned int highWatermark;            // largest queue depth seen
+		unsigned int capacity;                 // packets the ring holds
+	} BZPIngestStats;
+
+	// Create (or look up) the ring `pName` ahead of the server, returning its handle or -1. `packetCount` is rounded up to a power
+	// of two (0 selects 256, at most 65536) and `packetBytes` caps each write (0 selects 512, the largest attribute value).
+	// `GattCharacteristic::onWriteIngest()` registers its ring the same way, so either side may come first.
+	int bzpRegisterIngest(const char *pName, unsigned int packetCount, unsigned int packetBytes);
+	enum BZPIngestResult bzpRegisterIngestEx(const char *pName, unsigned int packetCount, unsigned int packetBytes, int *pHandle);
+	int bzpFindIngest(const char *pName);
+
+	// Fill `pPackets` with up to `maxPackets` queued writes in arrival order and return how many, or -1 for an unknown handle.
+	// Packets from the previous call are released first, so call this from a single thread per ring.
+	int bzpReadIngest(int handle, BZPIngestPacket *pPackets, unsigned int maxPackets);
+
+	// Non-blocking eventfd that becomes readable when packets arrive for a drained ring. Owned by BzPeri; do not close it.
+	int bzpGetIngestFD(int handle);
+	enum BZPIngestResult bzpGetIngestStats(int handle, BZPIngestStats *pStats);
+
 	// -----------------------------------------------------------------------------------------------------------------------------
 	// SERVER DATA UPDATE MANAGEMENT
 	// -----------------------------------------------------------------------------------------------------------------------------
@@ -317,7 +550,8 @@ extern "C"
 	{
 		BZP_UPDATE_ENQUEUE_OK = 1,
 		BZP_UPDATE_ENQUEUE_INVALID_ARGUMENT = -1,
-		BZP_UPDATE_ENQUEUE_NOT_RUNNING = -2
+		BZP_UPDATE_ENQUEUE_NOT_RUNNING = -2,
+		BZP_UPDATE_ENQUEUE_QUEUE_FULL = -3    // the queue holds only higher-priority entries; this update was dropped
 	};
 
 	// Detailed result codes for startup operations.
@@ -363,7 +597,8 @@ extern "C"
 	// Returns non-zero value on success or 0 on failure.
 	int bzpPushUpdateQueue(const char *pObjectPath, const char *pInterfaceName);
 
-	// Detailed enqueue helpers that distinguish invalid arguments from "server is not running".
+	// Detailed enqueue helpers that distinguish invalid arguments, "server is not running" and an update refused because the
+	// queue is full of higher-priority entries.
 	enum BZPUpdateEnqueueResult bzpNotifyUpdatedCharacteristicEx(const char *pObjectPath);
 	enum BZPUpdateEnqueueResult bzpNotifyUpdatedDescriptorEx(const char *pObjectPath);
 	enum BZPUpdateEnqueueResult bzpPushUpdateQueueEx(const char *pObjectPath, const char *pInterfaceName);
@@ -404,6 +639,170 @@ extern "C"
 	void bzpUpdateQueueClear();
 	enum BZPQueryResult bzpUpdateQueueClearEx(int *pClearedCount);
 
+	// Priority classes for queued updates. Each class has its own lane in the update queue, and the server loop drains the lanes
+	// according to the schedule below, so an alarm characteristic is not stuck behind hundreds of routine telemetry updates.
+	// Updates are emitted as they are taken off the queue, so the same order applies to the notifications they produce.
+	enum BZPUpdatePriority
+	{
+		BZP_UPDATE_PRIORITY_CRITICAL = 0,
+		BZP_UPDATE_PRIORITY_NORMAL = 1,
+		BZP_UPDATE_PRIORITY_BULK = 2
+	};
+
+	enum BZPUpdateScheduleMode
+	{
+		BZP_UPDATE_SCHEDULE_STRICT = 0,        // always serve the highest non-empty lane (default)
+		BZP_UPDATE_SCHEDULE_WEIGHTED = 1       // weighted round-robin using the per-lane weights
+	};
+
+	typedef struct BZPUpdateSchedule
+	{
+		enum BZPUpdateScheduleMode mode;
+		unsigned int criticalWeight;           // weighted mode: entries a lane may take per round (0 counts as 1)
+		unsigned int normalWeight;
+		unsigned int bulkWeight;
+		unsigned int maxWaitMS;                // starvation guard: an entry queued longer than this is served next, every
+		                                       // other pop at most; 0 disables it (default 500)
+	} BZPUpdateSchedule;
+
+	typedef struct BZPUpdateLaneStats
+	{
+		unsigned long long enqueued;
+		unsigned long long processed;          // entries taken off the lane
+		unsigned long long dropped;            // entries evicted or refused because the queue was full (lowest lane first)
+		unsigned long long promoted;           // entries served early by the starvation guard
+		unsigned long long maxLatencyUS;       // longest time from enqueue to processing
+		unsigned long long totalLatencyUS;     // divide by `processed` for the mean
+		unsigned int depth;                    // entries waiting now
+		unsigned int highWatermark;
+	} BZPUpdateLaneStats;
+
+	// Put updates for `pObjectPath` (a characteristic or descriptor) in the `priority` lane. Paths default to the normal lane;
+	// `GattCharacteristic::updatePriority()` sets this while the server is described. Returns 1 on success, 0 for bad arguments.
+	int bzpSetUpdatePriority(const char *pObjectPath, enum BZPUpdatePriority priority);
+
+	// Returns 1 on success, 0 for a null schedule or an unknown mode
+	int bzpSetUpdateSchedule(const BZPUpdateSchedule *pSchedule);
+	enum BZPQueryResult bzpGetUpdateSchedule(BZPUpdateSchedule *pSchedule);
+	enum BZPQueryResult bzpGetUpdateLaneStats(enum BZPUpdatePriority priority, BZPUpdateLaneStats *pStats);
+
+	// -----------------------------------------------------------------------------------------------------------------------------
+	// CONNECTIONLESS ADVERTISING DATA
+	// -----------------------------------------------------------------------------------------------------------------------------
+
+	// Detailed result codes for advertising payload updates.
+	enum BZPAdvertisingDataResult
+	{
+		BZP_ADVERTISING_DATA_OK = 1,
+		BZP_ADVERTISING_DATA_INVALID_ARGUMENT = -1,
+		BZP_ADVERTISING_DATA_NOT_RUNNING = -2,
+		BZP_ADVERTISING_DATA_TOO_LARGE = -3,
+		BZP_ADVERTISING_DATA_FAILED = -4
+	};
+
+	// Sets the ManufacturerData entry for `companyId` in the LE advertisement. Observers can read the bytes straight from the
+	// advertising reports without connecting. The payload is checked against the controller's advertising budget (MaxAdvLen)
+	// and then applied on the server loop; a live advertisement is updated in place via PropertiesChanged rather than being
+	// re-registered.
+	//
+	// Passing a null `pData` with `dataLength` of 0 removes the entry.
+	//
+	// Returns non-zero value on success or 0 on failure.
+	int bzpSetAdvertisingManufacturerData(unsigned short companyId, const unsigned char *pData, int dataLength);
+
+	// Detailed variant of bzpSetAdvertisingManufacturerData().
+	//
+	// Returns:
+	//   BZP_ADVERTISING_DATA_OK when the payload was accepted
+	//   BZP_ADVERTISING_DATA_INVALID_ARGUMENT for a negative length or a null buffer with a non-zero length
+	//   BZP_ADVERTISING_DATA_NOT_RUNNING if the server has not been started
+	//   BZP_ADVERTISING_DATA_TOO_LARGE if the resulting advertisement would exceed the controller budget
+	//   BZP_ADVERTISING_DATA_FAILED for any other failure
+	enum BZPAdvertisingDataResult bzpSetAdvertisingManufacturerDataEx(unsigned short companyId, const unsigned char *pData, int dataLength);
+
+	// Sets the ServiceData entry for `pServiceUuid` (16-bit, 32-bit or 128-bit form) in the LE advertisement. Behaves like
+	// bzpSetAdvertisingManufacturerData(), including removal with a null `pData` and a `dataLength` of 0.
+	int bzpSetAdvertisingServiceData(const char *pServiceUuid, const unsigned char *pData, int dataLength);
+	enum BZPAdvertisingDataResult bzpSetAdvertisingServiceDataEx(const char *pServiceUuid, const unsigned char *pData, int dataLength);
+
+	// Removes all ManufacturerData and ServiceData entries from the advertisement
+	void bzpClearAdvertisingData();
+	enum BZPAdvertisingDataResult bzpClearAdvertisingDataEx();
+
+	// Detailed result codes for advertising parameter and interval-schedule control.
+	enum BZPAdvertisingControlResult
+	{
+		BZP_ADVERTISING_CONTROL_OK = 1,
+		BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT = -1,
+		BZP_ADVERTISING_CONTROL_NOT_RUNNING = -2,
+		BZP_ADVERTISING_CONTROL_FAILED = -3
+	};
+
+	// LE advertising parameters. Zero intervals, duration and timeout leave the choice to BlueZ and the controller; the TX power
+	// is only requested when `txPowerSet` is non-zero. Intervals must lie within 20..10485759 ms with min <= max.
+	typedef struct BZPAdvertisingParameters
+	{
+		unsigned int minIntervalMS;
+		unsigned int maxIntervalMS;
+		int txPowerSet;
+		int txPowerDBm;
+		unsigned short durationSeconds;
+		unsigned short timeoutSeconds;
+	} BZPAdvertisingParameters;
+
+	// Applies advertising parameters on the server loop. A live advertisement is updated in place. Explicit intervals cancel a
+	// running advertising burst.
+	//
+	// Returns non-zero value on success or 0 on failure.
+	int bzpSetAdvertisingParameters(const BZPAdvertisingParameters *pParameters);
+	enum BZPAdvertisingControlResult bzpSetAdvertisingParametersEx(const BZPAdvertisingParameters *pParameters);
+
+	// Configures a burst-then-relax interval schedule: bzpTriggerAdvertisingBurst() (for example on a button press) advertises at
+	// the burst interval for `burstDurationMS`, after which the relaxed, power-saving interval is restored in place. The burst
+	// also runs whenever advertising is (re)registered. Until a burst is triggered the relaxed interval is used.
+	int bzpSetAdvertisingBurstPolicy(int burstMinIntervalMS, int burstMaxIntervalMS,
+		int relaxedMinIntervalMS, int relaxedMaxIntervalMS, int burstDurationMS);
+	enum BZPAdvertisingControlResult bzpSetAdvertisingBurstPolicyEx(int burstMinIntervalMS, int burstMaxIntervalMS,
+		int relaxedMinIntervalMS, int relaxedMaxIntervalMS, int burstDurationMS);
+
+	// Starts (or restarts) an advertising burst using the configured policy
+	int bzpTriggerAdvertisingBurst();
+	enum BZPAdvertisingControlResult bzpTriggerAdvertisingBurstEx();
+
+	// An additional advertisement registered next to the primary one, for example a non-connectable beacon. At most one
+	// ManufacturerData and one ServiceData entry can be given here; either is skipped when its length is 0.
+	typedef struct BZPAdvertisingSet
+	{
+		const char *pName;
+		int connectable;                 // non-zero advertises as "peripheral", zero as "broadcast"
+		unsigned int priority;           // relative share of airtime when sets are rotated (0 is treated as 1)
+		int includeLocalName;
+		unsigned short manufacturerId;
+		const unsigned char *pManufacturerData;
+		int manufacturerDataLength;
+		const char *pServiceDataUuid;
+		const unsigned char *pServiceData;
+		int serviceDataLength;
+		BZPAdvertisingParameters parameters;
+	} BZPAdvertisingSet;
+
+	// Adds an advertising set, or updates the set with the same name in place. The primary advertisement keeps one controller
+	// instance; when there are more sets than the remaining instances (LEAdvertisingManager1.SupportedInstances), the sets are
+	// rotated on air in time slices according to their priority. A payload that does not fit the controller's advertising
+	// budget is rejected on the server loop and logged.
+	//
+	// Returns non-zero value on success or 0 on failure.
+	int bzpSetAdvertisingSet(const BZPAdvertisingSet *pSet);
+	enum BZPAdvertisingControlResult bzpSetAdvertisingSetEx(const BZPAdvertisingSet *pSet);
+
+	// Unregisters and removes the named advertising set
+	int bzpRemoveAdvertisingSet(const char *pName);
+	enum BZPAdvertisingControlResult bzpRemoveAdvertisingSetEx(const char *pName);
+
+	// Sets how long each group of rotated advertising sets stays on air (at least 250 ms, default 2000 ms)
+	int bzpSetAdvertisingRotationSlice(int sliceMS);
+	enum BZPAdvertisingControlResult bzpSetAdvertisingRotationSliceEx(int sliceMS);
+
 	// -----------------------------------------------------------------------------------------------------------------------------
 	// SERVER CONTROL
 	// -----------------------------------------------------------------------------------------------------------------------------
@@ -627,7 +1026,8 @@ extern "C"
 		BZP_RUN_LOOP_ALLOCATION_FAILED = -9,
 		BZP_RUN_LOOP_INVALID_STATE = -10,
 		BZP_RUN_LOOP_INVALID_TIMEOUT = -11,
-		BZP_RUN_LOOP_NOT_ATTACHED = -12
+		BZP_RUN_LOOP_NOT_ATTACHED = -12,
+		BZP_RUN_LOOP_QUEUE_FULL = -13
 	};
 
 	enum BZPWaitResult bzpShutdownAndWaitEx();
@@ -710,10 +1110,34 @@ extern "C"
 	// In the default threaded mode, the callback executes on the internal server thread.
 	// In manual mode, the callback executes when the host next drives `bzpRunLoopIteration()`.
 	//
-	// Returns non-zero if the callback was queued successfully, otherwise 0.
+	// Invocations from any thread share one lock-free queue that the run loop drains in submission order per dispatch; only the
+	// call that finds the queue empty wakes the loop.
+	//
+	// Once shutdown begins, new invocations are refused with `BZP_RUN_LOOP_NOT_ACTIVE`; every callback accepted before that
+	// still runs, on the run loop's thread, before the server is torn down.
+	//
+	// Returns non-zero if the callback was queued successfully, otherwise 0. `bzpRunLoopInvokeEx()` reports
+	// `BZP_RUN_LOOP_QUEUE_FULL` when a capacity is set and reached.
 	int bzpRunLoopInvoke(BZPRunLoopCallback callback, void *pUserData);
 	enum BZPRunLoopResult bzpRunLoopInvokeEx(BZPRunLoopCallback callback, void *pUserData);
 
+	// Queue `count` callbacks in order with a single queue operation and at most one wakeup.
+	//
+	// With a capacity set, the batch is accepted or refused as a whole.
+	//
+	// Returns non-zero if the whole batch was queued, otherwise 0.
+	int bzpRunLoopInvokeBatch(const BZPRunLoopInvocation *pInvocations, int count);
+	enum BZPRunLoopResult bzpRunLoopInvokeBatchEx(const BZPRunLoopInvocation *pInvocations, int count);
+
+	// Bound the number of host invocations that may be pending on the run loop at once (`0`, the default, means unbounded).
+	//
+	// Producers that outpace the loop then get `BZP_RUN_LOOP_QUEUE_FULL` instead of growing the queue without limit. BzPeri's own
+	// internal invocations are not counted against the bound. May be called at any time, including before startup.
+	//
+	// Returns non-zero on success, otherwise 0 (negative capacity).
+	int bzpRunLoopSetInvokeCapacity(int capacity);
+	enum BZPRunLoopResult bzpRunLoopSetInvokeCapacityEx(int capacity);
+
 	// Begin a GLib-hidden poll cycle for the manual run loop.
 	//
 	// This acquires the dedicated run-loop context and prepares it for `query -> check -> dispatch/cancel`.
@@ -762,6 +1186,27 @@ extern "C"
 	int bzpRunLoopPollCancel();
 	enum BZPRunLoopResult bzpRunLoopPollCancelEx();
 
+	// Return a single descriptor that becomes readable whenever the manual run loop has work (I/O, timers or invocations).
+	//
+	// This lets a host reactor (epoll, kqueue-style wrappers, libuv, asio, ...) watch BzPeri with one stable registration instead
+	// of re-querying the full GLib poll set every cycle. When it is readable, call `bzpRunLoopDispatchPending()`. The descriptor
+	// is owned by BzPeri, must not be closed by the host, and is closed when the manual run loop finishes shutting down.
+	//
+	// Only valid after `bzpStartManual()` / `bzpStartWithBondableManual()`; the first call binds the loop to the calling thread.
+	//
+	// Returns the descriptor, or -1 on failure.
+	int bzpRunLoopGetFD();
+	enum BZPRunLoopResult bzpRunLoopGetFDEx(int *pFD);
+
+	// Dispatch ready manual run-loop work without blocking, running at most `budget` GLib iterations.
+	//
+	// The descriptor from `bzpRunLoopGetFD()` stays readable if work remains after the budget is spent. `pDispatchedCount` is
+	// optional and receives the number of iterations that dispatched work.
+	//
+	// Returns the number of iterations that dispatched work, or -1 on failure.
+	int bzpRunLoopDispatchPending(int budget);
+	enum BZPRunLoopResult bzpRunLoopDispatchPendingEx(int budget, int *pDispatchedCount);
+
 	// Drive the manual run loop until the requested state is reached or the timeout expires.
 	//
 	// This is intended for hosts using `bzpStartManual()` / `bzpStartWithBondableManual()` that want bounded lifecycle helpers
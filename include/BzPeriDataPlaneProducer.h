@@ -0,0 +1,49 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Producer side of the shared-memory data plane, for processes that feed characteristic values to a BzPeri server.
+//
+// The BzPeri process calls `bzpStartDataPlane()` with the slots it wants fed; a producer then attaches over the data plane's
+// Unix socket, looks its slots up once by name and publishes values with a single copy into shared memory. BzPeri queues a
+// characteristic update for every slot that changed, and reads through `bzpGetDataPlaneValue()` return the newest value.
+//
+//     BZPDataPlaneProducer *producer = bzpDataPlaneAttach(path);
+//     const int slot = bzpDataPlaneFindSlot(producer, "battery/level");
+//     bzpDataPlanePublish(producer, slot, &level, sizeof(level));
+//
+// Each slot must have a single writer. This library is plain C, links against nothing but libc and is safe to use from a
+// process that never loads BzPeri itself (link `bzp-producer`).
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bzp/DataPlaneLayout.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct BZPDataPlaneProducer BZPDataPlaneProducer;
+
+// Per-process default socket location: $XDG_RUNTIME_DIR/bzperi/dataplane-<pid>.sock (or /tmp/bzperi/... without a runtime
+// directory). Returns the length written, or -1 when `bufferBytes` is too small.
+int bzpDataPlaneDefaultSocketPath(int serverPid, char *pBuffer, size_t bufferBytes);
+
+// Attach to the data plane served at `pSocketPath`. Returns NULL and sets errno on failure (EPROTO when the region does not
+// match this header's layout version).
+BZPDataPlaneProducer *bzpDataPlaneAttach(const char *pSocketPath);
+void bzpDataPlaneDetach(BZPDataPlaneProducer *pProducer);
+
+// Slot index for `pName`, or -1 when the server did not declare it.
+int bzpDataPlaneFindSlot(const BZPDataPlaneProducer *pProducer, const char *pName);
+uint32_t bzpDataPlaneSlotCapacity(const BZPDataPlaneProducer *pProducer, int slot);
+
+// Store a new value and wake BzPeri if it is waiting. Returns 0 on success, or -1 with errno set (EINVAL for an unknown slot
+// or a value larger than the slot's capacity).
+int bzpDataPlanePublish(BZPDataPlaneProducer *pProducer, int slot, const void *pData, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
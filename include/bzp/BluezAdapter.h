@@ -30,6 +30,7 @@
 #pragma once
 
 #include <bzp/GLibTypes.h>
+#include <chrono>
 #include <string>
 #include <atomic>
 #include <functional>
@@ -37,6 +38,7 @@
 #include <memory>
 #include <unordered_map>
 #include <mutex>
+#include <optional>
 #include <bzp/BluezTypes.h>
 
 namespace bzp {
@@ -44,6 +46,7 @@ namespace bzp {
 // Forward declarations
 class BluezAdvertisement;
 struct Server;
+namespace detail { struct PendingDeviceEvent; }
 
 class BluezAdapter
 {
@@ -75,6 +78,7 @@ public:
 	// LE specific methods
 	BluezResult<void> setLEEnabled(bool enabled);
 	BluezResult<void> setAdvertising(bool enabled);
+	BluezResult<void> setAdvertising(bool enabled, const AdvertisingParameters& parameters);
 
 	// Feature detection
 	BluezResult<BluezCapabilities> detectCapabilities();
@@ -82,6 +86,7 @@ public:
 
 	// Connection tracking (replaces HciAdapter connection counting)
 	int getActiveConnectionCount() const { return activeConnections.load(); }
+	BluezSignalStats getSignalStats() const;
 
 	// Adapter information
 	std::string getAdapterPath() const { return adapterPath; }
@@ -91,6 +96,11 @@ public:
 	using ConnectionCallback = std::function<void(bool connected, const std::string& devicePath)>;
 	void setConnectionCallback(ConnectionCallback callback) { connectionCallback = callback; }
 
+	// Device signals are applied in batches, once per loop iteration. This fires once per batch with the devices whose
+	// connection state changed, after the connection count is updated and before the per-device callbacks.
+	using ConnectionsChangedCallback = std::function<void(const std::vector<std::string>& added, const std::vector<std::string>& removed)>;
+	void setConnectionsChangedCallback(ConnectionsChangedCallback callback) { connectionsChangedCallback = std::move(callback); }
+
 	// Retry operations with backoff
 	template<typename Func>
 	BluezResult<void> retryOperation(Func operation, const RetryPolicy& policy = RetryPolicy{});
@@ -104,8 +114,63 @@ public:
 	// Async advertising with retry support
 	void setAdvertisingAsync(bool enabled, std::function<void(BluezResult<void>)> callback = nullptr);
 
+	// Connectionless advertising payload (ManufacturerData / ServiceData)
+	//
+	// The setters may be called from any thread. They check the resulting payload against the controller's advertising budget
+	// and store it; applyAdvertisingData() must then run on the server loop to push the stored payload to a live advertisement
+	// in place. A payload stored before advertising starts is picked up when the advertisement is registered.
+	BluezResult<void> setAdvertisingManufacturerData(uint16_t companyId, std::vector<uint8_t> data);
+	BluezResult<void> removeAdvertisingManufacturerData(uint16_t companyId);
+	BluezResult<void> setAdvertisingServiceData(const std::string& serviceUuid, std::vector<uint8_t> data);
+	BluezResult<void> removeAdvertisingServiceData(const std::string& serviceUuid);
+	void clearAdvertisingData();
+	AdvertisingData getAdvertisingData() const;
+	void applyAdvertisingData();
+
+	// Layout of the primary advertisement as last packed, listing which AD structures went into the advertising data, which
+	// spilled into the scan response and which were dropped. Empty until advertising has been configured.
+	std::string getAdvertisingPayloadReport() const;
+
+	// Advertising parameters (intervals, TX power, duration, timeout), applied in place while advertising.
+	// Setting explicit intervals cancels a running burst.
+	BluezResult<void> setAdvertisingParameters(const AdvertisingParameters& parameters);
+	const AdvertisingParameters& getAdvertisingParameters() const { return advertisingParameters_; }
+
+	// Burst-then-relax interval scheduling: triggerAdvertisingBurst() switches to the fast interval (e.g. on a button press)
+	// and a GLib timer drops back to the relaxed interval afterwards, without re-registering the advertisement
+	BluezResult<void> setAdvertisingBurstPolicy(const AdvertisingBurstPolicy& policy);
+	void clearAdvertisingBurstPolicy();
+	BluezResult<void> triggerAdvertisingBurst();
+	bool isAdvertisingBurstActive() const { return advertisingBurstTimerId_ != 0; }
+
+	// Additional advertising sets (server loop only)
+	//
+	// Each set is its own LEAdvertisement1 object registered next to the primary advertisement, which keeps one controller
+	// instance for itself. When there are more sets than free instances, a GLib timer rotates them on air one time slice at a
+	// time, giving each set airtime in proportion to its priority. setAdvertisingSet() adds a set or updates it by name;
+	// payload and parameter changes are applied in place, other changes re-register the set. shutdown() drops every set; an
+	// automatic reconnect configures them again.
+	BluezResult<void> setAdvertisingSet(const AdvertisingSetConfig& config);
+	BluezResult<void> removeAdvertisingSet(const std::string& name);
+	std::vector<std::string> getAdvertisingSetNames() const;
+	std::vector<std::string> getOnAirAdvertisingSets() const;
+	BluezResult<void> setAdvertisingRotationSlice(uint32_t sliceMs);
+	uint32_t getAdvertisingRotationSlice() const { return advertisingRotationSliceMs_; }
+	bool isAdvertisingRotationActive() const { return advertisingRotationTimerId_ != 0; }
+
+	// System sleep fast path (server loop only)
+	//
+	// prepareForSleep() snapshots the adapter and advertising state, then takes every advertisement off air while keeping the
+	// exported objects and packed payloads staged. resumeFromSleep() replays the snapshot with all D-Bus calls in flight at
+	// once instead of the sequential cold-start path (power check, power on, register, back off), and reports how long it
+	// took from `resumedAt` until the primary advertisement was back on air.
+	void prepareForSleep(std::function<void(BluezResult<void>)> callback);
+	void resumeFromSleep(std::chrono::steady_clock::time_point resumedAt,
+		std::function<void(const ResumeReport&)> callback = nullptr);
+	const std::optional<SleepSnapshot>& getSleepSnapshot() const { return sleepSnapshot_; }
+
 private:
-	BluezAdapter() = default;
+	BluezAdapter();
 	~BluezAdapter();
 	static BluezAdapter& activeAdapterStorage() noexcept;
 	friend BluezAdapter* makeBluezAdapterForRuntime();
@@ -118,6 +183,8 @@ private:
 	// D-Bus property operations with error handling
 	BluezResult<void> setAdapterProperty(const std::string& property, DBusVariantRef value);
 	BluezResult<DBusVariantRef> getAdapterProperty(const std::string& property);
+	void setAdapterPropertyAsync(const std::string& property, GVariant* value, std::function<void(BluezResult<void>)> callback);
+	std::optional<bool> readAdapterBoolean(const std::string& property);
 
 	// Object Manager operations
 	BluezResult<void> setupObjectManager();
@@ -131,10 +198,33 @@ private:
 	void handleInterfacesAdded(DBusVariantRef parameters);
 	void handleInterfacesRemoved(DBusVariantRef parameters);
 	void handleNameOwnerChanged(DBusVariantRef parameters);
+	void refreshSignalMatchRule();
+	void removeSignalMatchRule();
+
+	// Advertising payload helpers
+	BluezResult<void> updateAdvertisingData(const std::function<void(AdvertisingData&)>& mutate);
+	void refreshAdvertisementPayload();
+	void applyAdvertisingIntervals(uint32_t minIntervalMs, uint32_t maxIntervalMs);
+	void cancelAdvertisingBurst();
+
+	// Advertising set helpers
+	struct AdvertisingSetState;
+	AdvertisingSetState* findAdvertisingSet(const std::string& name);
+	AdvertisingSetState* findAdvertisingSetByPath(const std::string& objectPath);
+	void releaseRetiredAdvertisement(const std::string& objectPath);
+	std::size_t advertisingSetCapacity() const;
+	void rotateAdvertisingSets();
+	void reconcileAdvertisingSets();
+	void updateAdvertisingRotationTimer(std::size_t liveSets);
+	void stopAdvertisingRotation();
 
 	// Internal connection tracking
 	void handleDeviceConnected(const std::string& devicePath);
 	void handleDeviceDisconnected(const std::string& devicePath);
+	void handleDeviceRemoved(const std::string& devicePath);
+	void scheduleDeviceEvents();
+	void flushDeviceEvents();
+	void cancelDeviceEvents();
 
 	// Member variables
 	std::string adapterPath;
@@ -153,16 +243,59 @@ private:
 	std::unique_ptr<BluezAdvertisement> advertisement;
 	std::unordered_map<std::string, bool> supportedInterfaces;
 
+	// Connectionless payload plus the budget inputs it is checked against (guarded for cross-thread setters)
+	mutable std::mutex advertisingDataMutex_;
+	AdvertisingData advertisingData_;
+	std::vector<std::string> advertisedServiceUUIDs_;
+	BluezCapabilities advertisingCapabilities_;
+	std::string advertisingPayloadReport_;
+
+	// Advertising parameters and burst scheduling (server loop only)
+	AdvertisingParameters advertisingParameters_;
+	std::optional<AdvertisingBurstPolicy> advertisingBurstPolicy_;
+	guint advertisingBurstTimerId_ = 0;
+
+	// Additional advertising sets in insertion order; removed sets linger until BlueZ has released them
+	struct AdvertisingSetState {
+		AdvertisingSetConfig config;
+		std::unique_ptr<BluezAdvertisement> advertisement;
+		int64_t rotationCredit = 0;
+		bool selected = false;     // should be on air in the current slice
+		bool pending = false;      // a register/unregister call is in flight
+		bool restart = false;      // re-register to pick up type, UUID or include changes
+		bool removed = false;
+	};
+	std::vector<AdvertisingSetState> advertisingSets_;
+	std::vector<std::unique_ptr<BluezAdvertisement>> retiredAdvertisements_;    // dropped by shutdown() with a call in flight
+	unsigned int nextAdvertisingSetIndex_ = 1;
+	uint32_t advertisingRotationSliceMs_ = 2000;
+	guint advertisingRotationTimerId_ = 0;
+
+	// State to replay on resume; set by prepareForSleep() and consumed by resumeFromSleep()
+	std::optional<SleepSnapshot> sleepSnapshot_;
+
 	// Signal subscription IDs
 	guint propertiesChangedSubscription = 0;
 	guint interfacesAddedSubscription = 0;
 	guint interfacesRemovedSubscription = 0;
 	guint nameOwnerChangedSubscription = 0;
 
+	// The PropertiesChanged subscription skips GDBus's own match rule; this one narrows it to the selected adapter
+	std::string propertiesChangedMatchRule_;
+
+	// Signal accounting, readable from any thread
+	std::atomic<uint64_t> signalsReceived_{0};
+	std::atomic<uint64_t> signalsFiltered_{0};
+	std::atomic<uint64_t> signalsHandled_{0};
+
 	// Connected devices tracking
 	std::unordered_map<std::string, DeviceInfo> connectedDevices;
 	mutable std::mutex connectedDevicesMutex_;
 
+	// Device signals waiting for the next batch (server loop only), flushed by a zero-delay run-loop timer on the next loop iteration
+	std::vector<detail::PendingDeviceEvent> pendingDeviceEvents_;
+	guint deviceEventsTimerId_ = 0;
+
 	// Configuration
 	RetryPolicy defaultRetryPolicy;
 	TimeoutConfig timeoutConfig;
@@ -193,6 +326,8 @@ private:
 	static gboolean onAdvertisingRetryTimeout(gpointer user_data);
 	static gboolean onReconnectTimeout(gpointer user_data);
 	static gboolean onDelayedReconnectTimeout(gpointer user_data);
+	static gboolean onAdvertisingBurstTimeout(gpointer user_data);
+	static gboolean onAdvertisingRotationTimeout(gpointer user_data);
 	void scheduleAsyncRetry(std::function<BluezResult<void>()> operation,
 	                       const RetryPolicy& policy,
 	                       std::function<void(BluezResult<void>)> completionCallback = nullptr);
@@ -200,8 +335,9 @@ private:
 	void clearReconnectTimers();
 	void scheduleReconnectAttempt(unsigned int delaySeconds, bool delayedRetry);
 
-	// Callback for connection events
+	// Callbacks for connection events
 	ConnectionCallback connectionCallback;
+	ConnectionsChangedCallback connectionsChangedCallback;
 
 	// Flag to cancel pending reconnect timers on shutdown
 	std::atomic<bool> reconnectCancelled_{false};
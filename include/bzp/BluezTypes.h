@@ -25,6 +25,7 @@
 
 #include <glib.h>
 #include <cstdint>
+#include <map>
 #include <string>
 #include <variant>
 #include <vector>
@@ -46,6 +47,7 @@ enum class BluezError
 	AlreadyExists,
 	NotFound,
 	ConnectionFailed,
+	PayloadTooLarge,    // an advertising payload that does not fit the controller budget
 	Unknown
 };
 
@@ -140,10 +142,89 @@ struct BluezCapabilities
 	bool hasExtendedAdvertising = false;
 	uint16_t maxAdvertisingDataLength = 31;
 	uint16_t maxScanResponseLength = 31;
+	uint8_t supportedAdvertisingInstances = 1;    // free LEAdvertisingManager1 instances when detected
 	std::vector<std::string> supportedSecondaryChannels;
 	std::string bluezVersion;
 };
 
+// Connectionless payload carried by the LE advertisement (keys are company IDs and service UUIDs)
+struct AdvertisingData
+{
+	std::map<uint16_t, std::vector<uint8_t>> manufacturerData;
+	std::map<std::string, std::vector<uint8_t>> serviceData;
+
+	bool empty() const { return manufacturerData.empty() && serviceData.empty(); }
+	bool operator==(const AdvertisingData&) const = default;
+};
+
+// LE advertising parameters; zero or empty fields leave the choice to BlueZ and the controller
+struct AdvertisingParameters
+{
+	uint32_t minIntervalMs = 0;
+	uint32_t maxIntervalMs = 0;
+	std::optional<int16_t> txPower;    // requested TX power in dBm
+	uint16_t durationSeconds = 0;      // on-air slot when BlueZ rotates several advertisements
+	uint16_t timeoutSeconds = 0;       // BlueZ releases the advertisement once this expires
+
+	bool operator==(const AdvertisingParameters&) const = default;
+};
+
+// Burst-then-relax schedule: a fast interval for quick discovery, then a power-saving interval
+struct AdvertisingBurstPolicy
+{
+	uint32_t burstMinIntervalMs = 20;
+	uint32_t burstMaxIntervalMs = 30;
+	uint32_t relaxedMinIntervalMs = 1000;
+	uint32_t relaxedMaxIntervalMs = 1200;
+	uint32_t burstDurationMs = 30000;
+	bool burstOnStart = true;
+};
+
+// An additional advertisement registered next to the primary connectable one (e.g. a non-connectable beacon)
+struct AdvertisingSetConfig
+{
+	std::string name;
+	std::string type = "broadcast";    // "broadcast" (non-connectable) or "peripheral"
+	unsigned int priority = 1;         // relative share of airtime when sets have to be rotated
+	std::vector<std::string> serviceUUIDs;
+	AdvertisingData data;
+	AdvertisingParameters parameters;
+	bool includeLocalName = false;
+
+	bool operator==(const AdvertisingSetConfig&) const = default;
+};
+
+// Adapter and advertising state captured before system sleep so resume can replay it directly
+struct SleepSnapshot
+{
+	bool powered = false;
+	std::optional<bool> discoverable;
+	std::optional<bool> pairable;
+	bool advertising = false;                    // the primary advertisement was registered
+	bool advertisingBurst = false;               // a fast-interval burst was running
+	std::vector<std::string> advertisingSets;    // additional sets that were on air
+};
+
+// Outcome of replaying a SleepSnapshot after resume
+struct ResumeReport
+{
+	int restoreCalls = 0;            // D-Bus calls issued concurrently
+	int failedCalls = 0;
+	bool advertisingRestored = false;
+	int64_t timeToAdvertiseMs = -1;  // resume signal to BlueZ accepting the primary advertisement; -1 if it never did
+	int64_t totalMs = 0;             // resume signal to the last restore call completing
+	std::string firstError;
+};
+
+// BlueZ signals that reached the adapter's handlers. `filtered` were dropped before being unpacked (objects of another adapter,
+// or property sets that cannot carry Device1.Connected); `handled` were passed on to connection or adapter tracking.
+struct BluezSignalStats
+{
+	uint64_t received = 0;
+	uint64_t filtered = 0;
+	uint64_t handled = 0;
+};
+
 // Retry policy configuration
 struct RetryPolicy
 {
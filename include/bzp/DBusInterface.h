@@ -117,8 +117,8 @@ struct DBusInterface
 	//
 
 	DBusObject &getOwner() const;
-	DBusObjectPath getPathNode() const;
-	DBusObjectPath getPath() const;
+	const DBusObjectPath &getPathNode() const;
+	const DBusObjectPath &getPath() const;
 
 	//
 	// D-Bus interface methods
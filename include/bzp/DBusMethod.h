@@ -146,7 +146,7 @@ struct DBusMethod
 			return;
 		}
 
-		Logger::info(SSTR << "Calling method: [" << path << "]:[" << interfaceName << "]:[" << methodName << "]");
+		LOG_INFO_STREAM(SSTR << "Calling method: [" << path << "]:[" << interfaceName << "]:[" << methodName << "]");
 		try {
 			callHandler(*typedOwner, methodName, methodCall);
 		} catch (const std::exception& e) {
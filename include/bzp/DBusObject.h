@@ -24,6 +24,7 @@
 
 #include <bzp/GLibTypes.h>
 #include <string>
+#include <string_view>
 #include <list>
 #include <memory>
 #include <optional>
@@ -69,8 +70,9 @@ struct DBusObject
 
 	// Returns the full path for this object within the hierarchy
 	//
-	// This method returns the full path. To get the current node, use `getPathNode()`
-	DBusObjectPath getPath() const;
+	// This method returns the full path. To get the current node, use `getPathNode()`. The full path is worked out once, when the
+	// object is constructed, so dispatch can compare against it without building strings.
+	const DBusObjectPath &getPath() const;
 
 	// Returns whether this object has a parent
 	bool hasParent() const noexcept;
@@ -100,6 +102,7 @@ struct DBusObject
 	std::shared_ptr<T> addInterface(std::shared_ptr<T> interface)
 	{
 		interfaces.push_back(interface);
+		noteTreeChanged();
 		return std::static_pointer_cast<T>(interfaces.back());
 	}
 
@@ -118,19 +121,25 @@ struct DBusObject
 	//
 
 	// Finds an interface by name within this D-Bus object
-	std::shared_ptr<const DBusInterface> findInterface(const DBusObjectPath &path, const std::string &interfaceName, const DBusObjectPath &basePath = DBusObjectPath()) const;
+	std::shared_ptr<const DBusInterface> findInterface(const DBusObjectPath &path, std::string_view interfaceName, const DBusObjectPath &basePath = DBusObjectPath()) const;
+
+	// Same search by full object path, skipping subtrees that cannot contain it. Does not allocate.
+	std::shared_ptr<const DBusInterface> findInterface(std::string_view path, std::string_view interfaceName) const;
 
 	// Finds a BlueZ method by name within the specified D-Bus interface
 #if BZP_ENABLE_LEGACY_RAW_GLIB_COMPAT
 	BZP_DEPRECATED("Use DBusObject::callMethod(..., DBusMethodCallRef)")
-	bool callMethod(const DBusObjectPath &path, const std::string &interfaceName, const std::string &methodName, GDBusConnection *pConnection, GVariant *pParameters, GDBusMethodInvocation *pInvocation, gpointer pUserData, const DBusObjectPath &basePath = DBusObjectPath()) const;
+	bool callMethod(const DBusObjectPath &path, std::string_view interfaceName, const std::string &methodName, GDBusConnection *pConnection, GVariant *pParameters, GDBusMethodInvocation *pInvocation, gpointer pUserData, const DBusObjectPath &basePath = DBusObjectPath()) const;
 #endif
-	bool callMethod(const DBusObjectPath &path, const std::string &interfaceName, const std::string &methodName, DBusMethodCallRef methodCall, const DBusObjectPath &basePath = DBusObjectPath()) const;
+	bool callMethod(const DBusObjectPath &path, std::string_view interfaceName, const std::string &methodName, DBusMethodCallRef methodCall, const DBusObjectPath &basePath = DBusObjectPath()) const;
 #if BZP_ENABLE_LEGACY_RAW_GLIB_COMPAT
 	BZP_DEPRECATED("Use DBusObject::callMethod(..., DBusMethodCallRef)")
-	bool callMethod(const DBusObjectPath &path, const std::string &interfaceName, const std::string &methodName, DBusConnectionRef connection, DBusVariantRef parameters, DBusMethodInvocationRef invocation, gpointer pUserData, const DBusObjectPath &basePath = DBusObjectPath()) const;
+	bool callMethod(const DBusObjectPath &path, std::string_view interfaceName, const std::string &methodName, DBusConnectionRef connection, DBusVariantRef parameters, DBusMethodInvocationRef invocation, gpointer pUserData, const DBusObjectPath &basePath = DBusObjectPath()) const;
 #endif
 
+	// Same dispatch by full object path, skipping subtrees that cannot contain it. Does not allocate.
+	bool callMethod(std::string_view path, std::string_view interfaceName, const std::string &methodName, DBusMethodCallRef methodCall) const;
+
 	// -----------------------------------------------------------------------------------------------------------------------------
 	// D-Bus signals
 	// -----------------------------------------------------------------------------------------------------------------------------
@@ -157,9 +166,13 @@ private:
 	Server *server_;
 	bool publish;
 	DBusObjectPath path;
+	DBusObjectPath fullPath;
 	InterfaceList interfaces;
 	std::list<DBusObject> children;
 	DBusObject *pParent;
+
+	// Bumps the server's tree generation
+	void noteTreeChanged() noexcept;
 };
 
 }; // namespace bzp
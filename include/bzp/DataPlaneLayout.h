@@ -0,0 +1,147 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Memory layout of the shared-memory data plane, shared by the BzPeri process and out-of-process producers.
+//
+// The region is a sealed memfd that BzPeri creates and hands out, together with an eventfd doorbell, over a Unix socket (see
+// BzPeriDataPlaneProducer.h). It starts with a 64-byte header, followed by one 64-byte slot descriptor per characteristic value,
+// followed by the value bytes of every slot, each starting on its own 64-byte boundary:
+//
+//     [BZPDataPlaneHeader][BZPDataPlaneSlot 0 .. slotCount-1][value 0][value 1]...
+//
+// Every slot is a seqlock with exactly one writer: the writer makes `sequence` odd, copies the value, stores `length` and makes
+// `sequence` even again; readers retry until they see the same even sequence before and after copying. After a write the
+// producer rings the doorbell only when BzPeri has armed it, so a burst of samples costs one eventfd write instead of one per
+// sample. All multi-byte fields are native-endian; the region never leaves the host.
+//
+// This header is plain C and needs nothing but a GCC-compatible compiler.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BZP_DATA_PLANE_MAGIC 0x50445a42u            /* "BZDP" */
+#define BZP_DATA_PLANE_VERSION 1
+#define BZP_DATA_PLANE_ALIGNMENT 64
+#define BZP_DATA_PLANE_NAME_BYTES 48                /* including the terminating NUL */
+#define BZP_DATA_PLANE_MAX_VALUE_BYTES 512          /* largest GATT attribute value */
+#define BZP_DATA_PLANE_READ_ATTEMPTS 1024           /* a slot still busy after this many tries reads as unavailable */
+
+typedef struct BZPDataPlaneHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t slotDescriptorBytes;    /* sizeof(BZPDataPlaneSlot) */
+	uint32_t slotCount;
+	uint32_t regionBytes;
+	uint32_t doorbellArmed;          /* non-zero while BzPeri wants the next write to ring the doorbell */
+	int32_t serverPid;
+	uint8_t reserved[40];
+} BZPDataPlaneHeader;
+
+typedef struct BZPDataPlaneSlot
+{
+	uint32_t sequence;               /* odd while a write is in progress */
+	uint32_t length;                 /* bytes of the current value */
+	uint32_t capacity;               /* most bytes a value may have */
+	uint32_t valueOffset;            /* from the start of the region */
+	char name[BZP_DATA_PLANE_NAME_BYTES];
+} BZPDataPlaneSlot;
+
+#ifdef __cplusplus
+static_assert(sizeof(BZPDataPlaneHeader) == BZP_DATA_PLANE_ALIGNMENT, "data plane header layout is shared across processes");
+static_assert(sizeof(BZPDataPlaneSlot) == BZP_DATA_PLANE_ALIGNMENT, "data plane slot layout is shared across processes");
+#else
+_Static_assert(sizeof(BZPDataPlaneHeader) == BZP_DATA_PLANE_ALIGNMENT, "data plane header layout is shared across processes");
+_Static_assert(sizeof(BZPDataPlaneSlot) == BZP_DATA_PLANE_ALIGNMENT, "data plane slot layout is shared across processes");
+#endif
+
+static inline uint32_t bzpDataPlaneAlign(uint32_t bytes)
+{
+	return (bytes + BZP_DATA_PLANE_ALIGNMENT - 1) & ~(uint32_t)(BZP_DATA_PLANE_ALIGNMENT - 1);
+}
+
+static inline BZPDataPlaneSlot *bzpDataPlaneSlots(void *region)
+{
+	return (BZPDataPlaneSlot *)((char *)region + sizeof(BZPDataPlaneHeader));
+}
+
+/* Returns non-zero when a mapping of `mappedBytes` holds a region this header version understands. */
+static inline int bzpDataPlaneIsValid(const void *region, size_t mappedBytes)
+{
+	const BZPDataPlaneHeader *header = (const BZPDataPlaneHeader *)region;
+	return mappedBytes >= sizeof(BZPDataPlaneHeader)
+		&& header->magic == BZP_DATA_PLANE_MAGIC
+		&& header->version == BZP_DATA_PLANE_VERSION
+		&& header->slotDescriptorBytes == sizeof(BZPDataPlaneSlot)
+		&& header->regionBytes <= mappedBytes
+		&& sizeof(BZPDataPlaneHeader) + (size_t)header->slotCount * sizeof(BZPDataPlaneSlot) <= header->regionBytes;
+}
+
+/* Seqlock write. Returns the value length written, or -1 when it exceeds the slot's capacity. */
+static inline int bzpDataPlaneWriteSlot(void *region, uint32_t index, const void *data, uint32_t length)
+{
+	BZPDataPlaneSlot *slot = &bzpDataPlaneSlots(region)[index];
+	if (length > slot->capacity)
+	{
+		return -1;
+	}
+
+	const uint32_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->sequence, sequence + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	memcpy((char *)region + slot->valueOffset, data, length);
+	__atomic_store_n(&slot->length, length, __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->sequence, sequence + 2, __ATOMIC_RELEASE);
+	return (int)length;
+}
+
+/* Call after one or more writes. Returns non-zero when the caller must write 1 to the doorbell eventfd. */
+static inline int bzpDataPlaneClaimDoorbell(void *region)
+{
+	BZPDataPlaneHeader *header = (BZPDataPlaneHeader *)region;
+	return __atomic_exchange_n(&header->doorbellArmed, 0u, __ATOMIC_SEQ_CST) != 0;
+}
+
+/* Seqlock read into `buffer`. Returns the value length (the copy is truncated to `bufferBytes`) and stores the even sequence
+   number the value belongs to in `sequenceOut` when it is non-NULL. Returns -1 when the slot stays mid-write, e.g. because its
+   writer died during a write. */
+static inline int bzpDataPlaneReadSlot(const void *region, uint32_t index, void *buffer, uint32_t bufferBytes, uint32_t *sequenceOut)
+{
+	const BZPDataPlaneSlot *slot = &bzpDataPlaneSlots((void *)region)[index];
+	for (int attempt = 0; attempt < BZP_DATA_PLANE_READ_ATTEMPTS; ++attempt)
+	{
+		const uint32_t before = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+		if ((before & 1u) != 0)
+		{
+			continue;
+		}
+
+		uint32_t length = __atomic_load_n(&slot->length, __ATOMIC_RELAXED);
+		if (length > slot->capacity)
+		{
+			continue;
+		}
+		memcpy(buffer, (const char *)region + slot->valueOffset, length < bufferBytes ? length : bufferBytes);
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) == before)
+		{
+			if (sequenceOut != NULL)
+			{
+				*sequenceOut = before;
+			}
+			return (int)length;
+		}
+	}
+	return -1;
+}
+
+#ifdef __cplusplus
+}
+#endif
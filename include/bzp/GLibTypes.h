@@ -105,21 +105,45 @@ private:
 	GDBusConnection *connection_;
 };
 
+// Receives the reply to a method call that did not arrive over a bus (see <bzp/Loopback.h>). `returnValue()` owns `parameters`
+// the way `g_dbus_method_invocation_return_value()` does: a floating reference is sunk, and nullptr is the empty reply.
+class DBusReplySink
+{
+public:
+	virtual void returnValue(GVariant *parameters) = 0;
+	virtual void returnDbusError(const char *errorName, const char *message) noexcept = 0;
+
+protected:
+	~DBusReplySink() = default;
+};
+
 class DBusMethodInvocationRef
 {
 public:
 	explicit DBusMethodInvocationRef(GDBusMethodInvocation *invocation = nullptr) noexcept
 	: invocation_(invocation)
+	, replySink_(nullptr)
+	{
+	}
+
+	explicit DBusMethodInvocationRef(DBusReplySink &replySink) noexcept
+	: invocation_(nullptr)
+	, replySink_(&replySink)
 	{
 	}
 
+	// The GDBus invocation, or nullptr when the reply goes to a sink instead
 	[[nodiscard]] GDBusMethodInvocation *get() const noexcept { return invocation_; }
-	[[nodiscard]] explicit operator bool() const noexcept { return invocation_ != nullptr; }
+	[[nodiscard]] DBusReplySink *replySink() const noexcept { return replySink_; }
+
+	// True when a reply has somewhere to go. Code that needs the GDBus invocation itself must test `get()`.
+	[[nodiscard]] explicit operator bool() const noexcept { return invocation_ != nullptr || replySink_ != nullptr; }
 	void returnDbusError(const char *errorName, const char *message) const noexcept;
 	void returnValue(DBusVariantRef variant, bool wrapInTuple = false) const;
 
 private:
 	GDBusMethodInvocation *invocation_;
+	DBusReplySink *replySink_;
 };
 
 class DBusObjectManagerRef
@@ -163,11 +187,15 @@ inline void DBusMethodInvocationRef::returnDbusError(const char *errorName, cons
 	{
 		g_dbus_method_invocation_return_dbus_error(invocation_, errorName, message);
 	}
+	else if (replySink_ != nullptr)
+	{
+		replySink_->returnDbusError(errorName, message);
+	}
 }
 
 inline void DBusMethodInvocationRef::returnValue(DBusVariantRef variant, bool wrapInTuple) const
 {
-	if (invocation_ == nullptr)
+	if (invocation_ == nullptr && replySink_ == nullptr)
 	{
 		return;
 	}
@@ -178,7 +206,14 @@ inline void DBusMethodInvocationRef::returnValue(DBusVariantRef variant, bool wr
 		parameters = g_variant_new_tuple(&parameters, 1);
 	}
 
-	g_dbus_method_invocation_return_value(invocation_, parameters);
+	if (invocation_ != nullptr)
+	{
+		g_dbus_method_invocation_return_value(invocation_, parameters);
+	}
+	else
+	{
+		replySink_->returnValue(parameters);
+	}
 }
 
 class DBusMethodCallRef
@@ -22,9 +22,19 @@
 
 #pragma once
 
+#include <BzPeri.h>
 #include <bzp/GLibTypes.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <list>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <bzp/Utils.h>
 #include <bzp/GattInterface.h>
@@ -42,6 +52,10 @@ struct GattProperty;
 struct GattService;
 struct GattUuid;
 struct DBusObject;
+struct PeriodicPublisher;
+struct IndicationQueue;
+class AcquiredNotifier;
+enum class IndicationResult;
 
 // ---------------------------------------------------------------------------------------------------------------------------------
 // Modern C++ Callback Types
@@ -59,8 +73,109 @@ namespace callbacks {
 	using CharacteristicMethodCallHandler = std::function<void(const GattCharacteristic&, const std::string&, DBusMethodCallRef)>;
 	using CharacteristicUpdateHandler = std::function<bool(const GattCharacteristic&, DBusConnectionRef, void*)>;
 	using CharacteristicUpdateCallHandler = std::function<bool(const GattCharacteristic&, DBusUpdateRef)>;
+
+	// Type-erased `GattCharacteristic::publishEvery()` producer: fills `bytes` (and `number` for numeric values) and returns
+	// false to skip the sample
+	using PublishSampler = std::function<bool(std::vector<std::uint8_t> &bytes, double &number)>;
+
+	// Completion of one `GattCharacteristic::indicateVariant()` / `indicateValue()` call, on the server thread
+	using IndicationCallback = std::function<void(IndicationResult)>;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Periodic publishing
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+// Which samples `GattCharacteristic::publishEvery()` leaves out
+struct PublishPolicy
+{
+	// Skip samples whose bytes equal the last value sent
+	bool suppressUnchanged = true;
+
+	// Numeric producers only: also skip samples less than this far from the last value sent (0 disables the deadband)
+	double deadband = 0.0;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Indications
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+// How an indication ended
+enum class IndicationResult
+{
+	Confirmed,     // the peer acknowledged it (BlueZ called Confirm)
+	TimedOut,      // no Confirm within IndicationPolicy::timeout
+	Superseded,    // replaced in the queue by a newer value (IndicationPolicy::coalesce)
+	Failed         // the value could not be emitted
+};
+
+// Queueing behind the one indication in flight
+struct IndicationPolicy
+{
+	// Values waiting behind the one in flight; further indications are refused
+	std::size_t maxQueued = 16;
+
+	// Keep only the newest waiting value; the one it replaces completes as Superseded
+	bool coalesce = false;
+
+	// ATT gives the peer 30 seconds to confirm
+	std::chrono::milliseconds timeout{30000};
+};
+
+// Counters for one characteristic's indications
+struct IndicationStats
+{
+	uint64_t sent = 0;
+	uint64_t confirmed = 0;
+	uint64_t timedOut = 0;
+	uint64_t superseded = 0;
+	uint64_t rejected = 0;      // refused because the queue was full
+	uint64_t failed = 0;
+	uint64_t strayConfirms = 0; // Confirm calls that arrived with nothing in flight
+	std::size_t queued = 0;     // waiting behind the one in flight
+	bool inFlight = false;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Acquired notifications
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+// Defaults for `GattCharacteristic::enableAcquiredNotify()`
+struct AcquiredNotifyPolicy
+{
+	// Token bucket for the characteristic: sustained notification payload bytes per second (0 is unlimited) and the burst on
+	// top of it
+	uint32_t bytesPerSecond = 0;
+	uint32_t burstBytes = 4096;
+
+	// Notifications waiting for the budget or the socket; a full queue drops its oldest entry
+	std::size_t maxQueued = 64;
+};
+
+// Counters for the AcquireNotify socket of one characteristic
+struct AcquiredNotifyStats
+{
+	bool acquired = false;      // BlueZ currently holds a socket (some device is subscribed)
+	uint16_t mtu = 0;           // as reported by the latest AcquireNotify
+	uint32_t bytesPerSecond = 0;
+	uint64_t acquisitions = 0;
+	uint64_t sent = 0;
+	uint64_t sentBytes = 0;
+	uint64_t dropped = 0;       // pushed out of a full queue
+	uint64_t oversized = 0;     // larger than the MTU allows
+	uint64_t refused = 0;       // queued while no socket was acquired
+	std::size_t queued = 0;
+};
+
+// Counters for one `GattCharacteristic::publishEvery()` publisher
+struct PublishStats
+{
+	uint64_t samples = 0;       // producer calls
+	uint64_t published = 0;     // samples sent as change notifications
+	uint64_t suppressed = 0;    // samples left out by the policy
+	bool subscribed = false;    // between StartNotify and StopNotify
+};
+
 // ---------------------------------------------------------------------------------------------------------------------------------
 // Representation of a Bluetooth GATT Characteristic
 // ---------------------------------------------------------------------------------------------------------------------------------
@@ -82,7 +197,7 @@ struct GattCharacteristic : GattInterface
 	// Genreally speaking, these objects should not be constructed directly. Rather, use the `gattCharacteristicBegin()` method
 	// in `GattService`.
 	GattCharacteristic(DBusObject &owner, GattService &service, const std::string &name);
-	virtual ~GattCharacteristic() {}
+	virtual ~GattCharacteristic();
 
 	// Returns a string identifying the type of interface
 	virtual const std::string getInterfaceType() const { return GattCharacteristic::kInterfaceType; }
@@ -103,12 +218,100 @@ struct GattCharacteristic : GattInterface
 	bool callMethod(const std::string &methodName, DBusConnectionRef connection, DBusVariantRef parameters, DBusMethodInvocationRef invocation, gpointer pUserData) const;
 #endif
 
-	// Modern periodic updates: Use GLib timers directly
-	// Example: g_timeout_add_seconds(60, [](gpointer data) -> gboolean {
-	//   auto* characteristic = static_cast<GattCharacteristic*>(data);
-	//   characteristic->sendChangeNotificationValue(connection, newValue);
-	//   return G_SOURCE_CONTINUE; // Keep repeating
-	// }, this);
+	// Periodic "sample, then notify if changed" publishing
+	//
+	// While a client is subscribed (between BlueZ's StartNotify and StopNotify calls), `producer` runs on the server thread
+	// every `period` and its value is sent as a change notification unless `policy` leaves it out. With no subscriber there is
+	// no timer and the producer is never called. The first sample after each StartNotify is always sent.
+	//
+	// Deadlines sit on a fixed-rate grid of the shared run-loop timer, so a slow producer or a late wakeup does not push later
+	// samples back, and publishers with the same period share one wakeup.
+	//
+	// The producer returns an arithmetic value (which also enables `policy.deadband`), std::string, std::string_view,
+	// std::vector<uint8_t> or any other trivially copyable type, sent as its raw bytes. publishEvery() answers StartNotify and
+	// StopNotify itself, so a characteristic cannot also define those methods.
+	//
+	//     .publishEvery(std::chrono::seconds(1), [] { return readBatteryLevel(); }, {.deadband = 2.0})
+	template<typename Producer>
+	GattCharacteristic &publishEvery(std::chrono::milliseconds period, Producer producer, const PublishPolicy &policy = {})
+	{
+		using Value = std::remove_cvref_t<std::invoke_result_t<Producer &>>;
+		callbacks::PublishSampler sampler = [producer = std::move(producer)](std::vector<std::uint8_t> &bytes, double &number) mutable {
+			const Value value = producer();
+			if constexpr (std::is_same_v<Value, std::string> || std::is_same_v<Value, std::string_view>)
+			{
+				bytes.assign(value.begin(), value.end());
+			}
+			else if constexpr (std::is_same_v<Value, std::vector<std::uint8_t>>)
+			{
+				bytes = value;
+			}
+			else
+			{
+				static_assert(std::is_trivially_copyable_v<Value>, "publishEvery() producers return numbers, text, bytes or trivially copyable values");
+				const auto *pRaw = reinterpret_cast<const std::uint8_t *>(&value);
+				bytes.assign(pRaw, pRaw + sizeof(Value));
+				if constexpr (std::is_arithmetic_v<Value>)
+				{
+					number = static_cast<double>(value);
+				}
+			}
+			return true;
+		};
+		return publishEverySampled(period, std::move(sampler), std::is_arithmetic_v<Value>, policy);
+	}
+
+	// Type-erased form of `publishEvery()`. `numeric` says whether the sampler fills `number`, which the deadband compares.
+	GattCharacteristic &publishEverySampled(std::chrono::milliseconds period, callbacks::PublishSampler sampler, bool numeric, const PublishPolicy &policy = {});
+
+	// Counters for the publisher set up by `publishEvery()` (all zero without one). Server thread only.
+	[[nodiscard]] PublishStats publishStats() const;
+
+	// Flow-controlled indications for characteristics declared with the "indicate" flag
+	//
+	// BlueZ calls the characteristic's Confirm method when the peer acknowledges an indication. Once this is enabled, at most one
+	// indication is in flight: `indicateVariant()` / `indicateValue()` emit right away when the window is free and otherwise
+	// queue according to `policy`, and each Confirm (or the timeout) completes the in-flight value and emits the next one. Values
+	// therefore go out as fast as the peer confirms them. A `publishEvery()` publisher on the same characteristic indicates
+	// through this queue as well.
+	//
+	// The window assumes a single subscribed device. BlueZ calls Confirm once per device that acknowledged, and Confirm carries
+	// nothing that ties it to an indication: with several subscribers the first Confirm completes the indication, and the
+	// extra ones either find nothing in flight (ignored and counted as `strayConfirms`) or complete the next indication before
+	// every device acknowledged it. Confirmed then means "one device confirmed".
+	GattCharacteristic &enableIndications(const IndicationPolicy &policy = {});
+	[[nodiscard]] bool indicationsEnabled() const { return static_cast<bool>(indications_); }
+
+	// Queues an indication; `done` runs on the server thread once it is confirmed, times out, is superseded or fails. Returns
+	// false (without calling `done`) when indications are not enabled or the queue is full. Server thread only; from other
+	// threads, wrap the call in `bzpRunLoopInvoke()`.
+	bool indicateVariant(DBusNotificationRef notification, callbacks::IndicationCallback done = {}) const;
+
+	template<typename T>
+	bool indicateValue(DBusConnectionRef busConnection, T value, callbacks::IndicationCallback done = {}) const
+	{
+		return indicateVariant(DBusNotificationRef(busConnection, Utils::dbusVariantFromByteArray(value)), std::move(done));
+	}
+
+	[[nodiscard]] IndicationStats indicationStats() const;
+
+	// Notifications through BlueZ's AcquireNotify
+	//
+	// Registers AcquireNotify and the NotifyAcquired property. BlueZ then asks for a socket when the first device enables
+	// notifications and sends every packet written to it to all subscribed devices; there is one socket per characteristic, not
+	// per device, and no way to address a single device through it. `notifyAcquired()` queues a value in front of that socket,
+	// drained under the token bucket from `policy` (or `setAcquiredNotifyBudget()`). NotifyAcquired follows the socket's state.
+	// StartNotify and StopNotify are no longer called once AcquireNotify exists, so this cannot be combined with `publishEvery()`.
+	// Server thread only; from other threads, wrap calls in `bzpRunLoopInvoke()`.
+	GattCharacteristic &enableAcquiredNotify(const AcquiredNotifyPolicy &policy = {});
+
+	// Queue a notification for the subscribed devices. Returns false when no device is subscribed or the value exceeds the MTU.
+	bool notifyAcquired(std::span<const std::uint8_t> value) const;
+
+	// 0 bytes per second is unlimited
+	void setAcquiredNotifyBudget(uint32_t bytesPerSecond, uint32_t burstBytes) const;
+
+	[[nodiscard]] AcquiredNotifyStats acquiredNotifyStats() const;
 
 	// Specialized support for Characteristic ReadlValue method
 	//
@@ -141,6 +344,18 @@ struct GattCharacteristic : GattInterface
 	GattCharacteristic &onWriteValue(const callbacks::CharacteristicMethodHandler &callback);
 	GattCharacteristic &onWriteValue(const callbacks::CharacteristicMethodCallHandler &callback);
 
+	// Alternative to `onWriteValue()` for high-rate writes (typically write-without-response streams)
+	//
+	// Instead of running a handler on the server thread, each WriteValue payload is copied once into the ingestion ring
+	// `ringName` and answered immediately; an application thread consumes the packets with `bzpReadIngest()` or
+	// `bzp::IngestReader`. The ring is created on first use with `packetCount` packets of up to `packetBytes` bytes (0 selects
+	// the defaults, see `bzpRegisterIngest()`). A characteristic has either a write handler or an ingestion ring, not both.
+	GattCharacteristic &onWriteIngest(const std::string &ringName, unsigned int packetCount = 0, unsigned int packetBytes = 0);
+
+	// Lane for this characteristic's queued updates (see `bzpSetUpdatePriority()`). Critical updates are taken off the queue
+	// ahead of normal and bulk ones, subject to the schedule set with `bzpSetUpdateSchedule()`.
+	GattCharacteristic &updatePriority(BZPUpdatePriority priority);
+
 	// Custom support for handling updates to our characteristic's value
 	//
 	// Defined as: (NOT defined by Bluetooth or BlueZ - this method is internal only)
@@ -259,6 +474,10 @@ private:
 	callbacks::CharacteristicMethodCallHandler readHandler_;
 	callbacks::CharacteristicMethodCallHandler writeHandler_;
 	callbacks::CharacteristicUpdateCallHandler updateHandler_;
+	int ingestHandle_ = -1;
+	std::shared_ptr<PeriodicPublisher> publisher_;
+	std::shared_ptr<IndicationQueue> indications_;
+	std::shared_ptr<AcquiredNotifier> acquiredNotifier_;
 };
 
 }; // namespace bzp
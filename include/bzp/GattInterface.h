@@ -23,8 +23,11 @@
 #pragma once
 
 #include <bzp/GLibTypes.h>
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <list>
+#include <type_traits>
 
 #include <bzp/DBusInterface.h>
 #include <bzp/DBusObject.h>
@@ -343,6 +346,36 @@ struct GattInterface : DBusInterface
 		return owner.getDataSetter()(pName, static_cast<const void *>(pointer)) != 0;
 	}
 
+	// Read a fixed-size value through a typed data store handle (see `bzpDataRegister()`)
+	//
+	// Services that resolve their handles once avoid the name lookup of `getDataValue()` on every access. An example usage would
+	// be:
+	//
+	//     uint8_t batteryLevel = self.readData<uint8_t>(batteryLevelHandle, 0);
+	template<typename T>
+	T readData(int handle, const T defaultValue) const
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "readData() copies the stored bytes");
+		T value = defaultValue;
+		return bzpDataRead(handle, &value, sizeof(T)) == static_cast<int>(sizeof(T)) ? value : defaultValue;
+	}
+
+	// Read a text slot through a typed data store handle
+	std::string readDataText(int handle, const std::string &defaultValue = {}) const
+	{
+		char buffer[512];
+		const int length = bzpDataRead(handle, buffer, sizeof(buffer));
+		return length < 0 ? defaultValue : std::string(buffer, static_cast<std::size_t>(std::min(length, static_cast<int>(sizeof(buffer)))));
+	}
+
+	// Store a fixed-size value through a typed data store handle. A slot bound to a characteristic queues its update itself.
+	template<typename T>
+	bool writeData(int handle, const T &value) const
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "writeData() stores raw bytes");
+		return bzpDataWrite(handle, &value, sizeof(T)) != 0;
+	}
+
 	// When responding to a ReadValue method, we need to return a GVariant value in the form "(ay)" (a tuple containing an array of
 	// bytes). This method will simplify this slightly by wrapping a GVariant of the type "ay" and wrapping it in a tuple before
 	// sending it off as the method response.
@@ -397,7 +430,7 @@ struct GattInterface : DBusInterface
 	// Locates a `GattProperty` within the interface
 	//
 	// This method returns a pointer to the property or nullptr if not found
-	const GattProperty *findProperty(const std::string &name) const;
+	const GattProperty *findProperty(std::string_view name) const;
 
 	// Internal method used to generate introspection XML used to describe our services on D-Bus
 	virtual std::string generateIntrospectionXML(int depth) const;
@@ -0,0 +1,88 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// C++ consumer for write ingestion rings (see `bzpReadIngest()` and `GattCharacteristic::onWriteIngest()`)
+//
+//     bzp::IngestReader<> reader(bzpFindIngest("uart/rx"));
+//     for (;;)
+//     {
+//         pollfd descriptor{reader.fd(), POLLIN, 0};
+//         poll(&descriptor, 1, -1);
+//         while (reader.next())
+//         {
+//             for (std::span<const std::uint8_t> packet : reader)
+//             {
+//                 parse(packet);
+//             }
+//         }
+//     }
+//
+// Spans point into the ring and stay valid until the following next(). Use one reader per ring, from one thread.
+
+#pragma once
+
+#include <BzPeri.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+
+namespace bzp {
+
+template<std::size_t BatchSize = 32>
+class IngestReader
+{
+	static_assert(BatchSize > 0, "IngestReader needs room for at least one packet");
+
+public:
+	class iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::span<const std::uint8_t>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = value_type;
+
+		iterator() noexcept = default;
+		explicit iterator(const BZPIngestPacket *packet) noexcept : packet_(packet) {}
+
+		reference operator*() const noexcept
+		{
+			return {static_cast<const std::uint8_t *>(packet_->pData), packet_->length};
+		}
+		iterator &operator++() noexcept { ++packet_; return *this; }
+		iterator operator++(int) noexcept { iterator previous = *this; ++packet_; return previous; }
+		bool operator==(const iterator &other) const noexcept = default;
+
+	private:
+		const BZPIngestPacket *packet_ = nullptr;
+	};
+
+	explicit IngestReader(int handle) noexcept : handle_(handle) {}
+
+	// Release the current batch and fetch the next one. Returns false once the ring is drained, which also arms fd() for the
+	// next packet.
+	bool next() noexcept
+	{
+		const int count = bzpReadIngest(handle_, packets_.data(), static_cast<unsigned int>(BatchSize));
+		count_ = count > 0 ? static_cast<std::size_t>(count) : 0;
+		return count_ != 0;
+	}
+
+	[[nodiscard]] int fd() const noexcept { return bzpGetIngestFD(handle_); }
+	[[nodiscard]] int handle() const noexcept { return handle_; }
+	[[nodiscard]] std::size_t size() const noexcept { return count_; }
+	[[nodiscard]] bool empty() const noexcept { return count_ == 0; }
+	[[nodiscard]] iterator begin() const noexcept { return iterator(packets_.data()); }
+	[[nodiscard]] iterator end() const noexcept { return iterator(packets_.data() + count_); }
+
+private:
+	int handle_;
+	std::array<BZPIngestPacket, BatchSize> packets_{};
+	std::size_t count_ = 0;
+};
+
+} // namespace bzp
@@ -0,0 +1,111 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// In-process transport that calls a server's methods and properties without a bus
+//
+//     bzp::LoopbackTransport loopback(server);
+//     const bzp::LoopbackReply &reply = loopback.callMethod("/com/example/battery/level", "org.bluez.GattCharacteristic1",
+//         "ReadValue", g_variant_new("(a{sv})", nullptr));
+//     if (reply.hasValue()) { ... reply.value().get() ... }
+//
+// Calls run through the same dispatch functions as messages from BlueZ: object and property lookup, handler selection, the
+// event stream record, logging, and the NotImplemented or property error when something is missing. Handlers see no
+// connection, and their `DBusMethodCallRef` replies (`returnValue()`, `returnDbusError()`, `methodReturnValue()`) land in the
+// transport instead of on the bus. `methodCall.invocation().get()` is nullptr, so legacy raw callbacks receive a null
+// `GDBusMethodInvocation *` and their replies are lost (the reply stays `Status::None`). AcquireNotify answers NotSupported
+// without acquiring anything, because there is no bus to carry its file descriptor.
+//
+// The transport keeps a single reply, reset by every call, so a call does not allocate on the transport's side. Handlers must
+// reply before they return: deferred replies are not supported. A reply that arrives after its call returned is logged as an
+// error, counted by `lateReplyCount()` and dropped, and one sent after the transport is destroyed is undefined behaviour. Use a
+// transport from one thread at a time; handlers have the same threading expectations they have on the server thread.
+
+#pragma once
+
+#include <bzp/GLibTypes.h>
+
+#include <cstddef>
+#include <string>
+
+namespace bzp {
+
+struct Server;
+
+class LoopbackReply
+{
+public:
+	enum class Status
+	{
+		None,     // the handler has not replied (yet)
+		Value,    // method return, property value, or a successful Set
+		Error
+	};
+
+	[[nodiscard]] Status status() const noexcept { return status_; }
+	[[nodiscard]] bool hasValue() const noexcept { return status_ == Status::Value; }
+	[[nodiscard]] bool hasError() const noexcept { return status_ == Status::Error; }
+
+	// The reply tuple or property value, owned by the transport. Empty for an empty method return and for Set.
+	[[nodiscard]] DBusVariantRef value() const noexcept { return DBusVariantRef(value_); }
+
+	// D-Bus error name and message, as a bus client would receive them
+	[[nodiscard]] const std::string &errorName() const noexcept { return errorName_; }
+	[[nodiscard]] const std::string &errorMessage() const noexcept { return errorMessage_; }
+
+	// How many replies the handler sent. Only the first one counts on a bus, and so it does here.
+	[[nodiscard]] std::size_t replyCount() const noexcept { return replyCount_; }
+
+private:
+	friend class LoopbackTransport;
+
+	Status status_ = Status::None;
+	GVariant *value_ = nullptr;
+	std::string errorName_;
+	std::string errorMessage_;
+	std::size_t replyCount_ = 0;
+};
+
+class LoopbackTransport : private DBusReplySink
+{
+public:
+	// `sender` is the unique bus name handlers see as the caller
+	explicit LoopbackTransport(const Server &server, std::string sender = ":1.loopback");
+	~LoopbackTransport();
+
+	LoopbackTransport(const LoopbackTransport &) = delete;
+	LoopbackTransport &operator=(const LoopbackTransport &) = delete;
+
+	// Calls a method. `pParameters` is the argument tuple (a floating reference is sunk and released after the call); nullptr
+	// passes an empty tuple.
+	const LoopbackReply &callMethod(const char *pObjectPath, const char *pInterfaceName, const char *pMethodName,
+		GVariant *pParameters = nullptr);
+
+	// Reads a property (org.freedesktop.DBus.Properties.Get)
+	const LoopbackReply &getProperty(const char *pObjectPath, const char *pInterfaceName, const char *pPropertyName);
+
+	// Writes a property (org.freedesktop.DBus.Properties.Set). A floating `pValue` is sunk and released after the call.
+	const LoopbackReply &setProperty(const char *pObjectPath, const char *pInterfaceName, const char *pPropertyName,
+		GVariant *pValue);
+
+	// The reply of the latest call
+	[[nodiscard]] const LoopbackReply &reply() const noexcept { return reply_; }
+
+	// Replies that arrived after their call had returned, and were dropped
+	[[nodiscard]] std::size_t lateReplyCount() const noexcept { return lateReplies_; }
+
+private:
+	void reset();
+	void returnError(GError *pError);
+	bool acceptReply() noexcept;
+	void returnValue(GVariant *parameters) override;
+	void returnDbusError(const char *errorName, const char *message) noexcept override;
+
+	const Server &server_;
+	std::string sender_;
+	GVariant *pEmptyParameters_;
+	LoopbackReply reply_;
+	bool inCall_ = false;
+	std::size_t lateReplies_ = 0;
+};
+
+} // namespace bzp
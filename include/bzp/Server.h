@@ -27,6 +27,8 @@
 #pragma once
 
 #include <bzp/GLibTypes.h>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -75,6 +77,10 @@ struct Server
 	// Configure the server using a builder callback to mutate the root hierarchy
 	void configure(const std::function<void(DBusObject&)>& builder);
 
+	// Changes whenever an object or interface is added anywhere in the hierarchy, so views derived from the tree can be cached
+	// and rebuilt only when it changes
+	[[nodiscard]] std::uint64_t getTreeGeneration() const noexcept { return treeGeneration.load(std::memory_order_acquire); }
+
 	// Returns the requested setting for BR/EDR (true = enabled, false = disabled)
 	[[nodiscard]] bool getEnableBREDR() const noexcept { return enableBREDR; }
 
@@ -134,6 +140,9 @@ struct Server
 	// server name to keep things simple.
 	[[nodiscard]] std::string getOwnedName() const { return std::string("com.") + getServiceName(); }
 
+	// Error name returned for methods without a handler (the owned name plus ".NotImplemented")
+	[[nodiscard]] const std::string& getNotImplementedErrorName() const noexcept { return notImplementedErrorName; }
+
 	//
 	// Initialization
 	//
@@ -190,6 +199,7 @@ struct Server
 	//
 	// If the method was called, this method returns true, otherwise false.  There is no result from the method call itself.
 	[[nodiscard]] std::shared_ptr<const DBusInterface> findInterface(const DBusObjectPath& objectPath, std::string_view interfaceName) const;
+	[[nodiscard]] std::shared_ptr<const DBusInterface> findInterface(std::string_view objectPath, std::string_view interfaceName) const;
 
 	// Find a D-Bus method within the given D-Bus object on the given D-Bus interface
 	//
@@ -199,6 +209,7 @@ struct Server
 	[[nodiscard]] bool callMethod(const DBusObjectPath& objectPath, std::string_view interfaceName, std::string_view methodName, GDBusConnection* pConnection, GVariant* pParameters, GDBusMethodInvocation* pInvocation, gpointer pUserData) const;
 #endif
 	[[nodiscard]] bool callMethod(const DBusObjectPath& objectPath, std::string_view interfaceName, std::string_view methodName, DBusMethodCallRef methodCall) const;
+	[[nodiscard]] bool callMethod(std::string_view objectPath, std::string_view interfaceName, std::string_view methodName, DBusMethodCallRef methodCall) const;
 #if BZP_ENABLE_LEGACY_RAW_GLIB_COMPAT
 	BZP_DEPRECATED("Use Server::callMethod(..., DBusMethodCallRef)")
 	[[nodiscard]] bool callMethod(const DBusObjectPath& objectPath, std::string_view interfaceName, std::string_view methodName, DBusConnectionRef connection, DBusVariantRef parameters, DBusMethodInvocationRef invocation, gpointer pUserData) const;
@@ -208,8 +219,13 @@ struct Server
 	//
 	// If the property was found, it is returned, otherwise nullptr is returned
 	[[nodiscard]] const GattProperty* findProperty(const DBusObjectPath& objectPath, std::string_view interfaceName, std::string_view propertyName) const;
+	[[nodiscard]] const GattProperty* findProperty(std::string_view objectPath, std::string_view interfaceName, std::string_view propertyName) const;
 
 private:
+	friend struct DBusObject;
+
+	// Called by DBusObject after an object or interface was added
+	void noteTreeChanged() noexcept { treeGeneration.fetch_add(1, std::memory_order_acq_rel); }
 
 	// Our server's objects
 	Objects objects;
@@ -269,6 +285,12 @@ private:
 	// This is used to build the path for our Bluetooth services (and we'll go ahead and use it as the owned name as well for
 	// consistency.)
 	std::string serviceName;
+
+	// Built once alongside serviceName so method dispatch never has to
+	std::string notImplementedErrorName;
+
+	// See getTreeGeneration()
+	std::atomic<std::uint64_t> treeGeneration{0};
 };
 
 std::shared_ptr<Server> getActiveServer();
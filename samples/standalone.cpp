@@ -30,7 +30,8 @@
 //         Two of the parameters to `bzpStart()` are delegates responsible for providing data accessors for the server, a
 //         `BZPServerDataGetter` delegate and a 'BZPServerDataSetter' delegate. The getter method simply receives a string name (for
 //         example, "battery/level") and returns a void pointer to that data (for example: `(void *)&batteryLevel`). The setter does
-//         the same only in reverse.
+//         the same only in reverse. `bzpDataStoreGetter` / `bzpDataStoreSetter` implement both on top of the typed data store
+//         (`bzpDataRegister()`), which is what this sample does.
 //
 //         While the server is running, you will likely need to update the data being served. This is done by calling
 //         `bzpNotifyUpdatedCharacteristic()` or `bzpNotifyUpdatedDescriptor()` with the full path to the characteristic or delegate
@@ -96,10 +97,21 @@
 #include <signal.h>
 #include <cerrno>
 #include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <gio/gio.h>
+#include <glib-unix.h>
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -116,6 +128,7 @@
 #include "../include/bzp/GattInterface.h"
 #include "../include/bzp/Server.h"
 #include "SampleServices.h"
+#include "../src/EventStream.h"
 #include "../src/StandaloneWorkflow.h"
 
 //
@@ -330,11 +343,13 @@ static bool parseGLibCaptureDomains(const std::string &value, unsigned int *doma
 // Server data values
 //
 
-// The battery level ("battery/level") reported by the server (see Server.cpp)
-static uint8_t serverDataBatteryLevel = 78;
-
-// The text string ("text/string") used by our custom text string service (see Server.cpp)
-static std::string serverDataTextString = "Hello, world!";
+// Typed data store handles for the battery level ("battery/level") and the text string ("text/string") served by the bundled
+// example services (see SampleServices.cpp). Both are registered before the server starts.
+static int batteryLevelHandle = -1;
+static int textStringHandle = -1;
+static constexpr uint8_t kInitialBatteryLevel = 78;
+static constexpr const char *kInitialTextString = "Hello, world!";
+static constexpr unsigned int kTextStringBytes = 512;
 
 // Cached D-Bus path for the sample battery characteristic
 static std::string batteryLevelObjectPath;
@@ -348,6 +363,28 @@ static std::unique_ptr<bzp::standalone::InspectSessionStore> inspectSessionStore
 static std::unique_ptr<bzp::standalone::InspectSessionSnapshot> inspectSessionSnapshot;
 static std::recursive_mutex inspectSessionMutex;
 
+// What a change event invalidates in the managed snapshot; refreshes recompute only the named fields
+enum InspectDirtyFlags : unsigned
+{
+	kInspectDirtyRuntime = 1U << 0,        // run state, health, connection count, advertising
+	kInspectDirtyAdapter = 1U << 1,        // adapter identity/power and the warnings derived from it
+	kInspectDirtySampleValue = 1U << 2,    // the selected object's live sample value line
+	kInspectDirtyTree = 1U << 3,           // object structure: count, tree lines, selected object metadata
+	kInspectDirtyAll = (1U << 4) - 1
+};
+
+// Object tree rendering, kept until the tree structure changes (guarded by inspectSessionMutex)
+struct InspectTreeCache
+{
+	bool valid = false;
+	int objectCount = 0;
+	std::uint64_t treeGeneration = 0;    // the server's tree generation the cache was built from
+	std::vector<std::string> objectTreeLines;
+	std::string selectedObjectSummary;
+	std::vector<std::string> selectedObjectLines;    // metadata only; the sample value line is appended per refresh
+};
+static InspectTreeCache inspectTreeCache;
+
 //
 // Logging
 //
@@ -372,7 +409,7 @@ void LogError(const char *pText);
 void LogFatal(const char *pText);
 void LogAlways(const char *pText);
 void LogTrace(const char *pText);
-void recordInspectSemanticEvent(bzp::standalone::EventLevel level, const std::string &component, const std::string &message, bool refreshSnapshot = false);
+void recordInspectSemanticEvent(bzp::standalone::EventLevel level, const std::string &component, const std::string &message, unsigned dirty = 0);
 }
 
 //
@@ -398,12 +435,26 @@ void installSignalHandler(int signum)
 // Server data management
 //
 
+static uint8_t currentBatteryLevel()
+{
+	uint8_t level = 0;
+	return bzpDataRead(batteryLevelHandle, &level, sizeof(level)) == sizeof(level) ? level : 0;
+}
+
+static void registerServerData()
+{
+	batteryLevelHandle = bzpDataRegister("battery/level", BZP_DATA_SLOT_FIXED, sizeof(uint8_t),
+		batteryLevelObjectPath.empty() ? nullptr : batteryLevelObjectPath.c_str());
+	textStringHandle = bzpDataRegister("text/string", BZP_DATA_SLOT_TEXT, kTextStringBytes, nullptr);
+	bzpDataWrite(batteryLevelHandle, &kInitialBatteryLevel, sizeof(kInitialBatteryLevel));
+	bzpDataWrite(textStringHandle, kInitialTextString, static_cast<unsigned int>(std::strlen(kInitialTextString)));
+}
+
 // Called by the server when it wants to retrieve a named value
 //
-// This method conforms to `BZPServerDataGetter` and is passed to the server via our call to `bzpStart()`.
-//
-// The server calls this method from its own thread, so we must ensure our implementation is thread-safe. In our case, we're simply
-// sending over stored values, so we don't need to take any additional steps to ensure thread-safety.
+// This method conforms to `BZPServerDataGetter` and is passed to the server via our call to `bzpStart()`. The values live in the
+// typed data store, which is safe to read from the server's thread while the main loop writes; this wrapper only adds the
+// inspect activity feed on top of `bzpDataStoreGetter()`.
 const void *dataGetter(const char *pName)
 {
 	if (nullptr == pName)
@@ -412,37 +463,36 @@ const void *dataGetter(const char *pName)
 		return nullptr;
 	}
 
-	std::string strName = pName;
+	const void *pValue = bzpDataStoreGetter(pName);
+	if (nullptr == pValue)
+	{
+		return nullptr;
+	}
 
-	if (strName == "battery/level")
+	const std::string_view name = pName;
+	if (name == "battery/level")
 	{
 		recordInspectSemanticEvent(
 			bzp::standalone::EventLevel::Status,
 			"gatt",
 			std::string("read path=") + (batteryLevelObjectPath.empty() ? "/com/.../battery/level" : batteryLevelObjectPath)
-				+ " value=" + std::to_string(serverDataBatteryLevel) + "%");
-		return &serverDataBatteryLevel;
+				+ " value=" + std::to_string(*static_cast<const uint8_t *>(pValue)) + "%");
 	}
-	else if (strName == "text/string")
+	else if (name == "text/string")
 	{
 		recordInspectSemanticEvent(
 			bzp::standalone::EventLevel::Status,
 			"gatt",
 			std::string("read path=") + (textStringObjectPath.empty() ? "/com/.../text/string" : textStringObjectPath)
-				+ " value='" + serverDataTextString + "'");
-		return serverDataTextString.c_str();
+				+ " value='" + static_cast<const char *>(pValue) + "'");
 	}
-
-	LogWarn((std::string("Unknown name for server data getter request: '") + pName + "'").c_str());
-	return nullptr;
+	return pValue;
 }
 
 // Called by the server when it wants to update a named value
 //
-// This method conforms to `BZPServerDataSetter` and is passed to the server via our call to `bzpStart()`.
-//
-// The server calls this method from its own thread, so we must ensure our implementation is thread-safe. In our case, we're simply
-// sending over stored values, so we don't need to take any additional steps to ensure thread-safety.
+// This method conforms to `BZPServerDataSetter` and is passed to the server via our call to `bzpStart()`. As with the getter,
+// storage and validation come from `bzpDataStoreSetter()`; this wrapper logs what changed.
 int dataSetter(const char *pName, const void *pData)
 {
 	if (nullptr == pName)
@@ -456,36 +506,35 @@ int dataSetter(const char *pName, const void *pData)
 		return 0;
 	}
 
-	std::string strName = pName;
+	if (bzpDataStoreSetter(pName, pData) == 0)
+	{
+		LogWarn((std::string("Server data setter rejected a value for '") + pName + "'").c_str());
+		return 0;
+	}
 
-	if (strName == "battery/level")
+	const std::string_view name = pName;
+	if (name == "battery/level")
 	{
-		serverDataBatteryLevel = *static_cast<const uint8_t *>(pData);
-		LogDebug((std::string("Server data: battery level set to ") + std::to_string(serverDataBatteryLevel)).c_str());
+		const uint8_t level = *static_cast<const uint8_t *>(pData);
+		LogDebug((std::string("Server data: battery level set to ") + std::to_string(level)).c_str());
 		recordInspectSemanticEvent(
 			bzp::standalone::EventLevel::Status,
 			"gatt",
 			std::string("write path=") + (batteryLevelObjectPath.empty() ? "/com/.../battery/level" : batteryLevelObjectPath)
-				+ " value=" + std::to_string(serverDataBatteryLevel) + "%",
-			true);
-		return 1;
+				+ " value=" + std::to_string(level) + "%",
+			kInspectDirtySampleValue);
 	}
-	else if (strName == "text/string")
+	else if (name == "text/string")
 	{
-		serverDataTextString = static_cast<const char *>(pData);
-		LogDebug((std::string("Server data: text string set to '") + serverDataTextString + "'").c_str());
+		const char *pText = static_cast<const char *>(pData);
+		LogDebug((std::string("Server data: text string set to '") + pText + "'").c_str());
 		recordInspectSemanticEvent(
 			bzp::standalone::EventLevel::Status,
 			"gatt",
 			std::string("write path=") + (textStringObjectPath.empty() ? "/com/.../text/string" : textStringObjectPath)
-				+ " value='" + serverDataTextString + "'",
-			true);
-		return 1;
+				+ " value='" + pText + "'");
 	}
-
-	LogWarn((std::string("Unknown name for server data setter request: '") + pName + "'").c_str());
-
-	return 0;
+	return 1;
 }
 
 //
@@ -496,6 +545,7 @@ namespace {
 
 constexpr std::size_t kInspectEventLimit = 64;
 constexpr int kDefaultInspectRefreshMs = 500;
+constexpr guint kBenchTickMs = 2;
 
 enum class CommandMode
 {
@@ -503,6 +553,7 @@ enum class CommandMode
 	Demo,
 	Doctor,
 	Inspect,
+	Bench,
 };
 
 struct CommonOptions
@@ -527,12 +578,32 @@ struct DemoOptions
 	bool sleepIntegrationEnabled = bzpGetConfiguredPrepareForSleepIntegrationEnabled() != 0;
 	bool sleepInhibitorEnabled = bzpGetConfiguredSleepInhibitorEnabled() != 0;
 	bool installHostManagedCapture = false;
+	double notifyRate = 0.0;    // battery level notifications per second for `bench`; 0 keeps the 15 s sample tick
 	bool showHelp = false;
 };
 
 struct DoctorOptions
 {
 	CommonOptions common;
+	int probeTimeoutMs = bzp::standalone::kDefaultDoctorProbeDeadlineMs;
+	bool showHelp = false;
+};
+
+struct BenchOptions
+{
+	CommonOptions common;
+	std::string bus = "system";         // system, session, or a D-Bus address such as unix:path=/tmp/fake-bluez.sock
+	std::string serviceName = "bzperi";
+	int durationSeconds = 10;
+	double readRate = 50.0;             // ReadValue calls per second, spread over every readable characteristic
+	double writeRate = 10.0;            // WriteValue calls per second, spread over every writable characteristic
+	std::string writeValue = "bzp-bench";
+	std::string readPath;               // restrict reads to one characteristic
+	std::string writePath;              // restrict writes to one characteristic
+	bool subscribe = true;              // count PropertiesChanged notifications from notify/indicate characteristics
+	int maxInFlight = 32;
+	int timeoutMs = 2000;
+	int pid = 0;                        // server pid for /proc CPU time; looked up from the bus name when 0
 	bool showHelp = false;
 };
 
@@ -542,6 +613,7 @@ struct InspectOptions
 	bool verboseEvents = false;
 	bool showTree = false;
 	int refreshMs = kDefaultInspectRefreshMs;
+	int pid = 0;    // attach to this process's event stream instead of the managed session file
 	bool showHelp = false;
 };
 
@@ -554,10 +626,21 @@ struct CommandSelection
 class RuntimeDoctorProbe final : public bzp::standalone::DoctorProbe
 {
 public:
+	RuntimeDoctorProbe() : cancellable_(g_cancellable_new()) {}
+	~RuntimeDoctorProbe() override { g_object_unref(cancellable_); }
+
+	RuntimeDoctorProbe(const RuntimeDoctorProbe &) = delete;
+	RuntimeDoctorProbe &operator=(const RuntimeDoctorProbe &) = delete;
+
+	void cancel() const override
+	{
+		g_cancellable_cancel(cancellable_);
+	}
+
 	bool checkSystemBus(std::string *detailOut) const override
 	{
 		GError *error = nullptr;
-		GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SYSTEM, nullptr, &error);
+		GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SYSTEM, cancellable_, &error);
 		if (connection == nullptr)
 		{
 			if (detailOut != nullptr)
@@ -582,7 +665,7 @@ public:
 	bool checkBluezService(std::string *detailOut) const override
 	{
 		GError *error = nullptr;
-		GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SYSTEM, nullptr, &error);
+		GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SYSTEM, cancellable_, &error);
 		if (connection == nullptr)
 		{
 			if (detailOut != nullptr)
@@ -606,7 +689,7 @@ public:
 			G_VARIANT_TYPE("(b)"),
 			G_DBUS_CALL_FLAGS_NONE,
 			3000,
-			nullptr,
+			cancellable_,
 			&error);
 		g_object_unref(connection);
 
@@ -638,7 +721,7 @@ public:
 	bool checkServiceOwnership(const std::string &ownedName, std::string *detailOut) const override
 	{
 		GError *error = nullptr;
-		GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SYSTEM, nullptr, &error);
+		GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SYSTEM, cancellable_, &error);
 		if (connection == nullptr)
 		{
 			if (detailOut != nullptr)
@@ -662,7 +745,7 @@ public:
 			G_VARIANT_TYPE("(u)"),
 			G_DBUS_CALL_FLAGS_NONE,
 			3000,
-			nullptr,
+			cancellable_,
 			&error);
 		if (reply == nullptr)
 		{
@@ -745,68 +828,63 @@ public:
 			*poweredAdapterAvailableOut = false;
 		}
 
-		auto &adapter = bzp::getActiveBluezAdapter();
-		adapter.setServiceNameContext("bzperi");
-		const auto initializeResult = adapter.initialize(preferredAdapter);
-		if (!initializeResult.isSuccess())
+		// Read the adapters straight from BlueZ's object manager; BluezAdapter::initialize() cannot be cancelled
+		GError *error = nullptr;
+		GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SYSTEM, cancellable_, &error);
+		GVariant *reply = connection == nullptr ? nullptr : g_dbus_connection_call_sync(
+			connection,
+			"org.bluez",
+			"/",
+			"org.freedesktop.DBus.ObjectManager",
+			"GetManagedObjects",
+			nullptr,
+			G_VARIANT_TYPE("(a{oa{sa{sv}}})"),
+			G_DBUS_CALL_FLAGS_NONE,
+			3000,
+			cancellable_,
+			&error);
+		if (connection != nullptr)
 		{
-			if (detailOut != nullptr)
-			{
-				*detailOut = initializeResult.errorMessage().empty()
-					? bzp::bluezErrorToString(initializeResult.error())
-					: initializeResult.errorMessage();
-			}
-			adapter.shutdown();
-			return false;
+			g_object_unref(connection);
 		}
-
-		const auto adaptersResult = adapter.discoverAdapters();
-		if (!adaptersResult.isSuccess())
+		if (reply == nullptr)
 		{
 			if (detailOut != nullptr)
 			{
-				*detailOut = adaptersResult.errorMessage();
+				*detailOut = error != nullptr ? error->message : "Unable to list BlueZ objects.";
+			}
+			if (error != nullptr)
+			{
+				g_error_free(error);
 			}
-			adapter.shutdown();
 			return false;
 		}
 
-		std::ostringstream summary;
-		bool first = true;
-		bool poweredAdapterAvailable = false;
-		for (const auto &adapterInfo : adaptersResult.value())
+		std::vector<bzp::standalone::DoctorAdapter> adapters;
+		GVariant *objects = g_variant_get_child_value(reply, 0);
+		GVariantIter objectIter;
+		g_variant_iter_init(&objectIter, objects);
+		const gchar *objectPath = nullptr;
+		GVariant *interfaces = nullptr;
+		while (g_variant_iter_next(&objectIter, "{&o@a{sa{sv}}}", &objectPath, &interfaces))
 		{
-			if (adapterLinesOut != nullptr)
-			{
-				adapterLinesOut->push_back(
-					adapterInfo.path + " [" + adapterInfo.address + "] powered=" + (adapterInfo.powered ? "yes" : "no"));
-			}
-			if (!first)
+			GVariant *properties = g_variant_lookup_value(interfaces, "org.bluez.Adapter1", G_VARIANT_TYPE("a{sv}"));
+			if (properties != nullptr)
 			{
-				summary << "; ";
+				const gchar *address = "";
+				gboolean powered = FALSE;
+				g_variant_lookup(properties, "Address", "&s", &address);
+				g_variant_lookup(properties, "Powered", "b", &powered);
+				adapters.push_back({objectPath, address, powered != FALSE});
+				g_variant_unref(properties);
 			}
-			first = false;
-			summary << adapterInfo.path << " powered=" << (adapterInfo.powered ? "yes" : "no");
-			poweredAdapterAvailable = poweredAdapterAvailable || adapterInfo.powered;
-		}
-
-		if (summaryOut != nullptr)
-		{
-			*summaryOut = summary.str();
-		}
-		if (poweredAdapterAvailableOut != nullptr)
-		{
-			*poweredAdapterAvailableOut = poweredAdapterAvailable;
-		}
-		if (detailOut != nullptr)
-		{
-			*detailOut = poweredAdapterAvailable
-				? summary.str()
-				: ("Adapters found but none are powered: " + summary.str());
+			g_variant_unref(interfaces);
 		}
+		g_variant_unref(objects);
+		g_variant_unref(reply);
 
-		adapter.shutdown();
-		return true;
+		return bzp::standalone::summarizeDoctorAdapters(std::move(adapters), preferredAdapter, poweredAdapterAvailableOut,
+			summaryOut, adapterLinesOut, detailOut);
 	}
 
 	bool checkPolicy(std::string *pathOut) const override
@@ -836,9 +914,8 @@ public:
 
 	bool checkExperimentalHelper(std::string *pathOut, bool *modeEnabledOut, std::string *detailOut) const override
 	{
-		const auto runningProcessHasExperimental = []() {
-			const int processCheck = std::system("ps -eo args= | grep '[b]luetoothd' | grep -q -- '--experimental'");
-			return processCheck == 0;
+		const auto runningProcessHasExperimental = [this]() {
+			return runShellCheck("ps -eo args= | grep '[b]luetoothd' | grep -q -- '--experimental'");
 		};
 
 		const std::vector<std::string> helperCandidates = {
@@ -858,9 +935,7 @@ public:
 					*modeEnabledOut = false;
 				}
 
-				const std::string command = "bash " + candidate + " check >/dev/null 2>&1";
-				const int result = std::system(command.c_str());
-				const bool helperEnabled = result == 0;
+				const bool helperEnabled = runShellCheck("bash " + candidate + " check");
 				const bool runningEnabled = !helperEnabled && runningProcessHasExperimental();
 				const bool enabled = helperEnabled || runningEnabled;
 				if (modeEnabledOut != nullptr)
@@ -899,6 +974,39 @@ public:
 		}
 		return runningEnabled;
 	}
+
+private:
+	// Run `sh -c command` with its output discarded; cancel() stops waiting and kills it together with its pipeline
+	bool runShellCheck(const std::string &command) const
+	{
+		GSubprocessLauncher *launcher = g_subprocess_launcher_new(
+			static_cast<GSubprocessFlags>(G_SUBPROCESS_FLAGS_STDOUT_SILENCE | G_SUBPROCESS_FLAGS_STDERR_SILENCE));
+		// A process group of its own, so `ps`, `grep` or the helper script go down with the shell
+		g_subprocess_launcher_set_child_setup(launcher, [](gpointer) { setpgid(0, 0); }, nullptr, nullptr);
+		GSubprocess *process = g_subprocess_launcher_spawn(launcher, nullptr, "sh", "-c", command.c_str(), nullptr);
+		g_object_unref(launcher);
+		if (process == nullptr)
+		{
+			return false;
+		}
+
+		const bool exited = g_subprocess_wait(process, cancellable_, nullptr) != FALSE;
+		if (!exited)
+		{
+			const gchar *identifier = g_subprocess_get_identifier(process);
+			if (identifier != nullptr)
+			{
+				kill(-static_cast<pid_t>(std::atoi(identifier)), SIGKILL);
+			}
+			g_subprocess_force_exit(process);
+			g_subprocess_wait(process, nullptr, nullptr);
+		}
+		const bool succeeded = exited && g_subprocess_get_successful(process) != FALSE;
+		g_object_unref(process);
+		return succeeded;
+	}
+
+	GCancellable *cancellable_;
 };
 
 std::string executableName(const char *argv0)
@@ -1084,99 +1192,137 @@ bool appendSelectedObjectLines(const bzp::DBusObject &object, const std::string
 	return false;
 }
 
-std::optional<bzp::standalone::InspectSessionSnapshot> buildInspectSnapshot(const DemoOptions &options)
+void rebuildInspectTreeCache(bzp::Server &server, const std::string &selectedPath)
 {
-	const auto server = bzp::getActiveServer();
-	if (!server)
+	InspectTreeCache cache;
+	cache.treeGeneration = server.getTreeGeneration();
+	for (const auto &object : server.getObjects())
 	{
-		return std::nullopt;
+		cache.objectCount += countObjectsRecursive(object);
+		appendObjectTreeLines(object, 0, &cache.objectTreeLines);
 	}
 
-	bzp::standalone::InspectSessionSnapshot snapshot;
-	snapshot.pid = static_cast<int>(getpid());
-	snapshot.updatedAtMs = bzp::standalone::currentTimeMs();
-	snapshot.serviceName = server->getServiceName();
-	snapshot.advertisingName = server->getAdvertisingName();
-	snapshot.advertisingShortName = server->getAdvertisingShortName();
-	snapshot.sampleNamespace = options.sampleNamespace;
-	snapshot.includeSampleServices = options.includeSampleServices;
-	snapshot.manualLoopMode = options.manualLoopMode;
-	snapshot.runState = static_cast<int>(bzpGetServerRunState());
-	snapshot.health = static_cast<int>(bzpGetServerHealth());
-	snapshot.objectRoot = !server->getObjects().empty()
-		? server->getObjects().begin()->getPath().toString()
-		: server->getRootObject().getPath().toString();
-	snapshot.selectedObjectPath = batteryLevelObjectPath.empty() ? snapshot.objectRoot : batteryLevelObjectPath;
-	snapshot.writeProbePath = textStringObjectPath;
-
-	for (const auto &object : server->getObjects())
+	bzp::standalone::InspectSessionSnapshot selected;
+	if (!appendSelectedObjectLines(server.getRootObject(), selectedPath, &selected))
 	{
-		snapshot.objectCount += countObjectsRecursive(object);
-		appendObjectTreeLines(object, 0, &snapshot.objectTreeLines);
+		selected.selectedObjectLines.push_back("No detailed object metadata captured for " + selectedPath);
 	}
+	cache.selectedObjectSummary = std::move(selected.selectedObjectSummary);
+	cache.selectedObjectLines = std::move(selected.selectedObjectLines);
+	cache.valid = true;
+	inspectTreeCache = std::move(cache);
+}
 
-	if (!appendSelectedObjectLines(server->getRootObject(), snapshot.selectedObjectPath, &snapshot))
+std::optional<std::string> inspectSampleValueLine(const bzp::standalone::InspectSessionSnapshot &snapshot)
+{
+	if (batteryLevelObjectPath.empty() || snapshot.selectedObjectPath != batteryLevelObjectPath)
 	{
-		snapshot.selectedObjectLines.push_back("No detailed object metadata captured for " + snapshot.selectedObjectPath);
+		return std::nullopt;
 	}
+	return "sample value: " + std::to_string(currentBatteryLevel()) + "%";
+}
 
-	if (!batteryLevelObjectPath.empty() && snapshot.selectedObjectPath == batteryLevelObjectPath)
+// Recompute the fields named by `dirty`. Callers hold inspectSessionMutex.
+void refreshInspectFields(bzp::standalone::InspectSessionSnapshot &snapshot, bzp::Server &server, unsigned dirty)
+{
+	snapshot.updatedAtMs = bzp::standalone::currentTimeMs();
+	// Adding objects or interfaces bumps the generation, so the tree is never walked just to find out whether it changed
+	if (inspectTreeCache.valid && inspectTreeCache.treeGeneration != server.getTreeGeneration())
 	{
-		snapshot.selectedObjectLines.push_back("sample value: " + std::to_string(serverDataBatteryLevel) + "%");
+		dirty |= kInspectDirtyTree;
 	}
 
-	auto adapterInfo = bzp::getActiveBluezAdapter().getAdapterInfo();
-	if (adapterInfo.isSuccess())
+	if ((dirty & kInspectDirtyTree) != 0 || !inspectTreeCache.valid)
 	{
-		snapshot.adapterPath = adapterInfo.value().path;
-		snapshot.adapterAddress = adapterInfo.value().address;
-		snapshot.adapterAlias = adapterInfo.value().alias;
-		snapshot.adapterPowered = adapterInfo.value().powered;
+		rebuildInspectTreeCache(server, snapshot.selectedObjectPath);
+		snapshot.objectCount = inspectTreeCache.objectCount;
+		snapshot.objectTreeLines = inspectTreeCache.objectTreeLines;
+		snapshot.selectedObjectSummary = inspectTreeCache.selectedObjectSummary;
+		snapshot.selectedObjectLines = inspectTreeCache.selectedObjectLines;
+		if (const auto line = inspectSampleValueLine(snapshot))
+		{
+			snapshot.selectedObjectLines.push_back(*line);
+		}
 	}
-	else
+	else if ((dirty & kInspectDirtySampleValue) != 0)
 	{
-		snapshot.warnings.push_back("Adapter metadata unavailable: " + adapterInfo.errorMessage());
+		// The sample value is the only line after the cached metadata
+		if (const auto line = inspectSampleValueLine(snapshot);
+			line && snapshot.selectedObjectLines.size() == inspectTreeCache.selectedObjectLines.size() + 1)
+		{
+			snapshot.selectedObjectLines.back() = *line;
+		}
 	}
 
-	snapshot.activeConnections = bzp::getActiveBluezAdapter().getActiveConnectionCount();
-	snapshot.advertisingEnabled = bzp::getActiveBluezAdapter().isAdvertising();
-	if (!snapshot.includeSampleServices)
+	auto &adapter = bzp::getActiveBluezAdapter();
+	if ((dirty & kInspectDirtyRuntime) != 0)
 	{
-		snapshot.warnings.push_back("Bundled sample services are disabled; inspect output will mostly reflect the empty server root.");
+		snapshot.runState = static_cast<int>(bzpGetServerRunState());
+		snapshot.health = static_cast<int>(bzpGetServerHealth());
+		snapshot.activeConnections = adapter.getActiveConnectionCount();
+		snapshot.advertisingEnabled = adapter.isAdvertising();
 	}
 
-	return snapshot;
+	if ((dirty & kInspectDirtyAdapter) != 0)
+	{
+		snapshot.warnings.clear();
+		auto adapterInfo = adapter.getAdapterInfo();
+		if (adapterInfo.isSuccess())
+		{
+			snapshot.adapterPath = adapterInfo.value().path;
+			snapshot.adapterAddress = adapterInfo.value().address;
+			snapshot.adapterAlias = adapterInfo.value().alias;
+			snapshot.adapterPowered = adapterInfo.value().powered;
+		}
+		else
+		{
+			snapshot.warnings.push_back("Adapter metadata unavailable: " + adapterInfo.errorMessage());
+		}
+
+		if (!snapshot.includeSampleServices)
+		{
+			snapshot.warnings.push_back("Bundled sample services are disabled; inspect output will mostly reflect the empty server root.");
+		}
+	}
 }
 
-void refreshInspectSession(bool rebuildTree)
+std::optional<bzp::standalone::InspectSessionSnapshot> buildInspectSnapshot(const DemoOptions &options)
 {
-	std::lock_guard<std::recursive_mutex> lock(inspectSessionMutex);
-	if (!inspectSessionSnapshot)
+	const auto server = bzp::getActiveServer();
+	if (!server)
 	{
-		return;
+		return std::nullopt;
 	}
 
-	const auto rebuilt = buildInspectSnapshot(DemoOptions{
-		{},
-		inspectSessionSnapshot->serviceName,
-		inspectSessionSnapshot->advertisingName,
-		inspectSessionSnapshot->advertisingShortName,
-		inspectSessionSnapshot->sampleNamespace,
-		inspectSessionSnapshot->includeSampleServices,
-		inspectSessionSnapshot->manualLoopMode
-	});
-	if (!rebuilt)
+	bzp::standalone::InspectSessionSnapshot snapshot;
+	snapshot.pid = static_cast<int>(getpid());
+	snapshot.serviceName = server->getServiceName();
+	snapshot.advertisingName = server->getAdvertisingName();
+	snapshot.advertisingShortName = server->getAdvertisingShortName();
+	snapshot.sampleNamespace = options.sampleNamespace;
+	snapshot.includeSampleServices = options.includeSampleServices;
+	snapshot.manualLoopMode = options.manualLoopMode;
+	snapshot.objectRoot = !server->getObjects().empty()
+		? server->getObjects().begin()->getPath().toString()
+		: server->getRootObject().getPath().toString();
+	snapshot.selectedObjectPath = batteryLevelObjectPath.empty() ? snapshot.objectRoot : batteryLevelObjectPath;
+	snapshot.writeProbePath = textStringObjectPath;
+
+	std::lock_guard<std::recursive_mutex> lock(inspectSessionMutex);
+	refreshInspectFields(snapshot, *server, kInspectDirtyAll);
+	return snapshot;
+}
+
+void refreshInspectSession(unsigned dirty)
+{
+	std::lock_guard<std::recursive_mutex> lock(inspectSessionMutex);
+	const auto server = bzp::getActiveServer();
+	if (!inspectSessionSnapshot || !server)
 	{
 		return;
 	}
 
-	auto refreshed = *rebuilt;
-	if (!rebuildTree)
-	{
-		refreshed.objectTreeLines = inspectSessionSnapshot->objectTreeLines;
-	}
-	refreshed.events = inspectSessionSnapshot->events;
-	*inspectSessionSnapshot = std::move(refreshed);
+	refreshInspectFields(*inspectSessionSnapshot, *server, dirty);
 	persistInspectSession();
 }
 
@@ -1193,6 +1339,29 @@ void clearInspectSession()
 	}
 	inspectSessionSnapshot.reset();
 	inspectSessionStore.reset();
+	inspectTreeCache = {};
+}
+
+void appendInspectSessionEvent(const bzp::standalone::InspectEvent &event)
+{
+	// Callers hold inspectSessionMutex. Events go to the append-only log; the snapshot file is only rewritten on refresh.
+	bzp::standalone::appendInspectEvent(*inspectSessionSnapshot, event, inspectSessionStore->eventLimit());
+
+	std::string error;
+	if (!inspectSessionStore->appendEvent(event, &error))
+	{
+		std::cerr << "WARNING: failed to append inspect event: " << error << std::endl;
+	}
+}
+
+// Log lines after which the adapter's identity, power or availability may differ from the snapshot
+bool isAdapterStateMessage(const std::string &message)
+{
+	static constexpr std::string_view kMarkers[] = {
+		"op=Initialize", "op=Reconnect", "op=AdapterRecovery", "op=BlueZService", "op=Set ", "Successfully set ",
+	};
+	return std::any_of(std::begin(kMarkers), std::end(kMarkers),
+		[&message](std::string_view marker) { return message.find(marker) != std::string::npos; });
 }
 
 void recordSessionEvent(bzp::standalone::EventLevel level, const char *text)
@@ -1206,25 +1375,24 @@ void recordSessionEvent(bzp::standalone::EventLevel level, const char *text)
 	std::string component;
 	const std::string rawMessage(text);
 	const std::string message = stripStructuredPrefix(rawMessage, &component);
-	bzp::standalone::appendInspectEvent(*inspectSessionSnapshot, {
+	appendInspectSessionEvent({
 		bzp::standalone::currentTimeMs(),
 		level,
 		component,
 		message,
-	}, inspectSessionStore->eventLimit());
+	});
 
-	if (message.find("op=Connection") != std::string::npos
-		|| message.find("op=Initialize") != std::string::npos
-		|| message.find("shutting down") != std::string::npos)
+	if (message.find("shutting down") != std::string::npos)
 	{
-		refreshInspectSession(false);
-		return;
+		refreshInspectSession(kInspectDirtyRuntime);
+	}
+	else if (isAdapterStateMessage(message))
+	{
+		refreshInspectSession(kInspectDirtyRuntime | kInspectDirtyAdapter);
 	}
-
-	persistInspectSession();
 }
 
-void recordInspectSemanticEvent(bzp::standalone::EventLevel level, const std::string &component, const std::string &message, bool refreshSnapshot)
+void recordInspectSemanticEvent(bzp::standalone::EventLevel level, const std::string &component, const std::string &message, unsigned dirty)
 {
 	std::lock_guard<std::recursive_mutex> lock(inspectSessionMutex);
 	if (!inspectSessionStore || !inspectSessionSnapshot || message.empty())
@@ -1232,20 +1400,17 @@ void recordInspectSemanticEvent(bzp::standalone::EventLevel level, const std::st
 		return;
 	}
 
-	bzp::standalone::appendInspectEvent(*inspectSessionSnapshot, {
+	appendInspectSessionEvent({
 		bzp::standalone::currentTimeMs(),
 		level,
 		component,
 		message,
-	}, inspectSessionStore->eventLimit());
+	});
 
-	if (refreshSnapshot)
+	if (dirty != 0)
 	{
-		refreshInspectSession(false);
-		return;
+		refreshInspectSession(dirty);
 	}
-
-	persistInspectSession();
 }
 
 void LogDebug(const char *pText) { recordSessionEvent(bzp::standalone::EventLevel::Debug, pText); if (logLevel <= Debug) { std::cout << "  DEBUG: " << pText << std::endl; } }
@@ -1307,11 +1472,13 @@ std::string buildTopLevelHelp(const std::string &binaryName)
 	stream << "Commands:\n";
 	stream << "  doctor   Check the local host for the BzPeri happy path\n";
 	stream << "  demo     Start the managed sample server\n";
-	stream << "  inspect  Inspect a managed demo session (use --live)\n\n";
+	stream << "  inspect  Inspect a managed demo session (use --live)\n";
+	stream << "  bench    Drive load against a running server and report throughput and latency\n\n";
 	stream << "Examples:\n";
 	stream << "  " << binaryName << " doctor\n";
 	stream << "  " << binaryName << " demo -d --adapter=hci0\n";
-	stream << "  " << binaryName << " inspect --live\n\n";
+	stream << "  " << binaryName << " inspect --live\n";
+	stream << "  " << binaryName << " bench --duration=30 --read-rate=200\n\n";
 	stream << "Legacy compatibility:\n";
 	stream << "  " << binaryName << " --adapter=hci0 -d\n\n";
 	stream << "Run '" << binaryName << " <command> --help' for command-specific options.\n";
@@ -1336,6 +1503,7 @@ std::string buildDemoHelp(const std::string &binaryName)
 	stream << "  --advertise-short=NAME     Set LE advertising short name (default BzPeri)\n";
 	stream << "  --sample-namespace=NODE    Namespace node for example services (default samples)\n";
 	stream << "  --manual-loop              Drive BzPeri via bzpRunLoopIteration()\n";
+	stream << "  --notify-rate=PER_SECOND   Notify the battery level at this rate (load for bench)\n";
 	stream << "  --sleep-integration=MODE   Enable or disable PrepareForSleep integration: on or off\n";
 	stream << "  --sleep-inhibitor=MODE     Enable or disable sleep inhibitor support: on or off\n";
 	stream << "  --glib-log-capture=MODE    Set GLib capture mode: auto, off, host, startup-shutdown\n";
@@ -1356,6 +1524,29 @@ std::string buildDoctorHelp(const std::string &binaryName)
 	stream << "  -d                         Debug mode\n";
 	stream << "  --adapter=NAME             Probe a specific adapter\n";
 	stream << "  --list-adapters            Include adapter listing during the probe\n";
+	stream << "  --probe-timeout-ms=INT     Deadline for each probe; probes run in parallel (default "
+		<< bzp::standalone::kDefaultDoctorProbeDeadlineMs << "ms)\n";
+	return stream.str();
+}
+
+std::string buildBenchHelp(const std::string &binaryName)
+{
+	std::ostringstream stream;
+	stream << "Usage: " << binaryName << " bench [options]\n\n";
+	stream << "Target:\n";
+	stream << "  --bus=BUS                  system (default), session, or a D-Bus address (e.g. unix:path=/tmp/bus)\n";
+	stream << "  --service-name=NAME        Server namespace to drive (default bzperi, i.e. com.bzperi)\n";
+	stream << "  --pid=INT                  Server pid for CPU time (default: looked up from the bus name)\n\n";
+	stream << "Load:\n";
+	stream << "  --duration=SECONDS         Length of the run (default 10)\n";
+	stream << "  --read-rate=PER_SECOND     ReadValue calls per second (default 50, 0 disables)\n";
+	stream << "  --write-rate=PER_SECOND    WriteValue calls per second (default 10, 0 disables)\n";
+	stream << "  --write-value=TEXT         Bytes sent by WriteValue (default bzp-bench)\n";
+	stream << "  --read-path=PATH           Read only this characteristic\n";
+	stream << "  --write-path=PATH          Write only this characteristic\n";
+	stream << "  --no-subscribe             Do not count notifications\n";
+	stream << "  --max-in-flight=INT        Outstanding calls per operation before calls are throttled (default 32)\n";
+	stream << "  --timeout-ms=INT           Per-call timeout (default 2000)\n";
 	return stream.str();
 }
 
@@ -1368,6 +1559,7 @@ std::string buildInspectHelp(const std::string &binaryName)
 	stream << "  --verbose-events           Show debug/info chatter in the event block\n";
 	stream << "  --show-tree                Include the full object tree in the report\n";
 	stream << "  --refresh-ms=INT           Poll the session file for updates (default " << kDefaultInspectRefreshMs << "ms)\n";
+	stream << "  --pid=INT                  Stream events from any BzPeri process that called bzpStartEventStream()\n";
 	return stream.str();
 }
 
@@ -1395,6 +1587,10 @@ CommandSelection selectCommand(int argc, char **argv)
 	{
 		return {CommandMode::Inspect, 2};
 	}
+	if (firstArg == "bench")
+	{
+		return {CommandMode::Bench, 2};
+	}
 	if (!firstArg.empty() && firstArg[0] != '-')
 	{
 		return {CommandMode::TopLevelHelp, 0};
@@ -1470,6 +1666,10 @@ bool parseDemoOptions(int argc, char **argv, std::size_t startIndex, DemoOptions
 		{
 			options->manualLoopMode = true;
 		}
+		else if (arg.rfind("--notify-rate=", 0) == 0)
+		{
+			options->notifyRate = std::max(0.0, std::atof(arg.substr(14).c_str()));
+		}
 		else if (arg.rfind("--sleep-integration=", 0) == 0)
 		{
 			std::string mode = toLowerCopy(arg.substr(20));
@@ -1583,12 +1783,87 @@ bool parseDoctorOptions(int argc, char **argv, std::size_t startIndex, DoctorOpt
 			options->showHelp = true;
 			continue;
 		}
+		if (arg.rfind("--probe-timeout-ms=", 0) == 0)
+		{
+			options->probeTimeoutMs = std::max(50, std::atoi(arg.substr(19).c_str()));
+			continue;
+		}
 		*errorOut = "Unknown parameter: " + arg;
 		return false;
 	}
 	return true;
 }
 
+bool parseBenchOptions(int argc, char **argv, std::size_t startIndex, BenchOptions *options, std::string *errorOut)
+{
+	for (std::size_t i = startIndex; i < static_cast<std::size_t>(argc); ++i)
+	{
+		const std::string arg = argv[i];
+		if (parseCommonOption(arg, &options->common))
+		{
+			continue;
+		}
+		if (arg == "--help" || arg == "-h")
+		{
+			options->showHelp = true;
+		}
+		else if (arg.rfind("--bus=", 0) == 0)
+		{
+			options->bus = arg.substr(6);
+		}
+		else if (arg.rfind("--service-name=", 0) == 0)
+		{
+			options->serviceName = arg.substr(15);
+		}
+		else if (arg.rfind("--pid=", 0) == 0)
+		{
+			options->pid = std::atoi(arg.substr(6).c_str());
+		}
+		else if (arg.rfind("--duration=", 0) == 0)
+		{
+			options->durationSeconds = std::max(1, std::atoi(arg.substr(11).c_str()));
+		}
+		else if (arg.rfind("--read-rate=", 0) == 0)
+		{
+			options->readRate = std::max(0.0, std::atof(arg.substr(12).c_str()));
+		}
+		else if (arg.rfind("--write-rate=", 0) == 0)
+		{
+			options->writeRate = std::max(0.0, std::atof(arg.substr(13).c_str()));
+		}
+		else if (arg.rfind("--write-value=", 0) == 0)
+		{
+			options->writeValue = arg.substr(14);
+		}
+		else if (arg.rfind("--read-path=", 0) == 0)
+		{
+			options->readPath = arg.substr(12);
+		}
+		else if (arg.rfind("--write-path=", 0) == 0)
+		{
+			options->writePath = arg.substr(13);
+		}
+		else if (arg == "--no-subscribe")
+		{
+			options->subscribe = false;
+		}
+		else if (arg.rfind("--max-in-flight=", 0) == 0)
+		{
+			options->maxInFlight = std::max(1, std::atoi(arg.substr(16).c_str()));
+		}
+		else if (arg.rfind("--timeout-ms=", 0) == 0)
+		{
+			options->timeoutMs = std::max(100, std::atoi(arg.substr(13).c_str()));
+		}
+		else
+		{
+			*errorOut = "Unknown parameter: " + arg;
+			return false;
+		}
+	}
+	return true;
+}
+
 bool parseInspectOptions(int argc, char **argv, std::size_t startIndex, InspectOptions *options, std::string *errorOut)
 {
 	for (std::size_t i = startIndex; i < static_cast<std::size_t>(argc); ++i)
@@ -1614,6 +1889,16 @@ bool parseInspectOptions(int argc, char **argv, std::size_t startIndex, InspectO
 		{
 			options->refreshMs = std::max(100, std::atoi(arg.substr(13).c_str()));
 		}
+		else if (arg.rfind("--pid=", 0) == 0 || (arg == "--pid" && i + 1 < static_cast<std::size_t>(argc)))
+		{
+			const std::string value = arg == "--pid" ? std::string(argv[++i]) : arg.substr(6);
+			options->pid = std::atoi(value.c_str());
+			if (options->pid <= 0)
+			{
+				*errorOut = "--pid requires a positive process ID";
+				return false;
+			}
+		}
 		else
 		{
 			*errorOut = "Unknown parameter: " + arg;
@@ -1691,12 +1976,13 @@ void configureDemoServices(const DemoOptions &options)
 		textStringObjectPath.clear();
 		LogStatus("Bundled example services disabled; starting with empty server");
 	}
+	registerServerData();
 }
 
 bzp::standalone::DoctorSnapshot collectDoctorSnapshot(const DoctorOptions &options, const std::string &ownedName = "com.bzperi")
 {
 	RuntimeDoctorProbe probe;
-	auto snapshot = bzp::standalone::collectDoctorSnapshot(probe, options.common.adapterName, ownedName);
+	auto snapshot = bzp::standalone::collectDoctorSnapshot(probe, options.common.adapterName, ownedName, options.probeTimeoutMs);
 	if (!options.common.listAdapters)
 	{
 		snapshot.adapterLines.clear();
@@ -1714,8 +2000,108 @@ int runDoctor(const std::string &binaryName, const DoctorOptions &options)
 	return bzp::standalone::exitCodeForDoctorReport(report);
 }
 
+std::string describeStreamEvent(const bzp::EventStreamEvent &event)
+{
+	const auto time = std::chrono::system_clock::time_point(std::chrono::microseconds(event.timestampUs));
+	const std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+	std::tm local{};
+	localtime_r(&seconds, &local);
+	char clock[16];
+	std::strftime(clock, sizeof(clock), "%H:%M:%S", &local);
+
+	std::ostringstream line;
+	line << clock << '.' << std::setw(3) << std::setfill('0') << (event.timestampUs / 1000) % 1000 << std::setfill(' ') << "  ";
+	switch (event.type)
+	{
+		case bzp::EventStreamFrameType::Hello:
+			line << "ATTACH    pid " << event.pid << " (protocol " << event.protocolVersion << ")";
+			break;
+		case bzp::EventStreamFrameType::State:
+			line << "STATE     " << bzpGetServerRunStateString(static_cast<BZPServerRunState>(event.runState))
+				<< ", health " << bzpGetServerHealthString(static_cast<BZPServerHealth>(event.health));
+			break;
+		case bzp::EventStreamFrameType::Dispatch:
+		{
+			static const char *const kKinds[] = {"call", "get", "set"};
+			const auto kind = static_cast<std::size_t>(event.dispatchKind);
+			line << (event.succeeded ? "DISPATCH  " : "FAILED    ") << (kind < 3 ? kKinds[kind] : "?") << ' '
+				<< event.objectPath << ' ' << event.interfaceName << '.' << event.member << " (" << event.durationUs << "us)";
+			break;
+		}
+		case bzp::EventStreamFrameType::QueueStats:
+			line << "QUEUE     processed " << event.updatesProcessed << ", waiting " << event.updateQueueDepth;
+			break;
+		case bzp::EventStreamFrameType::Dropped:
+			line << "DROPPED   " << event.droppedCount << " events (inspector fell behind)";
+			break;
+	}
+	return line.str();
+}
+
+// Attach to a process's event stream; the server only ever writes, so this just decodes frames until it hangs up
+int runInspectAttach(const InspectOptions &options)
+{
+	const std::string path = bzp::defaultEventStreamPath(options.pid);
+	const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+	if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+	{
+		const int error = errno;
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+		std::ostringstream failure;
+		failure << "BzPeri Inspect\n";
+		failure << "STATUS  FAIL\n";
+		failure << "Unable to attach to pid " << options.pid << " at " << path << ": " << std::strerror(error) << "\n\n";
+		failure << "NEXT\n";
+		failure << "run: confirm the process called bzpStartEventStream() and is running as this user\n";
+		printBlock(failure.str());
+		return 1;
+	}
+
+	std::cout << "BzPeri Inspect\nSTATUS  LIVE\nStreaming events from pid " << options.pid << ". Press Ctrl-C to detach.\n\n";
+	std::string buffer;
+	char chunk[4096];
+	for (;;)
+	{
+		const ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+		if (count < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (count <= 0)
+		{
+			break;
+		}
+
+		buffer.append(chunk, static_cast<std::size_t>(count));
+		for (const auto &event : bzp::detail::decodeEventStreamFrames(buffer))
+		{
+			if (event.type == bzp::EventStreamFrameType::QueueStats && !options.verboseEvents)
+			{
+				continue;
+			}
+			std::cout << describeStreamEvent(event) << '\n';
+		}
+		std::cout.flush();
+	}
+
+	close(fd);
+	printBlock("\nProcess " + std::to_string(options.pid) + " closed the event stream.\n");
+	return 0;
+}
+
 int runInspect(const std::string &binaryName, const InspectOptions &options)
 {
+	if (options.pid != 0)
+	{
+		return runInspectAttach(options);
+	}
+
 	bzp::standalone::InspectSessionStore store;
 	std::string error;
 	auto snapshot = store.load(&error);
@@ -1737,12 +2123,47 @@ int runInspect(const std::string &binaryName, const InspectOptions &options)
 	}
 
 	printBlock(bzp::standalone::formatInspectReport(*snapshot, binaryName, options.verboseEvents, options.showTree));
-	long long lastUpdatedAt = snapshot->updatedAtMs;
+
+	// Live mode tails the event log through its mapped head and only re-reads the snapshot file when it was rewritten
+	auto snapshotWriteTime = [&store]() -> std::optional<std::filesystem::file_time_type> {
+		std::error_code errorCode;
+		const auto writeTime = std::filesystem::last_write_time(store.path(), errorCode);
+		return errorCode ? std::nullopt : std::optional<std::filesystem::file_time_type>(writeTime);
+	};
+	auto lastSnapshotWrite = snapshotWriteTime();
+	uint64_t eventCursor = store.eventHead();
 
 	while (options.live)
 	{
 		std::this_thread::sleep_for(std::chrono::milliseconds(options.refreshMs));
 
+		const auto snapshotWrite = snapshotWriteTime();
+		if (snapshotWrite && snapshotWrite == lastSnapshotWrite)
+		{
+			if (bzp::standalone::isInspectSessionStale(*snapshot, isProcessAlive))
+			{
+				store.clear();
+				std::cout << '\n';
+				printBlock(bzp::standalone::formatStaleSessionReport(*snapshot, binaryName));
+				return 1;
+			}
+
+			if (store.eventHead() == eventCursor)
+			{
+				continue;
+			}
+
+			std::size_t droppedEvents = 0;
+			for (const auto &event : store.readEventsSince(&eventCursor, &droppedEvents))
+			{
+				bzp::standalone::appendInspectEvent(*snapshot, event, store.eventLimit());
+			}
+			snapshot->droppedEventCount += droppedEvents;
+			std::cout << '\n';
+			printBlock(bzp::standalone::formatInspectReport(*snapshot, binaryName, options.verboseEvents, options.showTree));
+			continue;
+		}
+
 		std::string refreshedError;
 		auto refreshed = store.load(&refreshedError);
 		if (!refreshed)
@@ -1764,17 +2185,448 @@ int runInspect(const std::string &binaryName, const InspectOptions &options)
 			return 1;
 		}
 
-		if (refreshed->updatedAtMs == lastUpdatedAt)
+		lastSnapshotWrite = snapshotWrite;
+		eventCursor = store.eventHead();
+		snapshot = std::move(refreshed);
+		std::cout << '\n';
+		printBlock(bzp::standalone::formatInspectReport(*snapshot, binaryName, options.verboseEvents, options.showTree));
+	}
+
+	return 0;
+}
+
+// One rate-driven stream of identical D-Bus calls
+struct BenchLane
+{
+	bzp::standalone::BenchOperationResult result;
+	std::vector<std::string> paths;
+	std::size_t nextPath = 0;
+	int inFlight = 0;
+};
+
+struct BenchRun
+{
+	const BenchOptions *options = nullptr;
+	GDBusConnection *connection = nullptr;
+	GMainLoop *loop = nullptr;
+	std::string ownedName;
+	BenchLane read;
+	BenchLane write;
+	gint64 startUs = 0;
+	gint64 endUs = 0;
+	uint64_t notifications = 0;
+	std::string streamBuffer;
+	guint streamSource = 0;    // zeroed when the source removes itself on hangup
+	bzp::standalone::BenchReport *report = nullptr;
+};
+
+struct BenchCall
+{
+	BenchRun *run;
+	BenchLane *lane;
+	gint64 startUs;
+};
+
+void onBenchCallFinished(GObject *source, GAsyncResult *result, gpointer userData)
+{
+	auto *call = static_cast<BenchCall *>(userData);
+	const auto latencyUs = g_get_monotonic_time() - call->startUs;
+	GError *error = nullptr;
+	GVariant *reply = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+	BenchLane &lane = *call->lane;
+	--lane.inFlight;
+	if (reply != nullptr)
+	{
+		++lane.result.succeeded;
+		lane.result.latenciesUs.push_back(static_cast<uint32_t>(std::min<gint64>(latencyUs, UINT32_MAX)));
+		g_variant_unref(reply);
+	}
+	else
+	{
+		++lane.result.failed;
+		if (lane.result.firstError.empty())
 		{
+			lane.result.firstError = error != nullptr ? error->message : "unknown error";
+		}
+	}
+	if (error != nullptr)
+	{
+		g_error_free(error);
+	}
+	delete call;
+}
+
+void issueBenchCall(BenchRun &run, BenchLane &lane, bool isWrite)
+{
+	const std::string &path = lane.paths[lane.nextPath++ % lane.paths.size()];
+	GVariantBuilder callOptions;
+	g_variant_builder_init(&callOptions, G_VARIANT_TYPE("a{sv}"));
+	GVariant *parameters = nullptr;
+	if (isWrite)
+	{
+		const std::string &value = run.options->writeValue;
+		GVariant *bytes = g_variant_new_fixed_array(G_VARIANT_TYPE_BYTE, value.data(), value.size(), sizeof(char));
+		parameters = g_variant_new("(@aya{sv})", bytes, &callOptions);
+	}
+	else
+	{
+		parameters = g_variant_new("(a{sv})", &callOptions);
+	}
+
+	++lane.result.issued;
+	++lane.inFlight;
+	g_dbus_connection_call(run.connection, run.ownedName.c_str(), path.c_str(), "org.bluez.GattCharacteristic1",
+		isWrite ? "WriteValue" : "ReadValue", parameters, nullptr, G_DBUS_CALL_FLAGS_NONE, run.options->timeoutMs, nullptr,
+		onBenchCallFinished, new BenchCall{&run, &lane, g_get_monotonic_time()});
+}
+
+// Keep each lane on its schedule: the number of calls due so far follows the target rate, and calls that would exceed the
+// in-flight limit are counted as throttled rather than queued, so a slow server shows up as lost throughput
+void scheduleBenchLane(BenchRun &run, BenchLane &lane, bool isWrite, gint64 elapsedUs)
+{
+	if (lane.paths.empty() || lane.result.targetRate <= 0.0)
+	{
+		return;
+	}
+
+	const auto due = static_cast<uint64_t>(lane.result.targetRate * static_cast<double>(elapsedUs) / 1000000.0);
+	while (lane.result.issued + lane.result.throttled < due)
+	{
+		if (lane.inFlight >= run.options->maxInFlight)
+		{
+			++lane.result.throttled;
 			continue;
 		}
+		issueBenchCall(run, lane, isWrite);
+	}
+}
 
-		lastUpdatedAt = refreshed->updatedAtMs;
-		std::cout << '\n';
-		printBlock(bzp::standalone::formatInspectReport(*refreshed, binaryName, options.verboseEvents, options.showTree));
+gboolean onBenchTick(gpointer userData)
+{
+	auto &run = *static_cast<BenchRun *>(userData);
+	const gint64 now = g_get_monotonic_time();
+	if (now < run.endUs)
+	{
+		scheduleBenchLane(run, run.read, false, now - run.startUs);
+		scheduleBenchLane(run, run.write, true, now - run.startUs);
+		return G_SOURCE_CONTINUE;
 	}
 
-	return 0;
+	// Let outstanding calls finish (or time out) so their latencies are counted
+	const bool drained = run.read.inFlight == 0 && run.write.inFlight == 0;
+	if (drained || now >= run.endUs + static_cast<gint64>(run.options->timeoutMs) * 1000)
+	{
+		g_main_loop_quit(run.loop);
+		return G_SOURCE_REMOVE;
+	}
+	return G_SOURCE_CONTINUE;
+}
+
+void onBenchNotification(GDBusConnection *, const gchar *, const gchar *, const gchar *, const gchar *, GVariant *parameters, gpointer userData)
+{
+	GVariant *changed = nullptr;
+	g_variant_get_child(parameters, 1, "@a{sv}", &changed);
+	if (changed == nullptr)
+	{
+		return;
+	}
+	GVariant *value = g_variant_lookup_value(changed, "Value", G_VARIANT_TYPE_BYTESTRING);
+	if (value != nullptr)
+	{
+		++static_cast<BenchRun *>(userData)->notifications;
+		g_variant_unref(value);
+	}
+	g_variant_unref(changed);
+}
+
+gboolean onBenchEventStream(gint fd, GIOCondition, gpointer userData)
+{
+	auto &run = *static_cast<BenchRun *>(userData);
+	char chunk[4096];
+	const ssize_t count = recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+	if (count == 0 || (count < 0 && errno != EAGAIN && errno != EINTR))
+	{
+		run.streamSource = 0;
+		return G_SOURCE_REMOVE;
+	}
+	if (count < 0)
+	{
+		return G_SOURCE_CONTINUE;
+	}
+
+	run.streamBuffer.append(chunk, static_cast<std::size_t>(count));
+	for (const auto &event : bzp::detail::decodeEventStreamFrames(run.streamBuffer))
+	{
+		if (event.type == bzp::EventStreamFrameType::QueueStats)
+		{
+			run.report->peakUpdateQueueDepth = std::max(run.report->peakUpdateQueueDepth, event.updateQueueDepth);
+			run.report->updatesProcessed += event.updatesProcessed;
+		}
+		else if (event.type == bzp::EventStreamFrameType::Dropped)
+		{
+			run.report->eventStreamDropped += event.droppedCount;
+		}
+	}
+	return G_SOURCE_CONTINUE;
+}
+
+std::optional<bzp::standalone::ProcessCpuTime> readProcessCpuTime(int pid)
+{
+	std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+	std::string line;
+	if (pid <= 0 || !std::getline(stat, line))
+	{
+		return std::nullopt;
+	}
+	return bzp::standalone::parseProcessCpuTime(line);
+}
+
+GDBusConnection *openBenchConnection(const std::string &bus, std::string *descriptionOut, std::string *errorOut)
+{
+	GError *error = nullptr;
+	GDBusConnection *connection = nullptr;
+	if (bus == "system" || bus == "session")
+	{
+		*descriptionOut = bus + " bus";
+		connection = g_bus_get_sync(bus == "system" ? G_BUS_TYPE_SYSTEM : G_BUS_TYPE_SESSION, nullptr, &error);
+	}
+	else
+	{
+		*descriptionOut = "bus at " + bus;
+		connection = g_dbus_connection_new_for_address_sync(bus.c_str(),
+			static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION),
+			nullptr, nullptr, &error);
+	}
+
+	if (connection == nullptr)
+	{
+		*errorOut = error != nullptr ? error->message : "unknown error";
+	}
+	if (error != nullptr)
+	{
+		g_error_free(error);
+	}
+	return connection;
+}
+
+// Sort the server's characteristics into read, write and notify targets by their GATT flags
+bool discoverBenchTargets(BenchRun &run, std::vector<std::string> *notifyPathsOut, std::string *errorOut)
+{
+	GError *error = nullptr;
+	GVariant *reply = g_dbus_connection_call_sync(run.connection, run.ownedName.c_str(), "/", "org.freedesktop.DBus.ObjectManager",
+		"GetManagedObjects", nullptr, G_VARIANT_TYPE("(a{oa{sa{sv}}})"), G_DBUS_CALL_FLAGS_NONE, run.options->timeoutMs, nullptr, &error);
+	if (reply == nullptr)
+	{
+		*errorOut = error != nullptr ? error->message : "unknown error";
+		if (error != nullptr)
+		{
+			g_error_free(error);
+		}
+		return false;
+	}
+
+	GVariant *objects = g_variant_get_child_value(reply, 0);
+	GVariantIter objectIter;
+	g_variant_iter_init(&objectIter, objects);
+	const gchar *objectPath = nullptr;
+	GVariant *interfaces = nullptr;
+	while (g_variant_iter_next(&objectIter, "{&o@a{sa{sv}}}", &objectPath, &interfaces))
+	{
+		GVariant *properties = g_variant_lookup_value(interfaces, "org.bluez.GattCharacteristic1", G_VARIANT_TYPE("a{sv}"));
+		if (properties != nullptr)
+		{
+			GVariant *flags = g_variant_lookup_value(properties, "Flags", G_VARIANT_TYPE_STRING_ARRAY);
+			if (flags != nullptr)
+			{
+				const gchar **names = g_variant_get_strv(flags, nullptr);
+				for (const gchar **name = names; name != nullptr && *name != nullptr; ++name)
+				{
+					const std::string flag = *name;
+					if (flag == "read" && run.options->readPath.empty())
+					{
+						run.read.paths.push_back(objectPath);
+					}
+					else if (flag == "write" && run.options->writePath.empty())
+					{
+						run.write.paths.push_back(objectPath);
+					}
+					else if (flag == "notify" || flag == "indicate")
+					{
+						notifyPathsOut->push_back(objectPath);
+					}
+				}
+				g_free(names);
+				g_variant_unref(flags);
+			}
+			g_variant_unref(properties);
+		}
+		g_variant_unref(interfaces);
+	}
+	g_variant_unref(objects);
+	g_variant_unref(reply);
+	return true;
+}
+
+int serverProcessId(GDBusConnection *connection, const std::string &ownedName)
+{
+	GVariant *reply = g_dbus_connection_call_sync(connection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+		"GetConnectionUnixProcessID", g_variant_new("(s)", ownedName.c_str()), G_VARIANT_TYPE("(u)"), G_DBUS_CALL_FLAGS_NONE,
+		1000, nullptr, nullptr);
+	if (reply == nullptr)
+	{
+		return 0;
+	}
+	guint32 pid = 0;
+	g_variant_get(reply, "(u)", &pid);
+	g_variant_unref(reply);
+	return static_cast<int>(pid);
+}
+
+int connectEventStream(int pid)
+{
+	const std::string path = bzp::defaultEventStreamPath(pid);
+	const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+	if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0)
+	{
+		return fd;
+	}
+	if (fd >= 0)
+	{
+		close(fd);
+	}
+	return -1;
+}
+
+int runBench(const std::string &binaryName, const BenchOptions &options)
+{
+	applyCommonOptions(options.common);
+
+	bzp::standalone::BenchReport report;
+	report.ownedName = "com." + toLowerCopy(options.serviceName);
+	report.clockTicksPerSecond = sysconf(_SC_CLK_TCK);
+
+	std::string error;
+	BenchRun run;
+	run.options = &options;
+	run.report = &report;
+	run.ownedName = report.ownedName;
+	run.connection = openBenchConnection(options.bus, &report.busDescription, &error);
+	if (run.connection == nullptr)
+	{
+		printBlock("BzPeri Bench\nSTATUS  FAIL\nUnable to connect to the " + report.busDescription + ": " + error
+			+ "\n\nNEXT\nrun: " + binaryName + " doctor\n");
+		return 1;
+	}
+
+	std::vector<std::string> notifyPaths;
+	if (!discoverBenchTargets(run, &notifyPaths, &error))
+	{
+		g_object_unref(run.connection);
+		printBlock("BzPeri Bench\nSTATUS  FAIL\nUnable to list the objects of " + report.ownedName + ": " + error
+			+ "\n\nNEXT\nrun: " + binaryName + " demo --service-name=" + options.serviceName + "\n");
+		return 1;
+	}
+	if (!options.readPath.empty())
+	{
+		run.read.paths = {options.readPath};
+	}
+	if (!options.writePath.empty())
+	{
+		run.write.paths = {options.writePath};
+	}
+
+	run.read.result.name = "ReadValue";
+	run.read.result.targetRate = options.readRate;
+	run.write.result.name = "WriteValue";
+	run.write.result.targetRate = options.writeRate;
+	if (options.readRate > 0.0 && run.read.paths.empty())
+	{
+		report.warnings.push_back("No readable characteristic found; ReadValue load was skipped");
+	}
+	if (options.writeRate > 0.0 && run.write.paths.empty())
+	{
+		report.warnings.push_back("No writable characteristic found; WriteValue load was skipped");
+	}
+
+	std::vector<guint> subscriptions;
+	if (options.subscribe)
+	{
+		for (const auto &path : notifyPaths)
+		{
+			subscriptions.push_back(g_dbus_connection_signal_subscribe(run.connection, report.ownedName.c_str(),
+				"org.freedesktop.DBus.Properties", "PropertiesChanged", path.c_str(), "org.bluez.GattCharacteristic1",
+				G_DBUS_SIGNAL_FLAGS_NONE, onBenchNotification, &run, nullptr));
+		}
+		report.subscriptions = subscriptions.size();
+	}
+
+	report.serverPid = options.pid > 0 ? options.pid : serverProcessId(run.connection, report.ownedName);
+	if (report.serverPid <= 0)
+	{
+		report.warnings.push_back("Server pid unknown; pass --pid to report CPU time");
+	}
+
+	const int streamFD = report.serverPid > 0 ? connectEventStream(report.serverPid) : -1;
+	if (streamFD >= 0)
+	{
+		report.eventStreamAttached = true;
+		run.streamSource = g_unix_fd_add(streamFD, G_IO_IN, onBenchEventStream, &run);
+	}
+
+	std::cout << "Benchmarking " << report.ownedName << " for " << options.durationSeconds << "s (read " << options.readRate
+		<< "/s x" << run.read.paths.size() << " paths, write " << options.writeRate << "/s x" << run.write.paths.size()
+		<< " paths, " << report.subscriptions << " notify subscriptions)..." << std::endl;
+
+	const auto cpuBefore = readProcessCpuTime(report.serverPid);
+	run.loop = g_main_loop_new(nullptr, FALSE);
+	run.startUs = g_get_monotonic_time();
+	run.endUs = run.startUs + static_cast<gint64>(options.durationSeconds) * 1000000;
+	g_timeout_add(kBenchTickMs, onBenchTick, &run);
+	g_main_loop_run(run.loop);
+	report.durationMs = (std::min(g_get_monotonic_time(), run.endUs) - run.startUs) / 1000;
+	const auto cpuAfter = readProcessCpuTime(report.serverPid);
+	if (cpuBefore && cpuAfter)
+	{
+		report.serverCpu = bzp::standalone::ProcessCpuTime{
+			cpuAfter->userTicks - cpuBefore->userTicks,
+			cpuAfter->systemTicks - cpuBefore->systemTicks};
+	}
+
+	for (const guint subscription : subscriptions)
+	{
+		g_dbus_connection_signal_unsubscribe(run.connection, subscription);
+	}
+	if (run.streamSource != 0)
+	{
+		g_source_remove(run.streamSource);
+	}
+	if (streamFD >= 0)
+	{
+		close(streamFD);
+	}
+	report.notificationsReceived = run.notifications;
+	for (BenchLane *lane : {&run.read, &run.write})
+	{
+		if (!lane->paths.empty() && lane->result.targetRate > 0.0)
+		{
+			report.operations.push_back(std::move(lane->result));
+		}
+	}
+
+	// Calls still outstanding after the grace period are abandoned; the default context is never iterated again, so their
+	// callbacks cannot run against this frame
+	if (run.read.inFlight != 0 || run.write.inFlight != 0)
+	{
+		report.warnings.push_back("Some calls were still outstanding after the run; the server stopped answering");
+	}
+	g_main_loop_unref(run.loop);
+	g_object_unref(run.connection);
+
+	printBlock(bzp::standalone::formatBenchReport(report, binaryName));
+	return bzp::standalone::evaluateBenchReport(report) == bzp::standalone::Verdict::Fail ? 1 : 0;
 }
 
 int runDemo(const std::string &binaryName, const DemoOptions &options)
@@ -1812,7 +2664,11 @@ int runDemo(const std::string &binaryName, const DemoOptions &options)
 		}
 	}
 
+	// Lets `inspect --live --pid` follow this process without touching the session file
+	bzpStartEventStream(nullptr, 0);
+
 	auto cleanupAndReturn = [&](int code) {
+		bzpStopEventStream();
 		clearInspectSession();
 		if (hostManagedCaptureInstalled)
 		{
@@ -1878,6 +2734,11 @@ int runDemo(const std::string &binaryName, const DemoOptions &options)
 		persistInspectSession();
 	}
 
+	// The adapter reports a connect storm as one batch, so the snapshot file is rewritten once per batch
+	bzp::getActiveBluezAdapter().setConnectionsChangedCallback([](const std::vector<std::string> &, const std::vector<std::string> &) {
+		refreshInspectSession(kInspectDirtyRuntime);
+	});
+
 	std::ostringstream success;
 	success << "BzPeri Demo\n";
 	success << "STATUS  PASS\n";
@@ -1906,8 +2767,27 @@ int runDemo(const std::string &binaryName, const DemoOptions &options)
 	success << "\nNEXT\n";
 	success << "run: Ctrl-C to stop the demo\n";
 	success << "run: " << binaryName << " inspect --live\n";
+	success << "run: " << binaryName << " inspect --live --pid " << getpid() << '\n';
 	printBlock(success.str());
 
+	// Load source for `bench`: queue battery level notifications at a fixed rate from a separate producer thread
+	std::atomic<bool> stopNotifyProducer{false};
+	std::thread notifyProducer;
+	if (validated.notifyRate > 0.0 && !batteryLevelObjectPath.empty())
+	{
+		const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double>(1.0 / validated.notifyRate));
+		notifyProducer = std::thread([&stopNotifyProducer, interval]() {
+			auto next = std::chrono::steady_clock::now();
+			while (!stopNotifyProducer.load(std::memory_order_acquire))
+			{
+				bzpNotifyUpdatedCharacteristic(batteryLevelObjectPath.c_str());
+				next += interval;
+				std::this_thread::sleep_until(next);
+			}
+		});
+	}
+
 	bool shutdownTriggered = false;
 	int batteryTickSeconds = 0;
 	constexpr auto kLoopTick = std::chrono::milliseconds(100);
@@ -1939,7 +2819,7 @@ int runDemo(const std::string &binaryName, const DemoOptions &options)
 			}
 			bzpTriggerShutdown();
 			shutdownTriggered = true;
-			refreshInspectSession(false);
+			refreshInspectSession(kInspectDirtyRuntime);
 		}
 
 		const auto now = std::chrono::steady_clock::now();
@@ -1956,22 +2836,29 @@ int runDemo(const std::string &binaryName, const DemoOptions &options)
 		}
 
 		batteryTickSeconds = 0;
-		serverDataBatteryLevel = std::max(serverDataBatteryLevel - 1, 0);
+		const uint8_t batteryLevel = static_cast<uint8_t>(std::max(currentBatteryLevel() - 1, 0));
+		// The battery slot is bound to its characteristic, so this write queues the notification
+		bzpDataWrite(batteryLevelHandle, &batteryLevel, sizeof(batteryLevel));
 		if (!batteryLevelObjectPath.empty())
 		{
-			bzpNotifyUpdatedCharacteristic(batteryLevelObjectPath.c_str());
 			recordInspectSemanticEvent(
 				bzp::standalone::EventLevel::Status,
 				"gatt",
-				std::string("notify path=") + batteryLevelObjectPath + " value=" + std::to_string(serverDataBatteryLevel) + "%",
-				true);
+				std::string("notify path=") + batteryLevelObjectPath + " value=" + std::to_string(batteryLevel) + "%",
+				kInspectDirtySampleValue);
 		}
 		else
 		{
-			refreshInspectSession(false);
+			refreshInspectSession(kInspectDirtyRuntime);
 		}
 	}
 
+	stopNotifyProducer.store(true, std::memory_order_release);
+	if (notifyProducer.joinable())
+	{
+		notifyProducer.join();
+	}
+
 	if (validated.manualLoopMode)
 	{
 		while (bzpGetServerRunState() != EStopped)
@@ -2067,6 +2954,22 @@ int main(int argc, char **ppArgv)
 		}
 		return runInspect(binaryName, options);
 	}
+	case CommandMode::Bench:
+	{
+		BenchOptions options;
+		if (!parseBenchOptions(argc, ppArgv, command.optionStartIndex, &options, &error))
+		{
+			std::cerr << "ERROR: " << error << "\n\n";
+			printBlock(buildBenchHelp(binaryName));
+			return 1;
+		}
+		if (options.showHelp)
+		{
+			printBlock(buildBenchHelp(binaryName));
+			return 0;
+		}
+		return runBench(binaryName, options);
+	}
 	case CommandMode::TopLevelHelp:
 	default:
 		printBlock(buildTopLevelHelp(binaryName));
@@ -0,0 +1,259 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// See the discussion at the top of AcquiredNotify.h
+
+#include "AcquiredNotify.h"
+#include "RunLoopTimers.h"
+
+#include <bzp/Logger.h>
+
+#include <glib-unix.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace bzp {
+
+namespace {
+
+constexpr uint16_t kDefaultAttMtu = 23;
+constexpr uint16_t kNotificationHeaderBytes = 3;    // ATT opcode and handle
+
+} // namespace
+
+AcquiredNotifier::AcquiredNotifier(std::string objectPath, const AcquiredNotifyPolicy &policy)
+: objectPath_(std::move(objectPath)), policy_(policy)
+{
+}
+
+AcquiredNotifier::~AcquiredNotifier()
+{
+	// No state callback from here: the characteristic that installed it is going away
+	stateCallback_ = nullptr;
+	release();
+}
+
+int AcquiredNotifier::acquire(uint16_t mtu)
+{
+	int fds[2] = {-1, -1};
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) != 0)
+	{
+		Logger::error(SSTR << "Unable to create the notification socket for " << objectPath_ << ": " << std::strerror(errno));
+		return -1;
+	}
+
+	// BlueZ only asks again once it has let go of the previous socket
+	if (fd_ >= 0)
+	{
+		release();
+	}
+
+	fd_ = fds[0];
+	mtu_ = mtu != 0 ? mtu : kDefaultAttMtu;
+	tokens_ = capacity();
+	refilledAt_ = g_get_monotonic_time();
+	stats_.acquisitions += 1;
+
+	pHangupWatch_ = g_unix_fd_source_new(fd_, static_cast<GIOCondition>(G_IO_HUP | G_IO_ERR));
+	g_source_set_callback(pHangupWatch_, G_SOURCE_FUNC(onHangup), this, nullptr);
+	g_source_attach(pHangupWatch_, threadRunLoopContext());
+
+	Logger::debug(SSTR << "Notifications acquired on " << objectPath_ << " (MTU " << mtu_ << ")");
+	if (stateCallback_)
+	{
+		stateCallback_(true);
+	}
+	return fds[1];
+}
+
+bool AcquiredNotifier::enqueue(std::span<const std::uint8_t> value)
+{
+	if (fd_ < 0)
+	{
+		stats_.refused += 1;
+		return false;
+	}
+	if (value.size() > maxPayload())
+	{
+		stats_.oversized += 1;
+		return false;
+	}
+
+	// The freshest value matters most, so a full queue gives up its oldest entry
+	if (queue_.size() >= std::max<std::size_t>(policy_.maxQueued, 1))
+	{
+		queue_.pop_front();
+		stats_.dropped += 1;
+	}
+	queue_.emplace_back(value.begin(), value.end());
+	service(g_get_monotonic_time());
+	return true;
+}
+
+void AcquiredNotifier::setBudget(uint32_t bytesPerSecond, uint32_t burstBytes)
+{
+	refill(g_get_monotonic_time());
+	policy_.bytesPerSecond = bytesPerSecond;
+	policy_.burstBytes = burstBytes;
+	tokens_ = std::min(tokens_, capacity());
+}
+
+AcquiredNotifyStats AcquiredNotifier::stats() const
+{
+	AcquiredNotifyStats stats = stats_;
+	stats.acquired = fd_ >= 0;
+	stats.mtu = mtu_;
+	stats.bytesPerSecond = policy_.bytesPerSecond;
+	stats.queued = queue_.size();
+	return stats;
+}
+
+void AcquiredNotifier::service(gint64 nowUS)
+{
+	refill(nowUS);
+	while (fd_ >= 0 && pWritableWatch_ == nullptr && !queue_.empty() && covers(queue_.front().size()))
+	{
+		const std::vector<std::uint8_t> &packet = queue_.front();
+		if (send(fd_, packet.data(), packet.size(), MSG_DONTWAIT | MSG_NOSIGNAL) < 0)
+		{
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				pWritableWatch_ = g_unix_fd_source_new(fd_, G_IO_OUT);
+				g_source_set_callback(pWritableWatch_, G_SOURCE_FUNC(onWritable), this, nullptr);
+				g_source_attach(pWritableWatch_, threadRunLoopContext());
+			}
+			else if (errno != EINTR)
+			{
+				release();
+			}
+			break;
+		}
+
+		if (policy_.bytesPerSecond != 0)
+		{
+			tokens_ -= static_cast<double>(packet.size());
+		}
+		stats_.sent += 1;
+		stats_.sentBytes += packet.size();
+		queue_.pop_front();
+	}
+
+	scheduleRefill(nowUS);
+}
+
+std::size_t AcquiredNotifier::maxPayload() const
+{
+	return mtu_ > kNotificationHeaderBytes ? mtu_ - kNotificationHeaderBytes : 0;
+}
+
+// A burst smaller than one notification would never let a full-size packet through
+double AcquiredNotifier::capacity() const
+{
+	return static_cast<double>(std::max<std::size_t>(policy_.burstBytes, maxPayload()));
+}
+
+void AcquiredNotifier::refill(gint64 nowUS)
+{
+	if (policy_.bytesPerSecond != 0 && nowUS > refilledAt_)
+	{
+		tokens_ = std::min(capacity(), tokens_ + static_cast<double>(nowUS - refilledAt_) * policy_.bytesPerSecond / 1e6);
+	}
+	refilledAt_ = std::max(refilledAt_, nowUS);
+}
+
+bool AcquiredNotifier::covers(std::size_t bytes) const
+{
+	return policy_.bytesPerSecond == 0 || tokens_ >= static_cast<double>(bytes);
+}
+
+// Drops the socket together with whatever was still queued for it; there is nobody left to receive it
+void AcquiredNotifier::release()
+{
+	for (GSource **ppWatch : {&pHangupWatch_, &pWritableWatch_})
+	{
+		if (*ppWatch != nullptr)
+		{
+			g_source_destroy(*ppWatch);
+			g_source_unref(*ppWatch);
+			*ppWatch = nullptr;
+		}
+	}
+	if (refillTimerId_ != 0)
+	{
+		removeRunLoopTimer(refillTimerId_);
+		refillTimerId_ = 0;
+	}
+	queue_.clear();
+
+	if (fd_ < 0)
+	{
+		return;
+	}
+	close(fd_);
+	fd_ = -1;
+	Logger::debug(SSTR << "Notifications released on " << objectPath_);
+	if (stateCallback_)
+	{
+		stateCallback_(false);
+	}
+}
+
+// Wake up when the budget covers the next notification
+void AcquiredNotifier::scheduleRefill(gint64 nowUS)
+{
+	if (fd_ < 0 || queue_.empty() || pWritableWatch_ != nullptr || covers(queue_.front().size()))
+	{
+		return;
+	}
+
+	const double missing = static_cast<double>(queue_.front().size()) - tokens_;
+	const gint64 deadline = nowUS + static_cast<gint64>(std::ceil(missing * 1e6 / policy_.bytesPerSecond));
+	if (refillTimerId_ != 0 && refillDeadline_ <= deadline)
+	{
+		return;
+	}
+	if (refillTimerId_ != 0)
+	{
+		removeRunLoopTimer(refillTimerId_);
+	}
+
+	const guint delayMS = static_cast<guint>(std::max<gint64>((deadline - nowUS + 999) / 1000, 1));
+	refillDeadline_ = deadline;
+	refillTimerId_ = addRunLoopTimer(threadRunLoopContext(), delayMS, onRefill, this);
+}
+
+gboolean AcquiredNotifier::onHangup(gint, GIOCondition, gpointer pUserData)
+{
+	auto &notifier = *static_cast<AcquiredNotifier *>(pUserData);
+
+	// Returning G_SOURCE_REMOVE destroys the source; release() must not destroy it a second time
+	g_source_unref(notifier.pHangupWatch_);
+	notifier.pHangupWatch_ = nullptr;
+	notifier.release();
+	return G_SOURCE_REMOVE;
+}
+
+gboolean AcquiredNotifier::onWritable(gint, GIOCondition, gpointer pUserData)
+{
+	auto &notifier = *static_cast<AcquiredNotifier *>(pUserData);
+	g_source_unref(notifier.pWritableWatch_);
+	notifier.pWritableWatch_ = nullptr;
+	notifier.service(g_get_monotonic_time());
+	return G_SOURCE_REMOVE;
+}
+
+gboolean AcquiredNotifier::onRefill(gpointer pUserData)
+{
+	auto &notifier = *static_cast<AcquiredNotifier *>(pUserData);
+	notifier.refillTimerId_ = 0;
+	notifier.service(g_get_monotonic_time());
+	return G_SOURCE_REMOVE;
+}
+
+} // namespace bzp
@@ -0,0 +1,93 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Notifications through BlueZ's AcquireNotify socket, behind `GattCharacteristic::enableAcquiredNotify()`.
+//
+// When a characteristic exposes NotifyAcquired, BlueZ calls AcquireNotify once, when the first device enables notifications, and
+// keeps the returned socket for as long as any device stays subscribed. Every packet written to it goes out to all subscribed
+// devices: BlueZ does not open a socket per device, devices that subscribe later share the existing one, and nothing on the
+// socket says which devices are listening. BlueZ closes its end after the last device unsubscribes and calls AcquireNotify again
+// for the next subscription.
+//
+// The notifier keeps one SOCK_SEQPACKET pair per acquisition, hands BlueZ one end and puts a bounded queue and a token bucket in
+// front of the other, so a producer that outpaces the budget loses its oldest values instead of flooding the link and every
+// subscriber with a backlog. A full socket parks the queue until it drains, and when the budget alone holds packets back a
+// one-shot run-loop timer fires when the next one is covered.
+//
+// Server thread only.
+
+#pragma once
+
+#include <bzp/GattCharacteristic.h>
+
+#include <glib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace bzp {
+
+class AcquiredNotifier
+{
+public:
+	// Runs after the socket was acquired or released, with the new state
+	using StateCallback = std::function<void(bool acquired)>;
+
+	AcquiredNotifier(std::string objectPath, const AcquiredNotifyPolicy &policy);
+	~AcquiredNotifier();
+
+	AcquiredNotifier(const AcquiredNotifier &) = delete;
+	AcquiredNotifier &operator=(const AcquiredNotifier &) = delete;
+
+	void setStateCallback(StateCallback callback) { stateCallback_ = std::move(callback); }
+
+	// Answers AcquireNotify, replacing an earlier socket. Returns BlueZ's end of the socket pair (the caller passes it on and
+	// closes it), or -1.
+	int acquire(uint16_t mtu);
+
+	// Queues `value` for the subscribed devices, then sends what the budget allows. Returns false while no socket is acquired or
+	// when the value does not fit the MTU.
+	bool enqueue(std::span<const std::uint8_t> value);
+
+	// 0 bytes per second is unlimited
+	void setBudget(uint32_t bytesPerSecond, uint32_t burstBytes);
+
+	[[nodiscard]] AcquiredNotifyStats stats() const;
+	[[nodiscard]] bool acquired() const { return fd_ >= 0; }
+
+	// Sends queued notifications as of `nowUS` (monotonic microseconds)
+	void service(gint64 nowUS);
+
+private:
+	std::size_t maxPayload() const;
+	double capacity() const;
+	void refill(gint64 nowUS);
+	bool covers(std::size_t bytes) const;
+	void release();
+	void scheduleRefill(gint64 nowUS);
+
+	static gboolean onHangup(gint fd, GIOCondition condition, gpointer pUserData);
+	static gboolean onWritable(gint fd, GIOCondition condition, gpointer pUserData);
+	static gboolean onRefill(gpointer pUserData);
+
+	std::string objectPath_;
+	AcquiredNotifyPolicy policy_;
+	StateCallback stateCallback_;
+	int fd_ = -1;
+	uint16_t mtu_ = 0;
+	double tokens_ = 0.0;
+	gint64 refilledAt_ = 0;
+	std::deque<std::vector<std::uint8_t>> queue_;
+	GSource *pHangupWatch_ = nullptr;
+	GSource *pWritableWatch_ = nullptr;    // only while the socket is full
+	guint refillTimerId_ = 0;
+	gint64 refillDeadline_ = 0;
+	AcquiredNotifyStats stats_;
+};
+
+} // namespace bzp
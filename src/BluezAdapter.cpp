@@ -6,6 +6,9 @@
 #include <bzp/BluezAdapter.h>
 #include "BluezAdvertisingSupport.h"
 #include "BluezAdvertisement.h"
+#include "BluezSignalFilter.h"
+#include "DeviceEventBatch.h"
+#include "RunLoopTimers.h"
 #include <bzp/Logger.h>
 #include <bzp/Server.h>
 #include "StructuredLogger.h"
@@ -19,12 +22,14 @@
 #include <string_view>
 #include <chrono>
 #include <thread>
+#include <utility>
 
 namespace bzp {
 
 namespace {
 
-std::string currentAdvertisementPath(const std::string& serviceName)
+// Index 0 is the primary advertisement; additional advertising sets use 1, 2, ...
+std::string currentAdvertisementPath(const std::string& serviceName, unsigned int index = 0)
 {
 	if (!serviceName.empty())
 	{
@@ -32,10 +37,10 @@ std::string currentAdvertisementPath(const std::string& serviceName)
 		// e.g., "bzperi.myapp" becomes "/com/bzperi/myapp/advertisement0"
 		std::string pathServiceName = serviceName;
 		std::replace(pathServiceName.begin(), pathServiceName.end(), '.', '/');
-		return std::string("/com/") + pathServiceName + "/advertisement0";
+		return std::string("/com/") + pathServiceName + "/advertisement" + std::to_string(index);
 	}
 
-	return "/com/bzperi/advertisement0";
+	return "/com/bzperi/advertisement" + std::to_string(index);
 }
 
 std::optional<std::pair<int, int>> parseBluezMajorMinor(const std::string& version)
@@ -165,48 +170,25 @@ std::string joinStrings(const std::vector<std::string>& values, std::string_view
 	return joined;
 }
 
-void configureAdvertisementPayload(BluezAdvertisement& advertisement, const BluezCapabilities& capabilities, const Server* serverContext)
+detail::AdvertisingPack configureAdvertisementPayload(BluezAdvertisement& advertisement, const BluezCapabilities& capabilities,
+	const Server* serverContext, const AdvertisingData& data)
 {
-	std::vector<std::string> discoveredServiceUUIDs;
+	detail::AdvertisingPackInput input;
 	if (serverContext != nullptr)
 	{
-		discoveredServiceUUIDs = detail::collectGattServiceUUIDs(*serverContext);
+		input.serviceUUIDs = detail::collectGattServiceUUIDs(*serverContext);
 	}
+	input.data = data;
+	input.includeLocalName = true;
 
-	const auto selectedServiceUUIDs = detail::selectAdvertisementServiceUUIDs(discoveredServiceUUIDs, capabilities);
-	const bool usingExtendedAdvertising = detail::canUseExtendedAdvertising(capabilities);
-	const char* payloadMode = usingExtendedAdvertising ? "extended" : "legacy";
+	detail::AdvertisingPack pack = detail::packAdvertisingPayload(input, capabilities);
 
-	if (discoveredServiceUUIDs.empty())
-	{
-		Logger::info(SSTR << "Advertising payload mode: " << payloadMode
-			<< " (MaxAdvLen=" << capabilities.maxAdvertisingDataLength << ", no service UUIDs discovered)");
-	}
-	else
-	{
-		Logger::info(SSTR << "Advertising payload mode: " << payloadMode
-			<< " (MaxAdvLen=" << capabilities.maxAdvertisingDataLength
-			<< ", discovered=" << discoveredServiceUUIDs.size()
-			<< ", selected=" << selectedServiceUUIDs.size()
-			<< ", uuids=" << joinStrings(selectedServiceUUIDs, ", ") << ")");
-	}
-
-	if (!discoveredServiceUUIDs.empty() && !usingExtendedAdvertising &&
-		selectedServiceUUIDs.size() < discoveredServiceUUIDs.size())
-	{
-		Logger::info(SSTR << "Legacy advertising budget active (" << capabilities.maxAdvertisingDataLength
-			<< " bytes); advertising " << selectedServiceUUIDs.size() << " of "
-			<< discoveredServiceUUIDs.size() << " service UUIDs");
-	}
-	else if (!selectedServiceUUIDs.empty())
-	{
-		Logger::debug(SSTR << "Advertising " << selectedServiceUUIDs.size()
-			<< " service UUIDs" << (usingExtendedAdvertising ? " with extended payload" : " with legacy payload"));
-	}
-
-	advertisement.setServiceUUIDs(selectedServiceUUIDs);
+	advertisement.setServiceUUIDs(pack.serviceUUIDs);
+	advertisement.setAdvertisingData(pack.data);
+	advertisement.setScanResponse(pack.scanResponseServiceUUIDs, pack.scanResponseData);
 	advertisement.setAdvertisementType("peripheral");
 	advertisement.setIncludeTxPower(false);
+	return pack;
 }
 
 GMainContext* currentOrDefaultMainContext() noexcept
@@ -219,22 +201,20 @@ GMainContext* currentOrDefaultMainContext() noexcept
 	return g_main_context_default();
 }
 
+// Adapter timers share the context's deadline-ordered timer source instead of attaching one GSource each
 guint attachTimeoutSource(guint intervalMS, GSourceFunc callback, gpointer userData)
 {
-	GSource* source = g_timeout_source_new(intervalMS);
-	g_source_set_callback(source, callback, userData, nullptr);
-	const guint sourceId = g_source_attach(source, currentOrDefaultMainContext());
-	g_source_unref(source);
-	return sourceId;
+	return addRunLoopTimer(currentOrDefaultMainContext(), intervalMS, callback, userData);
 }
 
 guint attachTimeoutSecondsSource(guint intervalSeconds, GSourceFunc callback, gpointer userData)
 {
-	GSource* source = g_timeout_source_new_seconds(intervalSeconds);
-	g_source_set_callback(source, callback, userData, nullptr);
-	const guint sourceId = g_source_attach(source, currentOrDefaultMainContext());
-	g_source_unref(source);
-	return sourceId;
+	return addRunLoopTimerSeconds(currentOrDefaultMainContext(), intervalSeconds, callback, userData);
+}
+
+void detachTimeoutSource(guint timerId)
+{
+	removeRunLoopTimer(timerId);
 }
 
 } // namespace
@@ -244,6 +224,8 @@ void BluezAdapter::setServiceNameContext(std::string serviceName)
 	serviceNameContext_ = serviceName.empty() ? "bzperi" : std::move(serviceName);
 }
 
+BluezAdapter::BluezAdapter() = default;
+
 BluezAdapter::~BluezAdapter()
 {
 	shutdown();
@@ -343,20 +325,22 @@ BluezResult<void> BluezAdapter::initialize(const std::string& preferredAdapter)
 		return selectResult;
 	}
 
-	// Subscribe to D-Bus signals for connection tracking and adapter monitoring
+	// Subscribe to D-Bus signals for connection tracking and adapter monitoring. Only Device1 property changes matter, and the
+	// bus match rule added by refreshSignalMatchRule() keeps other adapters' devices from waking us at all.
 	propertiesChangedSubscription = g_dbus_connection_signal_subscribe(
 		dbusConnection.get(),
 		"org.bluez",
 		"org.freedesktop.DBus.Properties",
 		"PropertiesChanged",
 		nullptr,
-		nullptr,  // Listen to all interfaces
-		G_DBUS_SIGNAL_FLAGS_NONE,
+		"org.bluez.Device1",
+		G_DBUS_SIGNAL_FLAGS_NO_MATCH_RULE,
 		[](GDBusConnection*, const gchar*, const gchar* object_path, const gchar*, const gchar*, GVariant* parameters, gpointer user_data) {
 			static_cast<BluezAdapter*>(user_data)->handlePropertiesChanged(object_path != nullptr ? object_path : "", DBusVariantRef(parameters));
 		},
 		this,
 		nullptr);
+	refreshSignalMatchRule();
 
 	interfacesAddedSubscription = g_dbus_connection_signal_subscribe(
 		dbusConnection.get(),
@@ -410,14 +394,21 @@ BluezResult<void> BluezAdapter::initialize(const std::string& preferredAdapter)
 					 << (capabilities.hasLEAdvertisingManager ? "Yes" : "No")
 					 << ", GATT Manager: " << (capabilities.hasGattManager ? "Yes" : "No")
 					 << ", MaxAdvLen: " << capabilities.maxAdvertisingDataLength
+					 << ", Instances: " << static_cast<int>(capabilities.supportedAdvertisingInstances)
 					 << ", Secondary PHYs: "
 					 << (capabilities.supportedSecondaryChannels.empty()
 					 	? "none"
 					 	: joinStrings(capabilities.supportedSecondaryChannels, ",")));
+
+		std::lock_guard<std::mutex> lock(advertisingDataMutex_);
+		advertisingCapabilities_ = capabilities;
 	}
 
 	initialized = true;
 	bluezLogger.log().op("Initialize").path(adapterPath).result("Success").info();
+
+	// Sets configured before initialization go on air now
+	rotateAdvertisingSets();
 	return BluezResult<void>();
 }
 
@@ -427,6 +418,17 @@ void BluezAdapter::shutdown()
 	// Cancel any pending reconnect timers immediately
 	reconnectCancelled_.store(true);
 	clearReconnectTimers();
+	cancelDeviceEvents();
+
+	// A set's advertisement has to outlive a register/unregister call that is still in flight; its completion frees it
+	for (auto& set : advertisingSets_)
+	{
+		if (set.pending)
+		{
+			retiredAdvertisements_.push_back(std::move(set.advertisement));
+		}
+	}
+	advertisingSets_.clear();
 
 	if (!initialized)
 		return;
@@ -438,6 +440,7 @@ void BluezAdapter::shutdown()
 		{
 			g_dbus_connection_signal_unsubscribe(dbusConnection.get(), propertiesChangedSubscription);
 			propertiesChangedSubscription = 0;
+			removeSignalMatchRule();
 		}
 		if (interfacesAddedSubscription > 0)
 		{
@@ -475,7 +478,7 @@ void BluezAdapter::shutdown()
 	{
 		if (retry->timeoutId > 0)
 		{
-			g_source_remove(retry->timeoutId);
+			detachTimeoutSource(retry->timeoutId);
 		}
 	}
 	activeRetries.clear();
@@ -483,9 +486,11 @@ void BluezAdapter::shutdown()
 	// Cancel advertising retry
 	if (activeAdvertisingRetry && activeAdvertisingRetry->timeoutId > 0)
 	{
-		g_source_remove(activeAdvertisingRetry->timeoutId);
+		detachTimeoutSource(activeAdvertisingRetry->timeoutId);
 	}
 	activeAdvertisingRetry.reset();
+	cancelAdvertisingBurst();
+	stopAdvertisingRotation();
 
 	// Reset state
 	initialized = false;
@@ -604,6 +609,10 @@ BluezResult<void> BluezAdapter::selectAdapter(const std::string& adapterPath)
 
 	this->adapterPath = adapterPath;
 	Logger::info(SSTR << "Selected adapter: " << adapterPath);
+	if (propertiesChangedSubscription > 0)
+	{
+		refreshSignalMatchRule();
+	}
 	return BluezResult<void>();
 }
 
@@ -717,6 +726,72 @@ BluezResult<DBusVariantRef> BluezAdapter::getAdapterProperty(const std::string&
 	return BluezResult<DBusVariantRef>(DBusVariantRef(value));
 }
 
+void BluezAdapter::setAdapterPropertyAsync(const std::string& property, GVariant* value, std::function<void(BluezResult<void>)> callback)
+{
+	struct PropertyCallContext {
+		std::string property;
+		std::function<void(BluezResult<void>)> callback;
+	};
+
+	if (!initialized || adapterPath.empty())
+	{
+		g_variant_unref(g_variant_ref_sink(value));
+		if (callback) callback(BluezResult<void>(BluezError::NotReady, "BluezAdapter not initialized"));
+		return;
+	}
+
+	g_dbus_connection_call(
+		dbusConnection.get(),
+		"org.bluez",
+		adapterPath.c_str(),
+		"org.freedesktop.DBus.Properties",
+		"Set",
+		g_variant_new("(ssv)", "org.bluez.Adapter1", property.c_str(), value),
+		nullptr,
+		G_DBUS_CALL_FLAGS_NONE,
+		timeoutConfig.propertyTimeoutMs,
+		nullptr,
+		[](GObject* source, GAsyncResult* res, gpointer user_data) {
+			std::unique_ptr<PropertyCallContext> context(static_cast<PropertyCallContext*>(user_data));
+			GError* error = nullptr;
+			GVariant* reply = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+
+			BluezResult<void> result;
+			if (reply == nullptr)
+			{
+				result = BluezResult<void>::fromGError(error);
+				bluezLogger.log().op("Set").prop(context->property).result("Failed").error(error ? error->message : "").warn();
+				if (error) g_error_free(error);
+			}
+			else
+			{
+				g_variant_unref(reply);
+				Logger::debug(SSTR << "Successfully set " << context->property);
+			}
+
+			if (context->callback) context->callback(result);
+		},
+		new PropertyCallContext{property, std::move(callback)});
+}
+
+std::optional<bool> BluezAdapter::readAdapterBoolean(const std::string& property)
+{
+	auto result = getAdapterProperty(property);
+	if (result.hasError() || result.value().get() == nullptr)
+	{
+		return std::nullopt;
+	}
+
+	GVariant* value = result.value().get();
+	std::optional<bool> flag;
+	if (g_variant_is_of_type(value, G_VARIANT_TYPE_BOOLEAN))
+	{
+		flag = g_variant_get_boolean(value) != FALSE;
+	}
+	g_variant_unref(value);
+	return flag;
+}
+
 // Non-blocking retry operations using GLib timeouts
 BluezResult<void> BluezAdapter::retryOperationWithTimeout(std::function<BluezResult<void>()> operation, const RetryPolicy& policy)
 {
@@ -864,7 +939,7 @@ gboolean BluezAdapter::onAdvertisingRetryTimeout(gpointer user_data)
 		{
 			adapter->advertisement = std::make_unique<BluezAdvertisement>(currentAdvertisementPath(adapter->serviceNameContext_));
 		}
-		configureAdvertisementPayload(*adapter->advertisement, adapter->capabilities, adapter->serverContext_);
+		adapter->refreshAdvertisementPayload();
 
 			adapter->advertisement->registerAdvertisementAsync(adapter->dbusConnection.get(), adapter->adapterPath,
 			[adapter, callback](BluezResult<void> result) {
@@ -875,7 +950,7 @@ gboolean BluezAdapter::onAdvertisingRetryTimeout(gpointer user_data)
 					// Safe cleanup: Cancel any pending timeout before resetting
 					if (adapter->activeAdvertisingRetry && adapter->activeAdvertisingRetry->timeoutId > 0)
 					{
-						g_source_remove(adapter->activeAdvertisingRetry->timeoutId);
+						detachTimeoutSource(adapter->activeAdvertisingRetry->timeoutId);
 						adapter->activeAdvertisingRetry->timeoutId = 0;
 					}
 					adapter->activeAdvertisingRetry.reset();
@@ -899,7 +974,7 @@ gboolean BluezAdapter::onAdvertisingRetryTimeout(gpointer user_data)
 						// Clear old timeout ID first if it exists
 						if (retryState->timeoutId > 0)
 						{
-							g_source_remove(retryState->timeoutId);
+							detachTimeoutSource(retryState->timeoutId);
 						}
 						retryState->timeoutId = attachTimeoutSource(delayMs, onAdvertisingRetryTimeout, adapter);
 					}
@@ -911,7 +986,7 @@ gboolean BluezAdapter::onAdvertisingRetryTimeout(gpointer user_data)
 						// Safe cleanup: Cancel any pending timeout before resetting
 						if (adapter->activeAdvertisingRetry && adapter->activeAdvertisingRetry->timeoutId > 0)
 						{
-							g_source_remove(adapter->activeAdvertisingRetry->timeoutId);
+							detachTimeoutSource(adapter->activeAdvertisingRetry->timeoutId);
 							adapter->activeAdvertisingRetry->timeoutId = 0;
 						}
 						adapter->activeAdvertisingRetry.reset();
@@ -1011,6 +1086,12 @@ BluezResult<BluezCapabilities> BluezAdapter::detectCapabilities()
 					g_variant_unref(supportedCapabilities);
 				}
 
+				if (GVariant* supportedInstances = g_dbus_proxy_get_cached_property(proxy, "SupportedInstances"))
+				{
+					caps.supportedAdvertisingInstances = g_variant_get_byte(supportedInstances);
+					g_variant_unref(supportedInstances);
+				}
+
 				if (GVariant* supportedSecondaryChannels = g_dbus_proxy_get_cached_property(proxy, "SupportedSecondaryChannels"))
 				{
 					gsize count = 0;
@@ -1076,70 +1157,195 @@ BluezResult<std::vector<DeviceInfo>> BluezAdapter::getConnectedDevices()
 	return BluezResult<std::vector<DeviceInfo>>(std::move(devices));
 }
 
-// Device connection tracking
+// Device connection tracking. Signals only queue events; flushDeviceEvents() applies everything queued during a loop iteration
+// at once (see DeviceEventBatch.h), so a connect storm costs one lock, one log line, one connection count update and one
+// aggregated callback instead of one of each per device.
 void BluezAdapter::handleDeviceConnected(const std::string& devicePath)
 {
-	bool shouldNotify = false;
-	ConnectionCallback callback;
-	{
-		std::lock_guard<std::mutex> lock(connectedDevicesMutex_);
-		auto it = connectedDevices.find(devicePath);
-		if (it == connectedDevices.end())
-		{
-			// New connection
-			DeviceInfo info;
-			info.path = devicePath;
-			info.connected = true;
-			connectedDevices[devicePath] = info;
+	pendingDeviceEvents_.push_back({devicePath, detail::DeviceEvent::Connected});
+	scheduleDeviceEvents();
+}
+
+void BluezAdapter::handleDeviceDisconnected(const std::string& devicePath)
+{
+	pendingDeviceEvents_.push_back({devicePath, detail::DeviceEvent::Disconnected});
+	scheduleDeviceEvents();
+}
 
-			int newCount = activeConnections.fetch_add(1) + 1;
-			bluezLogger.logConnectionEvent(devicePath, true, newCount);
+void BluezAdapter::handleDeviceRemoved(const std::string& devicePath)
+{
+	pendingDeviceEvents_.push_back({devicePath, detail::DeviceEvent::Removed});
+	scheduleDeviceEvents();
+}
 
-			shouldNotify = true;
-			callback = connectionCallback;
-		}
+// A zero-delay timer on the context's shared timer source (default priority) runs on the next loop iteration, after the
+// messages GDBus already dispatched in this one, so the signals of a burst that arrive together share the batch. Unlike idle
+// priority, steady GATT traffic cannot hold the batch back: the timer competes with D-Bus dispatch on equal terms.
+void BluezAdapter::scheduleDeviceEvents()
+{
+	if (deviceEventsTimerId_ != 0)
+	{
+		return;
 	}
 
-	if (shouldNotify && callback)
+	deviceEventsTimerId_ = attachTimeoutSource(0, [](gpointer userData) -> gboolean {
+		auto* self = static_cast<BluezAdapter*>(userData);
+		self->deviceEventsTimerId_ = 0;
+		self->flushDeviceEvents();
+		return G_SOURCE_REMOVE;
+	}, this);
+}
+
+void BluezAdapter::cancelDeviceEvents()
+{
+	if (deviceEventsTimerId_ != 0)
 	{
-		callback(true, devicePath);
+		detachTimeoutSource(deviceEventsTimerId_);
+		deviceEventsTimerId_ = 0;
 	}
+	pendingDeviceEvents_.clear();
 }
 
-void BluezAdapter::handleDeviceDisconnected(const std::string& devicePath)
+void BluezAdapter::flushDeviceEvents()
 {
-	bool shouldNotify = false;
-	ConnectionCallback callback;
+	const std::vector<detail::PendingDeviceEvent> events = std::exchange(pendingDeviceEvents_, {});
+	detail::ConnectionChanges changes;
+	int newCount = 0;
 	{
 		std::lock_guard<std::mutex> lock(connectedDevicesMutex_);
-		auto it = connectedDevices.find(devicePath);
-		if (it != connectedDevices.end() && it->second.connected)
-		{
-			// Mark as disconnected
-			it->second.connected = false;
+		changes = detail::applyDeviceEvents(connectedDevices, events);
+		const int delta = static_cast<int>(changes.added.size()) - static_cast<int>(changes.removed.size());
+		newCount = activeConnections.fetch_add(delta) + delta;
+	}
 
-			int newCount = activeConnections.fetch_sub(1) - 1;
-			bluezLogger.logConnectionEvent(devicePath, false, newCount);
+	if (changes.added.empty() && changes.removed.empty())
+	{
+		return;
+	}
 
-			shouldNotify = true;
-			callback = connectionCallback;
-		}
+	// One line per batch keeps log consumers (and inspect snapshots keyed on them) from churning through a storm
+	if (changes.added.size() + changes.removed.size() == 1)
+	{
+		const bool connected = !changes.added.empty();
+		bluezLogger.logConnectionEvent(connected ? changes.added.front() : changes.removed.front(), connected, newCount);
+	}
+	else
+	{
+		bluezLogger.log().op("Connection").result("Batch")
+			.extra("connected=" + std::to_string(changes.added.size()) + " disconnected=" + std::to_string(changes.removed.size())
+				+ " active=" + std::to_string(newCount))
+			.info();
 	}
 
-	if (shouldNotify && callback)
+	if (connectionsChangedCallback)
 	{
-		callback(false, devicePath);
+		connectionsChangedCallback(changes.added, changes.removed);
+	}
+	if (connectionCallback)
+	{
+		for (const std::string& devicePath : changes.added)
+		{
+			connectionCallback(true, devicePath);
+		}
+		for (const std::string& devicePath : changes.removed)
+		{
+			connectionCallback(false, devicePath);
+		}
 	}
 }
 
 // D-Bus signal handlers
+BluezSignalStats BluezAdapter::getSignalStats() const
+{
+	BluezSignalStats stats;
+	stats.received = signalsReceived_.load(std::memory_order_relaxed);
+	stats.filtered = signalsFiltered_.load(std::memory_order_relaxed);
+	stats.handled = signalsHandled_.load(std::memory_order_relaxed);
+	return stats;
+}
+
+// Swap the bus match rule for the one covering the selected adapter. Both calls are fire-and-forget; if the bus rejects
+// path_namespace, fall back to the arg0-only rule so connection tracking keeps working.
+void BluezAdapter::refreshSignalMatchRule()
+{
+	if (!dbusConnection)
+	{
+		return;
+	}
+
+	removeSignalMatchRule();
+	propertiesChangedMatchRule_ = detail::devicePropertiesMatchRule(adapterPath);
+
+	struct AddMatchContext
+	{
+		GDBusConnection *pConnection;
+		std::string fallbackRule;
+	};
+	auto *pContext = new AddMatchContext{G_DBUS_CONNECTION(g_object_ref(dbusConnection.get())),
+		adapterPath.empty() ? std::string() : detail::devicePropertiesMatchRule("")};
+
+	g_dbus_connection_call(dbusConnection.get(), "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+		"AddMatch", g_variant_new("(s)", propertiesChangedMatchRule_.c_str()), nullptr, G_DBUS_CALL_FLAGS_NONE, -1, nullptr,
+		[](GObject *pSource, GAsyncResult *pResult, gpointer pUserData) {
+			std::unique_ptr<AddMatchContext> context(static_cast<AddMatchContext *>(pUserData));
+			GError *pError = nullptr;
+			GVariant *pReply = g_dbus_connection_call_finish(G_DBUS_CONNECTION(pSource), pResult, &pError);
+			if (pReply != nullptr)
+			{
+				g_variant_unref(pReply);
+			}
+			else
+			{
+				bluezLogger.log().op("AddMatch").prop("PropertiesChanged").result("Failed").error(pError->message).warn();
+				g_error_free(pError);
+				if (!context->fallbackRule.empty())
+				{
+					g_dbus_connection_call(context->pConnection, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+						"org.freedesktop.DBus", "AddMatch", g_variant_new("(s)", context->fallbackRule.c_str()), nullptr,
+						G_DBUS_CALL_FLAGS_NONE, -1, nullptr, nullptr, nullptr);
+				}
+			}
+			g_object_unref(context->pConnection);
+		},
+		pContext);
+}
+
+void BluezAdapter::removeSignalMatchRule()
+{
+	if (!dbusConnection || propertiesChangedMatchRule_.empty())
+	{
+		return;
+	}
+
+	// Also drop the fallback rule in case the path_namespace one was rejected; removing a rule we never added is harmless
+	std::vector<std::string> rules{propertiesChangedMatchRule_};
+	if (const std::string fallbackRule = detail::devicePropertiesMatchRule(""); fallbackRule != propertiesChangedMatchRule_)
+	{
+		rules.push_back(fallbackRule);
+	}
+	for (const std::string &rule : rules)
+	{
+		g_dbus_connection_call(dbusConnection.get(), "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+			"RemoveMatch", g_variant_new("(s)", rule.c_str()), nullptr, G_DBUS_CALL_FLAGS_NONE, -1, nullptr, nullptr, nullptr);
+	}
+	propertiesChangedMatchRule_.clear();
+}
+
 void BluezAdapter::handlePropertiesChanged(std::string_view objectPath, DBusVariantRef parameters)
 {
+	signalsReceived_.fetch_add(1, std::memory_order_relaxed);
 	if (!g_variant_is_of_type(parameters.get(), G_VARIANT_TYPE("(sa{sv}as)"))) {
 		Logger::warn("onPropertiesChanged: unexpected parameter type, skipping");
 		return;
 	}
 
+	// RSSI and advertising data churn from scanning never mentions Connected; drop it before unpacking anything
+	if (!detail::isAdapterObjectPath(objectPath, adapterPath) || !detail::mayChangeConnected(parameters.get()))
+	{
+		signalsFiltered_.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
 	const gchar* changedInterface = nullptr;
 	GVariant* changedProperties = nullptr;
 	GVariant* invalidatedProperties = nullptr;
@@ -1158,6 +1364,7 @@ void BluezAdapter::handlePropertiesChanged(std::string_view objectPath, DBusVari
 		{
 			if (g_strcmp0(key, "Connected") == 0)
 			{
+				signalsHandled_.fetch_add(1, std::memory_order_relaxed);
 				gboolean connected = g_variant_get_boolean(value);
 				if (connected)
 				{
@@ -1178,14 +1385,23 @@ void BluezAdapter::handlePropertiesChanged(std::string_view objectPath, DBusVari
 
 void BluezAdapter::handleInterfacesAdded(DBusVariantRef parameters)
 {
+	signalsReceived_.fetch_add(1, std::memory_order_relaxed);
 	if (!g_variant_is_of_type(parameters.get(), G_VARIANT_TYPE("(oa{sa{sv}})"))) {
 		Logger::warn("onInterfacesAdded: unexpected parameter type, skipping");
 		return;
 	}
 
 	const gchar* objectPath = nullptr;
-	GVariant* interfaces = nullptr;
+	g_variant_get_child(parameters.get(), 0, "&o", &objectPath);
 
+	// Devices discovered through other adapters are not ours; a new adapter only matters while we are looking for one
+	if (initialized && !detail::isAdapterObjectPath(objectPath, adapterPath))
+	{
+		signalsFiltered_.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	GVariant* interfaces = nullptr;
 	g_variant_get(parameters.get(), "(&o@a{sa{sv}})", &objectPath, &interfaces);
 
 	// Check if this is a Device1 interface being added
@@ -1202,6 +1418,7 @@ void BluezAdapter::handleInterfacesAdded(DBusVariantRef parameters)
 			GVariant* connected = g_variant_lookup_value(properties, "Connected", G_VARIANT_TYPE_BOOLEAN);
 			if (connected && g_variant_get_boolean(connected))
 			{
+				signalsHandled_.fetch_add(1, std::memory_order_relaxed);
 				handleDeviceConnected(objectPath);
 			}
 			if (connected) g_variant_unref(connected);
@@ -1210,6 +1427,7 @@ void BluezAdapter::handleInterfacesAdded(DBusVariantRef parameters)
 				 (!initialized || adapterPath.empty()))
 		{
 			bluezLogger.log().op("AdapterRecovery").path(objectPath).result("Available").extra("refreshing adapter selection").info();
+			signalsHandled_.fetch_add(1, std::memory_order_relaxed);
 
 			auto adaptersResult = discoverAdapters();
 			if (adaptersResult.hasError())
@@ -1257,14 +1475,21 @@ void BluezAdapter::handleInterfacesAdded(DBusVariantRef parameters)
 
 void BluezAdapter::handleInterfacesRemoved(DBusVariantRef parameters)
 {
+	signalsReceived_.fetch_add(1, std::memory_order_relaxed);
 	if (!g_variant_is_of_type(parameters.get(), G_VARIANT_TYPE("(oas)"))) {
 		Logger::warn("onInterfacesRemoved: unexpected parameter type, skipping");
 		return;
 	}
 
 	const gchar* objectPath = nullptr;
-	GVariant* interfaces = nullptr;
+	g_variant_get_child(parameters.get(), 0, "&o", &objectPath);
+	if (!detail::isAdapterObjectPath(objectPath, adapterPath))
+	{
+		signalsFiltered_.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
 
+	GVariant* interfaces = nullptr;
 	g_variant_get(parameters.get(), "(&o@as)", &objectPath, &interfaces);
 
 	// Check if Device1 interface was removed
@@ -1277,29 +1502,14 @@ void BluezAdapter::handleInterfacesRemoved(DBusVariantRef parameters)
 		if (g_strcmp0(interfaceName, "org.bluez.Device1") == 0)
 		{
 			// Device was removed, clean up from tracking
-			bool wasConnected = false;
-			{
-				std::lock_guard<std::mutex> lock(connectedDevicesMutex_);
-				auto it = connectedDevices.find(objectPath);
-				if (it != connectedDevices.end())
-				{
-					wasConnected = it->second.connected;
-					connectedDevices.erase(it);
-					if (wasConnected) {
-						activeConnections.fetch_sub(1);
-					}
-				}
-			}
-			if (wasConnected && connectionCallback)
-			{
-				bluezLogger.logConnectionEvent(objectPath, false, activeConnections.load());
-				connectionCallback(false, objectPath);
-			}
+			signalsHandled_.fetch_add(1, std::memory_order_relaxed);
+			handleDeviceRemoved(objectPath);
 		}
 		else if (g_strcmp0(interfaceName, "org.bluez.Adapter1") == 0
 		         && adapterPath == objectPath)
 		{
 			bluezLogger.log().op("AdapterRecovery").path(objectPath).result("Removed").error("active adapter disappeared").error();
+			signalsHandled_.fetch_add(1, std::memory_order_relaxed);
 			initialized = false;
 			adapterPath.clear();
 
@@ -1348,13 +1558,13 @@ void BluezAdapter::clearReconnectTimers()
 {
 	if (reconnectTimerId_ > 0)
 	{
-		g_source_remove(reconnectTimerId_);
+		detachTimeoutSource(reconnectTimerId_);
 		reconnectTimerId_ = 0;
 	}
 
 	if (delayedReconnectTimerId_ > 0)
 	{
-		g_source_remove(delayedReconnectTimerId_);
+		detachTimeoutSource(delayedReconnectTimerId_);
 		delayedReconnectTimerId_ = 0;
 	}
 }
@@ -1369,7 +1579,7 @@ void BluezAdapter::scheduleReconnectAttempt(unsigned int delaySeconds, bool dela
 	guint& timerId = delayedRetry ? delayedReconnectTimerId_ : reconnectTimerId_;
 	if (timerId > 0)
 	{
-		g_source_remove(timerId);
+		detachTimeoutSource(timerId);
 		timerId = 0;
 	}
 
@@ -1390,7 +1600,21 @@ gboolean BluezAdapter::onReconnectTimeout(gpointer user_data)
 	}
 
 	bluezLogger.log().op("Reconnect").result("Starting").extra("cleaning up stale connections").info();
+
+	// shutdown() drops the advertising sets; configure them again so they go back on air with the new connection
+	std::vector<AdvertisingSetConfig> advertisingSets;
+	for (const auto& set : adapter->advertisingSets_)
+	{
+		if (!set.removed)
+		{
+			advertisingSets.push_back(set.config);
+		}
+	}
 	adapter->shutdown();
+	for (const auto& config : advertisingSets)
+	{
+		(void)adapter->setAdvertisingSet(config);
+	}
 	adapter->reconnectCancelled_.store(false);
 
 	auto result = adapter->initialize();
@@ -1468,6 +1692,17 @@ BluezResult<void> BluezAdapter::setAdvertising(bool enabled)
 	return finalResult;
 }
 
+BluezResult<void> BluezAdapter::setAdvertising(bool enabled, const AdvertisingParameters& parameters)
+{
+	auto result = setAdvertisingParameters(parameters);
+	if (result.hasError())
+	{
+		return result;
+	}
+
+	return setAdvertising(enabled);
+}
+
 void BluezAdapter::setAdvertisingAsync(bool enabled, std::function<void(BluezResult<void>)> callback)
 {
 	if (!initialized || adapterPath.empty())
@@ -1481,7 +1716,7 @@ void BluezAdapter::setAdvertisingAsync(bool enabled, std::function<void(BluezRes
 	// Cancel any existing advertising retry
 	if (activeAdvertisingRetry && activeAdvertisingRetry->timeoutId > 0)
 	{
-		g_source_remove(activeAdvertisingRetry->timeoutId);
+		detachTimeoutSource(activeAdvertisingRetry->timeoutId);
 		activeAdvertisingRetry.reset();
 	}
 
@@ -1513,7 +1748,11 @@ void BluezAdapter::setAdvertisingAsync(bool enabled, std::function<void(BluezRes
 		{
 			advertisement = std::make_unique<BluezAdvertisement>(currentAdvertisementPath(serviceNameContext_));
 		}
-		configureAdvertisementPayload(*advertisement, capabilities, serverContext_);
+		if (advertisingBurstPolicy_ && advertisingBurstPolicy_->burstOnStart && !isAdvertisingBurstActive())
+		{
+			(void)triggerAdvertisingBurst();
+		}
+		refreshAdvertisementPayload();
 
 		// Use async registration with retry on failure
 		advertisement->registerAdvertisementAsync(dbusConnection.get(), adapterPath,
@@ -1546,6 +1785,7 @@ void BluezAdapter::setAdvertisingAsync(bool enabled, std::function<void(BluezRes
 	else
 	{
 		// Stop advertising
+		cancelAdvertisingBurst();
 		if (advertisement && advertisement->isRegistered())
 		{
 			advertisement->unregisterAdvertisementAsync(dbusConnection.get(), adapterPath,
@@ -1571,4 +1811,688 @@ bool BluezAdapter::isAdvertising() const
 	return advertisement && advertisement->isRegistered();
 }
 
+BluezResult<void> BluezAdapter::setAdvertisingManufacturerData(uint16_t companyId, std::vector<uint8_t> data)
+{
+	return updateAdvertisingData([companyId, &data](AdvertisingData& candidate) {
+		candidate.manufacturerData[companyId] = std::move(data);
+	});
+}
+
+BluezResult<void> BluezAdapter::removeAdvertisingManufacturerData(uint16_t companyId)
+{
+	return updateAdvertisingData([companyId](AdvertisingData& candidate) {
+		candidate.manufacturerData.erase(companyId);
+	});
+}
+
+BluezResult<void> BluezAdapter::setAdvertisingServiceData(const std::string& serviceUuid, std::vector<uint8_t> data)
+{
+	const std::string key = detail::normalizeAdvertisingServiceDataUuid(serviceUuid);
+	if (key.empty())
+	{
+		return BluezResult<void>(BluezError::InvalidArgs, "Invalid service data UUID: " + serviceUuid);
+	}
+
+	return updateAdvertisingData([&key, &data](AdvertisingData& candidate) {
+		candidate.serviceData[key] = std::move(data);
+	});
+}
+
+BluezResult<void> BluezAdapter::removeAdvertisingServiceData(const std::string& serviceUuid)
+{
+	const std::string key = detail::normalizeAdvertisingServiceDataUuid(serviceUuid);
+	if (key.empty())
+	{
+		return BluezResult<void>(BluezError::InvalidArgs, "Invalid service data UUID: " + serviceUuid);
+	}
+
+	return updateAdvertisingData([&key](AdvertisingData& candidate) {
+		candidate.serviceData.erase(key);
+	});
+}
+
+void BluezAdapter::clearAdvertisingData()
+{
+	std::lock_guard<std::mutex> lock(advertisingDataMutex_);
+	advertisingData_ = AdvertisingData{};
+}
+
+AdvertisingData BluezAdapter::getAdvertisingData() const
+{
+	std::lock_guard<std::mutex> lock(advertisingDataMutex_);
+	return advertisingData_;
+}
+
+void BluezAdapter::applyAdvertisingData()
+{
+	// Without an advertisement object the payload is applied by refreshAdvertisementPayload() at registration time. The
+	// layout is recomputed because new data can move structures between advertising data and scan response.
+	if (advertisement)
+	{
+		refreshAdvertisementPayload();
+	}
+}
+
+BluezResult<void> BluezAdapter::updateAdvertisingData(const std::function<void(AdvertisingData&)>& mutate)
+{
+	std::lock_guard<std::mutex> lock(advertisingDataMutex_);
+	AdvertisingData candidate = advertisingData_;
+	mutate(candidate);
+
+	auto budgetResult = detail::checkAdvertisingPayloadBudget(advertisedServiceUUIDs_, candidate, false, advertisingCapabilities_);
+	if (budgetResult.hasError())
+	{
+		bluezLogger.log().op("SetAdvertisingData").result("OverBudget").error(budgetResult.errorMessage()).warn();
+		return budgetResult;
+	}
+
+	advertisingData_ = std::move(candidate);
+	return BluezResult<void>();
+}
+
+void BluezAdapter::refreshAdvertisementPayload()
+{
+	AdvertisingData data = getAdvertisingData();
+	const auto pack = configureAdvertisementPayload(*advertisement, capabilities, serverContext_, data);
+	const std::string report = pack.report();
+
+	bool layoutChanged = false;
+	{
+		std::lock_guard<std::mutex> lock(advertisingDataMutex_);
+		// Later budget checks only need the UUIDs that made it on air; they are packed ahead of any data
+		advertisedServiceUUIDs_ = pack.serviceUUIDs;
+		advertisedServiceUUIDs_.insert(advertisedServiceUUIDs_.end(),
+			pack.scanResponseServiceUUIDs.begin(), pack.scanResponseServiceUUIDs.end());
+		advertisingCapabilities_ = capabilities;
+		layoutChanged = report != advertisingPayloadReport_;
+		advertisingPayloadReport_ = report;
+	}
+
+	if (layoutChanged)
+	{
+		const char* payloadMode = detail::canUseExtendedAdvertising(capabilities) ? "extended" : "legacy";
+		if (pack.complete())
+		{
+			Logger::info(SSTR << "Advertising payload (" << payloadMode << "): " << report);
+		}
+		else
+		{
+			// Data stored before the service UUID list was known can still overflow
+			Logger::warn(SSTR << "Advertising payload exceeds the controller budget (" << payloadMode << "): " << report);
+		}
+	}
+
+	advertisement->setAdvertisingParameters(advertisingParameters_);
+}
+
+std::string BluezAdapter::getAdvertisingPayloadReport() const
+{
+	std::lock_guard<std::mutex> lock(advertisingDataMutex_);
+	return advertisingPayloadReport_;
+}
+
+BluezResult<void> BluezAdapter::setAdvertisingParameters(const AdvertisingParameters& parameters)
+{
+	auto validation = detail::validateAdvertisingParameters(parameters);
+	if (validation.hasError())
+	{
+		bluezLogger.log().op("SetAdvertisingParameters").result("Invalid").error(validation.errorMessage()).warn();
+		return validation;
+	}
+
+	if (parameters.minIntervalMs != 0)
+	{
+		cancelAdvertisingBurst();
+	}
+
+	advertisingParameters_ = parameters;
+	if (advertisement)
+	{
+		advertisement->setAdvertisingParameters(advertisingParameters_);
+	}
+	return BluezResult<void>();
+}
+
+BluezResult<void> BluezAdapter::setAdvertisingBurstPolicy(const AdvertisingBurstPolicy& policy)
+{
+	auto validation = detail::validateAdvertisingBurstPolicy(policy);
+	if (validation.hasError())
+	{
+		bluezLogger.log().op("SetAdvertisingBurstPolicy").result("Invalid").error(validation.errorMessage()).warn();
+		return validation;
+	}
+
+	advertisingBurstPolicy_ = policy;
+	if (!isAdvertisingBurstActive())
+	{
+		applyAdvertisingIntervals(policy.relaxedMinIntervalMs, policy.relaxedMaxIntervalMs);
+	}
+	return BluezResult<void>();
+}
+
+void BluezAdapter::clearAdvertisingBurstPolicy()
+{
+	cancelAdvertisingBurst();
+	advertisingBurstPolicy_.reset();
+	applyAdvertisingIntervals(0, 0);
+}
+
+BluezResult<void> BluezAdapter::triggerAdvertisingBurst()
+{
+	if (!advertisingBurstPolicy_)
+	{
+		return BluezResult<void>(BluezError::NotReady, "No advertising burst policy configured");
+	}
+
+	const AdvertisingBurstPolicy policy = *advertisingBurstPolicy_;
+	cancelAdvertisingBurst();
+	applyAdvertisingIntervals(policy.burstMinIntervalMs, policy.burstMaxIntervalMs);
+	advertisingBurstTimerId_ = attachTimeoutSource(policy.burstDurationMs, onAdvertisingBurstTimeout, this);
+
+	bluezLogger.log().op("AdvertisingBurst").result("Started")
+		.extra(std::to_string(policy.burstMinIntervalMs) + "-" + std::to_string(policy.burstMaxIntervalMs)
+			+ " ms for " + std::to_string(policy.burstDurationMs) + " ms").info();
+	return BluezResult<void>();
+}
+
+gboolean BluezAdapter::onAdvertisingBurstTimeout(gpointer user_data)
+{
+	auto* adapter = static_cast<BluezAdapter*>(user_data);
+	adapter->advertisingBurstTimerId_ = 0;
+
+	if (adapter->advertisingBurstPolicy_)
+	{
+		const auto& policy = *adapter->advertisingBurstPolicy_;
+		adapter->applyAdvertisingIntervals(policy.relaxedMinIntervalMs, policy.relaxedMaxIntervalMs);
+		bluezLogger.log().op("AdvertisingBurst").result("Relaxed")
+			.extra(std::to_string(policy.relaxedMinIntervalMs) + "-" + std::to_string(policy.relaxedMaxIntervalMs) + " ms").info();
+	}
+
+	return G_SOURCE_REMOVE;
+}
+
+void BluezAdapter::applyAdvertisingIntervals(uint32_t minIntervalMs, uint32_t maxIntervalMs)
+{
+	advertisingParameters_.minIntervalMs = minIntervalMs;
+	advertisingParameters_.maxIntervalMs = maxIntervalMs;
+	if (advertisement)
+	{
+		advertisement->setAdvertisingParameters(advertisingParameters_);
+	}
+}
+
+void BluezAdapter::cancelAdvertisingBurst()
+{
+	if (advertisingBurstTimerId_ != 0)
+	{
+		detachTimeoutSource(advertisingBurstTimerId_);
+		advertisingBurstTimerId_ = 0;
+	}
+}
+
+// Additional advertising sets
+
+BluezResult<void> BluezAdapter::setAdvertisingSet(const AdvertisingSetConfig& config)
+{
+	auto normalized = detail::normalizeAdvertisingSetConfig(config, capabilities);
+	if (normalized.hasError())
+	{
+		bluezLogger.log().op("SetAdvertisingSet").extra(config.name).result("Invalid").error(normalized.errorMessage()).warn();
+		return BluezResult<void>(normalized.error(), normalized.errorMessage());
+	}
+	const AdvertisingSetConfig& updated = normalized.value();
+
+	AdvertisingSetState* set = findAdvertisingSet(updated.name);
+	if (set == nullptr)
+	{
+		AdvertisingSetState state;
+		state.config = updated;
+		state.advertisement = std::make_unique<BluezAdvertisement>(currentAdvertisementPath(serviceNameContext_, nextAdvertisingSetIndex_++));
+		advertisingSets_.push_back(std::move(state));
+		set = &advertisingSets_.back();
+	}
+	else if (set->config == updated)
+	{
+		return BluezResult<void>();
+	}
+	else
+	{
+		// Type, service UUIDs and includes are only read by BlueZ at registration time
+		set->restart = set->restart
+			|| set->config.type != updated.type
+			|| set->config.serviceUUIDs != updated.serviceUUIDs
+			|| set->config.includeLocalName != updated.includeLocalName;
+		set->config = updated;
+	}
+
+	detail::AdvertisingPackInput packInput;
+	packInput.serviceUUIDs = updated.serviceUUIDs;
+	packInput.data = updated.data;
+	packInput.includeLocalName = updated.includeLocalName;
+	const auto pack = detail::packAdvertisingPayload(packInput, capabilities);
+
+	BluezAdvertisement& advertisement = *set->advertisement;
+	advertisement.setAdvertisementType(updated.type);
+	advertisement.setServiceUUIDs(pack.serviceUUIDs);
+	advertisement.setIncludeTxPower(false);
+	advertisement.setIncludeLocalName(updated.includeLocalName);
+	advertisement.setAdvertisingData(pack.data);
+	advertisement.setScanResponse(pack.scanResponseServiceUUIDs, pack.scanResponseData);
+	advertisement.setAdvertisingParameters(updated.parameters);
+
+	bluezLogger.log().op("SetAdvertisingSet").path(advertisement.getObjectPath()).extra(updated.name + " " + pack.report())
+		.result("Success").info();
+	rotateAdvertisingSets();
+	return BluezResult<void>();
+}
+
+BluezResult<void> BluezAdapter::removeAdvertisingSet(const std::string& name)
+{
+	AdvertisingSetState* set = findAdvertisingSet(name);
+	if (set == nullptr)
+	{
+		return BluezResult<void>(BluezError::NotFound, "No advertising set named '" + name + "'");
+	}
+
+	set->removed = true;
+	set->selected = false;
+	bluezLogger.log().op("RemoveAdvertisingSet").path(set->advertisement->getObjectPath()).extra(name).result("Success").info();
+	rotateAdvertisingSets();
+	return BluezResult<void>();
+}
+
+std::vector<std::string> BluezAdapter::getAdvertisingSetNames() const
+{
+	std::vector<std::string> names;
+	for (const auto& set : advertisingSets_)
+	{
+		if (!set.removed)
+		{
+			names.push_back(set.config.name);
+		}
+	}
+	return names;
+}
+
+std::vector<std::string> BluezAdapter::getOnAirAdvertisingSets() const
+{
+	std::vector<std::string> names;
+	for (const auto& set : advertisingSets_)
+	{
+		if (!set.removed && set.advertisement->isRegistered())
+		{
+			names.push_back(set.config.name);
+		}
+	}
+	return names;
+}
+
+BluezResult<void> BluezAdapter::setAdvertisingRotationSlice(uint32_t sliceMs)
+{
+	// Below a few hundred milliseconds the register/unregister round trips would eat most of the slice
+	if (sliceMs < 250)
+	{
+		return BluezResult<void>(BluezError::InvalidArgs, "Advertising rotation slice must be at least 250 ms");
+	}
+
+	advertisingRotationSliceMs_ = sliceMs;
+	if (isAdvertisingRotationActive())
+	{
+		stopAdvertisingRotation();
+		rotateAdvertisingSets();
+	}
+	return BluezResult<void>();
+}
+
+BluezAdapter::AdvertisingSetState* BluezAdapter::findAdvertisingSet(const std::string& name)
+{
+	for (auto& set : advertisingSets_)
+	{
+		if (!set.removed && set.config.name == name)
+		{
+			return &set;
+		}
+	}
+	return nullptr;
+}
+
+BluezAdapter::AdvertisingSetState* BluezAdapter::findAdvertisingSetByPath(const std::string& objectPath)
+{
+	for (auto& set : advertisingSets_)
+	{
+		if (set.advertisement->getObjectPath() == objectPath)
+		{
+			return &set;
+		}
+	}
+	return nullptr;
+}
+
+// Runs from the completion of the advertisement's own call, after which BluezAdvertisement no longer touches itself
+void BluezAdapter::releaseRetiredAdvertisement(const std::string& objectPath)
+{
+	std::erase_if(retiredAdvertisements_, [&objectPath](const std::unique_ptr<BluezAdvertisement>& advertisement) {
+		return advertisement->getObjectPath() == objectPath;
+	});
+}
+
+std::size_t BluezAdapter::advertisingSetCapacity() const
+{
+	// One instance stays reserved for the primary connectable advertisement
+	return capabilities.supportedAdvertisingInstances > 0 ? capabilities.supportedAdvertisingInstances - 1u : 0u;
+}
+
+void BluezAdapter::rotateAdvertisingSets()
+{
+	std::vector<AdvertisingSetState*> live;
+	for (auto& set : advertisingSets_)
+	{
+		if (!set.removed)
+		{
+			live.push_back(&set);
+		}
+	}
+
+	const std::size_t capacity = advertisingSetCapacity();
+	if (initialized && !live.empty() && capacity == 0)
+	{
+		Logger::warn(SSTR << "No free advertising instances for " << live.size() << " additional advertising set(s)");
+	}
+
+	std::vector<unsigned int> priorities;
+	std::vector<int64_t> credits;
+	for (const auto* set : live)
+	{
+		priorities.push_back(set->config.priority);
+		credits.push_back(set->rotationCredit);
+	}
+
+	const auto slice = detail::selectAdvertisingRotationSlice(priorities, credits, capacity);
+	for (std::size_t index = 0; index < live.size(); ++index)
+	{
+		live[index]->rotationCredit = credits[index];
+		live[index]->selected = std::binary_search(slice.begin(), slice.end(), index);
+	}
+
+	updateAdvertisingRotationTimer(live.size());
+	reconcileAdvertisingSets();
+}
+
+void BluezAdapter::updateAdvertisingRotationTimer(std::size_t liveSets)
+{
+	// Only keep a timer armed while there is something to rotate
+	const std::size_t capacity = advertisingSetCapacity();
+	const bool needsRotation = initialized && capacity > 0 && liveSets > capacity;
+	if (needsRotation && advertisingRotationTimerId_ == 0)
+	{
+		advertisingRotationTimerId_ = attachTimeoutSource(advertisingRotationSliceMs_, onAdvertisingRotationTimeout, this);
+		bluezLogger.log().op("AdvertisingRotation").result("Started")
+			.extra(std::to_string(liveSets) + " sets on " + std::to_string(capacity) + " instances, "
+				+ std::to_string(advertisingRotationSliceMs_) + " ms slices").info();
+	}
+	else if (!needsRotation)
+	{
+		stopAdvertisingRotation();
+	}
+}
+
+void BluezAdapter::reconcileAdvertisingSets()
+{
+	// Removed sets can go once BlueZ no longer references their objects
+	std::erase_if(advertisingSets_, [](const AdvertisingSetState& set) {
+		return set.removed && !set.pending && !set.advertisement->isRegistered();
+	});
+
+	if (!initialized || !dbusConnection)
+	{
+		return;
+	}
+
+	const std::size_t capacity = advertisingSetCapacity();
+	std::size_t occupied = 0;
+
+	// Release instances first so the sets entering this slice find them free
+	for (auto& set : advertisingSets_)
+	{
+		const bool registered = set.advertisement->isRegistered();
+		if (set.pending || (registered && set.selected && !set.restart))
+		{
+			++occupied;
+			continue;
+		}
+		if (!registered)
+		{
+			continue;
+		}
+
+		set.pending = true;
+		++occupied;
+		const std::string objectPath = set.advertisement->getObjectPath();
+		set.advertisement->unregisterAdvertisementAsync(dbusConnection.get(), adapterPath,
+			[this, objectPath](BluezResult<void> result) {
+				releaseRetiredAdvertisement(objectPath);
+				AdvertisingSetState* released = findAdvertisingSetByPath(objectPath);
+				if (released == nullptr)
+				{
+					return;
+				}
+				released->pending = false;
+				if (result.isSuccess())
+				{
+					released->restart = false;
+					reconcileAdvertisingSets();
+				}
+			});
+	}
+
+	for (auto& set : advertisingSets_)
+	{
+		if (occupied >= capacity)
+		{
+			break;
+		}
+		if (!set.selected || set.removed || set.pending || set.advertisement->isRegistered())
+		{
+			continue;
+		}
+
+		// A fresh registration already carries the latest type, UUIDs and includes
+		set.pending = true;
+		set.restart = false;
+		++occupied;
+		const std::string objectPath = set.advertisement->getObjectPath();
+		set.advertisement->registerAdvertisementAsync(dbusConnection.get(), adapterPath,
+			[this, objectPath](BluezResult<void> result) {
+				releaseRetiredAdvertisement(objectPath);
+				AdvertisingSetState* registered = findAdvertisingSetByPath(objectPath);
+				if (registered == nullptr)
+				{
+					return;
+				}
+				registered->pending = false;
+				if (result.isSuccess())
+				{
+					// The set may have left the rotation while the call was in flight
+					reconcileAdvertisingSets();
+				}
+			});
+	}
+}
+
+gboolean BluezAdapter::onAdvertisingRotationTimeout(gpointer user_data)
+{
+	auto* adapter = static_cast<BluezAdapter*>(user_data);
+	adapter->rotateAdvertisingSets();
+	return adapter->advertisingRotationTimerId_ != 0 ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+}
+
+void BluezAdapter::stopAdvertisingRotation()
+{
+	if (advertisingRotationTimerId_ != 0)
+	{
+		detachTimeoutSource(advertisingRotationTimerId_);
+		advertisingRotationTimerId_ = 0;
+	}
+}
+
+void BluezAdapter::prepareForSleep(std::function<void(BluezResult<void>)> callback)
+{
+	if (!initialized || adapterPath.empty())
+	{
+		if (callback) callback(BluezResult<void>(BluezError::NotReady, "BluezAdapter not initialized"));
+		return;
+	}
+
+	// The sleep inhibitor holds suspend off while this runs, so the property reads can be synchronous
+	SleepSnapshot snapshot;
+	snapshot.powered = readAdapterBoolean("Powered").value_or(false);
+	snapshot.discoverable = readAdapterBoolean("Discoverable");
+	snapshot.pairable = readAdapterBoolean("Pairable");
+	snapshot.advertising = isAdvertising();
+	snapshot.advertisingBurst = isAdvertisingBurstActive();
+	snapshot.advertisingSets = getOnAirAdvertisingSets();
+	sleepSnapshot_ = snapshot;
+
+	bluezLogger.log().op("PrepareForSleep").result("Snapshot")
+		.extra(std::string("powered=") + (snapshot.powered ? "1" : "0") + " advertising=" + (snapshot.advertising ? "1" : "0")
+			+ " sets=" + std::to_string(snapshot.advertisingSets.size())).info();
+
+	// Every unregister runs concurrently; the callback fires once the last one has settled
+	struct SleepFanIn {
+		int outstanding = 1;
+		BluezResult<void> result;
+		std::function<void(BluezResult<void>)> callback;
+	};
+	auto fanIn = std::make_shared<SleepFanIn>();
+	fanIn->callback = std::move(callback);
+	auto settle = [fanIn](BluezResult<void> result) {
+		if (result.hasError() && fanIn->result.isSuccess())
+		{
+			fanIn->result = result;
+		}
+		if (--fanIn->outstanding == 0 && fanIn->callback)
+		{
+			fanIn->callback(fanIn->result);
+		}
+	};
+
+	stopAdvertisingRotation();
+	for (auto& set : advertisingSets_)
+	{
+		set.selected = false;
+		if (set.pending || !set.advertisement->isRegistered())
+		{
+			continue;    // an in-flight registration is released by reconcileAdvertisingSets() when it lands
+		}
+
+		set.pending = true;
+		++fanIn->outstanding;
+		const std::string objectPath = set.advertisement->getObjectPath();
+		set.advertisement->unregisterAdvertisementAsync(dbusConnection.get(), adapterPath,
+			[this, objectPath, settle](BluezResult<void> result) {
+				releaseRetiredAdvertisement(objectPath);
+				if (AdvertisingSetState* released = findAdvertisingSetByPath(objectPath); released != nullptr)
+				{
+					released->pending = false;
+				}
+				settle(result);
+			});
+	}
+
+	if (snapshot.advertising)
+	{
+		++fanIn->outstanding;
+		setAdvertisingAsync(false, settle);
+	}
+
+	settle(BluezResult<void>());
+}
+
+void BluezAdapter::resumeFromSleep(std::chrono::steady_clock::time_point resumedAt, std::function<void(const ResumeReport&)> callback)
+{
+	auto tracker = std::make_shared<detail::ResumeRestoreTracker>(resumedAt, std::move(callback));
+	if (!initialized || adapterPath.empty() || !sleepSnapshot_)
+	{
+		tracker->seal();
+		return;
+	}
+
+	const SleepSnapshot snapshot = *sleepSnapshot_;
+	sleepSnapshot_.reset();
+
+	// Issue everything at once: BlueZ queues advertisement registrations until the controller is powered, so there is no
+	// need to wait for the Powered write (or to read it back first) before registering
+	auto restoreProperty = [this, tracker](const char* property, bool enabled) {
+		tracker->begin();
+		setAdapterPropertyAsync(property, g_variant_new_boolean(enabled), [tracker, property](BluezResult<void> result) {
+			tracker->finish(std::string("Set ") + property, result);
+		});
+	};
+	if (snapshot.powered)
+	{
+		restoreProperty("Powered", true);
+	}
+	if (snapshot.pairable.has_value())
+	{
+		restoreProperty("Pairable", *snapshot.pairable);
+	}
+	if (snapshot.discoverable.has_value())
+	{
+		restoreProperty("Discoverable", *snapshot.discoverable);
+	}
+
+	if (snapshot.advertising)
+	{
+		tracker->begin();
+		if (activeAdvertisingRetry && activeAdvertisingRetry->timeoutId > 0)
+		{
+			detachTimeoutSource(activeAdvertisingRetry->timeoutId);
+		}
+		activeAdvertisingRetry.reset();
+
+		if (!advertisement)
+		{
+			advertisement = std::make_unique<BluezAdvertisement>(currentAdvertisementPath(serviceNameContext_));
+		}
+		if (snapshot.advertisingBurst || (advertisingBurstPolicy_ && advertisingBurstPolicy_->burstOnStart))
+		{
+			(void)triggerAdvertisingBurst();
+		}
+		refreshAdvertisementPayload();
+
+		advertisement->registerAdvertisementAsync(dbusConnection.get(), adapterPath,
+			[this, tracker](BluezResult<void> result) {
+				if (result.isSuccess() || !(::bzp::isRetryableError(result.error()) || result.error() == BluezError::Timeout ||
+					result.error() == BluezError::Failed))
+				{
+					tracker->finish("RegisterAdvertisement", result, true);
+					return;
+				}
+
+				// The controller may still be coming back; retry on a short schedule rather than the cold-start backoff
+				bluezLogger.log().op("ResumeAdvertising").result("Retry").error(result.errorMessage()).warn();
+				scheduleAdvertisingRetry(true, RetryPolicy{6, 100, 1600, 2.0}, [tracker](BluezResult<void> retried) {
+					tracker->finish("RegisterAdvertisement", retried, true);
+				});
+			});
+	}
+
+	// Put the same sets back on air; rotation resumes from its saved credits
+	std::size_t liveSets = 0;
+	for (auto& set : advertisingSets_)
+	{
+		if (set.removed)
+		{
+			continue;
+		}
+		++liveSets;
+		set.selected = std::find(snapshot.advertisingSets.begin(), snapshot.advertisingSets.end(), set.config.name)
+			!= snapshot.advertisingSets.end();
+	}
+	updateAdvertisingRotationTimer(liveSets);
+	reconcileAdvertisingSets();
+
+	tracker->seal();
+}
+
 } // namespace bzp
@@ -23,6 +23,16 @@ static const gchar advertisement_introspection_xml[] =
     "    <property name='Type' type='s' access='read'/>"
     "    <property name='ServiceUUIDs' type='as' access='read'/>"
     "    <property name='Includes' type='as' access='read'/>"
+    "    <property name='ManufacturerData' type='a{qv}' access='read'/>"
+    "    <property name='ServiceData' type='a{sv}' access='read'/>"
+    "    <property name='ScanResponseServiceUUIDs' type='as' access='read'/>"
+    "    <property name='ScanResponseManufacturerData' type='a{qv}' access='read'/>"
+    "    <property name='ScanResponseServiceData' type='a{sv}' access='read'/>"
+    "    <property name='MinInterval' type='u' access='read'/>"
+    "    <property name='MaxInterval' type='u' access='read'/>"
+    "    <property name='TxPower' type='n' access='read'/>"
+    "    <property name='Duration' type='q' access='read'/>"
+    "    <property name='Timeout' type='q' access='read'/>"
     "  </interface>"
     "</node>";
 
@@ -33,10 +43,56 @@ static const GDBusInterfaceVTable advertisement_interface_vtable = {
     { nullptr }
 };
 
+namespace {
+
+GVariant* buildStringArray(const std::vector<std::string>& values)
+{
+    GVariantBuilder builder;
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("as"));
+
+    for (const auto& value : values)
+    {
+        g_variant_builder_add(&builder, "s", value.c_str());
+    }
+
+    return g_variant_builder_end(&builder);
+}
+
+GVariant* buildManufacturerData(const std::map<uint16_t, std::vector<uint8_t>>& manufacturerData)
+{
+    GVariantBuilder builder;
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{qv}"));
+
+    for (const auto& [companyId, payload] : manufacturerData)
+    {
+        GVariant* bytes = g_variant_new_fixed_array(G_VARIANT_TYPE_BYTE, payload.data(), payload.size(), sizeof(uint8_t));
+        g_variant_builder_add(&builder, "{qv}", companyId, bytes);
+    }
+
+    return g_variant_builder_end(&builder);
+}
+
+GVariant* buildServiceData(const std::map<std::string, std::vector<uint8_t>>& serviceData)
+{
+    GVariantBuilder builder;
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+
+    for (const auto& [uuid, payload] : serviceData)
+    {
+        GVariant* bytes = g_variant_new_fixed_array(G_VARIANT_TYPE_BYTE, payload.data(), payload.size(), sizeof(uint8_t));
+        g_variant_builder_add(&builder, "{sv}", uuid.c_str(), bytes);
+    }
+
+    return g_variant_builder_end(&builder);
+}
+
+} // namespace
+
 BluezAdvertisement::BluezAdvertisement(const std::string& objectPath)
     : objectPath_(objectPath)
     , advertisementType_("peripheral")
     , includeTxPower_(true)
+    , includeLocalName_(true)
     , registered_(false)
     , exported_(false)
     , connection_(nullptr)
@@ -54,7 +110,13 @@ BluezAdvertisement::~BluezAdvertisement()
 
 void BluezAdvertisement::setServiceUUIDs(const std::vector<std::string>& uuids)
 {
+    if (uuids == serviceUUIDs_)
+    {
+        return;
+    }
+
     serviceUUIDs_ = uuids;
+    emitPropertyChanged("ServiceUUIDs", getServiceUUIDs());
     bluezLogger.log().op("SetServiceUUIDs").extra(std::to_string(uuids.size()) + " UUIDs").result("Success").info();
 }
 
@@ -70,6 +132,145 @@ void BluezAdvertisement::setIncludeTxPower(bool include)
     bluezLogger.log().op("SetIncludeTxPower").extra(include ? "true" : "false").result("Success").info();
 }
 
+void BluezAdvertisement::setIncludeLocalName(bool include)
+{
+    includeLocalName_ = include;
+    bluezLogger.log().op("SetIncludeLocalName").extra(include ? "true" : "false").result("Success").info();
+}
+
+void BluezAdvertisement::setAdvertisingData(const AdvertisingData& data)
+{
+    const bool manufacturerDataChanged = data.manufacturerData != advertisingData_.manufacturerData;
+    const bool serviceDataChanged = data.serviceData != advertisingData_.serviceData;
+    if (!manufacturerDataChanged && !serviceDataChanged)
+    {
+        return;
+    }
+
+    advertisingData_ = data;
+
+    if (manufacturerDataChanged)
+    {
+        emitPropertyChanged("ManufacturerData", getManufacturerData());
+    }
+    if (serviceDataChanged)
+    {
+        emitPropertyChanged("ServiceData", getServiceData());
+    }
+
+    bluezLogger.log().op("SetAdvertisingData").path(objectPath_)
+        .extra(std::to_string(data.manufacturerData.size()) + " manufacturer, "
+            + std::to_string(data.serviceData.size()) + " service entries")
+        .result(exported_ ? "Updated" : "Stored").debug();
+}
+
+void BluezAdvertisement::setScanResponse(const std::vector<std::string>& serviceUUIDs, const AdvertisingData& data)
+{
+    const bool uuidsChanged = serviceUUIDs != scanResponseServiceUUIDs_;
+    const bool manufacturerDataChanged = data.manufacturerData != scanResponseData_.manufacturerData;
+    const bool serviceDataChanged = data.serviceData != scanResponseData_.serviceData;
+    if (!uuidsChanged && !manufacturerDataChanged && !serviceDataChanged)
+    {
+        return;
+    }
+
+    scanResponseServiceUUIDs_ = serviceUUIDs;
+    scanResponseData_ = data;
+
+    if (uuidsChanged)
+    {
+        emitPropertyChanged("ScanResponseServiceUUIDs", getScanResponseServiceUUIDs());
+    }
+    if (manufacturerDataChanged)
+    {
+        emitPropertyChanged("ScanResponseManufacturerData", getScanResponseManufacturerData());
+    }
+    if (serviceDataChanged)
+    {
+        emitPropertyChanged("ScanResponseServiceData", getScanResponseServiceData());
+    }
+
+    bluezLogger.log().op("SetScanResponse").path(objectPath_)
+        .extra(std::to_string(serviceUUIDs.size()) + " UUIDs, " + std::to_string(data.manufacturerData.size()) + " manufacturer, "
+            + std::to_string(data.serviceData.size()) + " service entries")
+        .result(exported_ ? "Updated" : "Stored").debug();
+}
+
+void BluezAdvertisement::setAdvertisingParameters(const AdvertisingParameters& parameters)
+{
+    if (parameters == parameters_)
+    {
+        return;
+    }
+
+    const AdvertisingParameters previous = parameters_;
+    parameters_ = parameters;
+
+    if (parameters.minIntervalMs != previous.minIntervalMs)
+    {
+        emitPropertyChanged("MinInterval", getMinInterval());
+    }
+    if (parameters.maxIntervalMs != previous.maxIntervalMs)
+    {
+        emitPropertyChanged("MaxInterval", getMaxInterval());
+    }
+    if (parameters.txPower != previous.txPower)
+    {
+        emitPropertyChanged("TxPower", getTxPower());
+    }
+    if (parameters.durationSeconds != previous.durationSeconds)
+    {
+        emitPropertyChanged("Duration", getDuration());
+    }
+    if (parameters.timeoutSeconds != previous.timeoutSeconds)
+    {
+        emitPropertyChanged("Timeout", getTimeout());
+    }
+
+    bluezLogger.log().op("SetAdvertisingParameters").path(objectPath_)
+        .extra("interval " + std::to_string(parameters.minIntervalMs) + "-" + std::to_string(parameters.maxIntervalMs) + " ms")
+        .result(exported_ ? "Updated" : "Stored").debug();
+}
+
+void BluezAdvertisement::emitPropertyChanged(const char* propertyName, GVariant* value)
+{
+    // Sink the floating reference so the value is released even when nothing is exported
+    auto ownedValue = make_gvariant(value != nullptr ? g_variant_ref_sink(value) : nullptr);
+    if (!exported_ || connection_ == nullptr)
+    {
+        return;
+    }
+
+    GVariantBuilder changed;
+    g_variant_builder_init(&changed, G_VARIANT_TYPE("a{sv}"));
+    GVariantBuilder invalidated;
+    g_variant_builder_init(&invalidated, G_VARIANT_TYPE("as"));
+    if (ownedValue)
+    {
+        g_variant_builder_add(&changed, "{sv}", propertyName, ownedValue.get());
+    }
+    else
+    {
+        g_variant_builder_add(&invalidated, "s", propertyName);
+    }
+
+    GError* rawError = nullptr;
+    g_dbus_connection_emit_signal(
+        connection_,
+        nullptr,  // broadcast to BlueZ, which watches this object since registration
+        objectPath_.c_str(),
+        "org.freedesktop.DBus.Properties",
+        "PropertiesChanged",
+        g_variant_new("(sa{sv}as)", ADVERTISEMENT_INTERFACE, &changed, &invalidated),
+        &rawError);
+    auto error = make_error(rawError);
+
+    if (error.get())
+    {
+        bluezLogger.log().op("PropertiesChanged").path(objectPath_).prop(propertyName).result("Failed").error(error.get()->message).warn();
+    }
+}
+
 BluezResult<void> BluezAdvertisement::exportToDBus(GDBusConnection* connection)
 {
     if (exported_)
@@ -384,23 +585,68 @@ GVariant* BluezAdvertisement::onGetProperty(GDBusConnection* connection,
     (void)sender;
     (void)object_path;
     (void)interface_name;
-    (void)error;
 
+    GVariant* value = nullptr;
     if (strcmp(property_name, "Type") == 0)
     {
-        return advertisement->getType();
+        value = advertisement->getType();
     }
     else if (strcmp(property_name, "ServiceUUIDs") == 0)
     {
-        return advertisement->getServiceUUIDs();
+        value = advertisement->getServiceUUIDs();
     }
     // LocalName property removed - name is included via Includes=["local-name"]
     else if (strcmp(property_name, "Includes") == 0)
     {
-        return advertisement->getIncludes();
+        value = advertisement->getIncludes();
+    }
+    else if (strcmp(property_name, "ManufacturerData") == 0)
+    {
+        value = advertisement->getManufacturerData();
+    }
+    else if (strcmp(property_name, "ServiceData") == 0)
+    {
+        value = advertisement->getServiceData();
+    }
+    else if (strcmp(property_name, "ScanResponseServiceUUIDs") == 0)
+    {
+        value = advertisement->getScanResponseServiceUUIDs();
+    }
+    else if (strcmp(property_name, "ScanResponseManufacturerData") == 0)
+    {
+        value = advertisement->getScanResponseManufacturerData();
+    }
+    else if (strcmp(property_name, "ScanResponseServiceData") == 0)
+    {
+        value = advertisement->getScanResponseServiceData();
+    }
+    else if (strcmp(property_name, "MinInterval") == 0)
+    {
+        value = advertisement->getMinInterval();
+    }
+    else if (strcmp(property_name, "MaxInterval") == 0)
+    {
+        value = advertisement->getMaxInterval();
+    }
+    else if (strcmp(property_name, "TxPower") == 0)
+    {
+        value = advertisement->getTxPower();
+    }
+    else if (strcmp(property_name, "Duration") == 0)
+    {
+        value = advertisement->getDuration();
+    }
+    else if (strcmp(property_name, "Timeout") == 0)
+    {
+        value = advertisement->getTimeout();
     }
 
-    return nullptr;
+    // Unset optional properties are left out of GetAll so BlueZ applies its own defaults
+    if (value == nullptr)
+    {
+        g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "Property '%s' is not set", property_name);
+    }
+    return value;
 }
 
 // D-Bus property setter (not used for LEAdvertisement1, but required)
@@ -436,15 +682,7 @@ GVariant* BluezAdvertisement::getType() const
 
 GVariant* BluezAdvertisement::getServiceUUIDs() const
 {
-    GVariantBuilder builder;
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("as"));
-
-    for (const auto& uuid : serviceUUIDs_)
-    {
-        g_variant_builder_add(&builder, "s", uuid.c_str());
-    }
-
-    return g_variant_builder_end(&builder);
+    return buildStringArray(serviceUUIDs_);
 }
 
 // getLocalName method removed - name included via Includes=["local-name"]
@@ -454,8 +692,11 @@ GVariant* BluezAdvertisement::getIncludes() const
     GVariantBuilder builder;
     g_variant_builder_init(&builder, G_VARIANT_TYPE("as"));
 
-    // Always include local-name so the adapter's Alias appears in advertising
-    g_variant_builder_add(&builder, "s", "local-name");
+    // Include local-name so the adapter's Alias appears in advertising
+    if (includeLocalName_)
+    {
+        g_variant_builder_add(&builder, "s", "local-name");
+    }
 
     if (includeTxPower_)
     {
@@ -465,4 +706,54 @@ GVariant* BluezAdvertisement::getIncludes() const
     return g_variant_builder_end(&builder);
 }
 
+GVariant* BluezAdvertisement::getManufacturerData() const
+{
+    return buildManufacturerData(advertisingData_.manufacturerData);
+}
+
+GVariant* BluezAdvertisement::getServiceData() const
+{
+    return buildServiceData(advertisingData_.serviceData);
+}
+
+GVariant* BluezAdvertisement::getScanResponseServiceUUIDs() const
+{
+    return scanResponseServiceUUIDs_.empty() ? nullptr : buildStringArray(scanResponseServiceUUIDs_);
+}
+
+GVariant* BluezAdvertisement::getScanResponseManufacturerData() const
+{
+    return scanResponseData_.manufacturerData.empty() ? nullptr : buildManufacturerData(scanResponseData_.manufacturerData);
+}
+
+GVariant* BluezAdvertisement::getScanResponseServiceData() const
+{
+    return scanResponseData_.serviceData.empty() ? nullptr : buildServiceData(scanResponseData_.serviceData);
+}
+
+GVariant* BluezAdvertisement::getMinInterval() const
+{
+    return parameters_.minIntervalMs != 0 ? g_variant_new_uint32(parameters_.minIntervalMs) : nullptr;
+}
+
+GVariant* BluezAdvertisement::getMaxInterval() const
+{
+    return parameters_.maxIntervalMs != 0 ? g_variant_new_uint32(parameters_.maxIntervalMs) : nullptr;
+}
+
+GVariant* BluezAdvertisement::getTxPower() const
+{
+    return parameters_.txPower ? g_variant_new_int16(*parameters_.txPower) : nullptr;
+}
+
+GVariant* BluezAdvertisement::getDuration() const
+{
+    return parameters_.durationSeconds != 0 ? g_variant_new_uint16(parameters_.durationSeconds) : nullptr;
+}
+
+GVariant* BluezAdvertisement::getTimeout() const
+{
+    return parameters_.timeoutSeconds != 0 ? g_variant_new_uint16(parameters_.timeoutSeconds) : nullptr;
+}
+
 } // namespace bzp
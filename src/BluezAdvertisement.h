@@ -26,6 +26,19 @@ public:
     void setServiceUUIDs(const std::vector<std::string>& uuids);
     void setAdvertisementType(const std::string& type = "peripheral"); // "peripheral" or "broadcast"
     void setIncludeTxPower(bool include);
+    void setIncludeLocalName(bool include); // on by default; beacons usually need the space for payload
+
+    // Connectionless payload; when the object is exported, changes are pushed to BlueZ with PropertiesChanged
+    // so the running advertisement is updated in place without re-registering
+    void setAdvertisingData(const AdvertisingData& data);
+    const AdvertisingData& getAdvertisingData() const { return advertisingData_; }
+
+    // Structures that did not fit the advertising data (BlueZ ScanResponse* properties); empty values are not exported
+    void setScanResponse(const std::vector<std::string>& serviceUUIDs, const AdvertisingData& data);
+
+    // Interval, TX power, duration and timeout; updated in place the same way as the payload
+    void setAdvertisingParameters(const AdvertisingParameters& parameters);
+    const AdvertisingParameters& getAdvertisingParameters() const { return parameters_; }
 
     // Register/unregister advertisement with BlueZ
     BluezResult<void> registerAdvertisement(GDBusConnection* connection, const std::string& adapterPath);
@@ -88,12 +101,30 @@ private:
     GVariant* getServiceUUIDs() const;
     // getLocalName removed - name included via Includes=["local-name"]
     GVariant* getIncludes() const;
+    GVariant* getManufacturerData() const;
+    GVariant* getServiceData() const;
+    GVariant* getScanResponseServiceUUIDs() const;
+    GVariant* getScanResponseManufacturerData() const;
+    GVariant* getScanResponseServiceData() const;
+    GVariant* getMinInterval() const;
+    GVariant* getMaxInterval() const;
+    GVariant* getTxPower() const;
+    GVariant* getDuration() const;
+    GVariant* getTimeout() const;
+
+    // A null value reports the property as invalidated so BlueZ falls back to its default
+    void emitPropertyChanged(const char* propertyName, GVariant* value);
 
     std::string objectPath_;
     // localName_ removed - name included via Includes=["local-name"]
     std::vector<std::string> serviceUUIDs_;
     std::string advertisementType_;
+    AdvertisingData advertisingData_;
+    std::vector<std::string> scanResponseServiceUUIDs_;
+    AdvertisingData scanResponseData_;
+    AdvertisingParameters parameters_;
     bool includeTxPower_;
+    bool includeLocalName_;
     bool registered_;
     bool exported_;
 
@@ -17,6 +17,7 @@
 #include <cctype>
 #include <string_view>
 #include <unordered_set>
+#include <utility>
 
 namespace bzp::detail {
 
@@ -24,6 +25,18 @@ namespace {
 
 constexpr std::string_view kBluetoothBaseUuidSuffix = "-0000-1000-8000-00805f9b34fb";
 
+// Each AD structure carries a length byte and a type byte ahead of its payload
+constexpr std::size_t kAdStructureHeaderLength = 2;
+constexpr std::size_t kFlagsStructureLength = kAdStructureHeaderLength + 1;
+constexpr std::size_t kTxPowerStructureLength = kAdStructureHeaderLength + 1;
+constexpr std::size_t kCompanyIdLength = 2;
+constexpr std::size_t kLegacyAdvertisingDataLength = 31;
+
+constexpr uint32_t kMinAdvertisingIntervalMs = 20;
+constexpr uint32_t kMaxAdvertisingIntervalMs = 10485759;
+constexpr int16_t kMinAdvertisingTxPower = -127;
+constexpr int16_t kMaxAdvertisingTxPower = 20;
+
 std::string toLower(std::string value)
 {
 	std::transform(value.begin(), value.end(), value.begin(), [](unsigned char ch) {
@@ -59,6 +72,58 @@ std::string shortenUuidForLegacyAdvertising(const std::string& normalizedUuid)
 	return normalizedUuid.substr(0, 8);
 }
 
+BluezResult<void> validateIntervalRange(uint32_t minIntervalMs, uint32_t maxIntervalMs, const char* label)
+{
+	if (minIntervalMs < kMinAdvertisingIntervalMs || maxIntervalMs > kMaxAdvertisingIntervalMs || minIntervalMs > maxIntervalMs)
+	{
+		return BluezResult<void>(BluezError::InvalidArgs,
+			std::string(label) + " advertising interval " + std::to_string(minIntervalMs) + "-" + std::to_string(maxIntervalMs)
+			+ " ms is outside " + std::to_string(kMinAdvertisingIntervalMs) + "-" + std::to_string(kMaxAdvertisingIntervalMs) + " ms");
+	}
+
+	return BluezResult<void>();
+}
+
+std::size_t advertisedUuidLength(const std::string& uuid)
+{
+	switch (uuid.size())
+	{
+		case 4:
+			return 2;
+		case 8:
+			return 4;
+		default:
+			return 16;
+	}
+}
+
+std::size_t uuidWidthIndex(std::size_t uuidLength)
+{
+	return uuidLength == 2 ? 0 : (uuidLength == 4 ? 1 : 2);
+}
+
+std::string formatCompanyId(uint16_t companyId)
+{
+	static constexpr char kHexDigits[] = "0123456789abcdef";
+	std::string formatted = "0x";
+	for (int shift = 12; shift >= 0; shift -= 4)
+	{
+		formatted += kHexDigits[(companyId >> shift) & 0xF];
+	}
+	return formatted;
+}
+
+// Running byte count of one PDU, including which UUID list structures it already opened
+struct PackSection
+{
+	std::size_t limit = 0;
+	std::size_t used = 0;
+	bool hasUuidList[3] = {};
+
+	std::size_t remaining() const { return limit - used; }
+	bool fits(std::size_t length) const { return length <= remaining(); }
+};
+
 void collectGattServiceUUIDsFromObject(
 	const DBusObject& object,
 	std::vector<std::string>& uuids,
@@ -117,28 +182,432 @@ std::vector<std::string> collectGattServiceUUIDs(const Server& server)
 	return uuids;
 }
 
-std::vector<std::string> selectAdvertisementServiceUUIDs(
+std::string normalizeAdvertisingServiceDataUuid(const std::string& uuid)
+{
+	const std::string normalized = normalizeUuid128(uuid);
+	if (normalized.empty())
+	{
+		return {};
+	}
+
+	const std::string shortened = shortenUuidForLegacyAdvertising(normalized);
+	return shortened.empty() ? normalized : shortened;
+}
+
+bool AdvertisingPack::complete() const
+{
+	return std::none_of(items.begin(), items.end(), [](const AdvertisingPackItem& item) {
+		return item.placement == AdvertisingPlacement::Dropped && item.label.rfind("local-name", 0) != 0;
+	});
+}
+
+std::string AdvertisingPack::report() const
+{
+	std::string advertising;
+	std::string scanResponse;
+	std::string dropped;
+	for (const auto& item : items)
+	{
+		std::string& target = item.placement == AdvertisingPlacement::AdvertisingData ? advertising
+			: (item.placement == AdvertisingPlacement::ScanResponse ? scanResponse : dropped);
+		target += " " + item.label + "(" + std::to_string(item.length) + ")";
+	}
+
+	std::string summary = "adv " + std::to_string(advertisingDataLength) + "/" + std::to_string(advertisingDataLimit) + ":"
+		+ (advertising.empty() ? " -" : advertising)
+		+ "; scan-rsp " + std::to_string(scanResponseLength) + "/" + std::to_string(scanResponseLimit) + ":"
+		+ (scanResponse.empty() ? " -" : scanResponse);
+	if (!dropped.empty())
+	{
+		summary += "; dropped:" + dropped;
+	}
+	return summary;
+}
+
+AdvertisingPack packAdvertisingPayload(const AdvertisingPackInput& input, const BluezCapabilities& capabilities)
+{
+	AdvertisingPack pack;
+	const bool extended = canUseExtendedAdvertising(capabilities);
+	pack.advertisingDataLimit = extended
+		? capabilities.maxAdvertisingDataLength
+		: std::min<std::size_t>(capabilities.maxAdvertisingDataLength, kLegacyAdvertisingDataLength);
+	pack.scanResponseLimit = extended
+		? capabilities.maxScanResponseLength
+		: std::min<std::size_t>(capabilities.maxScanResponseLength, kLegacyAdvertisingDataLength);
+
+	PackSection advertising{pack.advertisingDataLimit};
+	PackSection scanResponse{pack.scanResponseLimit};
+
+	// Places a structure in the first PDU with room for it; `cost` may depend on the PDU (UUID list headers)
+	const auto place = [&](std::string label, const auto& cost, bool allowScanResponse) {
+		AdvertisingPackItem item{std::move(label), cost(advertising), AdvertisingPlacement::Dropped};
+		if (advertising.fits(item.length))
+		{
+			advertising.used += item.length;
+			item.placement = AdvertisingPlacement::AdvertisingData;
+		}
+		else if (allowScanResponse && scanResponse.fits(cost(scanResponse)))
+		{
+			item.length = cost(scanResponse);
+			scanResponse.used += item.length;
+			item.placement = AdvertisingPlacement::ScanResponse;
+		}
+		pack.items.push_back(item);
+		return item.placement;
+	};
+
+	// The kernel always prepends Flags to advertising data
+	place("flags", [](const PackSection&) { return kFlagsStructureLength; }, false);
+
+	std::unordered_set<std::string> seenUuids;
+	for (const auto& uuid : input.serviceUUIDs)
+	{
+		const std::string shortened = normalizeAdvertisingServiceDataUuid(uuid);
+		if (shortened.empty() || !seenUuids.insert(shortened).second)
+		{
+			continue;
+		}
+
+		const std::size_t uuidLength = advertisedUuidLength(shortened);
+		const std::size_t width = uuidWidthIndex(uuidLength);
+		const auto cost = [&](const PackSection& section) {
+			return uuidLength + (section.hasUuidList[width] ? 0 : kAdStructureHeaderLength);
+		};
+		switch (place("uuid" + std::to_string(uuidLength * 8) + ":" + shortened, cost, true))
+		{
+			case AdvertisingPlacement::AdvertisingData:
+				advertising.hasUuidList[width] = true;
+				pack.serviceUUIDs.push_back(shortened);
+				break;
+			case AdvertisingPlacement::ScanResponse:
+				scanResponse.hasUuidList[width] = true;
+				pack.scanResponseServiceUUIDs.push_back(shortened);
+				break;
+			case AdvertisingPlacement::Dropped:
+				break;
+		}
+	}
+
+	for (const auto& [uuid, payload] : input.data.serviceData)
+	{
+		const std::size_t length = kAdStructureHeaderLength + advertisedUuidLength(uuid) + payload.size();
+		switch (place("service-data:" + uuid, [length](const PackSection&) { return length; }, true))
+		{
+			case AdvertisingPlacement::AdvertisingData:
+				pack.data.serviceData[uuid] = payload;
+				break;
+			case AdvertisingPlacement::ScanResponse:
+				pack.scanResponseData.serviceData[uuid] = payload;
+				break;
+			case AdvertisingPlacement::Dropped:
+				break;
+		}
+	}
+
+	for (const auto& [companyId, payload] : input.data.manufacturerData)
+	{
+		const std::size_t length = kAdStructureHeaderLength + kCompanyIdLength + payload.size();
+		switch (place("manufacturer-data:" + formatCompanyId(companyId), [length](const PackSection&) { return length; }, true))
+		{
+			case AdvertisingPlacement::AdvertisingData:
+				pack.data.manufacturerData[companyId] = payload;
+				break;
+			case AdvertisingPlacement::ScanResponse:
+				pack.scanResponseData.manufacturerData[companyId] = payload;
+				break;
+			case AdvertisingPlacement::Dropped:
+				break;
+		}
+	}
+
+	if (input.includeTxPower)
+	{
+		pack.includeTxPower = place("tx-power", [](const PackSection&) { return kTxPowerStructureLength; }, false)
+			== AdvertisingPlacement::AdvertisingData;
+	}
+
+	// The kernel shortens the name to whatever the scan response has left
+	if (input.includeLocalName)
+	{
+		const std::size_t wanted = input.localName.empty()
+			? scanResponse.remaining()
+			: kAdStructureHeaderLength + input.localName.size();
+		AdvertisingPackItem item{"local-name", std::min(wanted, scanResponse.remaining()), AdvertisingPlacement::Dropped};
+		if (item.length > kAdStructureHeaderLength)
+		{
+			item.placement = AdvertisingPlacement::ScanResponse;
+			if (item.length < wanted)
+			{
+				item.label = "local-name-shortened";
+			}
+			scanResponse.used += item.length;
+		}
+		else
+		{
+			item.length = wanted;
+		}
+		pack.items.push_back(item);
+	}
+
+	pack.advertisingDataLength = advertising.used;
+	pack.scanResponseLength = scanResponse.used;
+	return pack;
+}
+
+std::size_t estimateAdvertisingPayloadLength(
 	const std::vector<std::string>& serviceUUIDs,
+	const AdvertisingData& data,
+	bool includeTxPower)
+{
+	std::size_t length = kFlagsStructureLength;
+
+	// Service UUIDs are grouped into one list structure per UUID width
+	std::size_t uuidBytesByWidth[3] = {};
+	for (const auto& uuid : serviceUUIDs)
+	{
+		const std::size_t uuidLength = advertisedUuidLength(uuid);
+		uuidBytesByWidth[uuidLength == 2 ? 0 : (uuidLength == 4 ? 1 : 2)] += uuidLength;
+	}
+	for (const std::size_t uuidBytes : uuidBytesByWidth)
+	{
+		if (uuidBytes > 0)
+		{
+			length += kAdStructureHeaderLength + uuidBytes;
+		}
+	}
+
+	for (const auto& [companyId, payload] : data.manufacturerData)
+	{
+		(void)companyId;
+		length += kAdStructureHeaderLength + kCompanyIdLength + payload.size();
+	}
+
+	for (const auto& [uuid, payload] : data.serviceData)
+	{
+		length += kAdStructureHeaderLength + advertisedUuidLength(uuid) + payload.size();
+	}
+
+	if (includeTxPower)
+	{
+		length += kTxPowerStructureLength;
+	}
+
+	return length;
+}
+
+BluezResult<void> checkAdvertisingPayloadBudget(
+	const std::vector<std::string>& serviceUUIDs,
+	const AdvertisingData& data,
+	bool includeTxPower,
 	const BluezCapabilities& capabilities)
 {
-	if (canUseExtendedAdvertising(capabilities))
+	AdvertisingPackInput input;
+	input.serviceUUIDs = serviceUUIDs;
+	input.data = data;
+	input.includeTxPower = includeTxPower;
+
+	const AdvertisingPack pack = packAdvertisingPayload(input, capabilities);
+	if (!pack.complete())
 	{
-		return serviceUUIDs;
+		return BluezResult<void>(BluezError::PayloadTooLarge, "Advertising payload does not fit the controller budget (" + pack.report() + ")");
 	}
 
-	std::vector<std::string> selected;
-	std::unordered_set<std::string> seen;
+	return BluezResult<void>();
+}
 
-	for (const auto& uuid : serviceUUIDs)
+BluezResult<void> validateAdvertisingParameters(const AdvertisingParameters& parameters)
+{
+	if (parameters.minIntervalMs != 0 || parameters.maxIntervalMs != 0)
+	{
+		if (auto result = validateIntervalRange(parameters.minIntervalMs, parameters.maxIntervalMs, "Requested"); result.hasError())
+		{
+			return result;
+		}
+	}
+
+	if (parameters.txPower && (*parameters.txPower < kMinAdvertisingTxPower || *parameters.txPower > kMaxAdvertisingTxPower))
+	{
+		return BluezResult<void>(BluezError::InvalidArgs,
+			"Advertising TX power " + std::to_string(*parameters.txPower) + " dBm is outside -127..20 dBm");
+	}
+
+	return BluezResult<void>();
+}
+
+BluezResult<void> validateAdvertisingBurstPolicy(const AdvertisingBurstPolicy& policy)
+{
+	if (auto result = validateIntervalRange(policy.burstMinIntervalMs, policy.burstMaxIntervalMs, "Burst"); result.hasError())
+	{
+		return result;
+	}
+
+	if (auto result = validateIntervalRange(policy.relaxedMinIntervalMs, policy.relaxedMaxIntervalMs, "Relaxed"); result.hasError())
+	{
+		return result;
+	}
+
+	if (policy.burstDurationMs == 0)
 	{
-		const std::string shortened = shortenUuidForLegacyAdvertising(uuid);
-		if (!shortened.empty() && seen.insert(shortened).second)
+		return BluezResult<void>(BluezError::InvalidArgs, "Advertising burst duration must be non-zero");
+	}
+
+	return BluezResult<void>();
+}
+
+BluezResult<AdvertisingSetConfig> normalizeAdvertisingSetConfig(
+	const AdvertisingSetConfig& config,
+	const BluezCapabilities& capabilities)
+{
+	if (config.name.empty())
+	{
+		return BluezResult<AdvertisingSetConfig>(BluezError::InvalidArgs, "Advertising set name must not be empty");
+	}
+
+	if (config.type != "broadcast" && config.type != "peripheral")
+	{
+		return BluezResult<AdvertisingSetConfig>(BluezError::InvalidArgs,
+			"Advertising set type must be 'broadcast' or 'peripheral', got '" + config.type + "'");
+	}
+
+	if (auto result = validateAdvertisingParameters(config.parameters); result.hasError())
+	{
+		return BluezResult<AdvertisingSetConfig>(result.error(), result.errorMessage());
+	}
+
+	AdvertisingSetConfig normalized = config;
+	normalized.data.serviceData.clear();
+	for (const auto& [uuid, payload] : config.data.serviceData)
+	{
+		const std::string key = normalizeAdvertisingServiceDataUuid(uuid);
+		if (key.empty())
 		{
-			selected.push_back(shortened);
+			return BluezResult<AdvertisingSetConfig>(BluezError::InvalidArgs, "Invalid service data UUID: " + uuid);
 		}
+		normalized.data.serviceData[key] = payload;
+	}
+
+	if (auto result = checkAdvertisingPayloadBudget(normalized.serviceUUIDs, normalized.data, false, capabilities); result.hasError())
+	{
+		return BluezResult<AdvertisingSetConfig>(result.error(), result.errorMessage());
 	}
 
+	return BluezResult<AdvertisingSetConfig>(std::move(normalized));
+}
+
+std::vector<std::size_t> selectAdvertisingRotationSlice(
+	const std::vector<unsigned int>& priorities,
+	std::vector<int64_t>& credits,
+	std::size_t capacity)
+{
+	credits.resize(priorities.size(), 0);
+
+	std::vector<std::size_t> selected;
+	if (priorities.size() <= capacity)
+	{
+		for (std::size_t index = 0; index < priorities.size(); ++index)
+		{
+			selected.push_back(index);
+		}
+		return selected;
+	}
+
+	if (capacity == 0)
+	{
+		return selected;
+	}
+
+	// Every slice hands out `capacity` slots, so weights are scaled by it and each pick costs the total weight
+	int64_t totalWeight = 0;
+	for (std::size_t index = 0; index < priorities.size(); ++index)
+	{
+		const int64_t weight = std::max(1u, priorities[index]);
+		totalWeight += weight;
+		credits[index] += weight * static_cast<int64_t>(capacity);
+	}
+
+	std::vector<bool> picked(priorities.size(), false);
+	for (std::size_t slot = 0; slot < capacity; ++slot)
+	{
+		std::size_t best = priorities.size();
+		for (std::size_t index = 0; index < priorities.size(); ++index)
+		{
+			if (!picked[index] && (best == priorities.size() || credits[index] > credits[best]))
+			{
+				best = index;
+			}
+		}
+		picked[best] = true;
+		credits[best] -= totalWeight;
+		selected.push_back(best);
+	}
+
+	// A set whose share exceeds one instance is on air every slice; keep its surplus from piling up
+	for (auto& credit : credits)
+	{
+		credit = std::clamp(credit, -totalWeight, totalWeight);
+	}
+
+	std::sort(selected.begin(), selected.end());
 	return selected;
 }
 
+ResumeRestoreTracker::ResumeRestoreTracker(Clock::time_point resumedAt, std::function<void(const ResumeReport&)> completion)
+	: resumedAt_(resumedAt), completion_(std::move(completion))
+{
+}
+
+void ResumeRestoreTracker::begin()
+{
+	++outstanding_;
+	++report_.restoreCalls;
+}
+
+void ResumeRestoreTracker::finish(const std::string& call, const BluezResult<void>& result, bool primaryAdvertisement,
+	Clock::time_point now)
+{
+	if (outstanding_ == 0)
+	{
+		return;
+	}
+	--outstanding_;
+
+	const int64_t elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - resumedAt_).count();
+	if (result.hasError())
+	{
+		++report_.failedCalls;
+		if (report_.firstError.empty())
+		{
+			report_.firstError = call + ": " + result.errorMessage();
+		}
+	}
+	else if (primaryAdvertisement)
+	{
+		report_.advertisingRestored = true;
+		report_.timeToAdvertiseMs = elapsedMs;
+	}
+
+	completeIfSettled(now);
+}
+
+void ResumeRestoreTracker::seal(Clock::time_point now)
+{
+	sealed_ = true;
+	completeIfSettled(now);
+}
+
+void ResumeRestoreTracker::completeIfSettled(Clock::time_point now)
+{
+	if (!sealed_ || outstanding_ != 0 || completed_)
+	{
+		return;
+	}
+
+	completed_ = true;
+	report_.totalMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - resumedAt_).count();
+	if (completion_)
+	{
+		completion_(report_);
+	}
+}
+
 } // namespace bzp::detail
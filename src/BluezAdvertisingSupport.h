@@ -6,6 +6,10 @@
 #pragma once
 
 #include <bzp/BluezTypes.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -17,10 +21,120 @@ namespace detail {
 
 [[nodiscard]] bool canUseExtendedAdvertising(const BluezCapabilities& capabilities) noexcept;
 [[nodiscard]] std::vector<std::string> collectGattServiceUUIDs(const Server& server);
-[[nodiscard]] std::vector<std::string> selectAdvertisementServiceUUIDs(
+
+// Service data keys are stored in their shortest advertisable form ("180f" rather than the 128-bit base UUID).
+// Returns an empty string when the UUID cannot be parsed.
+[[nodiscard]] std::string normalizeAdvertisingServiceDataUuid(const std::string& uuid);
+
+// Where the packer put an AD structure
+enum class AdvertisingPlacement
+{
+	AdvertisingData,
+	ScanResponse,
+	Dropped
+};
+
+struct AdvertisingPackItem
+{
+	std::string label;        // e.g. "flags", "uuid16:180f", "service-data:feaa", "manufacturer-data:0x0059"
+	std::size_t length = 0;   // bytes on air, including the AD header of the UUID list it opened
+	AdvertisingPlacement placement = AdvertisingPlacement::Dropped;
+};
+
+struct AdvertisingPackInput
+{
+	std::vector<std::string> serviceUUIDs;   // any UUID form, most important first
+	AdvertisingData data;
+	bool includeTxPower = false;
+	bool includeLocalName = false;
+	std::string localName;                   // empty: the kernel fills whatever scan response space is left
+};
+
+// Exact AD structure layout for one advertisement. BlueZ advertises ServiceUUIDs, ServiceData and ManufacturerData in the
+// advertising data and the ScanResponse* counterparts in the scan response; the kernel adds Flags and TX power to the
+// advertising data and appends the local name to the scan response.
+struct AdvertisingPack
+{
+	std::size_t advertisingDataLimit = 0;
+	std::size_t scanResponseLimit = 0;
+	std::size_t advertisingDataLength = 0;
+	std::size_t scanResponseLength = 0;
+	std::vector<std::string> serviceUUIDs;              // shortest advertisable form
+	std::vector<std::string> scanResponseServiceUUIDs;
+	AdvertisingData data;
+	AdvertisingData scanResponseData;
+	bool includeTxPower = false;
+	std::vector<AdvertisingPackItem> items;             // in packing order
+
+	// True when everything except a shortened local name found a place
+	[[nodiscard]] bool complete() const;
+	// Deterministic one-line summary of the layout, e.g. for logs and diagnostics
+	[[nodiscard]] std::string report() const;
+};
+
+// Packs in a fixed order: Flags, service UUIDs (in the given order), service data, manufacturer data, TX power, local name.
+// Each structure goes into the advertising data when it fits, otherwise into the scan response, otherwise it is dropped. The
+// limits are 31 bytes each on the legacy path and the controller's MaxAdvLen / MaxScnRspLen with extended advertising.
+[[nodiscard]] AdvertisingPack packAdvertisingPayload(const AdvertisingPackInput& input, const BluezCapabilities& capabilities);
+
+// Bytes the advertising data will occupy on air, counting the Flags structure BlueZ prepends.
+// The local name is excluded because BlueZ truncates it to whatever space remains.
+[[nodiscard]] std::size_t estimateAdvertisingPayloadLength(
 	const std::vector<std::string>& serviceUUIDs,
+	const AdvertisingData& data,
+	bool includeTxPower);
+// Fails when the packer would have to drop any part of the payload
+[[nodiscard]] BluezResult<void> checkAdvertisingPayloadBudget(
+	const std::vector<std::string>& serviceUUIDs,
+	const AdvertisingData& data,
+	bool includeTxPower,
 	const BluezCapabilities& capabilities);
 
+// BlueZ accepts advertising intervals between 20 ms and 10,485.759 s, with MinInterval <= MaxInterval
+[[nodiscard]] BluezResult<void> validateAdvertisingParameters(const AdvertisingParameters& parameters);
+[[nodiscard]] BluezResult<void> validateAdvertisingBurstPolicy(const AdvertisingBurstPolicy& policy);
+
+// Validates an additional advertising set and returns it with its service data keys normalized
+[[nodiscard]] BluezResult<AdvertisingSetConfig> normalizeAdvertisingSetConfig(
+	const AdvertisingSetConfig& config,
+	const BluezCapabilities& capabilities);
+
+// Smooth weighted round-robin for advertising sets that outnumber the free controller instances. Each call returns the
+// (ascending) indices of up to `capacity` sets to put on air for the next time slice; over time every set gets airtime in
+// proportion to its priority. `credits` carries the rotation state between calls and is resized to match `priorities`.
+[[nodiscard]] std::vector<std::size_t> selectAdvertisingRotationSlice(
+	const std::vector<unsigned int>& priorities,
+	std::vector<int64_t>& credits,
+	std::size_t capacity);
+
+// Fan-in for the restore calls issued on resume. Every call is announced with begin() and settled with finish(); once
+// seal() has been called and nothing is outstanding, the completion callback receives the report exactly once.
+class ResumeRestoreTracker
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	ResumeRestoreTracker(Clock::time_point resumedAt, std::function<void(const ResumeReport&)> completion);
+
+	void begin();
+	void finish(const std::string& call, const BluezResult<void>& result, bool primaryAdvertisement = false,
+		Clock::time_point now = Clock::now());
+	void seal(Clock::time_point now = Clock::now());
+
+	[[nodiscard]] const ResumeReport& report() const noexcept { return report_; }
+	[[nodiscard]] bool completed() const noexcept { return completed_; }
+
+private:
+	void completeIfSettled(Clock::time_point now);
+
+	Clock::time_point resumedAt_;
+	std::function<void(const ResumeReport&)> completion_;
+	ResumeReport report_;
+	int outstanding_ = 0;
+	bool sealed_ = false;
+	bool completed_ = false;
+};
+
 } // namespace detail
 
 } // namespace bzp
@@ -40,25 +40,38 @@
 
 #include <string.h>
 #include <algorithm>
+#include <climits>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <thread>
+#include <vector>
 #include <atomic>
 #include <condition_variable>
 #include <chrono>
 #include <memory>
-#include <deque>
 #include <mutex>
 #include <exception>
+#include <unistd.h>
 
 #include "config.h"
 #include "BluezAdapterCompat.h"
+#include "BluezAdvertisingSupport.h"
 #include "ServerCompat.h"
 #include "Init.h"
 #include <bzp/BluezAdapter.h>
+#include <bzp/DataPlaneLayout.h>
+#include <bzp/GattUuid.h>
 #include <bzp/Logger.h>
 #include <bzp/Server.h>
+#include "DataPlane.h"
+#include "DataStore.h"
+#include "EventStream.h"
+#include "IngestRing.h"
 #include "ServiceRegistry.h"
+#include "ThreadScheduling.h"
+#include "UpdateQueue.h"
 
 // Macro for safe C API functions that catch C++ exceptions
 #define BZP_C_API_GUARD_BEGIN() try {
@@ -491,11 +504,6 @@ namespace bzp
 		}
 	};
 
-	// Our update queue
-	typedef std::tuple<std::string, std::string> QueueEntry;
-	std::deque<QueueEntry> updateQueue;
-	std::mutex updateQueueMutex;
-
 	// Internal method to set the run state of the server
 	void setServerRunState(BZPServerRunState newState)
 	{
@@ -504,6 +512,7 @@ namespace bzp
 
 		// Store with release ordering and notify
 		serverRunState.store(newState, std::memory_order_release);
+		publishStateEvent(newState, serverHealth.load(std::memory_order_acquire));
 
 		// Notify waiting threads about state change
 		stateChangedCV.notify_all();
@@ -522,6 +531,7 @@ namespace bzp
 
 		// Store with release ordering
 		serverHealth.store(newHealth, std::memory_order_release);
+		publishStateEvent(serverRunState.load(std::memory_order_acquire), newHealth);
 	}
 
 	void restoreGLibHandlers()
@@ -638,19 +648,94 @@ BZPUpdateEnqueueResult enqueueUpdate(const char *pObjectPath, const char *pInter
 		}
 	}
 
-	static constexpr size_t kMaxUpdateQueueSize = 1024;
-	QueueEntry entry(pObjectPath, pInterfaceName);
-
-	std::lock_guard<std::mutex> guard(updateQueueMutex);
-	if (updateQueue.size() >= kMaxUpdateQueueSize)
+	if (!pushUpdate(pObjectPath, pInterfaceName))
 	{
-		Logger::warn("Update queue full — dropping oldest entry");
-		updateQueue.pop_back();
+		return BZP_UPDATE_ENQUEUE_QUEUE_FULL;
 	}
-	updateQueue.push_front(std::move(entry));
+	scheduleServerLoopUpdateProcessing();
 	return BZP_UPDATE_ENQUEUE_OK;
 }
 
+BZPAdvertisingDataResult toAdvertisingDataResult(const BluezResult<void> &result)
+{
+	if (result.isSuccess())
+	{
+		return BZP_ADVERTISING_DATA_OK;
+	}
+
+	switch (result.error())
+	{
+		case BluezError::PayloadTooLarge: return BZP_ADVERTISING_DATA_TOO_LARGE;
+		case BluezError::InvalidArgs: return BZP_ADVERTISING_DATA_INVALID_ARGUMENT;
+		default: return BZP_ADVERTISING_DATA_FAILED;
+	}
+}
+
+bool isValidAdvertisingPayload(const unsigned char *pData, int dataLength)
+{
+	return dataLength >= 0 && (pData != nullptr || dataLength == 0);
+}
+
+void applyAdvertisingDataOnServerLoop()
+{
+	// The adapter is resolved again on the loop so a shutdown between scheduling and dispatch is harmless. If the loop is not up
+	// yet, the stored payload is applied when the advertisement is registered.
+	(void)invokeOnServerLoopEx(
+		[](void *) {
+			if (BluezAdapter *adapter = getRuntimeBluezAdapterPtr(); adapter != nullptr)
+			{
+				adapter->applyAdvertisingData();
+			}
+		},
+		nullptr);
+}
+
+bool toAdvertisingParameters(const BZPAdvertisingParameters &source, AdvertisingParameters &parameters)
+{
+	parameters.minIntervalMs = source.minIntervalMS;
+	parameters.maxIntervalMs = source.maxIntervalMS;
+	if (source.txPowerSet != 0)
+	{
+		if (source.txPowerDBm < INT16_MIN || source.txPowerDBm > INT16_MAX)
+		{
+			return false;
+		}
+		parameters.txPower = static_cast<int16_t>(source.txPowerDBm);
+	}
+	parameters.durationSeconds = source.durationSeconds;
+	parameters.timeoutSeconds = source.timeoutSeconds;
+
+	return detail::validateAdvertisingParameters(parameters).isSuccess();
+}
+
+using AdvertisingControlAction = std::function<void(BluezAdapter &)>;
+
+BZPAdvertisingControlResult postAdvertisingControl(AdvertisingControlAction action)
+{
+	if (getRuntimeBluezAdapterPtr() == nullptr)
+	{
+		return BZP_ADVERTISING_CONTROL_NOT_RUNNING;
+	}
+
+	auto *pendingAction = new AdvertisingControlAction(std::move(action));
+	const BZPRunLoopResult result = invokeOnServerLoopEx(
+		[](void *pUserData) {
+			std::unique_ptr<AdvertisingControlAction> pendingAction(static_cast<AdvertisingControlAction *>(pUserData));
+			if (BluezAdapter *adapter = getRuntimeBluezAdapterPtr(); adapter != nullptr)
+			{
+				(*pendingAction)(*adapter);
+			}
+		},
+		pendingAction);
+	if (result != BZP_RUN_LOOP_OK)
+	{
+		delete pendingAction;
+		return result == BZP_RUN_LOOP_NOT_ACTIVE ? BZP_ADVERTISING_CONTROL_NOT_RUNNING : BZP_ADVERTISING_CONTROL_FAILED;
+	}
+
+	return BZP_ADVERTISING_CONTROL_OK;
+}
+
 } // namespace
 
 void bzpSetGLibLogCaptureEnabled(int enabled)
@@ -743,6 +828,346 @@ BZPQueryResult bzpHasSleepInhibitorEx(int *pHasInhibitor)
 	BZP_C_API_GUARD_END_RETURN(BZP_QUERY_FAILED)
 }
 
+int bzpGetLastResumeTimeToAdvertiseMs()
+{
+	int milliseconds = -1;
+	(void)bzpGetLastResumeTimeToAdvertiseMsEx(&milliseconds);
+	return milliseconds;
+}
+
+BZPQueryResult bzpGetLastResumeTimeToAdvertiseMsEx(int *pMilliseconds)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return queryIntValue(pMilliseconds, []() {
+		const int64_t milliseconds = getLastResumeTimeToAdvertiseMs();
+		return milliseconds > INT_MAX ? INT_MAX : static_cast<int>(milliseconds);
+	});
+	BZP_C_API_GUARD_END_RETURN(BZP_QUERY_FAILED)
+}
+
+BZPQueryResult bzpGetBluezSignalStats(BZPBluezSignalStats *pStats)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pStats == nullptr)
+	{
+		return BZP_QUERY_INVALID_ARGUMENT;
+	}
+
+	const BluezAdapter *adapter = getRuntimeBluezAdapterPtr();
+	if (adapter == nullptr)
+	{
+		return BZP_QUERY_FAILED;
+	}
+
+	const BluezSignalStats stats = adapter->getSignalStats();
+	pStats->received = stats.received;
+	pStats->filtered = stats.filtered;
+	pStats->handled = stats.handled;
+	return BZP_QUERY_OK;
+	BZP_C_API_GUARD_END_RETURN(BZP_QUERY_FAILED)
+}
+
+void bzpSetServerThreadOptions(const BZPServerThreadOptions *pOptions)
+{
+	(void)bzpSetServerThreadOptionsEx(pOptions);
+}
+
+BZPServerThreadOptionsSetResult bzpSetServerThreadOptionsEx(const BZPServerThreadOptions *pOptions)
+{
+	BZP_C_API_GUARD_BEGIN()
+	ThreadSchedulingOptions options;
+	if (pOptions != nullptr)
+	{
+		if (pOptions->pName != nullptr && pOptions->pName[0] != '\0')
+		{
+			options.name = pOptions->pName;
+		}
+		options.cpuAffinityMask = pOptions->cpuAffinityMask;
+		if (pOptions->setNice != 0)
+		{
+			options.nice = pOptions->nice;
+		}
+		options.realtimePriority = pOptions->realtimePriority;
+		options.lockStack = pOptions->lockStack != 0;
+	}
+
+	if (const std::string problem = detail::validateThreadSchedulingOptions(options); !problem.empty())
+	{
+		Logger::warn(SSTR << "Ignoring invalid server thread options: " << problem);
+		return BZP_SERVER_THREAD_OPTIONS_SET_INVALID_OPTIONS;
+	}
+
+	setServerThreadSchedulingOptions(options);
+	return BZP_SERVER_THREAD_OPTIONS_SET_OK;
+	BZP_C_API_GUARD_END_RETURN(BZP_SERVER_THREAD_OPTIONS_SET_INVALID_OPTIONS)
+}
+
+int bzpStartEventStream(const char *pSocketPath, unsigned int subscriberBufferBytes)
+{
+	return bzpStartEventStreamEx(pSocketPath, subscriberBufferBytes) == BZP_EVENT_STREAM_START_OK ? 1 : 0;
+}
+
+BZPEventStreamStartResult bzpStartEventStreamEx(const char *pSocketPath, unsigned int subscriberBufferBytes)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (isEventStreamActive())
+	{
+		return BZP_EVENT_STREAM_START_ALREADY_ACTIVE;
+	}
+
+	const std::string path = (pSocketPath != nullptr && pSocketPath[0] != '\0')
+		? std::string(pSocketPath)
+		: defaultEventStreamPath(static_cast<int>(getpid()));
+	const std::size_t bufferBytes = subscriberBufferBytes != 0 ? subscriberBufferBytes : kDefaultEventStreamSubscriberBufferBytes;
+	if (const std::string problem = startEventStream(path, bufferBytes); !problem.empty())
+	{
+		Logger::error(SSTR << "Unable to start the event stream: " << problem);
+		return isEventStreamActive() ? BZP_EVENT_STREAM_START_ALREADY_ACTIVE : BZP_EVENT_STREAM_START_FAILED;
+	}
+
+	return BZP_EVENT_STREAM_START_OK;
+	BZP_C_API_GUARD_END_RETURN(BZP_EVENT_STREAM_START_FAILED)
+}
+
+void bzpStopEventStream()
+{
+	BZP_C_API_GUARD_BEGIN()
+	stopEventStream();
+	BZP_C_API_GUARD_END_RETURN_VOID()
+}
+
+int bzpIsEventStreamActive()
+{
+	BZP_C_API_GUARD_BEGIN()
+	return isEventStreamActive() ? 1 : 0;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+int bzpDataRegister(const char *pName, BZPDataSlotType type, unsigned int sizeBytes, const char *pObjectPath)
+{
+	int handle = -1;
+	return bzpDataRegisterEx(pName, type, sizeBytes, pObjectPath, &handle) == BZP_DATA_STORE_OK ? handle : -1;
+}
+
+BZPDataStoreResult bzpDataRegisterEx(const char *pName, BZPDataSlotType type, unsigned int sizeBytes, const char *pObjectPath,
+	int *pHandle)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pName == nullptr || pHandle == nullptr)
+	{
+		return BZP_DATA_STORE_INVALID_ARGUMENT;
+	}
+
+	const BZPDataStoreResult result = registerDataSlot(pName, type, sizeBytes, pObjectPath != nullptr ? pObjectPath : "", *pHandle);
+	if (result == BZP_DATA_STORE_CONFLICT)
+	{
+		Logger::error(SSTR << "Data slot '" << pName << "' is already registered with a different type, size or object path");
+	}
+	return result;
+	BZP_C_API_GUARD_END_RETURN(BZP_DATA_STORE_INVALID_ARGUMENT)
+}
+
+int bzpDataFind(const char *pName)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return pName != nullptr ? findDataSlot(pName) : -1;
+	BZP_C_API_GUARD_END_RETURN(-1)
+}
+
+unsigned int bzpDataSize(int handle)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return dataSlotSize(handle);
+	BZP_C_API_GUARD_END_RETURN(0U)
+}
+
+int bzpDataWrite(int handle, const void *pData, unsigned int length)
+{
+	return bzpDataWriteEx(handle, pData, length) == BZP_DATA_STORE_OK ? 1 : 0;
+}
+
+BZPDataStoreResult bzpDataWriteEx(int handle, const void *pData, unsigned int length)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return writeDataSlot(handle, pData, length);
+	BZP_C_API_GUARD_END_RETURN(BZP_DATA_STORE_INVALID_ARGUMENT)
+}
+
+int bzpDataRead(int handle, void *pBuffer, unsigned int bufferBytes)
+{
+	unsigned int length = 0;
+	return bzpDataReadEx(handle, pBuffer, bufferBytes, &length) == BZP_DATA_STORE_OK ? static_cast<int>(length) : -1;
+}
+
+BZPDataStoreResult bzpDataReadEx(int handle, void *pBuffer, unsigned int bufferBytes, unsigned int *pLength)
+{
+	BZP_C_API_GUARD_BEGIN()
+	uint32_t length = 0;
+	const BZPDataStoreResult result = readDataSlot(handle, pBuffer, bufferBytes, &length);
+	if (result == BZP_DATA_STORE_OK && pLength != nullptr)
+	{
+		*pLength = length;
+	}
+	return result;
+	BZP_C_API_GUARD_END_RETURN(BZP_DATA_STORE_INVALID_ARGUMENT)
+}
+
+const void *bzpDataStoreGetter(const char *pName)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return dataStoreGetter(pName);
+	BZP_C_API_GUARD_END_RETURN(nullptr)
+}
+
+int bzpDataStoreSetter(const char *pName, const void *pData)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return dataStoreSetter(pName, pData);
+	BZP_C_API_GUARD_END_RETURN(0)
+}
+
+int bzpRegisterIngest(const char *pName, unsigned int packetCount, unsigned int packetBytes)
+{
+	int handle = -1;
+	return bzpRegisterIngestEx(pName, packetCount, packetBytes, &handle) == BZP_INGEST_OK ? handle : -1;
+}
+
+BZPIngestResult bzpRegisterIngestEx(const char *pName, unsigned int packetCount, unsigned int packetBytes, int *pHandle)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pName == nullptr || pHandle == nullptr)
+	{
+		return BZP_INGEST_INVALID_ARGUMENT;
+	}
+
+	const BZPIngestResult result = registerIngestRing(pName,
+		packetCount != 0 ? packetCount : kDefaultIngestPackets,
+		packetBytes != 0 ? packetBytes : kDefaultIngestPacketBytes,
+		*pHandle);
+	if (result == BZP_INGEST_CONFLICT)
+	{
+		Logger::error(SSTR << "Ingest ring '" << pName << "' is already registered with a different packet count or size");
+	}
+	return result;
+	BZP_C_API_GUARD_END_RETURN(BZP_INGEST_FAILED)
+}
+
+int bzpFindIngest(const char *pName)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return pName != nullptr ? findIngestRing(pName) : -1;
+	BZP_C_API_GUARD_END_RETURN(-1)
+}
+
+int bzpReadIngest(int handle, BZPIngestPacket *pPackets, unsigned int maxPackets)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return readIngestBatch(handle, pPackets, maxPackets);
+	BZP_C_API_GUARD_END_RETURN_INT(-1)
+}
+
+int bzpGetIngestFD(int handle)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return ingestEventFD(handle);
+	BZP_C_API_GUARD_END_RETURN_INT(-1)
+}
+
+BZPIngestResult bzpGetIngestStats(int handle, BZPIngestStats *pStats)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pStats == nullptr)
+	{
+		return BZP_INGEST_INVALID_ARGUMENT;
+	}
+	return ingestStats(handle, *pStats);
+	BZP_C_API_GUARD_END_RETURN(BZP_INGEST_FAILED)
+}
+
+int bzpStartDataPlane(const char *pSocketPath, const BZPDataPlaneSlotConfig *pSlots, unsigned int slotCount)
+{
+	return bzpStartDataPlaneEx(pSocketPath, pSlots, slotCount) == BZP_DATA_PLANE_START_OK ? 1 : 0;
+}
+
+BZPDataPlaneStartResult bzpStartDataPlaneEx(const char *pSocketPath, const BZPDataPlaneSlotConfig *pSlots, unsigned int slotCount)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (isDataPlaneActive())
+	{
+		return BZP_DATA_PLANE_START_ALREADY_ACTIVE;
+	}
+	if (pSlots == nullptr || slotCount == 0)
+	{
+		return BZP_DATA_PLANE_START_INVALID_ARGUMENT;
+	}
+
+	std::vector<DataPlaneSlotConfig> slots;
+	slots.reserve(slotCount);
+	for (unsigned int index = 0; index < slotCount; ++index)
+	{
+		if (pSlots[index].pName == nullptr)
+		{
+			return BZP_DATA_PLANE_START_INVALID_ARGUMENT;
+		}
+
+		DataPlaneSlotConfig slot;
+		slot.name = pSlots[index].pName;
+		slot.objectPath = pSlots[index].pObjectPath != nullptr ? pSlots[index].pObjectPath : "";
+		slot.capacity = pSlots[index].maxValueBytes != 0 ? pSlots[index].maxValueBytes : BZP_DATA_PLANE_MAX_VALUE_BYTES;
+		slots.push_back(std::move(slot));
+	}
+
+	if (const std::string problem = validateDataPlaneSlots(slots); !problem.empty())
+	{
+		Logger::error(SSTR << "Unable to start the data plane: " << problem);
+		return BZP_DATA_PLANE_START_INVALID_ARGUMENT;
+	}
+
+	const std::string path = (pSocketPath != nullptr && pSocketPath[0] != '\0')
+		? std::string(pSocketPath)
+		: defaultDataPlanePath(static_cast<int>(getpid()));
+	if (const std::string problem = startDataPlane(path, slots); !problem.empty())
+	{
+		Logger::error(SSTR << "Unable to start the data plane: " << problem);
+		return isDataPlaneActive() ? BZP_DATA_PLANE_START_ALREADY_ACTIVE : BZP_DATA_PLANE_START_FAILED;
+	}
+
+	return BZP_DATA_PLANE_START_OK;
+	BZP_C_API_GUARD_END_RETURN(BZP_DATA_PLANE_START_FAILED)
+}
+
+void bzpStopDataPlane()
+{
+	BZP_C_API_GUARD_BEGIN()
+	stopDataPlane();
+	BZP_C_API_GUARD_END_RETURN_VOID()
+}
+
+int bzpIsDataPlaneActive()
+{
+	BZP_C_API_GUARD_BEGIN()
+	return isDataPlaneActive() ? 1 : 0;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+const void *bzpGetDataPlaneValue(const char *pName)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return pName != nullptr ? refreshDataPlaneValue(pName) : nullptr;
+	BZP_C_API_GUARD_END_RETURN(nullptr)
+}
+
+int bzpReadDataPlaneValue(const char *pName, void *pBuffer, unsigned int bufferBytes)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pName == nullptr || (pBuffer == nullptr && bufferBytes != 0))
+	{
+		return -1;
+	}
+	return readDataPlaneValue(pName, pBuffer, bufferBytes);
+	BZP_C_API_GUARD_END_RETURN(-1)
+}
+
 void bzpSetGLibLogCaptureMode(BZPGLibLogCaptureMode mode)
 {
 	(void)bzpSetGLibLogCaptureModeEx(mode);
@@ -1173,28 +1598,10 @@ enum BZPUpdateQueueResult bzpPopUpdateQueueEx(char *pElementBuffer, int elementL
 	BZP_C_API_GUARD_BEGIN()
 	if (!pElementBuffer || elementLen <= 0) return BZP_UPDATE_QUEUE_INVALID_ARGUMENT;
 
+	// One locked step: an entry that does not fit stays queued, and the entry copied out is the one removed
 	std::string result;
-
-	{
-		std::lock_guard<std::mutex> guard(updateQueueMutex);
-
-		// Check for an empty queue
-		if (updateQueue.empty()) { return BZP_UPDATE_QUEUE_EMPTY; }
-
-		// Get the last element
-		QueueEntry t = updateQueue.back();
-
-		// Get the result string
-		result = std::get<0>(t) + "|" + std::get<1>(t);
-
-		// Ensure there's enough room for it
-		if (result.length() + 1 > static_cast<size_t>(elementLen)) { return BZP_UPDATE_QUEUE_BUFFER_TOO_SMALL; }
-
-		if (keep == 0)
-		{
-			updateQueue.pop_back();
-		}
-	}
+	const BZPUpdateQueueResult popped = popUpdate(result, keep != 0, static_cast<size_t>(elementLen));
+	if (popped != BZP_UPDATE_QUEUE_OK) { return popped; }
 
 	// Copy the element string safely
 	strncpy(pElementBuffer, result.c_str(), elementLen - 1);
@@ -1216,8 +1623,7 @@ BZPQueryResult bzpUpdateQueueIsEmptyEx(int *pIsEmpty)
 {
 	BZP_C_API_GUARD_BEGIN()
 	return queryIntValue(pIsEmpty, []() {
-		std::lock_guard<std::mutex> guard(updateQueueMutex);
-		return updateQueue.empty() ? 1 : 0;
+		return updateQueueSize() == 0 ? 1 : 0;
 	});
 	BZP_C_API_GUARD_END_RETURN(BZP_QUERY_FAILED)
 }
@@ -1234,8 +1640,7 @@ BZPQueryResult bzpUpdateQueueSizeEx(int *pSize)
 {
 	BZP_C_API_GUARD_BEGIN()
 	return queryIntValue(pSize, []() {
-		std::lock_guard<std::mutex> guard(updateQueueMutex);
-		return static_cast<int>(updateQueue.size());
+		return static_cast<int>(updateQueueSize());
 	});
 	BZP_C_API_GUARD_END_RETURN(BZP_QUERY_FAILED)
 }
@@ -1251,14 +1656,335 @@ BZPQueryResult bzpUpdateQueueClearEx(int *pClearedCount)
 {
 	BZP_C_API_GUARD_BEGIN()
 	return queryIntValue(pClearedCount, []() {
-		std::lock_guard<std::mutex> guard(updateQueueMutex);
-		const int clearedCount = static_cast<int>(updateQueue.size());
-		updateQueue.clear();
-		return clearedCount;
+		return static_cast<int>(clearUpdateQueue());
 	});
 	BZP_C_API_GUARD_END_RETURN(BZP_QUERY_FAILED)
 }
 
+int bzpSetUpdatePriority(const char *pObjectPath, BZPUpdatePriority priority)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pObjectPath == nullptr || priority < BZP_UPDATE_PRIORITY_CRITICAL || priority > BZP_UPDATE_PRIORITY_BULK)
+	{
+		return 0;
+	}
+
+	setUpdatePriority(pObjectPath, priority);
+	return 1;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+int bzpSetUpdateSchedule(const BZPUpdateSchedule *pSchedule)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return pSchedule != nullptr && setUpdateSchedule(*pSchedule) ? 1 : 0;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPQueryResult bzpGetUpdateSchedule(BZPUpdateSchedule *pSchedule)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pSchedule == nullptr)
+	{
+		return BZP_QUERY_INVALID_ARGUMENT;
+	}
+
+	*pSchedule = updateSchedule();
+	return BZP_QUERY_OK;
+	BZP_C_API_GUARD_END_RETURN(BZP_QUERY_FAILED)
+}
+
+BZPQueryResult bzpGetUpdateLaneStats(BZPUpdatePriority priority, BZPUpdateLaneStats *pStats)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pStats == nullptr || priority < BZP_UPDATE_PRIORITY_CRITICAL || priority > BZP_UPDATE_PRIORITY_BULK)
+	{
+		return BZP_QUERY_INVALID_ARGUMENT;
+	}
+
+	*pStats = updateLaneStats(priority);
+	return BZP_QUERY_OK;
+	BZP_C_API_GUARD_END_RETURN(BZP_QUERY_FAILED)
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+//     _         _                     _    _       _                      _         _
+//    / \     __| |__   __  ___  _ __ | |_ (_) ___ (_) _ __    __ _     __| |  __ _ | |_   __ _
+//   / _ \   / _` |\ \ / / / _ \| '__|| __|| |/ __|| || '_ \  / _` |   / _` | / _` || __| / _` |
+//  / ___ \ | (_| | \ V / |  __/| |   | |_ | |\__ \| || | | || (_| |  | (_| || (_| || |_ | (_| |
+// /_/   \_\ \__,_|  \_/   \___||_|    \__||_||___/|_||_| |_| \__, |   \__,_| \__,_| \__| \__,_|
+//                                                            |___/
+//
+// Connectionless payload (ManufacturerData / ServiceData) carried in the LE advertisement, advertising parameters, the
+// burst-then-relax interval schedule and additional advertising sets. The adapter stores the payload under its own lock;
+// parameter and advertising set changes are validated here and handed to the server loop. All of these methods are thread-safe.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+int bzpSetAdvertisingManufacturerData(unsigned short companyId, const unsigned char *pData, int dataLength)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return bzpSetAdvertisingManufacturerDataEx(companyId, pData, dataLength) == BZP_ADVERTISING_DATA_OK;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPAdvertisingDataResult bzpSetAdvertisingManufacturerDataEx(unsigned short companyId, const unsigned char *pData, int dataLength)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (!isValidAdvertisingPayload(pData, dataLength))
+	{
+		return BZP_ADVERTISING_DATA_INVALID_ARGUMENT;
+	}
+
+	BluezAdapter *adapter = getRuntimeBluezAdapterPtr();
+	if (adapter == nullptr)
+	{
+		return BZP_ADVERTISING_DATA_NOT_RUNNING;
+	}
+
+	const BluezResult<void> result = pData == nullptr
+		? adapter->removeAdvertisingManufacturerData(companyId)
+		: adapter->setAdvertisingManufacturerData(companyId, std::vector<uint8_t>(pData, pData + dataLength));
+	if (result.hasError())
+	{
+		return toAdvertisingDataResult(result);
+	}
+
+	applyAdvertisingDataOnServerLoop();
+	return BZP_ADVERTISING_DATA_OK;
+	BZP_C_API_GUARD_END_RETURN(BZP_ADVERTISING_DATA_FAILED)
+}
+
+int bzpSetAdvertisingServiceData(const char *pServiceUuid, const unsigned char *pData, int dataLength)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return bzpSetAdvertisingServiceDataEx(pServiceUuid, pData, dataLength) == BZP_ADVERTISING_DATA_OK;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPAdvertisingDataResult bzpSetAdvertisingServiceDataEx(const char *pServiceUuid, const unsigned char *pData, int dataLength)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pServiceUuid == nullptr || GattUuid(pServiceUuid).toString128().empty() || !isValidAdvertisingPayload(pData, dataLength))
+	{
+		return BZP_ADVERTISING_DATA_INVALID_ARGUMENT;
+	}
+
+	BluezAdapter *adapter = getRuntimeBluezAdapterPtr();
+	if (adapter == nullptr)
+	{
+		return BZP_ADVERTISING_DATA_NOT_RUNNING;
+	}
+
+	const BluezResult<void> result = pData == nullptr
+		? adapter->removeAdvertisingServiceData(pServiceUuid)
+		: adapter->setAdvertisingServiceData(pServiceUuid, std::vector<uint8_t>(pData, pData + dataLength));
+	if (result.hasError())
+	{
+		return toAdvertisingDataResult(result);
+	}
+
+	applyAdvertisingDataOnServerLoop();
+	return BZP_ADVERTISING_DATA_OK;
+	BZP_C_API_GUARD_END_RETURN(BZP_ADVERTISING_DATA_FAILED)
+}
+
+void bzpClearAdvertisingData()
+{
+	(void)bzpClearAdvertisingDataEx();
+}
+
+BZPAdvertisingDataResult bzpClearAdvertisingDataEx()
+{
+	BZP_C_API_GUARD_BEGIN()
+	BluezAdapter *adapter = getRuntimeBluezAdapterPtr();
+	if (adapter == nullptr)
+	{
+		return BZP_ADVERTISING_DATA_NOT_RUNNING;
+	}
+
+	adapter->clearAdvertisingData();
+	applyAdvertisingDataOnServerLoop();
+	return BZP_ADVERTISING_DATA_OK;
+	BZP_C_API_GUARD_END_RETURN(BZP_ADVERTISING_DATA_FAILED)
+}
+
+int bzpSetAdvertisingParameters(const BZPAdvertisingParameters *pParameters)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return bzpSetAdvertisingParametersEx(pParameters) == BZP_ADVERTISING_CONTROL_OK;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPAdvertisingControlResult bzpSetAdvertisingParametersEx(const BZPAdvertisingParameters *pParameters)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pParameters == nullptr)
+	{
+		return BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT;
+	}
+
+	AdvertisingParameters parameters;
+	if (!toAdvertisingParameters(*pParameters, parameters))
+	{
+		return BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT;
+	}
+
+	return postAdvertisingControl([parameters](BluezAdapter &adapter) {
+		(void)adapter.setAdvertisingParameters(parameters);
+	});
+	BZP_C_API_GUARD_END_RETURN(BZP_ADVERTISING_CONTROL_FAILED)
+}
+
+int bzpSetAdvertisingBurstPolicy(int burstMinIntervalMS, int burstMaxIntervalMS,
+	int relaxedMinIntervalMS, int relaxedMaxIntervalMS, int burstDurationMS)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return bzpSetAdvertisingBurstPolicyEx(burstMinIntervalMS, burstMaxIntervalMS,
+		relaxedMinIntervalMS, relaxedMaxIntervalMS, burstDurationMS) == BZP_ADVERTISING_CONTROL_OK;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPAdvertisingControlResult bzpSetAdvertisingBurstPolicyEx(int burstMinIntervalMS, int burstMaxIntervalMS,
+	int relaxedMinIntervalMS, int relaxedMaxIntervalMS, int burstDurationMS)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (burstMinIntervalMS < 0 || burstMaxIntervalMS < 0 || relaxedMinIntervalMS < 0 || relaxedMaxIntervalMS < 0 || burstDurationMS <= 0)
+	{
+		return BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT;
+	}
+
+	AdvertisingBurstPolicy policy;
+	policy.burstMinIntervalMs = static_cast<uint32_t>(burstMinIntervalMS);
+	policy.burstMaxIntervalMs = static_cast<uint32_t>(burstMaxIntervalMS);
+	policy.relaxedMinIntervalMs = static_cast<uint32_t>(relaxedMinIntervalMS);
+	policy.relaxedMaxIntervalMs = static_cast<uint32_t>(relaxedMaxIntervalMS);
+	policy.burstDurationMs = static_cast<uint32_t>(burstDurationMS);
+
+	if (detail::validateAdvertisingBurstPolicy(policy).hasError())
+	{
+		return BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT;
+	}
+
+	return postAdvertisingControl([policy](BluezAdapter &adapter) {
+		(void)adapter.setAdvertisingBurstPolicy(policy);
+	});
+	BZP_C_API_GUARD_END_RETURN(BZP_ADVERTISING_CONTROL_FAILED)
+}
+
+int bzpTriggerAdvertisingBurst()
+{
+	BZP_C_API_GUARD_BEGIN()
+	return bzpTriggerAdvertisingBurstEx() == BZP_ADVERTISING_CONTROL_OK;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPAdvertisingControlResult bzpTriggerAdvertisingBurstEx()
+{
+	BZP_C_API_GUARD_BEGIN()
+	return postAdvertisingControl([](BluezAdapter &adapter) {
+		if (auto result = adapter.triggerAdvertisingBurst(); result.hasError())
+		{
+			Logger::warn(SSTR << "Unable to start advertising burst: " << result.errorMessage());
+		}
+	});
+	BZP_C_API_GUARD_END_RETURN(BZP_ADVERTISING_CONTROL_FAILED)
+}
+
+int bzpSetAdvertisingSet(const BZPAdvertisingSet *pSet)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return bzpSetAdvertisingSetEx(pSet) == BZP_ADVERTISING_CONTROL_OK;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPAdvertisingControlResult bzpSetAdvertisingSetEx(const BZPAdvertisingSet *pSet)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pSet == nullptr || pSet->pName == nullptr || pSet->pName[0] == '\0'
+		|| !isValidAdvertisingPayload(pSet->pManufacturerData, pSet->manufacturerDataLength)
+		|| !isValidAdvertisingPayload(pSet->pServiceData, pSet->serviceDataLength))
+	{
+		return BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT;
+	}
+
+	AdvertisingSetConfig config;
+	config.name = pSet->pName;
+	config.type = pSet->connectable != 0 ? "peripheral" : "broadcast";
+	config.priority = pSet->priority;
+	config.includeLocalName = pSet->includeLocalName != 0;
+	if (!toAdvertisingParameters(pSet->parameters, config.parameters))
+	{
+		return BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT;
+	}
+	if (pSet->manufacturerDataLength > 0)
+	{
+		config.data.manufacturerData[pSet->manufacturerId] =
+			std::vector<uint8_t>(pSet->pManufacturerData, pSet->pManufacturerData + pSet->manufacturerDataLength);
+	}
+	if (pSet->serviceDataLength > 0)
+	{
+		if (pSet->pServiceDataUuid == nullptr || detail::normalizeAdvertisingServiceDataUuid(pSet->pServiceDataUuid).empty())
+		{
+			return BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT;
+		}
+		config.data.serviceData[pSet->pServiceDataUuid] =
+			std::vector<uint8_t>(pSet->pServiceData, pSet->pServiceData + pSet->serviceDataLength);
+	}
+
+	return postAdvertisingControl([config = std::move(config)](BluezAdapter &adapter) {
+		if (auto result = adapter.setAdvertisingSet(config); result.hasError())
+		{
+			Logger::warn(SSTR << "Unable to set advertising set '" << config.name << "': " << result.errorMessage());
+		}
+	});
+	BZP_C_API_GUARD_END_RETURN(BZP_ADVERTISING_CONTROL_FAILED)
+}
+
+int bzpRemoveAdvertisingSet(const char *pName)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return bzpRemoveAdvertisingSetEx(pName) == BZP_ADVERTISING_CONTROL_OK;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPAdvertisingControlResult bzpRemoveAdvertisingSetEx(const char *pName)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (pName == nullptr || pName[0] == '\0')
+	{
+		return BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT;
+	}
+
+	return postAdvertisingControl([name = std::string(pName)](BluezAdapter &adapter) {
+		if (auto result = adapter.removeAdvertisingSet(name); result.hasError())
+		{
+			Logger::warn(SSTR << "Unable to remove advertising set: " << result.errorMessage());
+		}
+	});
+	BZP_C_API_GUARD_END_RETURN(BZP_ADVERTISING_CONTROL_FAILED)
+}
+
+int bzpSetAdvertisingRotationSlice(int sliceMS)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return bzpSetAdvertisingRotationSliceEx(sliceMS) == BZP_ADVERTISING_CONTROL_OK;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPAdvertisingControlResult bzpSetAdvertisingRotationSliceEx(int sliceMS)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (sliceMS < 250)
+	{
+		return BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT;
+	}
+
+	return postAdvertisingControl([sliceMS](BluezAdapter &adapter) {
+		(void)adapter.setAdvertisingRotationSlice(static_cast<uint32_t>(sliceMS));
+	});
+	BZP_C_API_GUARD_END_RETURN(BZP_ADVERTISING_CONTROL_FAILED)
+}
+
 // ---------------------------------------------------------------------------------------------------------------------------------
 //  ____                     _        _
 // |  _ \ _   _ _ __     ___| |_ __ _| |_ ___
@@ -1610,6 +2336,7 @@ BZPStartResult startServerWithMode(const char *pServiceName, const char *pAdvert
 			serverThread = std::thread([server, adapter] {
 				try
 				{
+					(void)applyServerThreadScheduling();
 					runServerThread(server.get(), adapter);
 				}
 				catch (const std::exception& ex)
@@ -1971,7 +2698,41 @@ int bzpRunLoopInvoke(BZPRunLoopCallback callback, void *pUserData)
 BZPRunLoopResult bzpRunLoopInvokeEx(BZPRunLoopCallback callback, void *pUserData)
 {
 	BZP_C_API_GUARD_BEGIN()
-	return invokeOnServerLoopEx(callback, pUserData);
+	return invokeOnServerLoopEx(callback, pUserData, true);
+	BZP_C_API_GUARD_END_RETURN(BZP_RUN_LOOP_ACTIVATION_FAILED)
+}
+
+int bzpRunLoopInvokeBatch(const BZPRunLoopInvocation *pInvocations, int count)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return bzpRunLoopInvokeBatchEx(pInvocations, count) == BZP_RUN_LOOP_OK;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPRunLoopResult bzpRunLoopInvokeBatchEx(const BZPRunLoopInvocation *pInvocations, int count)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return invokeBatchOnServerLoopEx(pInvocations, count, true);
+	BZP_C_API_GUARD_END_RETURN(BZP_RUN_LOOP_ACTIVATION_FAILED)
+}
+
+int bzpRunLoopSetInvokeCapacity(int capacity)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return bzpRunLoopSetInvokeCapacityEx(capacity) == BZP_RUN_LOOP_OK;
+	BZP_C_API_GUARD_END_RETURN_INT(0)
+}
+
+BZPRunLoopResult bzpRunLoopSetInvokeCapacityEx(int capacity)
+{
+	BZP_C_API_GUARD_BEGIN()
+	if (capacity < 0)
+	{
+		return BZP_RUN_LOOP_INVALID_ARGUMENT;
+	}
+
+	setServerLoopInvokeCapacity(static_cast<size_t>(capacity));
+	return BZP_RUN_LOOP_OK;
 	BZP_C_API_GUARD_END_RETURN(BZP_RUN_LOOP_ACTIVATION_FAILED)
 }
 
@@ -2045,6 +2806,37 @@ BZPRunLoopResult bzpRunLoopPollCancelEx()
 	BZP_C_API_GUARD_END_RETURN(BZP_RUN_LOOP_ACTIVATION_FAILED)
 }
 
+int bzpRunLoopGetFD()
+{
+	BZP_C_API_GUARD_BEGIN()
+	int fd = -1;
+	return bzpRunLoopGetFDEx(&fd) == BZP_RUN_LOOP_OK ? fd : -1;
+	BZP_C_API_GUARD_END_RETURN_INT(-1)
+}
+
+BZPRunLoopResult bzpRunLoopGetFDEx(int *pFD)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return getServerLoopFDEx(pFD);
+	BZP_C_API_GUARD_END_RETURN(BZP_RUN_LOOP_ACTIVATION_FAILED)
+}
+
+int bzpRunLoopDispatchPending(int budget)
+{
+	BZP_C_API_GUARD_BEGIN()
+	int dispatchedCount = 0;
+	const BZPRunLoopResult result = bzpRunLoopDispatchPendingEx(budget, &dispatchedCount);
+	return result == BZP_RUN_LOOP_OK || result == BZP_RUN_LOOP_IDLE ? dispatchedCount : -1;
+	BZP_C_API_GUARD_END_RETURN_INT(-1)
+}
+
+BZPRunLoopResult bzpRunLoopDispatchPendingEx(int budget, int *pDispatchedCount)
+{
+	BZP_C_API_GUARD_BEGIN()
+	return dispatchServerLoopPendingEx(budget, pDispatchedCount);
+	BZP_C_API_GUARD_END_RETURN(BZP_RUN_LOOP_ACTIVATION_FAILED)
+}
+
 int bzpRunLoopDriveUntilState(BZPServerRunState state, int timeoutMS)
 {
 	BZP_C_API_GUARD_BEGIN()
@@ -0,0 +1,57 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// See the discussion at the top of BluezSignalFilter.h
+
+#include "BluezSignalFilter.h"
+
+#include <cstring>
+
+namespace bzp::detail {
+
+std::string devicePropertiesMatchRule(std::string_view adapterPath)
+{
+	std::string rule = "type='signal',sender='org.bluez',interface='org.freedesktop.DBus.Properties',member='PropertiesChanged',"
+		"arg0='org.bluez.Device1'";
+	if (!adapterPath.empty())
+	{
+		rule.append(",path_namespace='").append(adapterPath).append("'");
+	}
+	return rule;
+}
+
+bool isAdapterObjectPath(std::string_view objectPath, std::string_view adapterPath) noexcept
+{
+	if (adapterPath.empty())
+	{
+		return true;
+	}
+	return objectPath.starts_with(adapterPath)
+		&& (objectPath.size() == adapterPath.size() || objectPath[adapterPath.size()] == '/');
+}
+
+bool mayChangeConnected(GVariant *pParameters) noexcept
+{
+	// Signals arrive in tree form, where g_variant_get_data() would serialize the whole message; children only cost a reference
+	GVariant *pChanged = g_variant_get_child_value(pParameters, 1);
+	GVariant *pConnected = g_variant_lookup_value(pChanged, "Connected", G_VARIANT_TYPE_BOOLEAN);
+	g_variant_unref(pChanged);
+	if (pConnected != nullptr)
+	{
+		g_variant_unref(pConnected);
+		return true;
+	}
+
+	GVariant *pInvalidated = g_variant_get_child_value(pParameters, 2);
+	bool invalidated = false;
+	for (gsize index = 0, count = g_variant_n_children(pInvalidated); index < count && !invalidated; ++index)
+	{
+		GVariant *pName = g_variant_get_child_value(pInvalidated, index);
+		invalidated = std::strcmp(g_variant_get_string(pName, nullptr), "Connected") == 0;
+		g_variant_unref(pName);
+	}
+	g_variant_unref(pInvalidated);
+	return invalidated;
+}
+
+} // namespace bzp::detail
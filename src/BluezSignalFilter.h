@@ -0,0 +1,31 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Cheap checks that keep unrelated BlueZ signal traffic off the server thread.
+//
+// While any process on the host scans, bluetoothd emits a steady stream of PropertiesChanged signals for RSSI, TxPower and
+// ManufacturerData on every device it sees. BluezAdapter only cares about Device1.Connected on the active adapter, so its
+// subscription asks the bus for Device1 signals below the adapter's path (`path_namespace` plus `arg0`), and whatever still
+// arrives is checked here for a Connected entry by direct lookup before the rest is unpacked. Connection changes that survive
+// the filter are batched (see DeviceEventBatch.h).
+
+#pragma once
+
+#include <glib.h>
+
+#include <string>
+#include <string_view>
+
+namespace bzp::detail {
+
+// Bus match rule for Device1 PropertiesChanged signals from BlueZ below `adapterPath` (any adapter when it is empty)
+[[nodiscard]] std::string devicePropertiesMatchRule(std::string_view adapterPath);
+
+// True for the adapter object itself and everything below it. An empty adapter path accepts every object.
+[[nodiscard]] bool isAdapterObjectPath(std::string_view objectPath, std::string_view adapterPath) noexcept;
+
+// Looks up "Connected" in the changed and invalidated properties of PropertiesChanged `(sa{sv}as)` parameters without unpacking
+// the other entries. False means the signal cannot change a connection state.
+[[nodiscard]] bool mayChangeConnected(GVariant *pParameters) noexcept;
+
+} // namespace bzp::detail
@@ -46,6 +46,7 @@ std::string bluezErrorToString(BluezError error)
 		case BluezError::AlreadyExists: return "Resource already exists";
 		case BluezError::NotFound: return "Resource not found";
 		case BluezError::ConnectionFailed: return "Connection failed";
+		case BluezError::PayloadTooLarge: return "Payload does not fit the controller budget";
 		case BluezError::Unknown:
 		default: return "Unknown error";
 	}
@@ -103,6 +104,7 @@ bool isRetryableError(BluezError error)
 		case BluezError::NotSupported:
 		case BluezError::InvalidArgs:
 		case BluezError::AlreadyExists:
+		case BluezError::PayloadTooLarge:
 			return false;
 
 		default:
@@ -90,13 +90,13 @@ DBusObject &DBusInterface::getOwner() const
 }
 
 // Returns the path node of this interface's owner
-DBusObjectPath DBusInterface::getPathNode() const
+const DBusObjectPath &DBusInterface::getPathNode() const
 {
 	return owner.getPathNode();
 }
 
 // Returns the full path of this interface's owner
-DBusObjectPath DBusInterface::getPath() const
+const DBusObjectPath &DBusInterface::getPath() const
 {
 	return owner.getPath();
 }
@@ -155,8 +155,7 @@ bool DBusInterface::callMethod(const std::string &methodName, DBusMethodCallRef
 	{
 		if (methodName == method.getName())
 		{
-			const std::string notImplementedErrorName = owner.getServer().getOwnedName() + ".NotImplemented";
-			method.call<DBusInterface>(methodCall, getPath(), getName(), methodName, notImplementedErrorName);
+			method.call<DBusInterface>(methodCall, getPath(), getName(), methodName, owner.getServer().getNotImplementedErrorName());
 			return true;
 		}
 	}
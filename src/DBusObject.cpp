@@ -47,13 +47,16 @@
 #include <bzp/Logger.h>
 #include <bzp/Server.h>
 
+#include <algorithm>
+#include <array>
+
 namespace bzp {
 
 // Construct a root object with no parent
 //
 // We'll include a publish flag since only root objects can be published
 DBusObject::DBusObject(Server &server, const DBusObjectPath &path, bool publish)
-: server_(&server), publish(publish), path(path), pParent(nullptr)
+: server_(&server), publish(publish), path(path), fullPath(path), pParent(nullptr)
 {
 }
 
@@ -61,7 +64,7 @@ DBusObject::DBusObject(Server &server, const DBusObjectPath &path, bool publish)
 //
 // Nodes inherit their parent's publish path
 DBusObject::DBusObject(DBusObject *pParent, const DBusObjectPath &pathElement)
-: server_(pParent->server_), publish(pParent->publish), path(pathElement), pParent(pParent)
+: server_(pParent->server_), publish(pParent->publish), path(pathElement), fullPath(pParent->getPath() + pathElement), pParent(pParent)
 {
 }
 
@@ -86,19 +89,9 @@ const DBusObjectPath &DBusObject::getPathNode() const
 // Returns the full path for this object within the hierarchy
 //
 // This method returns the full path. To get the current node, use `getPathNode()`
-DBusObjectPath DBusObject::getPath() const
+const DBusObjectPath &DBusObject::getPath() const
 {
-	DBusObjectPath path = getPathNode();
-	const DBusObject *pCurrent = pParent;
-
-	// Traverse up my chain, adding nodes to the path until we have the full thing
-	while(nullptr != pCurrent)
-	{
-		path = pCurrent->getPathNode() + path;
-		pCurrent = pCurrent->pParent;
-	}
-
-	return path;
+	return fullPath;
 }
 
 // Returns whether this object has a parent
@@ -144,9 +137,15 @@ const std::string &DBusObject::getServiceName() const
 DBusObject &DBusObject::addChild(const DBusObjectPath &pathElement)
 {
 	children.push_back(DBusObject(this, pathElement));
+	noteTreeChanged();
 	return children.back();
 }
 
+void DBusObject::noteTreeChanged() noexcept
+{
+	server_->noteTreeChanged();
+}
+
 // Returns a list of interfaces for this object
 const DBusObject::InterfaceList &DBusObject::getInterfaces() const
 {
@@ -170,11 +169,16 @@ GattService &DBusObject::gattServiceBegin(const std::string &pathElement, const
 //
 
 // Finds an interface by name within this D-Bus object
-std::shared_ptr<const DBusInterface> DBusObject::findInterface(const DBusObjectPath &path, const std::string &interfaceName, const DBusObjectPath &basePath) const
+std::shared_ptr<const DBusInterface> DBusObject::findInterface(const DBusObjectPath &path, std::string_view interfaceName, const DBusObjectPath &basePath) const
 {
+	if (basePath == DBusObjectPath())
+	{
+		return findInterface(std::string_view(path.toString()), interfaceName);
+	}
+
 	if ((basePath + getPathNode()) == path)
 	{
-		for (std::shared_ptr<const DBusInterface> interface : interfaces)
+		for (const std::shared_ptr<DBusInterface> &interface : interfaces)
 		{
 			if (interfaceName == interface->getName())
 			{
@@ -195,19 +199,55 @@ std::shared_ptr<const DBusInterface> DBusObject::findInterface(const DBusObjectP
 	return nullptr;
 }
 
+std::shared_ptr<const DBusInterface> DBusObject::findInterface(std::string_view path, std::string_view interfaceName) const
+{
+	// A child's path always extends its parent's, so nothing below a non-matching prefix can match either
+	const std::string &ownPath = fullPath.toString();
+	if (!path.starts_with(ownPath))
+	{
+		return nullptr;
+	}
+
+	if (path.size() == ownPath.size())
+	{
+		for (const std::shared_ptr<DBusInterface> &interface : interfaces)
+		{
+			if (interfaceName == interface->getName())
+			{
+				return interface;
+			}
+		}
+	}
+
+	for (const DBusObject &child : children)
+	{
+		if (std::shared_ptr<const DBusInterface> pInterface = child.findInterface(path, interfaceName))
+		{
+			return pInterface;
+		}
+	}
+
+	return nullptr;
+}
+
 // Finds a BlueZ method by name within the specified D-Bus interface
 #if BZP_ENABLE_LEGACY_RAW_GLIB_COMPAT
-bool DBusObject::callMethod(const DBusObjectPath &path, const std::string &interfaceName, const std::string &methodName, GDBusConnection *pConnection, GVariant *pParameters, GDBusMethodInvocation *pInvocation, gpointer pUserData, const DBusObjectPath &basePath) const
+bool DBusObject::callMethod(const DBusObjectPath &path, std::string_view interfaceName, const std::string &methodName, GDBusConnection *pConnection, GVariant *pParameters, GDBusMethodInvocation *pInvocation, gpointer pUserData, const DBusObjectPath &basePath) const
 {
 	return callMethod(path, interfaceName, methodName, DBusMethodCallRef(pConnection, pParameters, pInvocation, pUserData), basePath);
 }
 #endif
 
-bool DBusObject::callMethod(const DBusObjectPath &path, const std::string &interfaceName, const std::string &methodName, DBusMethodCallRef methodCall, const DBusObjectPath &basePath) const
+bool DBusObject::callMethod(const DBusObjectPath &path, std::string_view interfaceName, const std::string &methodName, DBusMethodCallRef methodCall, const DBusObjectPath &basePath) const
 {
+	if (basePath == DBusObjectPath())
+	{
+		return callMethod(std::string_view(path.toString()), interfaceName, methodName, methodCall);
+	}
+
 	if ((basePath + getPathNode()) == path)
 	{
-		for (std::shared_ptr<const DBusInterface> interface : interfaces)
+		for (const std::shared_ptr<DBusInterface> &interface : interfaces)
 		{
 			if (interfaceName == interface->getName())
 			{
@@ -230,8 +270,38 @@ bool DBusObject::callMethod(const DBusObjectPath &path, const std::string &inter
 	return false;
 }
 
+bool DBusObject::callMethod(std::string_view path, std::string_view interfaceName, const std::string &methodName, DBusMethodCallRef methodCall) const
+{
+	const std::string &ownPath = fullPath.toString();
+	if (!path.starts_with(ownPath))
+	{
+		return false;
+	}
+
+	if (path.size() == ownPath.size())
+	{
+		for (const std::shared_ptr<DBusInterface> &interface : interfaces)
+		{
+			if (interfaceName == interface->getName() && interface->callMethod(methodName, methodCall))
+			{
+				return true;
+			}
+		}
+	}
+
+	for (const DBusObject &child : children)
+	{
+		if (child.callMethod(path, interfaceName, methodName, methodCall))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 #if BZP_ENABLE_LEGACY_RAW_GLIB_COMPAT
-bool DBusObject::callMethod(const DBusObjectPath &path, const std::string &interfaceName, const std::string &methodName, DBusConnectionRef connection, DBusVariantRef parameters, DBusMethodInvocationRef invocation, gpointer pUserData, const DBusObjectPath &basePath) const
+bool DBusObject::callMethod(const DBusObjectPath &path, std::string_view interfaceName, const std::string &methodName, DBusConnectionRef connection, DBusVariantRef parameters, DBusMethodInvocationRef invocation, gpointer pUserData, const DBusObjectPath &basePath) const
 {
 	return callMethod(path, interfaceName, methodName, DBusMethodCallRef(connection, parameters, invocation, pUserData), basePath);
 }
@@ -297,23 +367,32 @@ bool DBusObject::emitSignalChecked(DBusConnectionRef busConnection, const std::s
 
 bool DBusObject::emitSignalChecked(DBusSignalRef signal)
 {
+	// D-Bus caps interface and member names at 255 bytes, so the NUL-terminated copies GLib needs fit on the stack
+	std::array<char, 256> interfaceName;
+	std::array<char, 256> signalName;
+	if (signal.interfaceName().size() >= interfaceName.size() || signal.signalName().size() >= signalName.size())
+	{
+		Logger::error(SSTR << "Failed to emit signal named '" << signal.signalName() << "': name exceeds the D-Bus limit");
+		return false;
+	}
+	*std::copy(signal.interfaceName().begin(), signal.interfaceName().end(), interfaceName.begin()) = '\0';
+	*std::copy(signal.signalName().begin(), signal.signalName().end(), signalName.begin()) = '\0';
+
 	GError *pError = nullptr;
-	const std::string interfaceName(signal.interfaceName());
-	const std::string signalName(signal.signalName());
 	gboolean result = g_dbus_connection_emit_signal
 	(
 		signal.connection().get(), // GDBusConnection *connection
 		NULL,                    // const gchar *destination_bus_name
 		getPath().c_str(),       // const gchar *object_path
-		interfaceName.c_str(),   // const gchar *interface_name
-		signalName.c_str(),      // const gchar *signal_name
+		interfaceName.data(),    // const gchar *interface_name
+		signalName.data(),       // const gchar *signal_name
 		signal.parameters().get(), // GVariant *parameters
 		&pError                  // GError **error
 	);
 
 	if (0 == result)
 	{
-		Logger::error(SSTR << "Failed to emit signal named '" << signalName << "': " << (nullptr == pError ? "Unknown" : pError->message));
+		Logger::error(SSTR << "Failed to emit signal named '" << signal.signalName() << "': " << (nullptr == pError ? "Unknown" : pError->message));
 		if (nullptr != pError)
 		{
 			g_error_free(pError);
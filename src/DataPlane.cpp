@@ -0,0 +1,508 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Server side of the shared-memory data plane.
+
+#include "DataPlane.h"
+#include "RuntimeSocket.h"
+#include "ThreadScheduling.h"
+
+#include <BzPeri.h>
+#include <bzp/DataPlaneLayout.h>
+#include <bzp/Logger.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace bzp {
+
+namespace {
+
+constexpr std::size_t kMaxDataPlaneSlots = 1024;
+constexpr int kListenBacklog = 8;
+
+struct SlotState
+{
+	std::string name;
+	std::string objectPath;
+	uint32_t capacity = 0;
+	uint32_t valueOffset = 0;
+	uint32_t lastSequence = 0;       // consumer thread only
+	std::vector<char> snapshot;      // refreshDataPlaneValue() copy, capacity + 1 bytes
+};
+
+// Lets data getters look slots up by string_view without building a std::string per read
+struct SlotNameHash
+{
+	using is_transparent = void;
+	std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+};
+
+// Shared with readers through a shared_ptr so a concurrent stop never unmaps memory a read is copying from
+struct Region
+{
+	int memfd = -1;
+	void *mapping = MAP_FAILED;
+	std::size_t bytes = 0;
+	std::vector<SlotState> slots;
+	std::unordered_map<std::string, std::size_t, SlotNameHash, std::equal_to<>> slotIndex;
+
+	~Region()
+	{
+		if (mapping != MAP_FAILED)
+		{
+			munmap(mapping, bytes);
+		}
+		if (memfd >= 0)
+		{
+			close(memfd);
+		}
+	}
+};
+
+std::mutex lifecycleMutex;
+std::mutex regionMutex;
+std::shared_ptr<Region> activeRegion;
+std::string activePath;
+int listenFD = -1;
+int doorbellFD = -1;
+std::thread consumerThread;
+std::atomic<bool> planeActive{false};
+std::atomic<bool> stopping{false};
+std::atomic<uint64_t> doorbellCount{0};
+std::atomic<uint64_t> changedSlotCount{0};
+std::atomic<uint64_t> producersServedCount{0};
+
+std::string errnoText(int error)
+{
+	return std::strerror(error);
+}
+
+std::shared_ptr<Region> currentRegion()
+{
+	std::lock_guard<std::mutex> lock(regionMutex);
+	return activeRegion;
+}
+
+BZPDataPlaneSlot &sharedSlot(const Region &region, std::size_t index)
+{
+	return bzpDataPlaneSlots(region.mapping)[index];
+}
+
+// Seqlock read using BzPeri's own offset and capacity rather than the producer-writable descriptor
+int readSlot(const Region &region, std::size_t index, void *buffer, std::size_t bufferBytes)
+{
+	const SlotState &slot = region.slots[index];
+	BZPDataPlaneSlot &shared = sharedSlot(region, index);
+	const char *value = static_cast<const char *>(region.mapping) + slot.valueOffset;
+	for (int attempt = 0; attempt < BZP_DATA_PLANE_READ_ATTEMPTS; ++attempt)
+	{
+		const uint32_t before = __atomic_load_n(&shared.sequence, __ATOMIC_ACQUIRE);
+		if (before == 0)
+		{
+			return -1;    // never written
+		}
+		if ((before & 1u) != 0)
+		{
+			continue;
+		}
+
+		const uint32_t length = __atomic_load_n(&shared.length, __ATOMIC_RELAXED);
+		if (length > slot.capacity)
+		{
+			continue;
+		}
+		std::memcpy(buffer, value, std::min<std::size_t>(length, bufferBytes));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&shared.sequence, __ATOMIC_RELAXED) == before)
+		{
+			return static_cast<int>(length);
+		}
+	}
+	return -1;
+}
+
+// `configs` has already passed validateDataPlaneSlots()
+std::shared_ptr<Region> createRegion(const std::vector<DataPlaneSlotConfig> &configs, std::string &error)
+{
+	auto region = std::make_shared<Region>();
+	uint32_t offset = bzpDataPlaneAlign(static_cast<uint32_t>(sizeof(BZPDataPlaneHeader) + configs.size() * sizeof(BZPDataPlaneSlot)));
+	for (const DataPlaneSlotConfig &config : configs)
+	{
+		region->slotIndex.emplace(config.name, region->slots.size());
+
+		SlotState slot;
+		slot.name = config.name;
+		slot.objectPath = config.objectPath;
+		slot.capacity = config.capacity;
+		slot.valueOffset = offset;
+		slot.snapshot.assign(config.capacity + 1, '\0');
+		region->slots.push_back(std::move(slot));
+		offset += bzpDataPlaneAlign(config.capacity);
+	}
+	region->bytes = offset;
+
+	region->memfd = memfd_create("bzperi-dataplane", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	if (region->memfd < 0 || ftruncate(region->memfd, static_cast<off_t>(region->bytes)) != 0)
+	{
+		error = "unable to create the shared region: " + errnoText(errno);
+		return nullptr;
+	}
+
+	region->mapping = mmap(nullptr, region->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, region->memfd, 0);
+	if (region->mapping == MAP_FAILED)
+	{
+		error = "unable to map the shared region: " + errnoText(errno);
+		return nullptr;
+	}
+
+	auto *header = static_cast<BZPDataPlaneHeader *>(region->mapping);
+	header->magic = BZP_DATA_PLANE_MAGIC;
+	header->version = BZP_DATA_PLANE_VERSION;
+	header->slotDescriptorBytes = sizeof(BZPDataPlaneSlot);
+	header->slotCount = static_cast<uint32_t>(region->slots.size());
+	header->regionBytes = static_cast<uint32_t>(region->bytes);
+	header->doorbellArmed = 1;
+	header->serverPid = static_cast<int32_t>(getpid());
+	for (std::size_t index = 0; index < region->slots.size(); ++index)
+	{
+		BZPDataPlaneSlot &shared = sharedSlot(*region, index);
+		shared.capacity = region->slots[index].capacity;
+		shared.valueOffset = region->slots[index].valueOffset;
+		std::memcpy(shared.name, region->slots[index].name.c_str(), region->slots[index].name.size() + 1);
+	}
+
+	// Producers map the same file; sealing its size means none of them can truncate it and fault BzPeri with SIGBUS
+	if (fcntl(region->memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0)
+	{
+		error = "unable to seal the shared region: " + errnoText(errno);
+		return nullptr;
+	}
+
+	return region;
+}
+
+void serveProducers(const Region &region)
+{
+	for (;;)
+	{
+		const int fd = accept4(listenFD, nullptr, nullptr, SOCK_CLOEXEC);
+		if (fd < 0)
+		{
+			return;    // EAGAIN once the backlog is empty
+		}
+
+		char byte = 0;
+		iovec vector{&byte, 1};
+		union
+		{
+			char buffer[CMSG_SPACE(2 * sizeof(int))];
+			cmsghdr align;
+		} control{};
+		msghdr message{};
+		message.msg_iov = &vector;
+		message.msg_iovlen = 1;
+		message.msg_control = control.buffer;
+		message.msg_controllen = sizeof(control.buffer);
+		cmsghdr *header = CMSG_FIRSTHDR(&message);
+		header->cmsg_level = SOL_SOCKET;
+		header->cmsg_type = SCM_RIGHTS;
+		header->cmsg_len = CMSG_LEN(2 * sizeof(int));
+		const int descriptors[2] = {region.memfd, doorbellFD};
+		std::memcpy(CMSG_DATA(header), descriptors, sizeof(descriptors));
+
+		if (sendmsg(fd, &message, MSG_NOSIGNAL | MSG_DONTWAIT) == 1)
+		{
+			producersServedCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			Logger::warn(SSTR << "Data plane could not hand the region to a producer: " << errnoText(errno));
+		}
+		close(fd);
+	}
+}
+
+// Re-arm the doorbell before scanning: a producer that finishes a write after this point sees it armed and rings again,
+// so no change can slip between this pass and the next wakeup
+void consumeChangedSlots(Region &region)
+{
+	auto *header = static_cast<BZPDataPlaneHeader *>(region.mapping);
+	__atomic_store_n(&header->doorbellArmed, 1u, __ATOMIC_SEQ_CST);
+
+	for (std::size_t index = 0; index < region.slots.size(); ++index)
+	{
+		SlotState &slot = region.slots[index];
+		const uint32_t sequence = __atomic_load_n(&sharedSlot(region, index).sequence, __ATOMIC_ACQUIRE);
+		if ((sequence & 1u) != 0 || sequence == slot.lastSequence)
+		{
+			continue;    // unchanged, or mid-write and about to ring again
+		}
+
+		slot.lastSequence = sequence;
+		changedSlotCount.fetch_add(1, std::memory_order_relaxed);
+		if (!slot.objectPath.empty())
+		{
+			(void)bzpNotifyUpdatedCharacteristicEx(slot.objectPath.c_str());
+		}
+	}
+}
+
+void runConsumerThread(std::shared_ptr<Region> region)
+{
+	applyServerThreadScheduling("bzp-dataplane");
+
+	pollfd descriptors[2] = {{doorbellFD, POLLIN, 0}, {listenFD, POLLIN, 0}};
+	for (;;)
+	{
+		if (poll(descriptors, 2, -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			Logger::error(SSTR << "Data plane poll failed: " << errnoText(errno));
+			return;
+		}
+
+		if (stopping.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		if (descriptors[1].revents & POLLIN)
+		{
+			serveProducers(*region);
+		}
+
+		if (descriptors[0].revents & POLLIN)
+		{
+			uint64_t count = 0;
+			[[maybe_unused]] const ssize_t drained = read(doorbellFD, &count, sizeof(count));
+			doorbellCount.fetch_add(1, std::memory_order_relaxed);
+			consumeChangedSlots(*region);
+		}
+	}
+}
+
+// Hosts that never stop the data plane still get the thread joined and the socket removed at exit
+struct StopDataPlaneAtExit
+{
+	~StopDataPlaneAtExit() { stopDataPlane(); }
+} stopDataPlaneAtExit;
+
+} // namespace
+
+std::string defaultDataPlanePath(int pid)
+{
+	return runtimeSocketPath("dataplane", pid);
+}
+
+std::string validateDataPlaneSlots(const std::vector<DataPlaneSlotConfig> &slots)
+{
+	if (slots.empty() || slots.size() > kMaxDataPlaneSlots)
+	{
+		return "between 1 and " + std::to_string(kMaxDataPlaneSlots) + " slots are required";
+	}
+
+	std::unordered_set<std::string_view> names;
+	for (const DataPlaneSlotConfig &config : slots)
+	{
+		if (config.name.empty() || config.name.size() >= BZP_DATA_PLANE_NAME_BYTES)
+		{
+			return "slot names must be between 1 and " + std::to_string(BZP_DATA_PLANE_NAME_BYTES - 1) + " bytes";
+		}
+		if (config.capacity == 0 || config.capacity > BZP_DATA_PLANE_MAX_VALUE_BYTES)
+		{
+			return "slot '" + config.name + "' capacity must be between 1 and " + std::to_string(BZP_DATA_PLANE_MAX_VALUE_BYTES) + " bytes";
+		}
+		if (!names.insert(config.name).second)
+		{
+			return "slot '" + config.name + "' is declared twice";
+		}
+	}
+	return {};
+}
+
+std::string startDataPlane(const std::string &path, const std::vector<DataPlaneSlotConfig> &slots)
+{
+	std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+	if (planeActive.load(std::memory_order_acquire))
+	{
+		return "the data plane is already active on '" + activePath + "'";
+	}
+
+	sockaddr_un address{};
+	if (path.empty() || path.size() >= sizeof(address.sun_path))
+	{
+		return "socket path must be between 1 and " + std::to_string(sizeof(address.sun_path) - 1) + " bytes";
+	}
+	if (std::string problem = validateDataPlaneSlots(slots); !problem.empty())
+	{
+		return problem;
+	}
+
+	std::string error;
+	std::shared_ptr<Region> region = createRegion(slots, error);
+	if (region == nullptr)
+	{
+		return error;
+	}
+
+	if (std::string problem = prepareSocketPath(path); !problem.empty())
+	{
+		return problem;
+	}
+
+	const int socketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (socketFD < 0)
+	{
+		return "socket() failed: " + errnoText(errno);
+	}
+
+	address.sun_family = AF_UNIX;
+	std::memcpy(address.sun_path, path.c_str(), path.size());
+	if (bind(socketFD, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+		|| chmod(path.c_str(), S_IRUSR | S_IWUSR) != 0
+		|| listen(socketFD, kListenBacklog) != 0)
+	{
+		const std::string problem = "unable to listen on '" + path + "': " + errnoText(errno);
+		close(socketFD);
+		unlink(path.c_str());
+		return problem;
+	}
+
+	// Producers write the doorbell from other processes, so it must not be semaphore-style or blocking for them
+	const int eventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (eventFD < 0)
+	{
+		const std::string problem = "eventfd() failed: " + errnoText(errno);
+		close(socketFD);
+		unlink(path.c_str());
+		return problem;
+	}
+
+	listenFD = socketFD;
+	doorbellFD = eventFD;
+	activePath = path;
+	stopping.store(false, std::memory_order_release);
+	doorbellCount.store(0, std::memory_order_relaxed);
+	changedSlotCount.store(0, std::memory_order_relaxed);
+	producersServedCount.store(0, std::memory_order_relaxed);
+	{
+		std::lock_guard<std::mutex> lock(regionMutex);
+		activeRegion = region;
+	}
+	consumerThread = std::thread(runConsumerThread, region);
+	planeActive.store(true, std::memory_order_release);
+	Logger::info(SSTR << "Data plane serving " << slots.size() << " slot(s) (" << region->bytes << " bytes) on " << path);
+	return {};
+}
+
+void stopDataPlane()
+{
+	std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+	if (!planeActive.exchange(false, std::memory_order_acq_rel))
+	{
+		return;
+	}
+
+	stopping.store(true, std::memory_order_release);
+	const uint64_t one = 1;
+	[[maybe_unused]] const ssize_t written = write(doorbellFD, &one, sizeof(one));
+	if (consumerThread.joinable())
+	{
+		consumerThread.join();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(regionMutex);
+		activeRegion.reset();
+	}
+	close(listenFD);
+	close(doorbellFD);
+	listenFD = -1;
+	doorbellFD = -1;
+	unlink(activePath.c_str());
+	activePath.clear();
+}
+
+bool isDataPlaneActive() noexcept
+{
+	return planeActive.load(std::memory_order_acquire);
+}
+
+std::string dataPlanePath()
+{
+	std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+	return activePath;
+}
+
+DataPlaneStats dataPlaneStats()
+{
+	DataPlaneStats stats;
+	stats.doorbells = doorbellCount.load(std::memory_order_relaxed);
+	stats.changedSlots = changedSlotCount.load(std::memory_order_relaxed);
+	stats.producersServed = producersServedCount.load(std::memory_order_relaxed);
+	return stats;
+}
+
+int readDataPlaneValue(std::string_view name, void *buffer, std::size_t bufferBytes)
+{
+	const std::shared_ptr<Region> region = currentRegion();
+	if (region == nullptr)
+	{
+		return -1;
+	}
+
+	const auto slot = region->slotIndex.find(name);
+	return slot == region->slotIndex.end() ? -1 : readSlot(*region, slot->second, buffer, bufferBytes);
+}
+
+const void *refreshDataPlaneValue(std::string_view name, std::size_t *lengthOut)
+{
+	const std::shared_ptr<Region> region = currentRegion();
+	if (region == nullptr)
+	{
+		return nullptr;
+	}
+
+	const auto found = region->slotIndex.find(name);
+	if (found == region->slotIndex.end())
+	{
+		return nullptr;
+	}
+
+	std::vector<char> &snapshot = region->slots[found->second].snapshot;
+	const int length = readSlot(*region, found->second, snapshot.data(), snapshot.size() - 1);
+	if (length < 0)
+	{
+		return nullptr;
+	}
+
+	snapshot[static_cast<std::size_t>(length)] = '\0';
+	if (lengthOut != nullptr)
+	{
+		*lengthOut = static_cast<std::size_t>(length);
+	}
+	return snapshot.data();
+}
+
+} // namespace bzp
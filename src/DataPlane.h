@@ -0,0 +1,60 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Server side of the shared-memory data plane that lets other processes feed characteristic values without a socket hop.
+//
+// BzPeri owns a sealed memfd laid out as described in <bzp/DataPlaneLayout.h> plus an eventfd doorbell, and hands both to any
+// producer that connects to the data plane socket. A consumer thread sleeps on the doorbell; when it rings, every slot whose
+// sequence moved since the last pass gets one characteristic update queued for its object path, so a burst of samples to the
+// same slot collapses into a single notification. Reads copy straight out of shared memory under the slot's seqlock.
+//
+// The slot descriptors in shared memory are writable by producers, so BzPeri never trusts them: it reads values using its own
+// copy of each slot's offset and capacity.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bzp {
+
+struct DataPlaneSlotConfig
+{
+	std::string name;          // looked up by producers and by readers; at most BZP_DATA_PLANE_NAME_BYTES - 1 bytes
+	std::string objectPath;    // characteristic to notify when the value changes; empty for read-only slots
+	uint32_t capacity = 0;     // 1..BZP_DATA_PLANE_MAX_VALUE_BYTES
+};
+
+struct DataPlaneStats
+{
+	uint64_t doorbells = 0;        // consumer wakeups caused by producers
+	uint64_t changedSlots = 0;     // slots found changed across all wakeups
+	uint64_t producersServed = 0;  // connections handed the region
+};
+
+// Per-process socket location: $XDG_RUNTIME_DIR/bzperi/dataplane-<pid>.sock
+[[nodiscard]] std::string defaultDataPlanePath(int pid);
+
+// Empty when `slots` can be served: 1..1024 uniquely named slots with capacities of 1..BZP_DATA_PLANE_MAX_VALUE_BYTES.
+[[nodiscard]] std::string validateDataPlaneSlots(const std::vector<DataPlaneSlotConfig> &slots);
+
+// Validate `slots`, create the region and start serving it on `path`. Returns an empty string on success, otherwise a
+// description of what failed.
+[[nodiscard]] std::string startDataPlane(const std::string &path, const std::vector<DataPlaneSlotConfig> &slots);
+void stopDataPlane();
+[[nodiscard]] bool isDataPlaneActive() noexcept;
+[[nodiscard]] std::string dataPlanePath();
+[[nodiscard]] DataPlaneStats dataPlaneStats();
+
+// Consistent copy of the newest value of `name` into `buffer` (truncated to `bufferBytes`). Returns the value length, or -1
+// when the slot is unknown, has never been written, or stayed mid-write. Safe from any thread.
+int readDataPlaneValue(std::string_view name, void *buffer, std::size_t bufferBytes);
+
+// Refresh BzPeri's own NUL-terminated copy of `name` and return it, or nullptr when readDataPlaneValue() would fail. The
+// pointer stays valid until the next refresh of the same slot or stopDataPlane(); meant for data getters on the server thread.
+const void *refreshDataPlaneValue(std::string_view name, std::size_t *lengthOut = nullptr);
+
+} // namespace bzp
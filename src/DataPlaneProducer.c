@@ -0,0 +1,220 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Producer side of the shared-memory data plane. Plain C with no GLib dependency so sensor processes can link it on its own.
+
+#define _GNU_SOURCE
+
+#include "BzPeriDataPlaneProducer.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+struct BZPDataPlaneProducer
+{
+	void *region;
+	size_t regionBytes;
+	int doorbellFD;
+};
+
+int bzpDataPlaneDefaultSocketPath(int serverPid, char *pBuffer, size_t bufferBytes)
+{
+	const char *runtimeDir = getenv("XDG_RUNTIME_DIR");
+	const int written = (runtimeDir != NULL && runtimeDir[0] != '\0')
+		? snprintf(pBuffer, bufferBytes, "%s/bzperi/dataplane-%d.sock", runtimeDir, serverPid)
+		: snprintf(pBuffer, bufferBytes, "/tmp/bzperi/dataplane-%d.sock", serverPid);
+	return (written < 0 || (size_t)written >= bufferBytes) ? -1 : written;
+}
+
+// BzPeri answers every connection with one byte carrying the region memfd and the doorbell eventfd, then hangs up
+static int receiveDescriptors(int socketFD, int *regionFD, int *doorbellFD)
+{
+	char byte = 0;
+	struct iovec vector = {&byte, 1};
+	union
+	{
+		char buffer[CMSG_SPACE(2 * sizeof(int))];
+		struct cmsghdr align;
+	} control;
+	struct msghdr message;
+	memset(&message, 0, sizeof(message));
+	message.msg_iov = &vector;
+	message.msg_iovlen = 1;
+	message.msg_control = control.buffer;
+	message.msg_controllen = sizeof(control.buffer);
+
+	ssize_t received;
+	do
+	{
+		received = recvmsg(socketFD, &message, MSG_CMSG_CLOEXEC);
+	} while (received < 0 && errno == EINTR);
+	if (received <= 0)
+	{
+		errno = received == 0 ? EPROTO : errno;
+		return -1;
+	}
+
+	const struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+	if (header == NULL || header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS
+		|| header->cmsg_len != CMSG_LEN(2 * sizeof(int)))
+	{
+		errno = EPROTO;
+		return -1;
+	}
+
+	int descriptors[2];
+	memcpy(descriptors, CMSG_DATA(header), sizeof(descriptors));
+	*regionFD = descriptors[0];
+	*doorbellFD = descriptors[1];
+	return 0;
+}
+
+static int slotIsUsable(const BZPDataPlaneProducer *producer, const BZPDataPlaneSlot *slot)
+{
+	return slot->capacity <= BZP_DATA_PLANE_MAX_VALUE_BYTES
+		&& (size_t)slot->valueOffset + slot->capacity <= producer->regionBytes;
+}
+
+BZPDataPlaneProducer *bzpDataPlaneAttach(const char *pSocketPath)
+{
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	if (pSocketPath == NULL || strlen(pSocketPath) >= sizeof(address.sun_path))
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	const int socketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (socketFD < 0)
+	{
+		return NULL;
+	}
+
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, pSocketPath);
+	int regionFD = -1;
+	int doorbellFD = -1;
+	const int received = connect(socketFD, (struct sockaddr *)&address, sizeof(address)) == 0
+		? receiveDescriptors(socketFD, &regionFD, &doorbellFD)
+		: -1;
+	int savedErrno = errno;
+	close(socketFD);
+	if (received != 0)
+	{
+		errno = savedErrno;
+		return NULL;
+	}
+
+	struct stat status;
+	void *region = MAP_FAILED;
+	if (fstat(regionFD, &status) == 0)
+	{
+		region = mmap(NULL, (size_t)status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, regionFD, 0);
+	}
+	savedErrno = errno;
+	close(regionFD);
+	if (region == MAP_FAILED)
+	{
+		close(doorbellFD);
+		errno = savedErrno;
+		return NULL;
+	}
+
+	if (!bzpDataPlaneIsValid(region, (size_t)status.st_size))
+	{
+		munmap(region, (size_t)status.st_size);
+		close(doorbellFD);
+		errno = EPROTO;
+		return NULL;
+	}
+
+	BZPDataPlaneProducer *producer = (BZPDataPlaneProducer *)calloc(1, sizeof(BZPDataPlaneProducer));
+	if (producer == NULL)
+	{
+		munmap(region, (size_t)status.st_size);
+		close(doorbellFD);
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	producer->region = region;
+	producer->regionBytes = (size_t)status.st_size;
+	producer->doorbellFD = doorbellFD;
+	return producer;
+}
+
+void bzpDataPlaneDetach(BZPDataPlaneProducer *pProducer)
+{
+	if (pProducer == NULL)
+	{
+		return;
+	}
+
+	munmap(pProducer->region, pProducer->regionBytes);
+	close(pProducer->doorbellFD);
+	free(pProducer);
+}
+
+int bzpDataPlaneFindSlot(const BZPDataPlaneProducer *pProducer, const char *pName)
+{
+	if (pProducer == NULL || pName == NULL)
+	{
+		return -1;
+	}
+
+	const BZPDataPlaneHeader *header = (const BZPDataPlaneHeader *)pProducer->region;
+	const BZPDataPlaneSlot *slots = bzpDataPlaneSlots(pProducer->region);
+	for (uint32_t index = 0; index < header->slotCount; ++index)
+	{
+		if (strncmp(slots[index].name, pName, BZP_DATA_PLANE_NAME_BYTES) == 0 && slotIsUsable(pProducer, &slots[index]))
+		{
+			return (int)index;
+		}
+	}
+	return -1;
+}
+
+uint32_t bzpDataPlaneSlotCapacity(const BZPDataPlaneProducer *pProducer, int slot)
+{
+	if (pProducer == NULL || slot < 0 || (uint32_t)slot >= ((const BZPDataPlaneHeader *)pProducer->region)->slotCount)
+	{
+		return 0;
+	}
+	return bzpDataPlaneSlots(pProducer->region)[slot].capacity;
+}
+
+int bzpDataPlanePublish(BZPDataPlaneProducer *pProducer, int slot, const void *pData, uint32_t length)
+{
+	if (pProducer == NULL || slot < 0 || (uint32_t)slot >= ((const BZPDataPlaneHeader *)pProducer->region)->slotCount
+		|| (pData == NULL && length != 0) || !slotIsUsable(pProducer, &bzpDataPlaneSlots(pProducer->region)[slot]))
+	{
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (bzpDataPlaneWriteSlot(pProducer->region, (uint32_t)slot, pData, length) < 0)
+	{
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (bzpDataPlaneClaimDoorbell(pProducer->region))
+	{
+		const uint64_t one = 1;
+		ssize_t written;
+		do
+		{
+			written = write(pProducer->doorbellFD, &one, sizeof(one));
+		} while (written < 0 && errno == EINTR);
+		// EAGAIN means the counter is saturated, which still leaves BzPeri woken
+	}
+	return 0;
+}
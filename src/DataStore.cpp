@@ -0,0 +1,274 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// See the discussion at the top of DataStore.h
+
+#include "DataStore.h"
+
+#include <bzp/Logger.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace bzp {
+
+namespace {
+
+constexpr int kReadAttempts = 1024;
+constexpr int kSpinsBeforeYield = 64;
+
+struct Slot
+{
+	std::string name;
+	std::string objectPath;
+	BZPDataSlotType type = BZP_DATA_SLOT_FIXED;
+	uint32_t size = 0;
+	std::atomic<uint32_t> sequence{0};     // odd while a write is in progress, 0 until the first write
+	std::atomic<uint32_t> length{0};
+	std::unique_ptr<unsigned char[]> value;
+	std::vector<char> snapshot;            // dataStoreGetter() copy, size + 1 bytes; server thread only
+};
+
+struct SlotNameHash
+{
+	using is_transparent = void;
+	std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+};
+
+// Slots are published by bumping slotCount after they are fully built, so handle lookups never need the registry lock
+std::array<std::unique_ptr<Slot>, kMaxDataSlots> slots;
+std::atomic<std::size_t> slotCount{0};
+std::mutex registryMutex;
+std::unordered_map<std::string, int, SlotNameHash, std::equal_to<>> slotsByName;
+
+Slot *slotForHandle(int handle) noexcept
+{
+	if (handle < 0 || static_cast<std::size_t>(handle) >= slotCount.load(std::memory_order_acquire))
+	{
+		return nullptr;
+	}
+	return slots[static_cast<std::size_t>(handle)].get();
+}
+
+// Claim the slot for writing by moving its sequence from even to odd; concurrent writers to the same slot take turns
+uint32_t beginWrite(Slot &slot)
+{
+	uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+	for (int spins = 0;; ++spins)
+	{
+		if ((sequence & 1u) == 0
+			&& slot.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			std::atomic_thread_fence(std::memory_order_release);
+			return sequence;
+		}
+		if ((sequence & 1u) != 0)
+		{
+			if (spins >= kSpinsBeforeYield)
+			{
+				std::this_thread::yield();
+			}
+			sequence = slot.sequence.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+BZPDataStoreResult readSlot(const Slot &slot, void *buffer, std::size_t bufferBytes, uint32_t *lengthOut)
+{
+	for (int attempt = 0; attempt < kReadAttempts; ++attempt)
+	{
+		const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+		if (before == 0)
+		{
+			return BZP_DATA_STORE_EMPTY;
+		}
+		if ((before & 1u) != 0)
+		{
+			if (attempt >= kSpinsBeforeYield)
+			{
+				std::this_thread::yield();
+			}
+			continue;
+		}
+
+		const uint32_t length = slot.length.load(std::memory_order_relaxed);
+		if (buffer != nullptr)
+		{
+			std::memcpy(buffer, slot.value.get(), std::min<std::size_t>(length, bufferBytes));
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) == before)
+		{
+			if (lengthOut != nullptr)
+			{
+				*lengthOut = length;
+			}
+			return BZP_DATA_STORE_OK;
+		}
+	}
+	return BZP_DATA_STORE_BUSY;
+}
+
+} // namespace
+
+BZPDataStoreResult registerDataSlot(std::string_view name, BZPDataSlotType type, uint32_t sizeBytes, std::string_view objectPath,
+	int &handle)
+{
+	handle = -1;
+	if (name.empty() || sizeBytes == 0 || sizeBytes > kMaxDataSlotBytes
+		|| (type != BZP_DATA_SLOT_FIXED && type != BZP_DATA_SLOT_TEXT))
+	{
+		return BZP_DATA_STORE_INVALID_ARGUMENT;
+	}
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	if (const auto found = slotsByName.find(name); found != slotsByName.end())
+	{
+		const Slot &existing = *slots[static_cast<std::size_t>(found->second)];
+		if (existing.type != type || existing.size != sizeBytes || existing.objectPath != objectPath)
+		{
+			return BZP_DATA_STORE_CONFLICT;
+		}
+		handle = found->second;
+		return BZP_DATA_STORE_OK;
+	}
+
+	const std::size_t index = slotCount.load(std::memory_order_relaxed);
+	if (index >= kMaxDataSlots)
+	{
+		return BZP_DATA_STORE_FULL;
+	}
+
+	auto slot = std::make_unique<Slot>();
+	slot->name = std::string(name);
+	slot->objectPath = std::string(objectPath);
+	slot->type = type;
+	slot->size = sizeBytes;
+	slot->value = std::make_unique<unsigned char[]>(sizeBytes);
+	slot->snapshot.assign(sizeBytes + 1, '\0');
+	slots[index] = std::move(slot);
+	slotsByName.emplace(std::string(name), static_cast<int>(index));
+	slotCount.store(index + 1, std::memory_order_release);
+
+	handle = static_cast<int>(index);
+	return BZP_DATA_STORE_OK;
+}
+
+int findDataSlot(std::string_view name)
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+	const auto found = slotsByName.find(name);
+	return found != slotsByName.end() ? found->second : -1;
+}
+
+uint32_t dataSlotSize(int handle) noexcept
+{
+	const Slot *slot = slotForHandle(handle);
+	return slot != nullptr ? slot->size : 0;
+}
+
+BZPDataStoreResult writeDataSlot(int handle, const void *data, uint32_t length, bool notify)
+{
+	Slot *slot = slotForHandle(handle);
+	if (slot == nullptr)
+	{
+		return BZP_DATA_STORE_UNKNOWN_HANDLE;
+	}
+	if (data == nullptr && length != 0)
+	{
+		return BZP_DATA_STORE_INVALID_ARGUMENT;
+	}
+	if (slot->type == BZP_DATA_SLOT_FIXED ? length != slot->size : length > slot->size)
+	{
+		return BZP_DATA_STORE_SIZE_MISMATCH;
+	}
+
+	// As the only writer while the sequence is odd, the previous value can be compared in place
+	const uint32_t sequence = beginWrite(*slot);
+	const bool changed = sequence == 0
+		|| slot->length.load(std::memory_order_relaxed) != length
+		|| (length != 0 && std::memcmp(slot->value.get(), data, length) != 0);
+	if (changed && length != 0)
+	{
+		std::memcpy(slot->value.get(), data, length);
+	}
+	slot->length.store(length, std::memory_order_relaxed);
+	slot->sequence.store(sequence + 2, std::memory_order_release);
+
+	if (notify && changed && !slot->objectPath.empty())
+	{
+		// Not running yet is fine: the value is stored and the next read picks it up
+		(void)bzpNotifyUpdatedCharacteristicEx(slot->objectPath.c_str());
+	}
+	return BZP_DATA_STORE_OK;
+}
+
+BZPDataStoreResult readDataSlot(int handle, void *buffer, std::size_t bufferBytes, uint32_t *lengthOut)
+{
+	const Slot *slot = slotForHandle(handle);
+	if (slot == nullptr)
+	{
+		return BZP_DATA_STORE_UNKNOWN_HANDLE;
+	}
+	if (buffer == nullptr && bufferBytes != 0)
+	{
+		return BZP_DATA_STORE_INVALID_ARGUMENT;
+	}
+	return readSlot(*slot, buffer, bufferBytes, lengthOut);
+}
+
+const void *dataStoreGetter(const char *pName)
+{
+	if (pName == nullptr)
+	{
+		return nullptr;
+	}
+
+	Slot *slot = slotForHandle(findDataSlot(pName));
+	if (slot == nullptr)
+	{
+		Logger::warn(SSTR << "Unknown name for server data getter request: '" << pName << "'");
+		return nullptr;
+	}
+
+	uint32_t length = 0;
+	if (readSlot(*slot, slot->snapshot.data(), slot->size, &length) != BZP_DATA_STORE_OK)
+	{
+		return nullptr;
+	}
+	slot->snapshot[length] = '\0';
+	return slot->snapshot.data();
+}
+
+int dataStoreSetter(const char *pName, const void *pData)
+{
+	if (pName == nullptr || pData == nullptr)
+	{
+		return 0;
+	}
+
+	const int handle = findDataSlot(pName);
+	const Slot *slot = slotForHandle(handle);
+	if (slot == nullptr)
+	{
+		Logger::warn(SSTR << "Unknown name for server data setter request: '" << pName << "'");
+		return 0;
+	}
+
+	// The legacy contract carries no length: fixed slots take their registered size, text slots a NUL-terminated string
+	const uint32_t length = slot->type == BZP_DATA_SLOT_FIXED
+		? slot->size
+		: static_cast<uint32_t>(strnlen(static_cast<const char *>(pData), slot->size + 1));
+	return writeDataSlot(handle, pData, length, false) == BZP_DATA_STORE_OK ? 1 : 0;
+}
+
+} // namespace bzp
@@ -0,0 +1,46 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Handle-based typed data store behind the `bzpData*()` C API.
+//
+// Hosts register each named value once and get back a small integer handle; reads and writes then index a fixed table instead
+// of matching strings. Every slot is a seqlock: writers (serialized among themselves per slot) never block readers, and readers
+// retry until they copy a value no write overlapped. Slots bound to a characteristic queue an update whenever a write changes
+// their bytes. The string-keyed `BZPServerDataGetter` / `BZPServerDataSetter` contract is served on top of this through
+// `dataStoreGetter()` / `dataStoreSetter()`.
+//
+// Slots live for the rest of the process once registered, so a handle never dangles.
+
+#pragma once
+
+#include <BzPeri.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace bzp {
+
+inline constexpr std::size_t kMaxDataSlots = 256;
+inline constexpr uint32_t kMaxDataSlotBytes = 512;
+
+// Registering an identical slot again returns the existing handle; a different type, size or object path is a conflict.
+BZPDataStoreResult registerDataSlot(std::string_view name, BZPDataSlotType type, uint32_t sizeBytes, std::string_view objectPath,
+	int &handle);
+[[nodiscard]] int findDataSlot(std::string_view name);
+[[nodiscard]] uint32_t dataSlotSize(int handle) noexcept;
+
+// Fixed slots take exactly their size; text slots take up to their size, without a terminator. `notify` queues an update for
+// the bound characteristic when the stored bytes changed.
+BZPDataStoreResult writeDataSlot(int handle, const void *data, uint32_t length, bool notify = true);
+
+// Consistent copy of the newest value into `buffer` (truncated to `bufferBytes`); `lengthOut` receives the full length.
+BZPDataStoreResult readDataSlot(int handle, void *buffer, std::size_t bufferBytes, uint32_t *lengthOut = nullptr);
+
+// Legacy delegate adapters. The getter refreshes the slot's own NUL-terminated copy and returns it, so its pointer stays valid
+// until the next getter call for that name; call it from the server thread only. The setter stores without queueing an update
+// because it runs inside the characteristic's write handler, which raises its own.
+const void *dataStoreGetter(const char *pName);
+int dataStoreSetter(const char *pName, const void *pData);
+
+} // namespace bzp
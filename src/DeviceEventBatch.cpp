@@ -0,0 +1,69 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// See the discussion at the top of DeviceEventBatch.h
+
+#include "DeviceEventBatch.h"
+
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+namespace bzp::detail {
+
+ConnectionChanges applyDeviceEvents(std::unordered_map<std::string, DeviceInfo> &devices,
+	const std::vector<PendingDeviceEvent> &events)
+{
+	const auto isConnected = [&devices](const std::string &path) {
+		const auto found = devices.find(path);
+		return found != devices.end() && found->second.connected;
+	};
+
+	// State of each device before its first event in this batch
+	std::vector<std::pair<std::string, bool>> touched;
+	std::unordered_set<std::string_view> seen;
+	for (const PendingDeviceEvent &pending : events)
+	{
+		if (seen.insert(pending.path).second)
+		{
+			touched.emplace_back(pending.path, isConnected(pending.path));
+		}
+
+		switch (pending.event)
+		{
+			case DeviceEvent::Connected:
+			{
+				DeviceInfo &info = devices[pending.path];
+				info.path = pending.path;
+				info.connected = true;
+				break;
+			}
+			case DeviceEvent::Disconnected:
+				if (const auto found = devices.find(pending.path); found != devices.end())
+				{
+					found->second.connected = false;
+				}
+				break;
+			case DeviceEvent::Removed:
+				devices.erase(pending.path);
+				break;
+		}
+	}
+
+	ConnectionChanges changes;
+	for (const auto &[path, wasConnected] : touched)
+	{
+		const bool connected = isConnected(path);
+		if (connected && !wasConnected)
+		{
+			changes.added.push_back(path);
+		}
+		else if (!connected && wasConnected)
+		{
+			changes.removed.push_back(path);
+		}
+	}
+	return changes;
+}
+
+} // namespace bzp::detail
@@ -0,0 +1,46 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Device connection events, folded into batches.
+//
+// BluezAdapter does not apply Device1 connects, disconnects and removals one signal at a time. It queues them and applies
+// everything queued during a loop iteration at once: one pass under the device map's lock, one log line, one update of the
+// connection count and one aggregated callback with the devices that actually changed state. Anything that follows the
+// connection state (the standalone inspect snapshot, for one) therefore refreshes once per batch, not once per device.
+
+#pragma once
+
+#include <bzp/BluezTypes.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bzp::detail {
+
+enum class DeviceEvent : uint8_t
+{
+	Connected,
+	Disconnected,
+	Removed      // Device1 interface went away
+};
+
+struct PendingDeviceEvent
+{
+	std::string path;
+	DeviceEvent event = DeviceEvent::Connected;
+};
+
+struct ConnectionChanges
+{
+	std::vector<std::string> added;      // connected after the batch, not before it
+	std::vector<std::string> removed;    // connected before the batch, not after it
+};
+
+// Applies `events` to `devices` in order and returns the net change, in the order devices first appear in the batch. A device
+// that connects and drops again within one batch shows up in neither list.
+ConnectionChanges applyDeviceEvents(std::unordered_map<std::string, DeviceInfo> &devices,
+	const std::vector<PendingDeviceEvent> &events);
+
+} // namespace bzp::detail
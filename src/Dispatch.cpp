@@ -0,0 +1,206 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// See the discussion at the top of Dispatch.h
+
+#include "Dispatch.h"
+#include "EventStream.h"
+
+#include <bzp/GattProperty.h>
+#include <bzp/Logger.h>
+#include <bzp/Server.h>
+
+#include <gio/gio.h>
+
+#include <string>
+#include <string_view>
+
+namespace bzp {
+
+namespace {
+
+// "[sender]:[path]:[interface]:[member]" for messages about a dispatch. Built only when something is logged or fails, so the
+// steady-state paths below stay off the heap.
+std::string describeDispatch(const gchar *pSender, const gchar *pObjectPath, const gchar *pInterfaceName, const gchar *pMember)
+{
+	const auto text = [](const gchar *pText) { return pText != nullptr ? pText : ""; };
+	return std::string("[") + text(pSender) + "]:[" + text(pObjectPath) + "]:[" + text(pInterfaceName) + "]:[" + text(pMember) + "]";
+}
+
+} // namespace
+
+bool dispatchMethodCall(const Server &server, const gchar *pSender, const gchar *pObjectPath, const gchar *pInterfaceName,
+	const gchar *pMethodName, DBusMethodCallRef methodCall)
+{
+	EventStreamDispatchScope dispatch(EventStreamDispatchKind::Method, pObjectPath, pInterfaceName, pMethodName);
+
+	if (!server.callMethod(std::string_view(pObjectPath), pInterfaceName, pMethodName, methodCall))
+	{
+		Logger::error(SSTR << " + Method not found: " << describeDispatch(pSender, pObjectPath, pInterfaceName, pMethodName));
+		methodCall.returnDbusError(server.getNotImplementedErrorName().c_str(), "This method is not implemented");
+		return false;
+	}
+
+	dispatch.setSucceeded(true);
+	return true;
+}
+
+GVariant *dispatchGetProperty(const Server &server, GDBusConnection *pConnection, const gchar *pSender, const gchar *pObjectPath,
+	const gchar *pInterfaceName, const gchar *pPropertyName, GError **ppError, gpointer pUserData)
+{
+	const GattProperty *pProperty = server.findProperty(std::string_view(pObjectPath), pInterfaceName, pPropertyName);
+	EventStreamDispatchScope dispatch(EventStreamDispatchKind::GetProperty, pObjectPath, pInterfaceName, pPropertyName);
+
+	if (!pProperty)
+	{
+		const std::string propertyPath = describeDispatch(pSender, pObjectPath, pInterfaceName, pPropertyName);
+		Logger::error(SSTR << "Property(get) not found: " << propertyPath);
+	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, "Property(get) not found: %s", propertyPath.c_str());
+		return nullptr;
+	}
+
+	const DBusPropertyCallRef propertyCall(
+		DBusConnectionRef(pConnection),
+		pSender != nullptr ? std::string_view(pSender) : std::string_view(),
+		std::string_view(pObjectPath),
+		pInterfaceName != nullptr ? std::string_view(pInterfaceName) : std::string_view(),
+		pPropertyName != nullptr ? std::string_view(pPropertyName) : std::string_view(),
+		DBusVariantRef(),
+		DBusErrorRef(ppError),
+		pUserData);
+
+	const auto &getterCallHandler = pProperty->getGetterCallHandler();
+	const auto &getterHandler = pProperty->getGetterHandler();
+#if BZP_ENABLE_LEGACY_RAW_GLIB_COMPAT
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+	const auto rawGetterFunc = pProperty->getGetterFunc();
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#else
+	const auto rawGetterFunc = static_cast<GDBusInterfaceGetPropertyFunc>(nullptr);
+#endif
+	if (!getterCallHandler && !getterHandler && !rawGetterFunc)
+	{
+		const std::string propertyPath = describeDispatch(pSender, pObjectPath, pInterfaceName, pPropertyName);
+		Logger::error(SSTR << "Property(get) func not found: " << propertyPath);
+	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, "Property(get) func not found: %s", propertyPath.c_str());
+		return nullptr;
+	}
+
+	LOG_INFO_STREAM(SSTR << "Calling property getter: " << describeDispatch(pSender, pObjectPath, pInterfaceName, pPropertyName));
+	GVariant *pResult = nullptr;
+	if (getterCallHandler)
+	{
+		pResult = getterCallHandler(propertyCall).get();
+	}
+	else if (getterHandler)
+	{
+		pResult = getterHandler(
+			propertyCall.connection(),
+			propertyCall.sender(),
+			propertyCall.objectPath(),
+			propertyCall.interfaceName(),
+			propertyCall.propertyName(),
+			propertyCall.error(),
+			propertyCall.userData()).get();
+	}
+	else
+	{
+		pResult = rawGetterFunc(pConnection, pSender, pObjectPath, pInterfaceName, pPropertyName, ppError, pUserData);
+	}
+
+	if (nullptr == pResult)
+	{
+		if (ppError != nullptr && *ppError != nullptr)
+		{
+			return nullptr;
+		}
+	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, "Property(get) failed: %s",
+			describeDispatch(pSender, pObjectPath, pInterfaceName, pPropertyName).c_str());
+	    return nullptr;
+	}
+
+	dispatch.setSucceeded(true);
+	return pResult;
+}
+
+gboolean dispatchSetProperty(const Server &server, GDBusConnection *pConnection, const gchar *pSender, const gchar *pObjectPath,
+	const gchar *pInterfaceName, const gchar *pPropertyName, GVariant *pValue, GError **ppError, gpointer pUserData)
+{
+	const GattProperty *pProperty = server.findProperty(std::string_view(pObjectPath), pInterfaceName, pPropertyName);
+	EventStreamDispatchScope dispatch(EventStreamDispatchKind::SetProperty, pObjectPath, pInterfaceName, pPropertyName);
+
+	if (!pProperty)
+	{
+		const std::string propertyPath = describeDispatch(pSender, pObjectPath, pInterfaceName, pPropertyName);
+		Logger::error(SSTR << "Property(set) not found: " << propertyPath);
+	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, "Property(set) not found: %s", propertyPath.c_str());
+		return false;
+	}
+
+	const DBusPropertyCallRef propertyCall(
+		DBusConnectionRef(pConnection),
+		pSender != nullptr ? std::string_view(pSender) : std::string_view(),
+		std::string_view(pObjectPath),
+		pInterfaceName != nullptr ? std::string_view(pInterfaceName) : std::string_view(),
+		pPropertyName != nullptr ? std::string_view(pPropertyName) : std::string_view(),
+		DBusVariantRef(pValue),
+		DBusErrorRef(ppError),
+		pUserData);
+
+	const auto &setterCallHandler = pProperty->getSetterCallHandler();
+	const auto &setterHandler = pProperty->getSetterHandler();
+#if BZP_ENABLE_LEGACY_RAW_GLIB_COMPAT
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+	const auto rawSetterFunc = pProperty->getSetterFunc();
+#if defined(__clang__) || defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#else
+	const auto rawSetterFunc = static_cast<GDBusInterfaceSetPropertyFunc>(nullptr);
+#endif
+	if (!setterCallHandler && !setterHandler && !rawSetterFunc)
+	{
+		const std::string propertyPath = describeDispatch(pSender, pObjectPath, pInterfaceName, pPropertyName);
+		Logger::error(SSTR << "Property(set) func not found: " << propertyPath);
+	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, "Property(set) func not found: %s", propertyPath.c_str());
+		return false;
+	}
+
+	LOG_INFO_STREAM(SSTR << "Calling property setter: " << describeDispatch(pSender, pObjectPath, pInterfaceName, pPropertyName));
+	const bool success = setterCallHandler
+		? setterCallHandler(propertyCall)
+		: setterHandler
+			? setterHandler(
+				propertyCall.connection(),
+				propertyCall.sender(),
+				propertyCall.objectPath(),
+				propertyCall.interfaceName(),
+				propertyCall.propertyName(),
+				propertyCall.value(),
+				propertyCall.error(),
+				propertyCall.userData())
+			: rawSetterFunc(pConnection, pSender, pObjectPath, pInterfaceName, pPropertyName, pValue, ppError, pUserData);
+	dispatch.setSucceeded(success);
+	if (!success)
+	{
+		if (ppError != nullptr && *ppError != nullptr)
+		{
+			return false;
+		}
+	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, "Property(set) failed: %s",
+			describeDispatch(pSender, pObjectPath, pInterfaceName, pPropertyName).c_str());
+	    return false;
+	}
+
+	return true;
+}
+
+} // namespace bzp
@@ -0,0 +1,30 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Method call and property dispatch into a server's object tree.
+//
+// The GDBus vtable handlers in Init.cpp pass every incoming message here together with the running server. `LoopbackTransport`
+// calls the same functions with the server it was given, so a call made without a bus goes through the same lookup, handler
+// selection, event stream record, logging and error replies as one that arrived from BlueZ.
+
+#pragma once
+
+#include <bzp/GLibTypes.h>
+
+namespace bzp {
+
+struct Server;
+
+// Returns false when nothing matched, after replying with the server's NotImplemented error through `methodCall`
+bool dispatchMethodCall(const Server &server, const gchar *pSender, const gchar *pObjectPath, const gchar *pInterfaceName,
+	const gchar *pMethodName, DBusMethodCallRef methodCall);
+
+// Same contract as GDBusInterfaceGetPropertyFunc: a (possibly floating) value, or nullptr with `ppError` set
+GVariant *dispatchGetProperty(const Server &server, GDBusConnection *pConnection, const gchar *pSender, const gchar *pObjectPath,
+	const gchar *pInterfaceName, const gchar *pPropertyName, GError **ppError, gpointer pUserData);
+
+// Same contract as GDBusInterfaceSetPropertyFunc
+gboolean dispatchSetProperty(const Server &server, GDBusConnection *pConnection, const gchar *pSender, const gchar *pObjectPath,
+	const gchar *pInterfaceName, const gchar *pPropertyName, GVariant *pValue, GError **ppError, gpointer pUserData);
+
+} // namespace bzp
@@ -0,0 +1,633 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Optional Unix-socket endpoint that streams structured server events to live inspectors.
+
+#include "EventStream.h"
+#include "RuntimeSocket.h"
+#include "ThreadScheduling.h"
+
+#include <bzp/Logger.h>
+#include <glib.h>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace bzp {
+
+namespace {
+
+constexpr std::size_t kMaxDispatchFieldLength = 1024;
+constexpr std::size_t kMinimumSubscriberBufferBytes = 1024;
+constexpr int kListenBacklog = 8;
+constexpr std::size_t kDroppedFrameLength = kEventStreamFrameHeaderLength + 4;
+
+struct Subscriber
+{
+	int fd = -1;
+	std::string pending;
+	uint32_t dropped = 0;    // not yet reported to this subscriber
+};
+
+struct EventStreamState
+{
+	std::mutex mutex;
+	std::vector<Subscriber> subscribers;
+	std::size_t bufferLimit = kDefaultEventStreamSubscriberBufferBytes;
+	std::string path;
+	int listenFD = -1;
+	int wakeFD = -1;
+	bool stopping = false;
+	std::thread thread;
+};
+
+// Serializes start/stop so the thread handle and descriptors are never torn down twice
+std::mutex lifecycleMutex;
+EventStreamState stream;
+std::atomic<bool> streamActive{false};
+std::atomic<std::size_t> subscriberCount{0};
+std::atomic<int> lastRunState{0};
+std::atomic<int> lastHealth{0};
+
+uint64_t nowUs()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void putU16(std::string &out, uint16_t value)
+{
+	out.push_back(static_cast<char>(value & 0xFF));
+	out.push_back(static_cast<char>(value >> 8));
+}
+
+void putU32(std::string &out, uint32_t value)
+{
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		out.push_back(static_cast<char>((value >> shift) & 0xFF));
+	}
+}
+
+void putU64(std::string &out, uint64_t value)
+{
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		out.push_back(static_cast<char>((value >> shift) & 0xFF));
+	}
+}
+
+void putString(std::string &out, std::string_view text)
+{
+	text = text.substr(0, kMaxDispatchFieldLength);
+	putU16(out, static_cast<uint16_t>(text.size()));
+	out.append(text.data(), text.size());
+}
+
+uint64_t getLE(const std::string &in, std::size_t offset, int bytes)
+{
+	uint64_t value = 0;
+	for (int index = 0; index < bytes; ++index)
+	{
+		value |= static_cast<uint64_t>(static_cast<unsigned char>(in[offset + index])) << (index * 8);
+	}
+	return value;
+}
+
+bool getString(const std::string &payload, std::size_t &offset, std::string &out)
+{
+	if (offset + 2 > payload.size())
+	{
+		return false;
+	}
+	const std::size_t length = getLE(payload, offset, 2);
+	offset += 2;
+	if (offset + length > payload.size())
+	{
+		return false;
+	}
+	out.assign(payload, offset, length);
+	offset += length;
+	return true;
+}
+
+bool decodePayload(EventStreamEvent &event, uint8_t detail, const std::string &payload)
+{
+	switch (event.type)
+	{
+		case EventStreamFrameType::Hello:
+			if (payload.size() < 6) return false;
+			event.pid = static_cast<uint32_t>(getLE(payload, 0, 4));
+			event.protocolVersion = static_cast<uint16_t>(getLE(payload, 4, 2));
+			return true;
+		case EventStreamFrameType::State:
+			if (payload.size() < 2) return false;
+			event.runState = static_cast<unsigned char>(payload[0]);
+			event.health = static_cast<unsigned char>(payload[1]);
+			return true;
+		case EventStreamFrameType::Dispatch:
+		{
+			if (payload.size() < 4) return false;
+			event.dispatchKind = static_cast<EventStreamDispatchKind>(detail & 0x7F);
+			event.succeeded = (detail & 0x80) != 0;
+			event.durationUs = static_cast<uint32_t>(getLE(payload, 0, 4));
+			std::size_t offset = 4;
+			return getString(payload, offset, event.objectPath)
+				&& getString(payload, offset, event.interfaceName)
+				&& getString(payload, offset, event.member);
+		}
+		case EventStreamFrameType::QueueStats:
+			if (payload.size() < 8) return false;
+			event.updateQueueDepth = static_cast<uint32_t>(getLE(payload, 0, 4));
+			event.updatesProcessed = static_cast<uint32_t>(getLE(payload, 4, 4));
+			return true;
+		case EventStreamFrameType::Dropped:
+			if (payload.size() < 4) return false;
+			event.droppedCount = static_cast<uint32_t>(getLE(payload, 0, 4));
+			return true;
+	}
+
+	return false;
+}
+
+std::string errnoText(int error)
+{
+	return std::strerror(error);
+}
+
+// Append `frame` unless it would overflow the subscriber's buffer. A pending drop count is reported in front of the first
+// frame that fits again, so the subscriber sees exactly where the gap is. Returns true when the buffer went from empty to
+// non-empty and the stream thread needs waking.
+bool enqueueLocked(Subscriber &subscriber, const std::string &frame, std::size_t limit)
+{
+	const std::size_t droppedFrameLength = subscriber.dropped != 0 ? kDroppedFrameLength : 0;
+	if (subscriber.pending.size() + droppedFrameLength + frame.size() > limit)
+	{
+		++subscriber.dropped;
+		return false;
+	}
+
+	const bool wasEmpty = subscriber.pending.empty();
+	if (subscriber.dropped != 0)
+	{
+		EventStreamEvent dropped;
+		dropped.type = EventStreamFrameType::Dropped;
+		dropped.timestampUs = nowUs();
+		dropped.droppedCount = subscriber.dropped;
+		subscriber.pending += detail::encodeEventStreamFrame(dropped);
+		subscriber.dropped = 0;
+	}
+	subscriber.pending += frame;
+	return wasEmpty;
+}
+
+// Called with the state mutex held so the descriptor cannot be closed underneath us
+void wakeStreamThreadLocked()
+{
+	const uint64_t one = 1;
+	if (stream.wakeFD >= 0)
+	{
+		[[maybe_unused]] const ssize_t written = write(stream.wakeFD, &one, sizeof(one));
+	}
+}
+
+void publish(const EventStreamEvent &event)
+{
+	const std::string frame = detail::encodeEventStreamFrame(event);
+	std::lock_guard<std::mutex> lock(stream.mutex);
+	bool wake = false;
+	for (Subscriber &subscriber : stream.subscribers)
+	{
+		wake = enqueueLocked(subscriber, frame, stream.bufferLimit) || wake;
+	}
+
+	if (wake)
+	{
+		wakeStreamThreadLocked();
+	}
+}
+
+void closeSubscriberLocked(std::size_t index)
+{
+	close(stream.subscribers[index].fd);
+	stream.subscribers.erase(stream.subscribers.begin() + static_cast<std::ptrdiff_t>(index));
+	subscriberCount.store(stream.subscribers.size(), std::memory_order_release);
+}
+
+void acceptSubscribers()
+{
+	for (;;)
+	{
+		const int fd = accept4(stream.listenFD, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0)
+		{
+			return;    // EAGAIN once the backlog is empty; anything else is retried on the next readiness
+		}
+
+		EventStreamEvent hello;
+		hello.type = EventStreamFrameType::Hello;
+		hello.timestampUs = nowUs();
+		hello.pid = static_cast<uint32_t>(getpid());
+		hello.protocolVersion = kEventStreamProtocolVersion;
+
+		EventStreamEvent state;
+		state.type = EventStreamFrameType::State;
+		state.timestampUs = hello.timestampUs;
+		state.runState = lastRunState.load(std::memory_order_acquire);
+		state.health = lastHealth.load(std::memory_order_acquire);
+
+		std::lock_guard<std::mutex> lock(stream.mutex);
+		Subscriber subscriber;
+		subscriber.fd = fd;
+		subscriber.pending = detail::encodeEventStreamFrame(hello) + detail::encodeEventStreamFrame(state);
+		stream.subscribers.push_back(std::move(subscriber));
+		subscriberCount.store(stream.subscribers.size(), std::memory_order_release);
+	}
+}
+
+// Returns false when the subscriber has gone away
+bool flushSubscriberLocked(Subscriber &subscriber)
+{
+	while (!subscriber.pending.empty())
+	{
+		const ssize_t sent = send(subscriber.fd, subscriber.pending.data(), subscriber.pending.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+		if (sent < 0)
+		{
+			return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+		}
+		subscriber.pending.erase(0, static_cast<std::size_t>(sent));
+	}
+	return true;
+}
+
+void runStreamThread()
+{
+	applyServerThreadScheduling("bzp-events");
+
+	std::vector<pollfd> descriptors;
+	for (;;)
+	{
+		descriptors.clear();
+		descriptors.push_back({stream.wakeFD, POLLIN, 0});
+		descriptors.push_back({stream.listenFD, POLLIN, 0});
+		{
+			std::lock_guard<std::mutex> lock(stream.mutex);
+			if (stream.stopping)
+			{
+				return;
+			}
+
+			// Inspectors never send anything, so readability on a subscriber only ever means it hung up
+			for (const Subscriber &subscriber : stream.subscribers)
+			{
+				const short events = static_cast<short>(POLLIN | (subscriber.pending.empty() ? 0 : POLLOUT));
+				descriptors.push_back({subscriber.fd, events, 0});
+			}
+		}
+
+		if (poll(descriptors.data(), descriptors.size(), -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			Logger::error(SSTR << "Event stream poll failed: " << errnoText(errno));
+			return;
+		}
+
+		if (descriptors[0].revents & POLLIN)
+		{
+			uint64_t count = 0;
+			[[maybe_unused]] const ssize_t drained = read(stream.wakeFD, &count, sizeof(count));
+		}
+
+		if (descriptors[1].revents & POLLIN)
+		{
+			acceptSubscribers();
+		}
+
+		std::lock_guard<std::mutex> lock(stream.mutex);
+		for (std::size_t polled = descriptors.size(); polled-- > 2;)
+		{
+			const int fd = descriptors[polled].fd;
+			const auto subscriber = std::find_if(stream.subscribers.begin(), stream.subscribers.end(),
+				[fd](const Subscriber &candidate) { return candidate.fd == fd; });
+			if (subscriber == stream.subscribers.end())
+			{
+				continue;
+			}
+
+			const std::size_t index = static_cast<std::size_t>(subscriber - stream.subscribers.begin());
+			const short revents = descriptors[polled].revents;
+			bool alive = (revents & (POLLHUP | POLLERR | POLLNVAL)) == 0;
+			if (alive && (revents & POLLIN))
+			{
+				char discard[64];
+				const ssize_t received = recv(fd, discard, sizeof(discard), MSG_DONTWAIT);
+				alive = received > 0 || (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR));
+			}
+
+			if (!alive)
+			{
+				closeSubscriberLocked(index);
+			}
+		}
+
+		// Flush every subscriber rather than only those polled for POLLOUT: events published after the poll set was built,
+		// and greetings for subscribers accepted during this pass, arrive through the eventfd instead
+		for (std::size_t index = stream.subscribers.size(); index-- > 0;)
+		{
+			if (!flushSubscriberLocked(stream.subscribers[index]))
+			{
+				closeSubscriberLocked(index);
+			}
+		}
+	}
+}
+
+} // namespace
+
+namespace detail {
+
+std::string encodeEventStreamFrame(const EventStreamEvent &event)
+{
+	std::string payload;
+	uint8_t detailByte = 0;
+	switch (event.type)
+	{
+		case EventStreamFrameType::Hello:
+			putU32(payload, event.pid);
+			putU16(payload, event.protocolVersion);
+			break;
+		case EventStreamFrameType::State:
+			payload.push_back(static_cast<char>(event.runState));
+			payload.push_back(static_cast<char>(event.health));
+			break;
+		case EventStreamFrameType::Dispatch:
+			detailByte = static_cast<uint8_t>(static_cast<uint8_t>(event.dispatchKind) | (event.succeeded ? 0x80 : 0));
+			putU32(payload, event.durationUs);
+			putString(payload, event.objectPath);
+			putString(payload, event.interfaceName);
+			putString(payload, event.member);
+			break;
+		case EventStreamFrameType::QueueStats:
+			putU32(payload, event.updateQueueDepth);
+			putU32(payload, event.updatesProcessed);
+			break;
+		case EventStreamFrameType::Dropped:
+			putU32(payload, event.droppedCount);
+			break;
+	}
+
+	std::string frame;
+	frame.reserve(kEventStreamFrameHeaderLength + payload.size());
+	putU16(frame, static_cast<uint16_t>(payload.size()));
+	frame.push_back(static_cast<char>(event.type));
+	frame.push_back(static_cast<char>(detailByte));
+	putU64(frame, event.timestampUs);
+	frame += payload;
+	return frame;
+}
+
+std::vector<EventStreamEvent> decodeEventStreamFrames(std::string &buffer)
+{
+	std::vector<EventStreamEvent> events;
+	std::size_t offset = 0;
+	while (buffer.size() - offset >= kEventStreamFrameHeaderLength)
+	{
+		const std::size_t payloadLength = getLE(buffer, offset, 2);
+		const std::size_t frameLength = kEventStreamFrameHeaderLength + payloadLength;
+		if (buffer.size() - offset < frameLength)
+		{
+			break;
+		}
+
+		EventStreamEvent event;
+		event.type = static_cast<EventStreamFrameType>(static_cast<unsigned char>(buffer[offset + 2]));
+		const uint8_t detailByte = static_cast<uint8_t>(buffer[offset + 3]);
+		event.timestampUs = getLE(buffer, offset + 4, 8);
+		const std::string payload = buffer.substr(offset + kEventStreamFrameHeaderLength, payloadLength);
+		if (decodePayload(event, detailByte, payload))
+		{
+			events.push_back(std::move(event));
+		}
+		offset += frameLength;
+	}
+
+	buffer.erase(0, offset);
+	return events;
+}
+
+} // namespace detail
+
+namespace {
+
+// Hosts that never stop the stream still get the thread joined and the socket removed at exit
+struct StopAtExit
+{
+	~StopAtExit() { stopEventStream(); }
+} stopAtExit;
+
+} // namespace
+
+std::string defaultEventStreamPath(int pid)
+{
+	return runtimeSocketPath("events", pid);
+}
+
+std::string startEventStream(const std::string &path, std::size_t subscriberBufferBytes)
+{
+	std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+	if (streamActive.load(std::memory_order_acquire))
+	{
+		return "the event stream is already active on '" + stream.path + "'";
+	}
+
+	sockaddr_un address{};
+	if (path.empty() || path.size() >= sizeof(address.sun_path))
+	{
+		return "socket path must be between 1 and " + std::to_string(sizeof(address.sun_path) - 1) + " bytes";
+	}
+
+	if (std::string error = prepareSocketPath(path); !error.empty())
+	{
+		return error;
+	}
+
+	const int listenFD = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (listenFD < 0)
+	{
+		return "socket() failed: " + errnoText(errno);
+	}
+
+	address.sun_family = AF_UNIX;
+	std::memcpy(address.sun_path, path.c_str(), path.size());
+	if (bind(listenFD, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+		|| chmod(path.c_str(), S_IRUSR | S_IWUSR) != 0
+		|| listen(listenFD, kListenBacklog) != 0)
+	{
+		const std::string error = "unable to listen on '" + path + "': " + errnoText(errno);
+		close(listenFD);
+		unlink(path.c_str());
+		return error;
+	}
+
+	const int wakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (wakeFD < 0)
+	{
+		const std::string error = "eventfd() failed: " + errnoText(errno);
+		close(listenFD);
+		unlink(path.c_str());
+		return error;
+	}
+
+	stream.path = path;
+	stream.listenFD = listenFD;
+	stream.wakeFD = wakeFD;
+	stream.bufferLimit = std::max(subscriberBufferBytes, kMinimumSubscriberBufferBytes);
+	stream.stopping = false;
+	stream.thread = std::thread(runStreamThread);
+	streamActive.store(true, std::memory_order_release);
+	Logger::info(SSTR << "Event stream listening on " << path);
+	return {};
+}
+
+void stopEventStream()
+{
+	std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+	if (!streamActive.exchange(false, std::memory_order_acq_rel))
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(stream.mutex);
+		stream.stopping = true;
+		wakeStreamThreadLocked();
+	}
+	if (stream.thread.joinable())
+	{
+		stream.thread.join();
+	}
+
+	std::lock_guard<std::mutex> lock(stream.mutex);
+	for (const Subscriber &subscriber : stream.subscribers)
+	{
+		close(subscriber.fd);
+	}
+	stream.subscribers.clear();
+	subscriberCount.store(0, std::memory_order_release);
+	close(stream.listenFD);
+	close(stream.wakeFD);
+	stream.listenFD = -1;
+	stream.wakeFD = -1;
+	unlink(stream.path.c_str());
+	stream.path.clear();
+}
+
+bool isEventStreamActive() noexcept
+{
+	return streamActive.load(std::memory_order_acquire);
+}
+
+bool hasEventStreamSubscribers() noexcept
+{
+	return subscriberCount.load(std::memory_order_relaxed) != 0;
+}
+
+std::string eventStreamPath()
+{
+	std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+	return stream.path;
+}
+
+void publishStateEvent(int runState, int health)
+{
+	lastRunState.store(runState, std::memory_order_release);
+	lastHealth.store(health, std::memory_order_release);
+	if (!hasEventStreamSubscribers())
+	{
+		return;
+	}
+
+	EventStreamEvent event;
+	event.type = EventStreamFrameType::State;
+	event.timestampUs = nowUs();
+	event.runState = runState;
+	event.health = health;
+	publish(event);
+}
+
+void publishDispatchEvent(EventStreamDispatchKind kind, std::string_view objectPath, std::string_view interfaceName,
+	std::string_view member, bool succeeded, uint32_t durationUs)
+{
+	if (!hasEventStreamSubscribers())
+	{
+		return;
+	}
+
+	EventStreamEvent event;
+	event.type = EventStreamFrameType::Dispatch;
+	event.timestampUs = nowUs();
+	event.dispatchKind = kind;
+	event.succeeded = succeeded;
+	event.durationUs = durationUs;
+	event.objectPath = objectPath;
+	event.interfaceName = interfaceName;
+	event.member = member;
+	publish(event);
+}
+
+void publishQueueStatsEvent(uint32_t updateQueueDepth, uint32_t updatesProcessed)
+{
+	if (!hasEventStreamSubscribers())
+	{
+		return;
+	}
+
+	EventStreamEvent event;
+	event.type = EventStreamFrameType::QueueStats;
+	event.timestampUs = nowUs();
+	event.updateQueueDepth = updateQueueDepth;
+	event.updatesProcessed = updatesProcessed;
+	publish(event);
+}
+
+EventStreamDispatchScope::EventStreamDispatchScope(EventStreamDispatchKind kind, std::string_view objectPath,
+	std::string_view interfaceName, std::string_view member) noexcept
+	: kind_(kind),
+	  objectPath_(objectPath),
+	  interfaceName_(interfaceName),
+	  member_(member)
+{
+	if (hasEventStreamSubscribers())
+	{
+		startUs_ = g_get_monotonic_time();
+	}
+}
+
+EventStreamDispatchScope::~EventStreamDispatchScope()
+{
+	if (startUs_ < 0)
+	{
+		return;
+	}
+
+	const int64_t elapsed = g_get_monotonic_time() - startUs_;
+	publishDispatchEvent(kind_, objectPath_, interfaceName_, member_, succeeded_,
+		static_cast<uint32_t>(std::min<int64_t>(elapsed, UINT32_MAX)));
+}
+
+} // namespace bzp
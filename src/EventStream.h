@@ -0,0 +1,114 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Optional Unix-socket endpoint that streams structured server events to live inspectors.
+//
+// Every frame is a 12-byte little-endian header (u16 payload length, u8 type, u8 detail, u64 wall-clock microseconds) followed
+// by the payload. Each subscriber owns a bounded send buffer that only the stream thread drains; when a slow reader lets it fill
+// up, further events for that subscriber are dropped and counted, and a Dropped frame reports the gap once there is room again.
+// Publishing therefore never waits on a socket, and costs one relaxed load while nobody is attached.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bzp {
+
+enum class EventStreamFrameType : uint8_t
+{
+	Hello = 1,         // first frame on every connection
+	State = 2,         // run state and health
+	Dispatch = 3,      // one D-Bus method call or property access handled by the server
+	QueueStats = 4,    // update queue depth after a processing pass
+	Dropped = 5        // events this subscriber lost while its buffer was full
+};
+
+enum class EventStreamDispatchKind : uint8_t
+{
+	Method = 0,
+	GetProperty = 1,
+	SetProperty = 2
+};
+
+struct EventStreamEvent
+{
+	EventStreamFrameType type = EventStreamFrameType::Hello;
+	uint64_t timestampUs = 0;           // microseconds since the Unix epoch
+
+	uint32_t pid = 0;                   // Hello
+	uint16_t protocolVersion = 0;       // Hello
+
+	int runState = 0;                   // State: BZPServerRunState
+	int health = 0;                     // State: BZPServerHealth
+
+	EventStreamDispatchKind dispatchKind = EventStreamDispatchKind::Method;
+	bool succeeded = true;              // Dispatch
+	uint32_t durationUs = 0;            // Dispatch
+	std::string objectPath;             // Dispatch
+	std::string interfaceName;          // Dispatch
+	std::string member;                 // Dispatch: method or property name
+
+	uint32_t updateQueueDepth = 0;      // QueueStats: entries still waiting
+	uint32_t updatesProcessed = 0;      // QueueStats: entries consumed by the pass
+
+	uint32_t droppedCount = 0;          // Dropped
+};
+
+constexpr uint16_t kEventStreamProtocolVersion = 1;
+constexpr std::size_t kEventStreamFrameHeaderLength = 12;
+constexpr std::size_t kDefaultEventStreamSubscriberBufferBytes = 64 * 1024;
+
+namespace detail {
+
+[[nodiscard]] std::string encodeEventStreamFrame(const EventStreamEvent &event);
+
+// Decode every complete frame at the front of `buffer` and erase it; a trailing partial frame stays for the next call.
+// Frames of unknown type are skipped so older inspectors keep working against newer servers.
+[[nodiscard]] std::vector<EventStreamEvent> decodeEventStreamFrames(std::string &buffer);
+
+} // namespace detail
+
+// Per-process socket location: $XDG_RUNTIME_DIR/bzperi/events-<pid>.sock
+[[nodiscard]] std::string defaultEventStreamPath(int pid);
+
+// Bind `path` (replacing a stale socket left by a dead process) and start the stream thread. Returns an empty string on
+// success, otherwise a description of what failed.
+[[nodiscard]] std::string startEventStream(const std::string &path, std::size_t subscriberBufferBytes);
+void stopEventStream();
+[[nodiscard]] bool isEventStreamActive() noexcept;
+[[nodiscard]] bool hasEventStreamSubscribers() noexcept;
+[[nodiscard]] std::string eventStreamPath();
+
+// Publishers; each is a no-op unless at least one inspector is attached
+void publishStateEvent(int runState, int health);
+void publishDispatchEvent(EventStreamDispatchKind kind, std::string_view objectPath, std::string_view interfaceName,
+	std::string_view member, bool succeeded, uint32_t durationUs);
+void publishQueueStatsEvent(uint32_t updateQueueDepth, uint32_t updatesProcessed);
+
+// Times one D-Bus dispatch and publishes it on destruction, but only when an inspector was attached when it started
+class EventStreamDispatchScope
+{
+public:
+	EventStreamDispatchScope(EventStreamDispatchKind kind, std::string_view objectPath, std::string_view interfaceName,
+		std::string_view member) noexcept;
+	~EventStreamDispatchScope();
+
+	EventStreamDispatchScope(const EventStreamDispatchScope &) = delete;
+	EventStreamDispatchScope &operator=(const EventStreamDispatchScope &) = delete;
+
+	void setSucceeded(bool succeeded) noexcept { succeeded_ = succeeded; }
+
+private:
+	EventStreamDispatchKind kind_;
+	std::string_view objectPath_;
+	std::string_view interfaceName_;
+	std::string_view member_;
+	int64_t startUs_ = -1;
+	bool succeeded_ = false;
+};
+
+} // namespace bzp
@@ -32,6 +32,20 @@
 #include <bzp/Utils.h>
 #include <bzp/Logger.h>
 
+#include "AcquiredNotify.h"
+#include "IngestRing.h"
+#include "RunLoopTimers.h"
+
+#include <gio/gio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <utility>
+
 namespace bzp {
 
 namespace {
@@ -60,8 +74,302 @@ callbacks::CharacteristicUpdateCallHandler makeUpdateCallHandler(const callbacks
 	};
 }
 
+// Connection of the latest AcquireNotify call, kept for announcing NotifyAcquired changes
+struct AcquiredNotifyBus
+{
+	GDBusConnection *pConnection = nullptr;
+
+	~AcquiredNotifyBus()
+	{
+		if (pConnection != nullptr)
+		{
+			g_object_unref(pConnection);
+		}
+	}
+
+	void track(GDBusConnection *pNewConnection)
+	{
+		if (pNewConnection == nullptr || pNewConnection == pConnection)
+		{
+			return;
+		}
+		g_object_ref(pNewConnection);
+		if (pConnection != nullptr)
+		{
+			g_object_unref(pConnection);
+		}
+		pConnection = pNewConnection;
+	}
+};
+
 } // namespace
 
+// State behind `GattCharacteristic::enableIndications()`: one indication in flight, the rest queued behind it. Server thread
+// only.
+struct IndicationQueue
+{
+	struct Indication
+	{
+		GDBusConnection *pConnection = nullptr;
+		GVariant *pValue = nullptr;
+		callbacks::IndicationCallback done;
+	};
+
+	const GattCharacteristic *pCharacteristic = nullptr;
+	IndicationPolicy policy;
+	std::optional<Indication> inFlight;
+	std::deque<Indication> pending;
+	guint timeoutTimerId = 0;
+	IndicationStats stats;
+
+	~IndicationQueue()
+	{
+		// Teardown: the owners of any remaining callbacks may already be gone, so release without reporting
+		cancelTimeout();
+		if (inFlight)
+		{
+			release(*inFlight);
+		}
+		for (Indication &indication : pending)
+		{
+			release(indication);
+		}
+	}
+
+	static void release(Indication &indication)
+	{
+		if (indication.pConnection != nullptr)
+		{
+			g_object_unref(indication.pConnection);
+		}
+		if (indication.pValue != nullptr)
+		{
+			g_variant_unref(indication.pValue);
+		}
+		indication = Indication{};
+	}
+
+	static void finish(Indication indication, IndicationResult result)
+	{
+		callbacks::IndicationCallback done = std::move(indication.done);
+		release(indication);
+		if (done)
+		{
+			done(result);
+		}
+	}
+
+	bool submit(DBusNotificationRef notification, callbacks::IndicationCallback done)
+	{
+		if (!notification.value())
+		{
+			return false;
+		}
+
+		Indication indication;
+		indication.pConnection = notification.connection().get();
+		if (indication.pConnection != nullptr)
+		{
+			g_object_ref(indication.pConnection);
+		}
+		indication.pValue = g_variant_ref_sink(notification.value().get());
+		indication.done = std::move(done);
+
+		if (inFlight && policy.coalesce && !pending.empty())
+		{
+			Indication superseded = std::exchange(pending.back(), std::move(indication));
+			stats.superseded += 1;
+			finish(std::move(superseded), IndicationResult::Superseded);
+			return true;
+		}
+		if (inFlight && pending.size() >= policy.maxQueued)
+		{
+			indication.done = {};
+			release(indication);
+			stats.rejected += 1;
+			return false;
+		}
+
+		pending.push_back(std::move(indication));
+		sendNext();
+		return true;
+	}
+
+	void sendNext()
+	{
+		while (!inFlight && !pending.empty())
+		{
+			inFlight = std::move(pending.front());
+			pending.pop_front();
+
+			// Without a connection (never the case for a call that came from BlueZ) there is nothing to emit on, but the
+			// indication still waits for Confirm so the window behaves the same
+			const bool sent = inFlight->pConnection == nullptr || pCharacteristic->sendChangeNotificationVariantChecked(
+				DBusNotificationRef(DBusConnectionRef(inFlight->pConnection), DBusVariantRef(inFlight->pValue)));
+			if (sent)
+			{
+				stats.sent += 1;
+				timeoutTimerId = addRunLoopTimer(threadRunLoopContext(), static_cast<guint>(policy.timeout.count()), onTimeout, this);
+				return;
+			}
+
+			Indication failed = std::move(*inFlight);
+			inFlight.reset();
+			stats.failed += 1;
+			finish(std::move(failed), IndicationResult::Failed);
+		}
+	}
+
+	void complete(IndicationResult result)
+	{
+		if (!inFlight)
+		{
+			// Another subscriber confirming an indication that already completed
+			stats.strayConfirms += result == IndicationResult::Confirmed ? 1 : 0;
+			return;
+		}
+
+		cancelTimeout();
+		Indication finished = std::move(*inFlight);
+		inFlight.reset();
+		stats.confirmed += result == IndicationResult::Confirmed ? 1 : 0;
+		stats.timedOut += result == IndicationResult::TimedOut ? 1 : 0;
+
+		// Start the next transfer before reporting, so a callback that indicates again simply queues behind it
+		sendNext();
+		finish(std::move(finished), result);
+	}
+
+	void cancelTimeout()
+	{
+		if (timeoutTimerId != 0)
+		{
+			removeRunLoopTimer(timeoutTimerId);
+			timeoutTimerId = 0;
+		}
+	}
+
+	static gboolean onTimeout(gpointer pUserData)
+	{
+		auto &queue = *static_cast<IndicationQueue *>(pUserData);
+		queue.timeoutTimerId = 0;
+		Logger::warn(SSTR << "Indication on " << queue.pCharacteristic->getPath() << " was not confirmed within "
+			<< queue.policy.timeout.count() << "ms");
+		queue.complete(IndicationResult::TimedOut);
+		return G_SOURCE_REMOVE;
+	}
+};
+
+// State behind `GattCharacteristic::publishEvery()`. Everything here is touched on the server thread only.
+struct PeriodicPublisher
+{
+	const GattCharacteristic *pCharacteristic = nullptr;
+	callbacks::PublishSampler sampler;
+	PublishPolicy policy;
+	bool numeric = false;
+	guint periodMS = 0;
+
+	guint timerId = 0;
+	GDBusConnection *pConnection = nullptr;    // referenced while subscribed
+	bool hasLastValue = false;
+	std::vector<std::uint8_t> lastValue;
+	double lastNumber = 0.0;
+	std::vector<std::uint8_t> sample;          // reused by every tick
+	PublishStats stats;
+
+	~PeriodicPublisher() { unsubscribe(); }
+
+	void subscribe(GDBusConnection *pNewConnection)
+	{
+		if (pNewConnection != nullptr && pNewConnection != pConnection)
+		{
+			g_object_ref(pNewConnection);
+			if (pConnection != nullptr)
+			{
+				g_object_unref(pConnection);
+			}
+			pConnection = pNewConnection;
+		}
+
+		// A new subscriber has not seen anything yet
+		hasLastValue = false;
+		stats.subscribed = true;
+		if (timerId == 0)
+		{
+			timerId = addRunLoopTimerFixedRate(threadRunLoopContext(), periodMS, tick, this);
+		}
+	}
+
+	void unsubscribe()
+	{
+		if (timerId != 0)
+		{
+			removeRunLoopTimer(timerId);
+			timerId = 0;
+		}
+		if (pConnection != nullptr)
+		{
+			g_object_unref(pConnection);
+			pConnection = nullptr;
+		}
+		stats.subscribed = false;
+	}
+
+	bool suppresses(double number) const
+	{
+		if (!hasLastValue)
+		{
+			return false;
+		}
+		if (numeric && policy.deadband > 0.0 && std::fabs(number - lastNumber) < policy.deadband)
+		{
+			return true;
+		}
+		return policy.suppressUnchanged && sample == lastValue;
+	}
+
+	static gboolean tick(gpointer pUserData)
+	{
+		auto &publisher = *static_cast<PeriodicPublisher *>(pUserData);
+		publisher.stats.samples += 1;
+		publisher.sample.clear();
+		double number = 0.0;
+		try
+		{
+			if (!publisher.sampler(publisher.sample, number))
+			{
+				return G_SOURCE_CONTINUE;
+			}
+		}
+		catch (const std::exception &error)
+		{
+			Logger::error(SSTR << "Periodic publisher for " << publisher.pCharacteristic->getPath() << " failed: " << error.what());
+			return G_SOURCE_CONTINUE;
+		}
+
+		if (publisher.suppresses(number))
+		{
+			publisher.stats.suppressed += 1;
+			return G_SOURCE_CONTINUE;
+		}
+
+		publisher.lastValue.swap(publisher.sample);
+		publisher.lastNumber = number;
+		publisher.hasLastValue = true;
+		publisher.stats.published += 1;
+		const DBusNotificationRef notification(DBusConnectionRef(publisher.pConnection), Utils::dbusVariantFromByteArray(publisher.lastValue));
+		if (publisher.pCharacteristic->indicationsEnabled())
+		{
+			(void)publisher.pCharacteristic->indicateVariant(notification);
+		}
+		else if (publisher.pConnection != nullptr)
+		{
+			publisher.pCharacteristic->sendChangeNotificationVariantChecked(notification);
+		}
+		return G_SOURCE_CONTINUE;
+	}
+};
+
 //
 // Standard constructor
 //
@@ -75,6 +383,23 @@ GattCharacteristic::GattCharacteristic(DBusObject &owner, GattService &service,
 {
 }
 
+GattCharacteristic::~GattCharacteristic()
+{
+	// The StartNotify/StopNotify handlers share the publisher, so stop its timer while this characteristic still exists
+	if (publisher_)
+	{
+		publisher_->unsubscribe();
+	}
+	if (indications_)
+	{
+		indications_->cancelTimeout();
+	}
+	if (acquiredNotifier_)
+	{
+		acquiredNotifier_->setStateCallback(nullptr);
+	}
+}
+
 // Returning the owner pops us one level up the hierarchy
 //
 // This method compliments `GattService::gattCharacteristicBegin()`
@@ -97,8 +422,7 @@ bool GattCharacteristic::callMethod(const std::string &methodName, DBusMethodCal
 	{
 		if (methodName == method.getName())
 		{
-			const std::string notImplementedErrorName = owner.getServer().getOwnedName() + ".NotImplemented";
-			method.call<GattCharacteristic>(methodCall, getPath(), getName(), methodName, notImplementedErrorName);
+			method.call<GattCharacteristic>(methodCall, getPath(), getName(), methodName, owner.getServer().getNotImplementedErrorName());
 			return true;
 		}
 	}
@@ -113,8 +437,225 @@ bool GattCharacteristic::callMethod(const std::string &methodName, DBusConnectio
 }
 #endif
 
-// Modern approach: Use GLib timers directly for periodic updates
-// Applications should use g_timeout_add_seconds() or g_timeout_add() for periodic operations
+// Periodic "sample, then notify if changed" publishing
+//
+// The publisher's timer exists only between StartNotify and StopNotify, which BlueZ sends when the first client subscribes and
+// after the last one unsubscribes.
+GattCharacteristic &GattCharacteristic::publishEverySampled(std::chrono::milliseconds period, callbacks::PublishSampler sampler, bool numeric, const PublishPolicy &policy)
+{
+	if (period.count() <= 0 || !sampler) {
+		Logger::error(SSTR << "GattCharacteristic::publishEvery() on " << getPath() << ": needs a positive period and a producer");
+		return *this;
+	}
+	if (publisher_) {
+		Logger::error(SSTR << "GattCharacteristic::publishEvery() on " << getPath() << ": already publishing");
+		return *this;
+	}
+	if (acquiredNotifier_) {
+		Logger::error(SSTR << "GattCharacteristic::publishEvery() on " << getPath() << ": notifications go through AcquireNotify");
+		return *this;
+	}
+	for (const DBusMethod &method : methods) {
+		if (method.getName() == "StartNotify" || method.getName() == "StopNotify") {
+			Logger::error(SSTR << "GattCharacteristic::publishEvery() on " << getPath() << ": " << method.getName() << " is already handled");
+			return *this;
+		}
+	}
+
+	auto publisher = std::make_shared<PeriodicPublisher>();
+	publisher->pCharacteristic = this;
+	publisher->sampler = std::move(sampler);
+	publisher->policy = policy;
+	publisher->numeric = numeric;
+	publisher->periodMS = static_cast<guint>(std::min<std::chrono::milliseconds::rep>(period.count(), G_MAXUINT));
+	publisher_ = publisher;
+
+	static const char *noArgs[] = {nullptr};
+	addMethod("StartNotify", noArgs, nullptr,
+		[publisher](const DBusInterface&, const std::string&, DBusMethodCallRef methodCall) {
+			publisher->subscribe(methodCall.connection().get());
+			methodCall.invocation().returnValue(DBusVariantRef());
+		});
+	addMethod("StopNotify", noArgs, nullptr,
+		[publisher](const DBusInterface&, const std::string&, DBusMethodCallRef methodCall) {
+			publisher->unsubscribe();
+			methodCall.invocation().returnValue(DBusVariantRef());
+		});
+	return *this;
+}
+
+PublishStats GattCharacteristic::publishStats() const
+{
+	return publisher_ ? publisher_->stats : PublishStats{};
+}
+
+// Flow-controlled indications
+//
+// Defined as: void Confirm()
+//
+// BlueZ calls Confirm once per device that acknowledged the indication emitted last. It has no arguments and no reply payload,
+// so nothing says which indication a Confirm belongs to; see the single-subscriber note in GattCharacteristic.h.
+GattCharacteristic &GattCharacteristic::enableIndications(const IndicationPolicy &policy)
+{
+	if (policy.timeout.count() <= 0) {
+		Logger::error(SSTR << "GattCharacteristic::enableIndications() on " << getPath() << ": needs a positive timeout");
+		return *this;
+	}
+	if (indications_) {
+		Logger::error(SSTR << "GattCharacteristic::enableIndications() on " << getPath() << ": already enabled");
+		return *this;
+	}
+	for (const DBusMethod &method : methods) {
+		if (method.getName() == "Confirm") {
+			Logger::error(SSTR << "GattCharacteristic::enableIndications() on " << getPath() << ": Confirm is already handled");
+			return *this;
+		}
+	}
+
+	auto indications = std::make_shared<IndicationQueue>();
+	indications->pCharacteristic = this;
+	indications->policy = policy;
+	indications->policy.timeout = std::min<std::chrono::milliseconds>(policy.timeout, std::chrono::milliseconds(G_MAXUINT));
+	indications_ = indications;
+
+	static const char *noArgs[] = {nullptr};
+	addMethod("Confirm", noArgs, nullptr,
+		[indications](const DBusInterface&, const std::string&, DBusMethodCallRef methodCall) {
+			methodCall.invocation().returnValue(DBusVariantRef());
+			indications->complete(IndicationResult::Confirmed);
+		});
+	return *this;
+}
+
+bool GattCharacteristic::indicateVariant(DBusNotificationRef notification, callbacks::IndicationCallback done) const
+{
+	if (!indications_) {
+		Logger::error(SSTR << "GattCharacteristic::indicateVariant() on " << getPath() << ": indications are not enabled");
+		return false;
+	}
+	return indications_->submit(notification, std::move(done));
+}
+
+// Acquired notifications
+//
+// Defined as: fd, uint16 AcquireNotify(dict options)
+//
+// D-Bus breakdown:
+//
+//     Input args:  options - "a{sv}" ("mtu", "device", "link")
+//     Output args: fd, mtu - "hq"
+//
+// BlueZ calls this when the first device enables notifications, keeps the socket while any device stays subscribed, and sends
+// every packet written to it to all of them. It closes its end after the last one unsubscribes and asks again for the next.
+GattCharacteristic &GattCharacteristic::enableAcquiredNotify(const AcquiredNotifyPolicy &policy)
+{
+	if (acquiredNotifier_) {
+		Logger::error(SSTR << "GattCharacteristic::enableAcquiredNotify() on " << getPath() << ": already enabled");
+		return *this;
+	}
+	if (publisher_) {
+		Logger::error(SSTR << "GattCharacteristic::enableAcquiredNotify() on " << getPath() << ": already publishing through StartNotify");
+		return *this;
+	}
+	for (const DBusMethod &method : methods) {
+		if (method.getName() == "StartNotify" || method.getName() == "StopNotify" || method.getName() == "AcquireNotify") {
+			Logger::error(SSTR << "GattCharacteristic::enableAcquiredNotify() on " << getPath() << ": " << method.getName() << " is already handled");
+			return *this;
+		}
+	}
+
+	addProperty<GattCharacteristic>("NotifyAcquired", Utils::dbusVariantFromBoolean(false));
+	GattProperty *pNotifyAcquired = &properties.back();
+	auto bus = std::make_shared<AcquiredNotifyBus>();
+	auto notifier = std::make_shared<AcquiredNotifier>(getPath().toString(), policy);
+	acquiredNotifier_ = notifier;
+
+	// The notifier drops this callback before the characteristic goes away
+	notifier->setStateCallback([this, pNotifyAcquired, bus](bool acquired) {
+		pNotifyAcquired->setValue(Utils::dbusVariantFromBoolean(acquired));
+		if (bus->pConnection == nullptr) {
+			return;
+		}
+
+		g_auto(GVariantBuilder) builder;
+		g_variant_builder_init(&builder, G_VARIANT_TYPE_ARRAY);
+		g_variant_builder_add(&builder, "{sv}", "NotifyAcquired", g_variant_new_boolean(acquired));
+		GVariant *pSasv = g_variant_new("(sa{sv}as)", getName().c_str(), &builder, nullptr);
+		(void)owner.emitSignalChecked(DBusSignalRef(DBusConnectionRef(bus->pConnection), "org.freedesktop.DBus.Properties",
+			"PropertiesChanged", DBusVariantRef(pSasv)));
+	});
+
+	static const char *inArgs[] = {"a{sv}", nullptr};
+	addMethod("AcquireNotify", inArgs, "hq",
+		[notifier, bus](const DBusInterface&, const std::string&, DBusMethodCallRef methodCall) {
+			// A loopback call has nowhere to send a file descriptor; answer before BlueZ's side of the state changes
+			if (methodCall.invocation().get() == nullptr) {
+				methodCall.invocation().returnDbusError("org.bluez.Error.NotSupported", "AcquireNotify needs a bus connection");
+				return;
+			}
+
+			guint16 mtu = 0;
+			GVariant *pOptions = methodCall.parameters() ? g_variant_get_child_value(methodCall.parameters().get(), 0) : nullptr;
+			if (pOptions != nullptr) {
+				g_variant_lookup(pOptions, "mtu", "q", &mtu);
+				g_variant_unref(pOptions);
+			}
+
+			bus->track(methodCall.connection().get());
+			const int fd = notifier->acquire(mtu);
+			if (fd < 0) {
+				methodCall.invocation().returnDbusError("org.bluez.Error.Failed", "Unable to create the notification socket");
+				return;
+			}
+
+			GError *pError = nullptr;
+			GUnixFDList *pFDList = g_unix_fd_list_new();
+			const gint fdIndex = g_unix_fd_list_append(pFDList, fd, &pError);
+			close(fd);
+			if (fdIndex < 0) {
+				Logger::error(SSTR << "AcquireNotify: unable to pass the socket to BlueZ: " << (pError != nullptr ? pError->message : "Unknown"));
+				g_clear_error(&pError);
+				g_object_unref(pFDList);
+				methodCall.invocation().returnDbusError("org.bluez.Error.Failed", "Unable to pass the notification socket");
+				return;
+			}
+			g_dbus_method_invocation_return_value_with_unix_fd_list(methodCall.invocation().get(),
+				g_variant_new("(hq)", fdIndex, notifier->stats().mtu), pFDList);
+			g_object_unref(pFDList);
+		});
+	return *this;
+}
+
+bool GattCharacteristic::notifyAcquired(std::span<const std::uint8_t> value) const
+{
+	return acquiredNotifier_ && acquiredNotifier_->enqueue(value);
+}
+
+void GattCharacteristic::setAcquiredNotifyBudget(uint32_t bytesPerSecond, uint32_t burstBytes) const
+{
+	if (acquiredNotifier_)
+	{
+		acquiredNotifier_->setBudget(bytesPerSecond, burstBytes);
+	}
+}
+
+AcquiredNotifyStats GattCharacteristic::acquiredNotifyStats() const
+{
+	return acquiredNotifier_ ? acquiredNotifier_->stats() : AcquiredNotifyStats{};
+}
+
+IndicationStats GattCharacteristic::indicationStats() const
+{
+	if (!indications_)
+	{
+		return {};
+	}
+
+	IndicationStats stats = indications_->stats;
+	stats.queued = indications_->pending.size();
+	stats.inFlight = indications_->inFlight.has_value();
+	return stats;
+}
 
 // Specialized support for ReadlValue method
 //
@@ -222,6 +763,10 @@ GattCharacteristic &GattCharacteristic::onWriteValue(RawMethodCallback callback)
 	}
 
 	static const char *inArgs[] = {"ay", "a{sv}", nullptr};
+	if (ingestHandle_ >= 0) {
+		Logger::error(SSTR << "GattCharacteristic::onWriteValue() on " << getPath() << ": WriteValue already feeds an ingest ring");
+		return *this;
+	}
 	if (static_cast<bool>(writeHandler_)) {
 		Logger::warn("GattCharacteristic::onWriteValue() called twice — replacing callback without re-adding method");
 		writeHandler_ = handler;
@@ -259,6 +804,10 @@ GattCharacteristic &GattCharacteristic::onWriteValue(const callbacks::Characteri
 GattCharacteristic &GattCharacteristic::onWriteValue(const callbacks::CharacteristicMethodCallHandler &callback)
 {
 	static const char *inArgs[] = {"ay", "a{sv}", nullptr};
+	if (ingestHandle_ >= 0) {
+		Logger::error(SSTR << "GattCharacteristic::onWriteValue() on " << getPath() << ": WriteValue already feeds an ingest ring");
+		return *this;
+	}
 	if (static_cast<bool>(writeHandler_)) {
 		Logger::warn("GattCharacteristic::onWriteValue() called twice — replacing callback without re-adding method");
 		writeHandler_ = callback;
@@ -287,6 +836,66 @@ GattCharacteristic &GattCharacteristic::onWriteValue(const callbacks::Characteri
 	return *this;
 }
 
+// Ingestion-mode WriteValue
+//
+// The trampoline copies the "ay" payload straight out of the message into the ring and replies; nothing else runs on the server
+// thread, so it can keep draining the bus while the application parses on its own thread.
+GattCharacteristic &GattCharacteristic::onWriteIngest(const std::string &ringName, unsigned int packetCount, unsigned int packetBytes)
+{
+	if (static_cast<bool>(writeHandler_) || ingestHandle_ >= 0) {
+		Logger::error(SSTR << "GattCharacteristic::onWriteIngest() on " << getPath() << ": WriteValue is already handled");
+		return *this;
+	}
+
+	const int handle = bzpRegisterIngest(ringName.c_str(), packetCount, packetBytes);
+	if (handle < 0) {
+		Logger::error(SSTR << "GattCharacteristic::onWriteIngest() on " << getPath() << ": unable to create ingest ring '" << ringName << "'");
+		return *this;
+	}
+	ingestHandle_ = handle;
+
+	static const char *inArgs[] = {"ay", "a{sv}", nullptr};
+	addMethod("WriteValue", inArgs, nullptr,
+		[](const DBusInterface& self, DBusConnectionRef, const std::string&, DBusVariantRef p, DBusMethodInvocationRef inv, void*) {
+			const auto* ch = dynamic_cast<const GattCharacteristic*>(&self);
+			if (!ch) {
+				Logger::error("WriteValue ingest: type mismatch — expected GattCharacteristic");
+				inv.returnDbusError("com.bzperi.Error.InternalError", "Type error");
+				return;
+			}
+
+			GVariant *pValue = g_variant_get_child_value(p.get(), 0);
+			gsize size = 0;
+			gconstpointer pBytes = g_variant_get_fixed_array(pValue, &size, 1);
+			const BZPIngestResult result = pushIngestPacket(ch->ingestHandle_, pBytes, static_cast<std::size_t>(size));
+			g_variant_unref(pValue);
+
+			switch (result) {
+			case BZP_INGEST_OK:
+				inv.returnValue(DBusVariantRef());
+				break;
+			case BZP_INGEST_PACKET_TOO_LARGE:
+				inv.returnDbusError("org.bluez.Error.InvalidValueLength", "Value exceeds the ingest packet size");
+				break;
+			case BZP_INGEST_RING_FULL:
+				inv.returnDbusError("org.bluez.Error.Failed", "Ingest ring is full");
+				break;
+			default:
+				inv.returnDbusError("com.bzperi.Error.InternalError", "Ingest ring unavailable");
+				break;
+			}
+		});
+	return *this;
+}
+
+GattCharacteristic &GattCharacteristic::updatePriority(BZPUpdatePriority priority)
+{
+	if (bzpSetUpdatePriority(getPath().c_str(), priority) == 0) {
+		Logger::error(SSTR << "GattCharacteristic::updatePriority() on " << getPath() << ": invalid priority " << static_cast<int>(priority));
+	}
+	return *this;
+}
+
 // Custom support for handling updates to our characteristic's value
 //
 // Defined as: (NOT defined by Bluetooth or BlueZ - this method is internal only)
@@ -98,8 +98,7 @@ bool GattDescriptor::callMethod(const std::string &methodName, DBusMethodCallRef
 	{
 		if (methodName == method.getName())
 		{
-			const std::string notImplementedErrorName = owner.getServer().getOwnedName() + ".NotImplemented";
-			method.call<GattDescriptor>(methodCall, getPath(), getName(), methodName, notImplementedErrorName);
+			method.call<GattDescriptor>(methodCall, getPath(), getName(), methodName, owner.getServer().getNotImplementedErrorName());
 			return true;
 		}
 	}
@@ -84,7 +84,7 @@ void GattInterface::methodReturnVariant(DBusReplyRef reply, DBusVariantRef varia
 // Locates a `GattProperty` within the interface
 //
 // This method returns a pointer to the property or nullptr if not found
-const GattProperty *GattInterface::findProperty(const std::string &name) const
+const GattProperty *GattInterface::findProperty(std::string_view name) const
 {
 	for (const GattProperty &property : properties)
 	{
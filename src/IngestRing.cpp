@@ -0,0 +1,252 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// See the discussion at the top of IngestRing.h
+
+#include "IngestRing.h"
+
+#include <bzp/Logger.h>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace bzp {
+
+namespace {
+
+constexpr uint32_t kMaxIngestPackets = 65536;
+constexpr uint32_t kMaxIngestPacketBytes = 512;
+
+struct Ring
+{
+	std::string name;
+	uint32_t packetCount = 0;
+	uint32_t packetBytes = 0;
+	uint32_t mask = 0;
+	std::unique_ptr<unsigned char[]> storage;     // packetCount * packetBytes
+	std::unique_ptr<uint32_t[]> lengths;
+	int eventFD = -1;
+
+	// Producer and consumer indices on their own cache lines so the two threads do not share one
+	alignas(64) std::atomic<uint64_t> tail{0};
+	alignas(64) std::atomic<uint64_t> head{0};
+	uint64_t reserved = 0;                         // packets handed out by the last read; consumer only
+	std::atomic<uint32_t> armed{1};
+
+	alignas(64) std::atomic<uint64_t> received{0};
+	std::atomic<uint64_t> dropped{0};
+	std::atomic<uint64_t> oversized{0};
+	std::atomic<uint32_t> highWatermark{0};
+
+	~Ring()
+	{
+		if (eventFD >= 0)
+		{
+			close(eventFD);
+		}
+	}
+};
+
+struct RingNameHash
+{
+	using is_transparent = void;
+	std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+};
+
+std::array<std::unique_ptr<Ring>, kMaxIngestRings> rings;
+std::atomic<std::size_t> ringCount{0};
+std::mutex registryMutex;
+std::unordered_map<std::string, int, RingNameHash, std::equal_to<>> ringsByName;
+
+Ring *ringForHandle(int handle) noexcept
+{
+	if (handle < 0 || static_cast<std::size_t>(handle) >= ringCount.load(std::memory_order_acquire))
+	{
+		return nullptr;
+	}
+	return rings[static_cast<std::size_t>(handle)].get();
+}
+
+uint32_t roundUpToPowerOfTwo(uint32_t value)
+{
+	uint32_t rounded = 2;
+	while (rounded < value)
+	{
+		rounded <<= 1;
+	}
+	return rounded;
+}
+
+} // namespace
+
+BZPIngestResult registerIngestRing(std::string_view name, uint32_t packetCount, uint32_t packetBytes, int &handle)
+{
+	handle = -1;
+	if (name.empty() || packetCount == 0 || packetCount > kMaxIngestPackets || packetBytes == 0 || packetBytes > kMaxIngestPacketBytes)
+	{
+		return BZP_INGEST_INVALID_ARGUMENT;
+	}
+	const uint32_t roundedCount = roundUpToPowerOfTwo(packetCount);
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	if (const auto found = ringsByName.find(name); found != ringsByName.end())
+	{
+		const Ring &existing = *rings[static_cast<std::size_t>(found->second)];
+		if (existing.packetCount != roundedCount || existing.packetBytes != packetBytes)
+		{
+			return BZP_INGEST_CONFLICT;
+		}
+		handle = found->second;
+		return BZP_INGEST_OK;
+	}
+
+	const std::size_t index = ringCount.load(std::memory_order_relaxed);
+	if (index >= kMaxIngestRings)
+	{
+		return BZP_INGEST_FULL;
+	}
+
+	auto ring = std::make_unique<Ring>();
+	ring->eventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (ring->eventFD < 0)
+	{
+		Logger::error(SSTR << "Unable to create the ingest eventfd for '" << name << "': " << std::strerror(errno));
+		return BZP_INGEST_FAILED;
+	}
+	ring->name = std::string(name);
+	ring->packetCount = roundedCount;
+	ring->packetBytes = packetBytes;
+	ring->mask = roundedCount - 1;
+	ring->storage = std::make_unique<unsigned char[]>(static_cast<std::size_t>(roundedCount) * packetBytes);
+	ring->lengths = std::make_unique<uint32_t[]>(roundedCount);
+	rings[index] = std::move(ring);
+	ringsByName.emplace(std::string(name), static_cast<int>(index));
+	ringCount.store(index + 1, std::memory_order_release);
+
+	handle = static_cast<int>(index);
+	return BZP_INGEST_OK;
+}
+
+int findIngestRing(std::string_view name)
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+	const auto found = ringsByName.find(name);
+	return found != ringsByName.end() ? found->second : -1;
+}
+
+BZPIngestResult pushIngestPacket(int handle, const void *data, std::size_t length)
+{
+	Ring *ring = ringForHandle(handle);
+	if (ring == nullptr)
+	{
+		return BZP_INGEST_UNKNOWN_HANDLE;
+	}
+	if (length > ring->packetBytes)
+	{
+		ring->oversized.fetch_add(1, std::memory_order_relaxed);
+		return BZP_INGEST_PACKET_TOO_LARGE;
+	}
+
+	const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+	const uint64_t head = ring->head.load(std::memory_order_acquire);
+	if (tail - head >= ring->packetCount)
+	{
+		ring->dropped.fetch_add(1, std::memory_order_relaxed);
+		return BZP_INGEST_RING_FULL;
+	}
+
+	const uint32_t index = static_cast<uint32_t>(tail) & ring->mask;
+	if (length != 0)
+	{
+		std::memcpy(ring->storage.get() + static_cast<std::size_t>(index) * ring->packetBytes, data, length);
+	}
+	ring->lengths[index] = static_cast<uint32_t>(length);
+	ring->tail.store(tail + 1, std::memory_order_release);
+
+	ring->received.fetch_add(1, std::memory_order_relaxed);
+	const uint32_t depth = static_cast<uint32_t>(tail + 1 - head);
+	if (depth > ring->highWatermark.load(std::memory_order_relaxed))
+	{
+		ring->highWatermark.store(depth, std::memory_order_relaxed);
+	}
+
+	// Pairs with the consumer arming before its final emptiness check: one side always sees the other
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (ring->armed.exchange(0, std::memory_order_seq_cst) != 0)
+	{
+		const uint64_t one = 1;
+		[[maybe_unused]] const ssize_t written = write(ring->eventFD, &one, sizeof(one));
+	}
+	return BZP_INGEST_OK;
+}
+
+int readIngestBatch(int handle, BZPIngestPacket *packets, unsigned int maxPackets)
+{
+	Ring *ring = ringForHandle(handle);
+	if (ring == nullptr || (packets == nullptr && maxPackets != 0))
+	{
+		return -1;
+	}
+
+	// Packets from the previous batch go back to the producer only now, so their pointers stayed valid until this call
+	uint64_t head = ring->head.load(std::memory_order_relaxed) + ring->reserved;
+	ring->head.store(head, std::memory_order_release);
+	ring->reserved = 0;
+
+	uint64_t tail = ring->tail.load(std::memory_order_acquire);
+	if (tail == head)
+	{
+		uint64_t ignored = 0;
+		[[maybe_unused]] const ssize_t drained = read(ring->eventFD, &ignored, sizeof(ignored));
+		ring->armed.store(1, std::memory_order_seq_cst);
+		tail = ring->tail.load(std::memory_order_seq_cst);
+	}
+
+	const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(tail - head, maxPackets));
+	for (uint32_t offset = 0; offset < count; ++offset)
+	{
+		const uint32_t index = static_cast<uint32_t>(head + offset) & ring->mask;
+		packets[offset].pData = ring->storage.get() + static_cast<std::size_t>(index) * ring->packetBytes;
+		packets[offset].length = ring->lengths[index];
+	}
+	ring->reserved = count;
+	return static_cast<int>(count);
+}
+
+int ingestEventFD(int handle) noexcept
+{
+	const Ring *ring = ringForHandle(handle);
+	return ring != nullptr ? ring->eventFD : -1;
+}
+
+BZPIngestResult ingestStats(int handle, BZPIngestStats &stats)
+{
+	const Ring *ring = ringForHandle(handle);
+	if (ring == nullptr)
+	{
+		return BZP_INGEST_UNKNOWN_HANDLE;
+	}
+
+	stats.received = ring->received.load(std::memory_order_relaxed);
+	stats.dropped = ring->dropped.load(std::memory_order_relaxed);
+	stats.oversized = ring->oversized.load(std::memory_order_relaxed);
+	const uint64_t tail = ring->tail.load(std::memory_order_acquire);
+	const uint64_t head = ring->head.load(std::memory_order_acquire);
+	stats.queued = static_cast<unsigned int>(tail - head);
+	stats.highWatermark = ring->highWatermark.load(std::memory_order_relaxed);
+	stats.capacity = ring->packetCount;
+	return BZP_INGEST_OK;
+}
+
+} // namespace bzp
@@ -0,0 +1,44 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Write ingestion rings behind `GattCharacteristic::onWriteIngest()` and the `bzpIngest*()` C API.
+//
+// A characteristic in ingestion mode does not run a user handler on the server thread. Its WriteValue trampoline copies the
+// payload once into the next preallocated packet of a single-producer/single-consumer ring and replies right away, so the GLib
+// thread goes straight back to accepting packets. One application thread drains the ring in batches with zero further copies:
+// readIngestBatch() hands out pointers into the ring and keeps those packets reserved until the next call.
+//
+// The consumer sleeps on an eventfd. It arms the doorbell only when it finds the ring empty, and the producer writes the eventfd
+// only when it takes that arm, so a busy consumer costs the producer no syscalls. When the ring is full, new packets are dropped
+// and counted rather than stalling the server thread.
+//
+// Rings live for the rest of the process once registered, so a handle never dangles.
+
+#pragma once
+
+#include <BzPeri.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace bzp {
+
+inline constexpr std::size_t kMaxIngestRings = 64;
+inline constexpr uint32_t kDefaultIngestPackets = 256;
+inline constexpr uint32_t kDefaultIngestPacketBytes = 512;
+
+// Packet counts are rounded up to a power of two (2..65536); packets hold 1..512 bytes. Registering an identical ring again
+// returns the existing handle; a different shape is a conflict.
+BZPIngestResult registerIngestRing(std::string_view name, uint32_t packetCount, uint32_t packetBytes, int &handle);
+[[nodiscard]] int findIngestRing(std::string_view name);
+
+// Producer side, called from the server thread only
+BZPIngestResult pushIngestPacket(int handle, const void *data, std::size_t length);
+
+// Consumer side, called from one application thread per ring
+int readIngestBatch(int handle, BZPIngestPacket *packets, unsigned int maxPackets);
+[[nodiscard]] int ingestEventFD(int handle) noexcept;
+BZPIngestResult ingestStats(int handle, BZPIngestStats &stats);
+
+} // namespace bzp
@@ -36,11 +36,16 @@
 #include <glib-unix.h>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <thread>
+#include <memory>
 #include <new>
 #include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
 
 #include <bzp/Server.h>
 #include <bzp/BluezAdapter.h>
@@ -48,10 +53,13 @@
 #include <bzp/DBusObject.h>
 #include <bzp/DBusInterface.h>
 #include <bzp/GattCharacteristic.h>
-#include <bzp/GattProperty.h>
 #include <bzp/Logger.h>
 #include "config.h"
+#include "Dispatch.h"
+#include "EventStream.h"
 #include "Init.h"
+#include "RunLoopTimers.h"
+#include "UpdateQueue.h"
 
 namespace bzp {
 
@@ -59,9 +67,8 @@ namespace bzp {
 // Constants
 //
 
-static const int kPeriodicTimerFrequencySeconds = 1;
 static const int kRetryDelaySeconds = 2;
-static const int kIdleFrequencyMS = 10;
+static const int kMaxUpdatesPerDispatch = 32;
 
 //
 // Retries
@@ -75,8 +82,8 @@ static time_t retryTimeStart = 0;
 
 GDBusConnection *pBusConnection = nullptr;
 static guint ownedNameId = 0;
-static guint periodicTimeoutId = 0;
-static guint updateProcessorSourceId = 0;
+static guint retryTimerId = 0;
+static std::atomic_bool bUpdateProcessingScheduled{false};
 static guint sigtermSourceId = 0;
 static guint sigintSourceId = 0;
 static guint sleepSignalSubscriptionId = 0;
@@ -98,9 +105,10 @@ static GDBusProxy *pBluezAdapterInterfaceProxy = nullptr;
 static GDBusProxy *pBluezDeviceInterfaceProxy = nullptr;
 static GDBusProxy *pBluezAdapterPropertiesInterfaceProxy = nullptr;
 static bool bOwnedNameAcquired = false;
+static bool bOwnedNameEverAcquired = false;
 static bool bAdapterConfigured = false;
 static bool bApplicationRegistered = false;
-static bool bRestoreAdvertisingAfterResume = false;
+static std::atomic<int64_t> lastResumeTimeToAdvertiseMs{-1};
 static int sleepInhibitorFD = -1;
 static std::string bluezGattManagerInterfaceName = "";
 static Server* pServerContext = nullptr;
@@ -165,22 +173,18 @@ static GMainContext *mainContextForSources()
 	return g_main_context_default();
 }
 
-static guint attachTimeoutSource(guint intervalMS, GSourceFunc callback, gpointer userData)
+static guint attachTimeoutSecondsSource(guint intervalSeconds, GSourceFunc callback, gpointer userData)
 {
-	GSource *source = g_timeout_source_new(intervalMS);
-	g_source_set_callback(source, callback, userData, nullptr);
-	const guint sourceId = g_source_attach(source, mainContextForSources());
-	g_source_unref(source);
-	return sourceId;
+	return addRunLoopTimerSeconds(mainContextForSources(), intervalSeconds, callback, userData);
 }
 
-static guint attachTimeoutSecondsSource(guint intervalSeconds, GSourceFunc callback, gpointer userData)
+static void removeTimerIfPresent(guint *timerId)
 {
-	GSource *source = g_timeout_source_new_seconds(intervalSeconds);
-	g_source_set_callback(source, callback, userData, nullptr);
-	const guint sourceId = g_source_attach(source, mainContextForSources());
-	g_source_unref(source);
-	return sourceId;
+	if (timerId != nullptr && *timerId != 0)
+	{
+		removeRunLoopTimer(*timerId);
+		*timerId = 0;
+	}
 }
 
 static guint attachUnixSignalSource(int signalNumber, GSourceFunc callback, gpointer userData)
@@ -196,8 +200,197 @@ struct RunLoopInvocation
 {
 	void (*callback)(void *);
 	void *userData;
+	RunLoopInvocation *next = nullptr;
+};
+
+// Cross-thread invocations go through a lock-free MPSC stack drained by one GSource per run loop. Producers only wake the
+// context when they find the stack empty, so a burst of invokes costs one wakeup and one dispatch instead of one idle source
+// each.
+//
+// Nodes are recycled rather than freed: each dispatch hands the nodes it ran back through `spare`, and a producer that runs out
+// takes that whole chain into a per-thread cache. Only whole-chain exchanges and publishes into an empty slot touch `spare`,
+// so the recycling is ABA-free, and a steady stream of invokes stops allocating once the caches are warm.
+//
+// `accepting` and `producers` close the queue at shutdown: a producer registers itself before checking `accepting`, and
+// closeRunLoopInvokeQueue() clears `accepting` and waits for registered producers before it drains, so no invocation can land
+// after the final drain.
+struct RunLoopInvokeQueue
+{
+	std::atomic<RunLoopInvocation *> head{nullptr};
+	std::atomic<RunLoopInvocation *> spare{nullptr};
+	std::atomic<size_t> depth{0};
+	std::atomic<size_t> capacity{0};
+	std::atomic<bool> accepting{false};
+	std::atomic<unsigned> producers{0};
+	GSource *source = nullptr;
+};
+
+static RunLoopInvokeQueue runLoopInvokeQueue;
+
+// Upper bound on the nodes one dispatch hands back for reuse; the rest of a larger burst is freed
+static constexpr size_t kMaxSpareRunLoopInvocations = 256;
+
+static void freeRunLoopInvocations(RunLoopInvocation *invocation)
+{
+	while (invocation != nullptr)
+	{
+		RunLoopInvocation *next = invocation->next;
+		delete invocation;
+		invocation = next;
+	}
+}
+
+// Nodes this thread took from `spare` but has not used yet
+struct RunLoopInvocationCache
+{
+	RunLoopInvocation *nodes = nullptr;
+	~RunLoopInvocationCache() { freeRunLoopInvocations(nodes); }
+};
+
+static thread_local RunLoopInvocationCache runLoopInvocationCache;
+
+static RunLoopInvocation *acquireRunLoopInvocation(void (*callback)(void *), void *userData)
+{
+	RunLoopInvocationCache &cache = runLoopInvocationCache;
+	if (cache.nodes == nullptr)
+	{
+		cache.nodes = runLoopInvokeQueue.spare.exchange(nullptr, std::memory_order_acquire);
+	}
+
+	RunLoopInvocation *invocation = cache.nodes;
+	if (invocation == nullptr)
+	{
+		return new (std::nothrow) RunLoopInvocation{callback, userData};
+	}
+
+	cache.nodes = invocation->next;
+	*invocation = RunLoopInvocation{callback, userData};
+	return invocation;
+}
+
+// Return an unpublished chain to this thread's cache
+static void releaseRunLoopInvocations(RunLoopInvocation *invocation)
+{
+	while (invocation != nullptr)
+	{
+		RunLoopInvocation *next = invocation->next;
+		invocation->next = runLoopInvocationCache.nodes;
+		runLoopInvocationCache.nodes = invocation;
+		invocation = next;
+	}
+}
+
+// Run a chain taken from `head` (newest first) in submission order, then offer the nodes for reuse
+static void runRunLoopInvocations(RunLoopInvocation *pending)
+{
+	RunLoopInvocation *ordered = nullptr;
+	while (pending != nullptr)
+	{
+		RunLoopInvocation *next = pending->next;
+		pending->next = ordered;
+		ordered = pending;
+		pending = next;
+	}
+
+	RunLoopInvocation *recycled = nullptr;
+	size_t recycledCount = 0;
+	while (ordered != nullptr)
+	{
+		RunLoopInvocation *invocation = ordered;
+		ordered = ordered->next;
+		const auto callback = invocation->callback;
+		void *userData = invocation->userData;
+		if (recycledCount < kMaxSpareRunLoopInvocations)
+		{
+			invocation->next = recycled;
+			recycled = invocation;
+			++recycledCount;
+		}
+		else
+		{
+			delete invocation;
+		}
+
+		runLoopInvokeQueue.depth.fetch_sub(1, std::memory_order_relaxed);
+		callback(userData);
+	}
+
+	// Publish only into an empty slot; producers have not drained the previous chain yet, so this one is not needed
+	RunLoopInvocation *expected = nullptr;
+	if (recycled != nullptr
+		&& !runLoopInvokeQueue.spare.compare_exchange_strong(expected, recycled, std::memory_order_release, std::memory_order_relaxed))
+	{
+		freeRunLoopInvocations(recycled);
+	}
+}
+
+static gboolean runLoopInvokeSourcePrepare(GSource *, gint *timeoutMS)
+{
+	*timeoutMS = -1;
+	return runLoopInvokeQueue.head.load(std::memory_order_acquire) != nullptr;
+}
+
+static gboolean runLoopInvokeSourceCheck(GSource *)
+{
+	return runLoopInvokeQueue.head.load(std::memory_order_acquire) != nullptr;
+}
+
+static gboolean runLoopInvokeSourceDispatch(GSource *, GSourceFunc, gpointer)
+{
+	// Take the current snapshot only, so callbacks that invoke again are picked up by the next dispatch rather than starving
+	// other sources
+	runRunLoopInvocations(runLoopInvokeQueue.head.exchange(nullptr, std::memory_order_acq_rel));
+	return G_SOURCE_CONTINUE;
+}
+
+static GSourceFuncs runLoopInvokeSourceFuncs = {
+	runLoopInvokeSourcePrepare,
+	runLoopInvokeSourceCheck,
+	runLoopInvokeSourceDispatch,
+	nullptr,
+	nullptr,
+	nullptr
 };
 
+static void attachRunLoopInvokeSource(GMainContext *context)
+{
+	freeRunLoopInvocations(runLoopInvokeQueue.head.exchange(nullptr, std::memory_order_acq_rel));
+	runLoopInvokeQueue.depth.store(0, std::memory_order_relaxed);
+
+	runLoopInvokeQueue.source = g_source_new(&runLoopInvokeSourceFuncs, sizeof(GSource));
+	g_source_set_priority(runLoopInvokeQueue.source, G_PRIORITY_DEFAULT);
+	g_source_set_name(runLoopInvokeQueue.source, "bzp-run-loop-invoke");
+	g_source_attach(runLoopInvokeQueue.source, context);
+	runLoopInvokeQueue.accepting.store(true);
+}
+
+// Refuse new invocations, then run everything accepted before that point on the loop's own thread, so a callback that owns its
+// user data is never silently lost at shutdown. Invokes made from those callbacks are refused like any other.
+static void closeRunLoopInvokeQueue()
+{
+	runLoopInvokeQueue.accepting.store(false);
+	while (runLoopInvokeQueue.producers.load() != 0)
+	{
+		std::this_thread::yield();
+	}
+
+	runRunLoopInvocations(runLoopInvokeQueue.head.exchange(nullptr, std::memory_order_acq_rel));
+}
+
+static void detachRunLoopInvokeSource()
+{
+	closeRunLoopInvokeQueue();
+	if (runLoopInvokeQueue.source != nullptr)
+	{
+		g_source_destroy(runLoopInvokeQueue.source);
+		g_source_unref(runLoopInvokeQueue.source);
+		runLoopInvokeQueue.source = nullptr;
+	}
+
+	runLoopInvokeQueue.depth.store(0, std::memory_order_relaxed);
+	freeRunLoopInvocations(runLoopInvokeQueue.spare.exchange(nullptr, std::memory_order_acquire));
+}
+
 struct RunLoopTimeoutWake
 {
 	guint sourceId = 0;
@@ -254,28 +447,162 @@ static void releaseRunLoopPollCycle()
 	resetRunLoopPollCycle();
 }
 
-static void attachUpdateProcessor()
+// A single descriptor for host reactors: an epoll set mirroring the GLib poll set plus a timerfd carrying the GLib timeout
+struct RunLoopEventFD
 {
-	updateProcessorSourceId = attachTimeoutSource
-	(
-		kIdleFrequencyMS,
-		[](gpointer pUserData) -> gboolean
+	int epollFD = -1;
+	int timerFD = -1;
+	std::vector<GPollFD> registered;
+};
+
+static RunLoopEventFD runLoopEventFD;
+
+static uint32_t toEpollEvents(gushort events)
+{
+	uint32_t epollEvents = 0;
+	if (events & G_IO_IN) { epollEvents |= EPOLLIN; }
+	if (events & G_IO_OUT) { epollEvents |= EPOLLOUT; }
+	if (events & G_IO_PRI) { epollEvents |= EPOLLPRI; }
+	return epollEvents;
+}
+
+static void closeRunLoopEventFD()
+{
+	if (runLoopEventFD.timerFD >= 0)
+	{
+		close(runLoopEventFD.timerFD);
+	}
+
+	if (runLoopEventFD.epollFD >= 0)
+	{
+		close(runLoopEventFD.epollFD);
+	}
+
+	runLoopEventFD = RunLoopEventFD();
+}
+
+// Re-mirror the GLib poll set and timeout into the epoll descriptor. Must run on the owner thread outside a poll cycle.
+static void syncRunLoopEventFD()
+{
+	if (runLoopEventFD.epollFD < 0 || pMainContext == nullptr || hasActiveRunLoopPollCycle())
+	{
+		return;
+	}
+
+	if (!g_main_context_acquire(pMainContext))
+	{
+		return;
+	}
+
+	int maxPriority = G_PRIORITY_DEFAULT;
+	const bool ready = g_main_context_prepare(pMainContext, &maxPriority) != FALSE;
+	int timeoutMS = -1;
+	std::vector<GPollFD> pollFDs(std::max<size_t>(runLoopEventFD.registered.size(), 8));
+	int fdCount = g_main_context_query(pMainContext, maxPriority, &timeoutMS, pollFDs.data(), static_cast<gint>(pollFDs.size()));
+	if (fdCount > static_cast<int>(pollFDs.size()))
+	{
+		pollFDs.resize(static_cast<size_t>(fdCount));
+		fdCount = g_main_context_query(pMainContext, maxPriority, &timeoutMS, pollFDs.data(), static_cast<gint>(pollFDs.size()));
+	}
+	g_main_context_release(pMainContext);
+	pollFDs.resize(static_cast<size_t>(std::min(fdCount, static_cast<int>(pollFDs.size()))));
+
+	// GLib may list one descriptor several times; epoll needs one entry with the merged interest set
+	std::vector<GPollFD> wanted;
+	for (const GPollFD &pollFD : pollFDs)
+	{
+		auto existing = std::find_if(wanted.begin(), wanted.end(), [&](const GPollFD &entry) { return entry.fd == pollFD.fd; });
+		if (existing == wanted.end())
 		{
-			if (bzpGetServerRunState() > ERunning)
+			wanted.push_back(GPollFD{pollFD.fd, pollFD.events, 0});
+		}
+		else
+		{
+			existing->events |= pollFD.events;
+		}
+	}
+
+	for (const GPollFD &previous : runLoopEventFD.registered)
+	{
+		if (std::none_of(wanted.begin(), wanted.end(), [&](const GPollFD &entry) { return entry.fd == previous.fd; }))
+		{
+			epoll_ctl(runLoopEventFD.epollFD, EPOLL_CTL_DEL, previous.fd, nullptr);
+		}
+	}
+
+	for (const GPollFD &entry : wanted)
+	{
+		epoll_event event{};
+		event.events = toEpollEvents(entry.events);
+		event.data.fd = entry.fd;
+
+		auto previous = std::find_if(runLoopEventFD.registered.begin(), runLoopEventFD.registered.end(),
+			[&](const GPollFD &registered) { return registered.fd == entry.fd; });
+		if (previous != runLoopEventFD.registered.end() && previous->events == entry.events)
+		{
+			continue;
+		}
+
+		// A descriptor GLib closed and reopened under the same number has already left the epoll set, so fall back to ADD
+		if (previous == runLoopEventFD.registered.end()
+			|| epoll_ctl(runLoopEventFD.epollFD, EPOLL_CTL_MOD, entry.fd, &event) != 0)
+		{
+			if (epoll_ctl(runLoopEventFD.epollFD, EPOLL_CTL_ADD, entry.fd, &event) != 0 && errno == EEXIST)
 			{
-				updateProcessorSourceId = 0;
-				return G_SOURCE_REMOVE;
+				epoll_ctl(runLoopEventFD.epollFD, EPOLL_CTL_MOD, entry.fd, &event);
 			}
+		}
+	}
+	runLoopEventFD.registered = std::move(wanted);
 
-			idleFunc(pUserData);
-			return G_SOURCE_CONTINUE;
-		},
-		nullptr
-	);
+	itimerspec expiry{};
+	if (ready || timeoutMS == 0)
+	{
+		expiry.it_value.tv_nsec = 1;
+	}
+	else if (timeoutMS > 0)
+	{
+		expiry.it_value.tv_sec = timeoutMS / 1000;
+		expiry.it_value.tv_nsec = static_cast<long>(timeoutMS % 1000) * 1000000L;
+	}
+	timerfd_settime(runLoopEventFD.timerFD, 0, &expiry, nullptr);
+}
+
+// Updates are processed when they are queued rather than by polling the queue, so an idle server never wakes up for them
+static void processPendingUpdates(void *)
+{
+	bUpdateProcessingScheduled.store(false, std::memory_order_release);
+	if (bzpGetServerRunState() != ERunning)
+	{
+		return;    // reaching ERunning schedules another pass
+	}
 
-	if (updateProcessorSourceId == 0)
+	int processed = 0;
+	while (processed < kMaxUpdatesPerDispatch && idleFunc(nullptr))
 	{
-		Logger::error(SSTR << "Unable to add update timer to main loop");
+		++processed;
+	}
+
+	const int remaining = bzpUpdateQueueSize();
+	publishQueueStatsEvent(static_cast<uint32_t>(remaining), static_cast<uint32_t>(processed));
+
+	// Yield to other sources between batches
+	if (remaining > 0)
+	{
+		scheduleServerLoopUpdateProcessing();
+	}
+}
+
+void scheduleServerLoopUpdateProcessing()
+{
+	if (pMainContext == nullptr || bUpdateProcessingScheduled.exchange(true, std::memory_order_acq_rel))
+	{
+		return;
+	}
+
+	if (invokeOnServerLoopEx(processPendingUpdates, nullptr) != BZP_RUN_LOOP_OK)
+	{
+		bUpdateProcessingScheduled.store(false, std::memory_order_release);
 	}
 }
 
@@ -322,20 +649,11 @@ static void onPrepareForSleepSignal(
 			return;
 		}
 
-		bRestoreAdvertisingAfterResume = adapterContext().isAdvertising();
-		Logger::status("System suspend requested; preparing BLE advertising state");
-
-		if (!bRestoreAdvertisingAfterResume)
-		{
-			Logger::info("BLE advertising was already stopped before suspend");
-			releaseSleepInhibitor();
-			return;
-		}
-
-		adapterContext().setAdvertisingAsync(false, [](BluezResult<void> result) {
+		Logger::status("System suspend requested; snapshotting BLE adapter and advertising state");
+		adapterContext().prepareForSleep([](BluezResult<void> result) {
 			if (result.hasError())
 			{
-				LOG_WARN_STREAM(SSTR << "Failed to stop BLE advertising for suspend: " << result.errorMessage());
+				LOG_WARN_STREAM(SSTR << "Failed to take BLE advertising off air for suspend: " << result.errorMessage());
 			}
 			else
 			{
@@ -346,38 +664,49 @@ static void onPrepareForSleepSignal(
 		return;
 	}
 
+	// Measured from the moment logind reports the wake, before anything else runs
+	const auto resumedAt = std::chrono::steady_clock::now();
 	Logger::status("System resume detected; restoring BLE adapter state");
-	refreshSleepInhibitorOnCurrentThread();
 
 	if (pAdapterContext == nullptr || !adapterContext().isInitialized())
 	{
 		LOG_DEBUG_STREAM("PrepareForSleep(false) received before adapter initialization");
+		refreshSleepInhibitorOnCurrentThread();
 		return;
 	}
 
-	const auto powerResult = adapterContext().setPowered(true);
-	if (powerResult.hasError())
-	{
-		LOG_WARN_STREAM(SSTR << "Failed to restore adapter power after resume: " << powerResult.errorMessage());
-	}
-
-	if (!bRestoreAdvertisingAfterResume)
+	if (!adapterContext().getSleepSnapshot().has_value())
 	{
-		Logger::info("BLE advertising was not active before suspend; no resume restart needed");
+		Logger::info("No suspend snapshot was taken; ensuring the adapter is powered");
+		const auto powerResult = adapterContext().setPowered(true);
+		if (powerResult.hasError())
+		{
+			LOG_WARN_STREAM(SSTR << "Failed to restore adapter power after resume: " << powerResult.errorMessage());
+		}
+		refreshSleepInhibitorOnCurrentThread();
 		return;
 	}
 
-	bRestoreAdvertisingAfterResume = false;
-	adapterContext().setAdvertisingAsync(true, [](BluezResult<void> result) {
-		if (result.hasError())
+	adapterContext().resumeFromSleep(resumedAt, [](const ResumeReport& report) {
+		lastResumeTimeToAdvertiseMs.store(report.timeToAdvertiseMs, std::memory_order_release);
+		if (report.failedCalls != 0)
+		{
+			LOG_WARN_STREAM(SSTR << "Resume restore finished with " << report.failedCalls << " of " << report.restoreCalls
+				<< " calls failing (" << report.firstError << ")");
+		}
+		if (report.advertisingRestored)
 		{
-			LOG_WARN_STREAM(SSTR << "Failed to restore BLE advertising after resume: " << result.errorMessage());
+			Logger::info(SSTR << "BLE advertising restored " << report.timeToAdvertiseMs << " ms after system resume ("
+				<< report.restoreCalls << " concurrent restore calls, " << report.totalMs << " ms total)");
 		}
 		else
 		{
-			Logger::info("BLE advertising restored after system resume");
+			Logger::info(SSTR << "BLE adapter state restored " << report.totalMs << " ms after system resume");
 		}
 	});
+
+	// Re-arming the inhibitor is a blocking logind call, so it goes out after the restore calls are already in flight
+	refreshSleepInhibitorOnCurrentThread();
 }
 
 static void subscribePrepareForSleepSignals()
@@ -412,7 +741,6 @@ static void unsubscribePrepareForSleepSignals()
 		g_dbus_connection_signal_unsubscribe(pBusConnection, sleepSignalSubscriptionId);
 		sleepSignalSubscriptionId = 0;
 	}
-	bRestoreAdvertisingAfterResume = false;
 }
 
 static void refreshPrepareForSleepSignalSubscriptionOnCurrentThread()
@@ -540,7 +868,6 @@ static bool activateRunLoopOnCurrentThread()
 	if (!bRunLoopActivated)
 	{
 		initializationStateProcessor();
-		attachUpdateProcessor();
 
 		if (bRunLoopInstallsSignalHandlers)
 		{
@@ -623,6 +950,8 @@ static bool initializeRunLoop(Server *serverContextPtr, BluezAdapter *adapterCon
 		return false;
 	}
 
+	attachRunLoopInvokeSource(pMainContext);
+	bUpdateProcessingScheduled.store(false, std::memory_order_release);
 	pMainLoop.store(mainLoop, std::memory_order_release);
 	mainContextOwnerThread = std::thread::id();
 	bRunLoopInstallsSignalHandlers = installSignalHandlers;
@@ -682,8 +1011,9 @@ static bool finalizeManualRunLoopIfStopped()
 // entry represents an interface that needs to be updated. The idleFunc calls the interface's `onUpdatedValue` method for each
 // update.
 //
-// The idle processor will perform one update per idle tick, however, it will notify that there is more data so the idle ticks
-// do not lag behind.
+// Queueing an update schedules a pass of the processor on the run loop, which drains the queue in batches of
+// kMaxUpdatesPerDispatch. There is no polling timer, so nothing runs while the queue is empty. Each pop picks the next entry by
+// priority lane (see UpdateQueue.h), so a critical update queued mid-batch goes out before the bulk entries still waiting.
 // ---------------------------------------------------------------------------------------------------------------------------------
 
 // Our idle function
@@ -691,9 +1021,9 @@ static bool finalizeManualRunLoopIfStopped()
 // This method is used to process data on the same thread as our main loop. This allows us to communicate with our service from
 // the outside.
 //
-// IMPORTANT: This method must return 'true' if any work was performed, otherwise it must return 'false'. Returning 'true' will
-// cause the idle loop to continue to call this method to process data at the maximum rate (which can peg the CPU at 100%.) By
-// returning false when there is no work to do, we are nicer to the system.
+// IMPORTANT: This method must return 'true' if an entry was taken off the queue, even one that names no known characteristic, and
+// 'false' only when there was nothing to take. The update processor keeps calling it while it returns 'true', so returning
+// 'false' for a consumed entry would end the batch early, and returning 'true' for an empty queue would spin.
 bool idleFunc(void *pUserData)
 {
 
@@ -703,20 +1033,18 @@ bool idleFunc(void *pUserData)
 		return false;
 	}
 
-	// Try to get an update
-	const int kQueueEntryLen = 1024;
-	char queueEntry[kQueueEntryLen];
-	if (bzpPopUpdateQueue(queueEntry, kQueueEntryLen, 0) != 1)
+	// Try to get an update; without a length limit an entry is always taken once it is chosen
+	std::string entryString;
+	if (popUpdate(entryString, false) != BZP_UPDATE_QUEUE_OK)
 	{
 		return false;
 	}
 
-	std::string entryString = queueEntry;
 	auto token = entryString.find('|');
 	if (token == std::string::npos)
 	{
 		Logger::error("Queue entry was not formatted properly - could not find separating token");
-		return false;
+		return true;
 	}
 
 	DBusObjectPath objectPath = DBusObjectPath(entryString.substr(0, token));
@@ -735,11 +1063,10 @@ bool idleFunc(void *pUserData)
 		{
 			LOG_DEBUG_STREAM(SSTR << "Processing updated value for interface '" << interfaceName << "' at path '" << objectPath << "'");
 			pCharacteristic->callOnUpdatedValue(DBusUpdateRef(pBusConnection, pUserData));
-			return true;
 		}
 	}
 
-	return false;
+	return true;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------------------
@@ -755,6 +1082,8 @@ bool idleFunc(void *pUserData)
 // Perform final cleanup of various resources that were allocated while the server was initialized and/or running
 void uninit()
 {
+	closeRunLoopInvokeQueue();
+
 	GMainLoop *mainLoop = pMainLoop.exchange(nullptr);
 	GMainContext *mainContext = pMainContext;
 	if (runLoopPollCycle.active && mainContext != nullptr)
@@ -762,6 +1091,7 @@ void uninit()
 		g_main_context_release(mainContext);
 	}
 	resetRunLoopPollCycle();
+	closeRunLoopEventFD();
 	pMainContext = nullptr;
 	pServerContext = nullptr;
 	pAdapterContext = nullptr;
@@ -817,15 +1147,9 @@ void uninit()
 		registeredObjectIds.clear();
 	}
 
-	if (0 != periodicTimeoutId)
-	{
-		removeSourceIfPresent(&periodicTimeoutId);
-	}
-
-	if (0 != updateProcessorSourceId)
-	{
-		removeSourceIfPresent(&updateProcessorSourceId);
-	}
+	removeTimerIfPresent(&retryTimerId);
+	retryTimeStart = 0;
+	bOwnedNameEverAcquired = false;
 
 	if (0 != sigtermSourceId)
 	{
@@ -856,6 +1180,8 @@ void uninit()
 		pBusConnection = nullptr;
 	}
 
+	detachRunLoopInvokeSource();
+
 	if (nullptr != mainLoop)
 	{
 		g_main_loop_unref(mainLoop);
@@ -938,37 +1264,23 @@ void shutdown()
 //
 // ---------------------------------------------------------------------------------------------------------------------------------
 
-// Periodic timer handler
+// Retry timer handler
 //
-// A periodic timer is a timer fires every so often (see kPeriodicTimerFrequencySeconds.) This is used for our initialization
-// failure retries. TickEvent system removed - use g_timeout_add() for periodic operations.
-gboolean onPeriodicTimer(gpointer pUserData)
+// Armed by setRetry() for a single shot, so nothing ticks while there is no failure to recover from.
+gboolean onRetryTimer(gpointer pUserData)
 {
 	(void)pUserData; // Suppress unused parameter warning
-	// If we're shutting down, don't do anything and stop the periodic timer
-	if (bzpGetServerRunState() > ERunning)
-	{
-		periodicTimeoutId = 0;
-		return FALSE;
-	}
+	retryTimerId = 0;
 
-	// Deal with retry timers
-	if (0 != retryTimeStart)
+	// If we're shutting down, don't do anything
+	if (bzpGetServerRunState() > ERunning)
 	{
-		Logger::debug(SSTR << "Ticking retry timer");
-
-		// Has the retry time expired?
-		int secondsRemaining = time(nullptr) - retryTimeStart - kRetryDelaySeconds;
-		if (secondsRemaining >= 0)
-		{
-			retryTimeStart = 0;
-			initializationStateProcessor();
-		}
+		return G_SOURCE_REMOVE;
 	}
 
-	// Note: TickEvent system removed in modernization - periodic operations should use g_timeout_add directly
-
-	return TRUE;
+	retryTimeStart = 0;
+	initializationStateProcessor();
+	return G_SOURCE_REMOVE;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------------------
@@ -995,23 +1307,8 @@ void onMethodCall
 	gpointer pUserData
 )
 {
-	// Convert our input path into our custom type for path management
-	DBusObjectPath objectPath(pObjectPath);
-
-	if (!serverContext().callMethod(
-		objectPath,
-		pInterfaceName,
-		pMethodName,
-		DBusMethodCallRef(pConnection, pParameters, pInvocation, pUserData)
-	))
-	{
-		Logger::error(SSTR << " + Method not found: [" << pSender << "]:[" << objectPath << "]:[" << pInterfaceName << "]:[" << pMethodName << "]");
-		const std::string notImplementedErrorName = serverContext().getOwnedName() + ".NotImplemented";
-		DBusMethodInvocationRef(pInvocation).returnDbusError(notImplementedErrorName.c_str(), "This method is not implemented");
-		return;
-	}
-
-	return;
+	dispatchMethodCall(serverContext(), pSender, pObjectPath, pInterfaceName, pMethodName,
+		DBusMethodCallRef(pConnection, pParameters, pInvocation, pUserData));
 }
 
 // Handle D-Bus requests to get a property
@@ -1026,83 +1323,7 @@ GVariant *onGetProperty
 	gpointer         pUserData
 )
 {
-	// Convert our input path into our custom type for path management
-	DBusObjectPath objectPath(pObjectPath);
-
-	const GattProperty *pProperty = serverContext().findProperty(objectPath, pInterfaceName, pPropertyName);
-
-	std::string propertyPath = std::string("[") + pSender + "]:[" + objectPath.toString() + "]:[" + pInterfaceName + "]:[" + pPropertyName + "]";
-	if (!pProperty)
-	{
-		Logger::error(SSTR << "Property(get) not found: " << propertyPath);
-	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, ("Property(get) not found: " + propertyPath).c_str(), pSender);
-		return nullptr;
-	}
-
-	const DBusPropertyCallRef propertyCall(
-		DBusConnectionRef(pConnection),
-		pSender != nullptr ? std::string_view(pSender) : std::string_view(),
-		objectPath.toString(),
-		pInterfaceName != nullptr ? std::string_view(pInterfaceName) : std::string_view(),
-		pPropertyName != nullptr ? std::string_view(pPropertyName) : std::string_view(),
-		DBusVariantRef(),
-		DBusErrorRef(ppError),
-		pUserData);
-
-	const auto &getterCallHandler = pProperty->getGetterCallHandler();
-	const auto &getterHandler = pProperty->getGetterHandler();
-#if BZP_ENABLE_LEGACY_RAW_GLIB_COMPAT
-#if defined(__clang__) || defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#endif
-	const auto rawGetterFunc = pProperty->getGetterFunc();
-#if defined(__clang__) || defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-#else
-	const auto rawGetterFunc = static_cast<GDBusInterfaceGetPropertyFunc>(nullptr);
-#endif
-	if (!getterCallHandler && !getterHandler && !rawGetterFunc)
-	{
-		Logger::error(SSTR << "Property(get) func not found: " << propertyPath);
-	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, ("Property(get) func not found: " + propertyPath).c_str(), pSender);
-		return nullptr;
-	}
-
-	Logger::info(SSTR << "Calling property getter: " << propertyPath);
-	GVariant *pResult = nullptr;
-	if (getterCallHandler)
-	{
-		pResult = getterCallHandler(propertyCall).get();
-	}
-	else if (getterHandler)
-	{
-		pResult = getterHandler(
-			propertyCall.connection(),
-			propertyCall.sender(),
-			propertyCall.objectPath(),
-			propertyCall.interfaceName(),
-			propertyCall.propertyName(),
-			propertyCall.error(),
-			propertyCall.userData()).get();
-	}
-	else
-	{
-		pResult = rawGetterFunc(pConnection, pSender, objectPath.c_str(), pInterfaceName, pPropertyName, ppError, pUserData);
-	}
-
-	if (nullptr == pResult)
-	{
-		if (ppError != nullptr && *ppError != nullptr)
-		{
-			return nullptr;
-		}
-	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, ("Property(get) failed: " + propertyPath).c_str(), pSender);
-	    return nullptr;
-	}
-
-	return pResult;
+	return dispatchGetProperty(serverContext(), pConnection, pSender, pObjectPath, pInterfaceName, pPropertyName, ppError, pUserData);
 }
 
 // Handle D-Bus requests to set a property
@@ -1118,75 +1339,8 @@ gboolean onSetProperty
 	gpointer         pUserData
 )
 {
-	// Convert our input path into our custom type for path management
-	DBusObjectPath objectPath(pObjectPath);
-
-	const GattProperty *pProperty = serverContext().findProperty(objectPath, pInterfaceName, pPropertyName);
-
-	std::string propertyPath = std::string("[") + pSender + "]:[" + objectPath.toString() + "]:[" + pInterfaceName + "]:[" + pPropertyName + "]";
-	if (!pProperty)
-	{
-		Logger::error(SSTR << "Property(set) not found: " << propertyPath);
-	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, ("Property(set) not found: " + propertyPath).c_str(), pSender);
-		return false;
-	}
-
-	const DBusPropertyCallRef propertyCall(
-		DBusConnectionRef(pConnection),
-		pSender != nullptr ? std::string_view(pSender) : std::string_view(),
-		objectPath.toString(),
-		pInterfaceName != nullptr ? std::string_view(pInterfaceName) : std::string_view(),
-		pPropertyName != nullptr ? std::string_view(pPropertyName) : std::string_view(),
-		DBusVariantRef(pValue),
-		DBusErrorRef(ppError),
+	return dispatchSetProperty(serverContext(), pConnection, pSender, pObjectPath, pInterfaceName, pPropertyName, pValue, ppError,
 		pUserData);
-
-	const auto &setterCallHandler = pProperty->getSetterCallHandler();
-	const auto &setterHandler = pProperty->getSetterHandler();
-#if BZP_ENABLE_LEGACY_RAW_GLIB_COMPAT
-#if defined(__clang__) || defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#endif
-	const auto rawSetterFunc = pProperty->getSetterFunc();
-#if defined(__clang__) || defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-#else
-	const auto rawSetterFunc = static_cast<GDBusInterfaceSetPropertyFunc>(nullptr);
-#endif
-	if (!setterCallHandler && !setterHandler && !rawSetterFunc)
-	{
-		Logger::error(SSTR << "Property(set) func not found: " << propertyPath);
-	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, ("Property(set) func not found: " + propertyPath).c_str(), pSender);
-		return false;
-	}
-
-	Logger::info(SSTR << "Calling property setter: " << propertyPath);
-	const bool success = setterCallHandler
-		? setterCallHandler(propertyCall)
-		: setterHandler
-			? setterHandler(
-				propertyCall.connection(),
-				propertyCall.sender(),
-				propertyCall.objectPath(),
-				propertyCall.interfaceName(),
-				propertyCall.propertyName(),
-				propertyCall.value(),
-				propertyCall.error(),
-				propertyCall.userData())
-			: rawSetterFunc(pConnection, pSender, objectPath.c_str(), pInterfaceName, pPropertyName, pValue, ppError, pUserData);
-	if (!success)
-	{
-		if (ppError != nullptr && *ppError != nullptr)
-		{
-			return false;
-		}
-	    g_set_error(ppError, G_IO_ERROR, G_IO_ERROR_FAILED, ("Property(set) failed: " + propertyPath).c_str(), pSender);
-	    return false;
-	}
-
-	return true;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------------------
@@ -1203,6 +1357,8 @@ gboolean onSetProperty
 void setRetry()
 {
 	retryTimeStart = time(nullptr);
+	removeTimerIfPresent(&retryTimerId);
+	retryTimerId = attachTimeoutSecondsSource(kRetryDelaySeconds, onRetryTimer, nullptr);
 }
 
 // Convenience method for setting a retry timer so that failures (related to initialization) can be continuously retried until we
@@ -1659,17 +1815,9 @@ void doOwnedNameAcquire()
 		// GBusNameAcquiredCallback name_acquired_handler
 		[](GDBusConnection *, const gchar *, gpointer)
 		{
-			// Handy way to get periodic activity
-			periodicTimeoutId = attachTimeoutSecondsSource(kPeriodicTimerFrequencySeconds, onPeriodicTimer, pBusConnection);
-			if (periodicTimeoutId <= 0)
-			{
-				Logger::fatal(SSTR << "Failed to add a periodic timer");
-				setServerHealth(EFailedInit);
-				shutdown();
-			}
-
-			// Bus name acquired
+			// Bus name acquired; from here on a lost name is recovered through the retry timer
 			bOwnedNameAcquired = true;
+			bOwnedNameEverAcquired = true;
 
 			// Keep going...
 			initializationStateProcessor();
@@ -1681,8 +1829,8 @@ void doOwnedNameAcquire()
 			// Bus name lost
 			bOwnedNameAcquired = false;
 
-			// If we don't have a periodicTimeout (which we use for error recovery) then we're sunk
-			if (0 == periodicTimeoutId)
+			// If we never held the name, there is nothing to recover and we're sunk
+			if (!bOwnedNameEverAcquired)
 			{
 				Logger::fatal(SSTR << "Unable to acquire an owned name ('" << serverContext().getOwnedName() << "') on the bus");
 				setServerHealth(EFailedInit);
@@ -1849,6 +1997,9 @@ void initializationStateProcessor()
 
 	// Successful initialization - switch to running state
 	setServerRunState(ERunning);
+
+	// Deliver anything that was queued while we were initializing
+	scheduleServerLoopUpdateProcessing();
 }
 
 void setPrepareForSleepIntegrationEnabled(bool enabled)
@@ -1922,6 +2073,11 @@ bool hasSleepInhibitor()
 	return sleepInhibitorFD >= 0;
 }
 
+int64_t getLastResumeTimeToAdvertiseMs()
+{
+	return lastResumeTimeToAdvertiseMs.load(std::memory_order_acquire);
+}
+
 // ---------------------------------------------------------------------------------------------------------------------------------
 //  ____                                                                  _
 // |  _ \ _   _ _ __     ___  ___ _ ____   _____ _ __    _ __ _   _ _ __ | |
@@ -2008,6 +2164,7 @@ BZPRunLoopResult runServerLoopIterationEx(int mayBlock)
 		return BZP_RUN_LOOP_OK;
 	}
 
+	syncRunLoopEventFD();
 	return dispatched ? BZP_RUN_LOOP_OK : BZP_RUN_LOOP_IDLE;
 }
 
@@ -2087,6 +2244,7 @@ BZPRunLoopResult runServerLoopIterationForEx(int timeoutMS)
 		return BZP_RUN_LOOP_OK;
 	}
 
+	syncRunLoopEventFD();
 	if (timeoutWake.fired)
 	{
 		return BZP_RUN_LOOP_IDLE;
@@ -2346,6 +2504,7 @@ BZPRunLoopResult dispatchServerLoopPollEx()
 		return BZP_RUN_LOOP_OK;
 	}
 
+	syncRunLoopEventFD();
 	return ready ? BZP_RUN_LOOP_OK : BZP_RUN_LOOP_IDLE;
 }
 
@@ -2358,65 +2517,272 @@ BZPRunLoopResult cancelServerLoopPollEx()
 	}
 
 	releaseRunLoopPollCycle();
-	(void)finalizeManualRunLoopIfStopped();
+	if (!finalizeManualRunLoopIfStopped())
+	{
+		syncRunLoopEventFD();
+	}
 	return BZP_RUN_LOOP_OK;
 }
 
-BZPRunLoopResult invokeOnServerLoopEx(void (*callback)(void *), void *userData)
+BZPRunLoopResult getServerLoopFDEx(int *fd)
 {
-	if (callback == nullptr)
+	if (fd == nullptr)
 	{
-		Logger::warn("invokeOnServerLoop() requires a non-null callback");
+		Logger::warn("getServerLoopFD() requires a non-null output pointer");
 		return BZP_RUN_LOOP_INVALID_ARGUMENT;
 	}
 
+	*fd = -1;
+	if (!bManualRunLoopMode)
+	{
+		Logger::warn("getServerLoopFD() is only valid after startServerLoopManually()");
+		return BZP_RUN_LOOP_NOT_MANUAL_MODE;
+	}
+
 	if (pMainContext == nullptr)
 	{
-		Logger::warn("invokeOnServerLoop() called without an active BzPeri run loop");
+		Logger::warn("getServerLoopFD() called without an active manual run loop");
 		return BZP_RUN_LOOP_NOT_ACTIVE;
 	}
 
-	RunLoopInvocation *invocation = new (std::nothrow) RunLoopInvocation{callback, userData};
-	if (invocation == nullptr)
+	if (hasActiveRunLoopPollCycle())
 	{
-		Logger::error("Unable to allocate run-loop invocation state");
-		return BZP_RUN_LOOP_ALLOCATION_FAILED;
+		Logger::warn("getServerLoopFD() cannot run while a manual run-loop poll cycle is active; call dispatch or cancel first");
+		return BZP_RUN_LOOP_POLL_CYCLE_ACTIVE;
 	}
 
-	if (mainContextOwnerThread != std::thread::id() && mainContextOwnerThread != std::this_thread::get_id())
+	if (const BZPRunLoopResult ownerResult = ensureRunLoopOwnerThread("getServerLoopFD()");
+		ownerResult != BZP_RUN_LOOP_OK)
+	{
+		return ownerResult;
+	}
+
+	if (!activateRunLoopOnCurrentThread())
+	{
+		setServerHealth(EFailedInit);
+		setServerRunState(EStopped);
+		finalizeRunLoop();
+		return BZP_RUN_LOOP_ACTIVATION_FAILED;
+	}
+
+	if (finalizeManualRunLoopIfStopped())
+	{
+		return BZP_RUN_LOOP_NOT_ACTIVE;
+	}
+
+	if (runLoopEventFD.epollFD < 0)
+	{
+		runLoopEventFD.epollFD = epoll_create1(EPOLL_CLOEXEC);
+		runLoopEventFD.timerFD = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		epoll_event timerEvent{};
+		timerEvent.events = EPOLLIN;
+		timerEvent.data.fd = runLoopEventFD.timerFD;
+		if (runLoopEventFD.epollFD < 0 || runLoopEventFD.timerFD < 0
+			|| epoll_ctl(runLoopEventFD.epollFD, EPOLL_CTL_ADD, runLoopEventFD.timerFD, &timerEvent) != 0)
+		{
+			Logger::error(SSTR << "Unable to create the manual run-loop event descriptor: " << g_strerror(errno));
+			closeRunLoopEventFD();
+			return BZP_RUN_LOOP_ALLOCATION_FAILED;
+		}
+
+		syncRunLoopEventFD();
+	}
+
+	*fd = runLoopEventFD.epollFD;
+	return BZP_RUN_LOOP_OK;
+}
+
+BZPRunLoopResult dispatchServerLoopPendingEx(int budget, int *dispatchedCount)
+{
+	if (dispatchedCount != nullptr)
+	{
+		*dispatchedCount = 0;
+	}
+
+	if (budget <= 0)
+	{
+		Logger::warn("dispatchServerLoopPending() requires a positive budget");
+		return BZP_RUN_LOOP_INVALID_ARGUMENT;
+	}
+
+	if (!bManualRunLoopMode)
+	{
+		Logger::warn("dispatchServerLoopPending() is only valid after startServerLoopManually()");
+		return BZP_RUN_LOOP_NOT_MANUAL_MODE;
+	}
+
+	if (pMainContext == nullptr)
+	{
+		Logger::warn("dispatchServerLoopPending() called without an active manual run loop");
+		return BZP_RUN_LOOP_NOT_ACTIVE;
+	}
+
+	if (hasActiveRunLoopPollCycle())
+	{
+		Logger::warn("dispatchServerLoopPending() cannot run while a manual run-loop poll cycle is active; call dispatch or cancel first");
+		return BZP_RUN_LOOP_POLL_CYCLE_ACTIVE;
+	}
+
+	if (const BZPRunLoopResult ownerResult = ensureRunLoopOwnerThread("dispatchServerLoopPending()");
+		ownerResult != BZP_RUN_LOOP_OK)
+	{
+		return ownerResult;
+	}
+
+	if (!activateRunLoopOnCurrentThread())
+	{
+		setServerHealth(EFailedInit);
+		setServerRunState(EStopped);
+		finalizeRunLoop();
+		return BZP_RUN_LOOP_ACTIVATION_FAILED;
+	}
+
+	if (finalizeManualRunLoopIfStopped())
 	{
-		g_main_context_invoke_full(
-			pMainContext,
-			G_PRIORITY_DEFAULT,
-			[](gpointer data) -> gboolean {
-				auto *invocation = static_cast<RunLoopInvocation *>(data);
-				invocation->callback(invocation->userData);
-				return G_SOURCE_REMOVE;
-			},
-			invocation,
-			[](gpointer data) {
-				delete static_cast<RunLoopInvocation *>(data);
-			});
 		return BZP_RUN_LOOP_OK;
 	}
 
-	GSource *source = g_idle_source_new();
-	g_source_set_priority(source, G_PRIORITY_DEFAULT);
-	g_source_set_callback(
-		source,
-		[](gpointer data) -> gboolean {
-			auto *invocation = static_cast<RunLoopInvocation *>(data);
-			invocation->callback(invocation->userData);
-			return G_SOURCE_REMOVE;
-		},
-		invocation,
-		[](gpointer data) {
-			delete static_cast<RunLoopInvocation *>(data);
-		});
-	g_source_attach(source, pMainContext);
-	g_source_unref(source);
+	if (runLoopEventFD.timerFD >= 0)
+	{
+		uint64_t expirations = 0;
+		(void)!read(runLoopEventFD.timerFD, &expirations, sizeof(expirations));
+	}
+
+	// Each non-blocking iteration dispatches every ready source at the highest ready priority
+	int dispatched = 0;
+	while (dispatched < budget && g_main_context_iteration(pMainContext, FALSE))
+	{
+		++dispatched;
+		if (dispatchedCount != nullptr)
+		{
+			*dispatchedCount = dispatched;
+		}
+
+		if (finalizeManualRunLoopIfStopped())
+		{
+			return BZP_RUN_LOOP_OK;
+		}
+	}
+
+	if (finalizeManualRunLoopIfStopped())
+	{
+		return BZP_RUN_LOOP_OK;
+	}
+
+	syncRunLoopEventFD();
+	return dispatched > 0 ? BZP_RUN_LOOP_OK : BZP_RUN_LOOP_IDLE;
+}
+
+static BZPRunLoopResult queueServerLoopInvocations(const BZPRunLoopInvocation *invocations, int count, bool bounded, const char *context)
+{
+	// Registering before the check pairs with closeRunLoopInvokeQueue(), which waits for registered producers after it stops
+	// accepting; both sides use sequentially consistent operations so one of them always sees the other
+	runLoopInvokeQueue.producers.fetch_add(1);
+	struct ProducerScope
+	{
+		~ProducerScope() { runLoopInvokeQueue.producers.fetch_sub(1, std::memory_order_release); }
+	} producerScope;
+
+	if (!runLoopInvokeQueue.accepting.load())
+	{
+		Logger::warn(SSTR << context << " called without an active BzPeri run loop");
+		return BZP_RUN_LOOP_NOT_ACTIVE;
+	}
+
+	const size_t requested = static_cast<size_t>(count);
+	const size_t capacity = runLoopInvokeQueue.capacity.load(std::memory_order_relaxed);
+	if (bounded && capacity > 0)
+	{
+		size_t depth = runLoopInvokeQueue.depth.load(std::memory_order_relaxed);
+		do
+		{
+			if (depth + requested > capacity)
+			{
+				return BZP_RUN_LOOP_QUEUE_FULL;
+			}
+		} while (!runLoopInvokeQueue.depth.compare_exchange_weak(depth, depth + requested, std::memory_order_relaxed));
+	}
+	else
+	{
+		runLoopInvokeQueue.depth.fetch_add(requested, std::memory_order_relaxed);
+	}
+
+	// Link the batch newest-first so it joins the stack as one chain and drains in submission order
+	RunLoopInvocation *first = nullptr;
+	RunLoopInvocation *last = nullptr;
+	for (int index = 0; index < count; ++index)
+	{
+		RunLoopInvocation *invocation = acquireRunLoopInvocation(invocations[index].callback, invocations[index].pUserData);
+		if (invocation == nullptr)
+		{
+			releaseRunLoopInvocations(last);
+			runLoopInvokeQueue.depth.fetch_sub(requested, std::memory_order_relaxed);
+			Logger::error("Unable to allocate run-loop invocation state");
+			return BZP_RUN_LOOP_ALLOCATION_FAILED;
+		}
+
+		invocation->next = last;
+		last = invocation;
+		if (first == nullptr)
+		{
+			first = invocation;
+		}
+	}
+
+	RunLoopInvocation *previousHead = runLoopInvokeQueue.head.load(std::memory_order_relaxed);
+	do
+	{
+		first->next = previousHead;
+	} while (!runLoopInvokeQueue.head.compare_exchange_weak(previousHead, last, std::memory_order_release, std::memory_order_relaxed));
+
+	if (previousHead == nullptr)
+	{
+		g_main_context_wakeup(pMainContext);
+	}
 
 	return BZP_RUN_LOOP_OK;
 }
 
+BZPRunLoopResult invokeOnServerLoopEx(void (*callback)(void *), void *userData, bool bounded)
+{
+	if (callback == nullptr)
+	{
+		Logger::warn("invokeOnServerLoop() requires a non-null callback");
+		return BZP_RUN_LOOP_INVALID_ARGUMENT;
+	}
+
+	const BZPRunLoopInvocation invocation{callback, userData};
+	return queueServerLoopInvocations(&invocation, 1, bounded, "invokeOnServerLoop()");
+}
+
+BZPRunLoopResult invokeBatchOnServerLoopEx(const BZPRunLoopInvocation *invocations, int count, bool bounded)
+{
+	if (count <= 0 || invocations == nullptr)
+	{
+		Logger::warn("invokeBatchOnServerLoop() requires a non-empty invocation array");
+		return BZP_RUN_LOOP_INVALID_ARGUMENT;
+	}
+
+	for (int index = 0; index < count; ++index)
+	{
+		if (invocations[index].callback == nullptr)
+		{
+			Logger::warn("invokeBatchOnServerLoop() requires a non-null callback for every entry");
+			return BZP_RUN_LOOP_INVALID_ARGUMENT;
+		}
+	}
+
+	return queueServerLoopInvocations(invocations, count, bounded, "invokeBatchOnServerLoop()");
+}
+
+void setServerLoopInvokeCapacity(size_t capacity)
+{
+	runLoopInvokeQueue.capacity.store(capacity, std::memory_order_relaxed);
+}
+
+size_t getServerLoopInvokeCapacity()
+{
+	return runLoopInvokeQueue.capacity.load(std::memory_order_relaxed);
+}
+
 }; // namespace bzp
@@ -41,6 +41,9 @@ void setSleepInhibitorEnabled(bool enabled);
 bool isSleepInhibitorEnabled();
 bool hasSleepInhibitor();
 
+// Milliseconds from the last system resume until the primary advertisement was back on air, or -1 if none was restored
+int64_t getLastResumeTimeToAdvertiseMs();
+
 // Entry point for the asynchronous server thread
 //
 // This method should not be called directly, instead, direct your attention over to `bzpStart()`
@@ -68,7 +71,23 @@ BZPRunLoopResult checkServerLoopPollEx(const BZPPollFD *pollFDs, int pollFDCount
 BZPRunLoopResult dispatchServerLoopPollEx();
 BZPRunLoopResult cancelServerLoopPollEx();
 
+// Single-descriptor integration: an epoll fd mirroring the GLib poll set and timeout, plus a bounded non-blocking dispatcher.
+BZPRunLoopResult getServerLoopFDEx(int *fd);
+BZPRunLoopResult dispatchServerLoopPendingEx(int budget, int *dispatchedCount);
+
+// Ask the run loop to drain the update queue; called whenever an update is queued.
+void scheduleServerLoopUpdateProcessing();
+
 // Queue a callback to execute on the dedicated GLib runtime.
-BZPRunLoopResult invokeOnServerLoopEx(void (*callback)(void *), void *userData);
+//
+// `bounded` applies the host-configured invoke capacity; internal callers leave it off so library work is never refused.
+BZPRunLoopResult invokeOnServerLoopEx(void (*callback)(void *), void *userData, bool bounded = false);
+
+// Queue several callbacks with a single wakeup. A bounded batch is accepted or refused as a whole.
+BZPRunLoopResult invokeBatchOnServerLoopEx(const BZPRunLoopInvocation *invocations, int count, bool bounded = false);
+
+// Maximum number of pending bounded invocations; 0 means unbounded.
+void setServerLoopInvokeCapacity(size_t capacity);
+size_t getServerLoopInvokeCapacity();
 
 }; // namespace bzp
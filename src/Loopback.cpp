@@ -0,0 +1,194 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// See the discussion at the top of Loopback.h
+
+#include <bzp/Loopback.h>
+#include <bzp/Logger.h>
+
+#include "Dispatch.h"
+
+#include <gio/gio.h>
+
+#include <new>
+#include <string>
+#include <utility>
+
+namespace bzp {
+
+LoopbackTransport::LoopbackTransport(const Server &server, std::string sender)
+: server_(server), sender_(std::move(sender)), pEmptyParameters_(g_variant_ref_sink(g_variant_new_tuple(nullptr, 0)))
+{
+}
+
+LoopbackTransport::~LoopbackTransport()
+{
+	reset();
+	g_variant_unref(pEmptyParameters_);
+}
+
+const LoopbackReply &LoopbackTransport::callMethod(const char *pObjectPath, const char *pInterfaceName, const char *pMethodName,
+	GVariant *pParameters)
+{
+	reset();
+	GVariant *pArguments = pParameters != nullptr ? g_variant_ref_sink(pParameters) : g_variant_ref(pEmptyParameters_);
+	inCall_ = true;
+	dispatchMethodCall(server_, sender_.c_str(), pObjectPath, pInterfaceName, pMethodName,
+		DBusMethodCallRef(DBusConnectionRef(), DBusVariantRef(pArguments), DBusMethodInvocationRef(*this), nullptr));
+	inCall_ = false;
+	g_variant_unref(pArguments);
+	return reply_;
+}
+
+const LoopbackReply &LoopbackTransport::getProperty(const char *pObjectPath, const char *pInterfaceName, const char *pPropertyName)
+{
+	reset();
+	GError *pError = nullptr;
+	GVariant *pValue = dispatchGetProperty(server_, nullptr, sender_.c_str(), pObjectPath, pInterfaceName, pPropertyName, &pError,
+		nullptr);
+	if (pValue != nullptr)
+	{
+		reply_.status_ = LoopbackReply::Status::Value;
+		reply_.value_ = g_variant_ref_sink(pValue);
+		reply_.replyCount_ = 1;
+	}
+	else
+	{
+		returnError(pError);
+	}
+	g_clear_error(&pError);
+	return reply_;
+}
+
+const LoopbackReply &LoopbackTransport::setProperty(const char *pObjectPath, const char *pInterfaceName, const char *pPropertyName,
+	GVariant *pValue)
+{
+	reset();
+	GError *pError = nullptr;
+	GVariant *pOwnedValue = pValue != nullptr ? g_variant_ref_sink(pValue) : nullptr;
+	if (dispatchSetProperty(server_, nullptr, sender_.c_str(), pObjectPath, pInterfaceName, pPropertyName, pOwnedValue, &pError,
+		nullptr))
+	{
+		reply_.status_ = LoopbackReply::Status::Value;
+		reply_.replyCount_ = 1;
+	}
+	else
+	{
+		returnError(pError);
+	}
+	g_clear_error(&pError);
+	if (pOwnedValue != nullptr)
+	{
+		g_variant_unref(pOwnedValue);
+	}
+	return reply_;
+}
+
+void LoopbackTransport::reset()
+{
+	if (reply_.value_ != nullptr)
+	{
+		g_variant_unref(reply_.value_);
+		reply_.value_ = nullptr;
+	}
+	reply_.status_ = LoopbackReply::Status::None;
+	reply_.errorName_.clear();
+	reply_.errorMessage_.clear();
+	reply_.replyCount_ = 0;
+}
+
+// GDBus turns a GError from a property handler into an error reply; use the same name mapping
+void LoopbackTransport::returnError(GError *pError)
+{
+	reply_.status_ = LoopbackReply::Status::Error;
+	reply_.replyCount_ = 1;
+	if (pError == nullptr)
+	{
+		reply_.errorName_ = "org.freedesktop.DBus.Error.Failed";
+		reply_.errorMessage_ = "Property handler failed without an error";
+		return;
+	}
+
+	gchar *pErrorName = g_dbus_error_encode_gerror(pError);
+	reply_.errorName_ = pErrorName;
+	reply_.errorMessage_ = pError->message != nullptr ? pError->message : "";
+	g_free(pErrorName);
+}
+
+// Only the call that is being dispatched can reply; anything later would land in another call's reply
+bool LoopbackTransport::acceptReply() noexcept
+{
+	if (inCall_)
+	{
+		return true;
+	}
+	lateReplies_ += 1;
+	Logger::error("Loopback: a handler replied after its call returned; deferred replies are not supported");
+	return false;
+}
+
+void LoopbackTransport::returnValue(GVariant *parameters)
+{
+	GVariant *pOwned = parameters != nullptr ? g_variant_ref_sink(parameters) : nullptr;
+	if (!acceptReply())
+	{
+		if (pOwned != nullptr)
+		{
+			g_variant_unref(pOwned);
+		}
+		return;
+	}
+
+	reply_.replyCount_ += 1;
+	if (reply_.replyCount_ > 1)
+	{
+		Logger::warn("Loopback: handler replied more than once; keeping the first reply");
+	}
+	else if (pOwned != nullptr && !g_variant_is_of_type(pOwned, G_VARIANT_TYPE_TUPLE))
+	{
+		// A bus refuses to send this, and the caller gets an error instead
+		reply_.status_ = LoopbackReply::Status::Error;
+		reply_.errorName_ = "org.freedesktop.DBus.Error.InvalidArgs";
+		reply_.errorMessage_ = std::string("Type of return value is incorrect: expected a tuple, got '")
+			+ g_variant_get_type_string(pOwned) + "'";
+	}
+	else
+	{
+		reply_.status_ = LoopbackReply::Status::Value;
+		reply_.value_ = pOwned;
+		pOwned = nullptr;
+	}
+
+	if (pOwned != nullptr)
+	{
+		g_variant_unref(pOwned);
+	}
+}
+
+void LoopbackTransport::returnDbusError(const char *errorName, const char *message) noexcept
+{
+	if (!acceptReply())
+	{
+		return;
+	}
+
+	reply_.replyCount_ += 1;
+	if (reply_.replyCount_ > 1)
+	{
+		Logger::warn("Loopback: handler replied more than once; keeping the first reply");
+		return;
+	}
+
+	try
+	{
+		reply_.errorName_ = errorName != nullptr ? errorName : "";
+		reply_.errorMessage_ = message != nullptr ? message : "";
+	}
+	catch (const std::bad_alloc &)
+	{
+		reply_.errorMessage_.clear();
+	}
+	reply_.status_ = LoopbackReply::Status::Error;
+}
+
+} // namespace bzp
@@ -0,0 +1,311 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Deadline-ordered timers for BzPeri's GLib run loops.
+
+#include "RunLoopTimers.h"
+
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bzp {
+
+namespace {
+
+constexpr gint64 kMicrosecondsPerSecond = 1000000;
+
+struct TimerEntry
+{
+	GMainContext *context = nullptr;
+	gint64 deadline = 0;
+	gint64 intervalUS = 0;
+	bool wholeSeconds = false;
+	bool fixedRate = false;
+	bool running = false;
+	GSourceFunc callback = nullptr;
+	gpointer userData = nullptr;
+};
+
+// One per GMainContext: the attached source plus its timers ordered by (deadline, id)
+struct TimerWheel
+{
+	GSource *source = nullptr;
+	std::set<std::pair<gint64, guint>> deadlines;
+	uint64_t wakeups = 0;
+};
+
+struct TimerWheelSource
+{
+	GSource base;
+	GMainContext *context;
+};
+
+std::mutex timersMutex;
+std::unordered_map<guint, TimerEntry> timers;
+std::unordered_map<GMainContext *, TimerWheel> wheels;
+guint nextTimerId = 1;
+
+gint64 deadlineAfter(gint64 now, const TimerEntry &timer)
+{
+	if (timer.fixedRate)
+	{
+		return (now / timer.intervalUS + 1) * timer.intervalUS;
+	}
+
+	const gint64 deadline = now + timer.intervalUS;
+	if (!timer.wholeSeconds)
+	{
+		return deadline;
+	}
+
+	return ((deadline + kMicrosecondsPerSecond - 1) / kMicrosecondsPerSecond) * kMicrosecondsPerSecond;
+}
+
+// Next grid point after the previous deadline, skipping any periods that already passed while the callback was late
+gint64 nextFixedRateDeadline(gint64 now, const TimerEntry &timer)
+{
+	const gint64 deadline = timer.deadline + timer.intervalUS;
+	if (deadline > now)
+	{
+		return deadline;
+	}
+
+	return deadline + ((now - deadline) / timer.intervalUS + 1) * timer.intervalUS;
+}
+
+void rearmLocked(TimerWheel &wheel)
+{
+	g_source_set_ready_time(wheel.source, wheel.deadlines.empty() ? -1 : wheel.deadlines.begin()->first);
+}
+
+gboolean dispatchTimerWheel(GSource *source, GSourceFunc, gpointer)
+{
+	GMainContext *context = reinterpret_cast<TimerWheelSource *>(source)->context;
+	const gint64 now = g_source_get_time(source);
+
+	// Collect what is due first so timers re-armed by their own callbacks wait for the next dispatch
+	std::vector<guint> due;
+	{
+		std::lock_guard<std::mutex> lock(timersMutex);
+		auto wheel = wheels.find(context);
+		if (wheel == wheels.end())
+		{
+			return G_SOURCE_CONTINUE;
+		}
+
+		++wheel->second.wakeups;
+		auto &deadlines = wheel->second.deadlines;
+		while (!deadlines.empty() && deadlines.begin()->first <= now)
+		{
+			const guint timerId = deadlines.begin()->second;
+			deadlines.erase(deadlines.begin());
+			timers[timerId].running = true;
+			due.push_back(timerId);
+		}
+	}
+
+	for (const guint timerId : due)
+	{
+		GSourceFunc callback = nullptr;
+		gpointer userData = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(timersMutex);
+			auto timer = timers.find(timerId);
+			if (timer == timers.end())
+			{
+				continue;
+			}
+			callback = timer->second.callback;
+			userData = timer->second.userData;
+		}
+
+		const bool keep = callback(userData) != G_SOURCE_REMOVE;
+
+		std::lock_guard<std::mutex> lock(timersMutex);
+		auto timer = timers.find(timerId);
+		if (timer == timers.end())
+		{
+			continue;    // removed from inside its callback
+		}
+
+		if (!keep)
+		{
+			timers.erase(timer);
+			continue;
+		}
+
+		timer->second.running = false;
+		const gint64 returnedAt = g_get_monotonic_time();
+		timer->second.deadline = timer->second.fixedRate
+			? nextFixedRateDeadline(returnedAt, timer->second)
+			: deadlineAfter(returnedAt, timer->second);
+		if (auto wheel = wheels.find(context); wheel != wheels.end())
+		{
+			wheel->second.deadlines.emplace(timer->second.deadline, timerId);
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(timersMutex);
+	if (auto wheel = wheels.find(context); wheel != wheels.end())
+	{
+		rearmLocked(wheel->second);
+	}
+	return G_SOURCE_CONTINUE;
+}
+
+// The context owns the only reference to the source, so this runs when the context itself goes away
+void finalizeTimerWheel(GSource *source)
+{
+	GMainContext *context = reinterpret_cast<TimerWheelSource *>(source)->context;
+
+	std::lock_guard<std::mutex> lock(timersMutex);
+	wheels.erase(context);
+	for (auto timer = timers.begin(); timer != timers.end();)
+	{
+		timer = timer->second.context == context ? timers.erase(timer) : std::next(timer);
+	}
+}
+
+GSourceFuncs timerWheelSourceFuncs = {
+	nullptr,
+	nullptr,
+	dispatchTimerWheel,
+	finalizeTimerWheel,
+	nullptr,
+	nullptr
+};
+
+TimerWheel &ensureWheelLocked(GMainContext *context)
+{
+	TimerWheel &wheel = wheels[context];
+	if (wheel.source == nullptr)
+	{
+		wheel.source = g_source_new(&timerWheelSourceFuncs, sizeof(TimerWheelSource));
+		reinterpret_cast<TimerWheelSource *>(wheel.source)->context = context;
+		g_source_set_priority(wheel.source, G_PRIORITY_DEFAULT);
+		g_source_set_name(wheel.source, "bzp-timer-wheel");
+		g_source_set_ready_time(wheel.source, -1);
+		g_source_attach(wheel.source, context);
+		g_source_unref(wheel.source);
+	}
+
+	return wheel;
+}
+
+guint addTimer(GMainContext *context, TimerEntry timer)
+{
+	if (context == nullptr || timer.callback == nullptr)
+	{
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(timersMutex);
+	TimerWheel &wheel = ensureWheelLocked(context);
+
+	while (nextTimerId == 0 || timers.count(nextTimerId) != 0)
+	{
+		++nextTimerId;
+	}
+	const guint timerId = nextTimerId++;
+
+	timer.context = context;
+	timer.deadline = deadlineAfter(g_get_monotonic_time(), timer);
+	wheel.deadlines.emplace(timer.deadline, timerId);
+	timers.emplace(timerId, timer);
+	rearmLocked(wheel);
+	return timerId;
+}
+
+} // namespace
+
+GMainContext *threadRunLoopContext()
+{
+	GMainContext *context = g_main_context_get_thread_default();
+	return context != nullptr ? context : g_main_context_default();
+}
+
+guint addRunLoopTimer(GMainContext *context, guint intervalMS, GSourceFunc callback, gpointer userData)
+{
+	TimerEntry timer;
+	timer.intervalUS = static_cast<gint64>(intervalMS) * 1000;
+	timer.callback = callback;
+	timer.userData = userData;
+	return addTimer(context, timer);
+}
+
+guint addRunLoopTimerSeconds(GMainContext *context, guint intervalSeconds, GSourceFunc callback, gpointer userData)
+{
+	TimerEntry timer;
+	timer.intervalUS = static_cast<gint64>(intervalSeconds) * kMicrosecondsPerSecond;
+	timer.wholeSeconds = true;
+	timer.callback = callback;
+	timer.userData = userData;
+	return addTimer(context, timer);
+}
+
+guint addRunLoopTimerFixedRate(GMainContext *context, guint intervalMS, GSourceFunc callback, gpointer userData)
+{
+	if (intervalMS == 0)
+	{
+		return 0;
+	}
+
+	TimerEntry timer;
+	timer.intervalUS = static_cast<gint64>(intervalMS) * 1000;
+	timer.fixedRate = true;
+	timer.callback = callback;
+	timer.userData = userData;
+	return addTimer(context, timer);
+}
+
+bool removeRunLoopTimer(guint timerId)
+{
+	std::lock_guard<std::mutex> lock(timersMutex);
+	auto timer = timers.find(timerId);
+	if (timer == timers.end())
+	{
+		return false;
+	}
+
+	if (!timer->second.running)
+	{
+		if (auto wheel = wheels.find(timer->second.context); wheel != wheels.end())
+		{
+			wheel->second.deadlines.erase({timer->second.deadline, timerId});
+			rearmLocked(wheel->second);
+		}
+	}
+
+	timers.erase(timer);
+	return true;
+}
+
+std::size_t runLoopTimerCount(GMainContext *context)
+{
+	std::lock_guard<std::mutex> lock(timersMutex);
+	std::size_t count = 0;
+	for (const auto &[timerId, timer] : timers)
+	{
+		count += timer.context == context ? 1 : 0;
+	}
+	return count;
+}
+
+gint64 runLoopTimerNextDeadline(GMainContext *context)
+{
+	std::lock_guard<std::mutex> lock(timersMutex);
+	auto wheel = wheels.find(context);
+	return wheel == wheels.end() || wheel->second.deadlines.empty() ? -1 : wheel->second.deadlines.begin()->first;
+}
+
+uint64_t runLoopTimerWakeups(GMainContext *context)
+{
+	std::lock_guard<std::mutex> lock(timersMutex);
+	auto wheel = wheels.find(context);
+	return wheel == wheels.end() ? 0 : wheel->second.wakeups;
+}
+
+} // namespace bzp
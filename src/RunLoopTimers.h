@@ -0,0 +1,44 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Deadline-ordered timers for BzPeri's GLib run loops.
+//
+// Every timer BzPeri arms on a GMainContext lives on that context's single timer source. The source's ready time tracks the
+// earliest pending deadline and is cleared when none is left, so an idle server contributes no wakeups at all instead of one
+// per GLib timeout. Callbacks use GLib's GSourceFunc contract: return G_SOURCE_CONTINUE to re-arm after the same interval.
+//
+// Ordinary timers re-arm relative to the moment their callback returns, so callback time and dispatch latency accumulate.
+// Fixed-rate timers instead keep deadlines on a grid of whole intervals of the monotonic clock: late dispatches do not push
+// later ones back, missed periods are skipped rather than replayed, and every fixed-rate timer with the same interval on a
+// context fires in the same wakeup.
+
+#pragma once
+
+#include <glib.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace bzp {
+
+// The calling thread's default context, falling back to the global default. Handlers running on the server thread use this to
+// find the context their own timers and fd watches belong on.
+[[nodiscard]] GMainContext *threadRunLoopContext();
+
+// Arm a timer on `context` (never null). Returns a non-zero timer ID that is unique across contexts.
+guint addRunLoopTimer(GMainContext *context, guint intervalMS, GSourceFunc callback, gpointer userData);
+
+// Second-granularity timer. Deadlines are rounded up to a whole second so coarse timers share wakeups.
+guint addRunLoopTimerSeconds(GMainContext *context, guint intervalSeconds, GSourceFunc callback, gpointer userData);
+
+// Fixed-rate timer: deadlines fall on multiples of `intervalMS` (never 0) on the monotonic clock. See the discussion above.
+guint addRunLoopTimerFixedRate(GMainContext *context, guint intervalMS, GSourceFunc callback, gpointer userData);
+
+// Cancel a timer; safe from inside its own callback. Returns false when the ID is unknown (already fired or removed).
+bool removeRunLoopTimer(guint timerId);
+
+// Introspection for tests and diagnostics
+[[nodiscard]] std::size_t runLoopTimerCount(GMainContext *context);
+[[nodiscard]] gint64 runLoopTimerNextDeadline(GMainContext *context);    // monotonic microseconds, or -1 when idle
+[[nodiscard]] uint64_t runLoopTimerWakeups(GMainContext *context);       // dispatches of the shared timer source
+
+} // namespace bzp
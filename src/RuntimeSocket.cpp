@@ -0,0 +1,82 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// See the discussion at the top of RuntimeSocket.h
+
+#include "RuntimeSocket.h"
+
+#include <glib.h>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+namespace bzp {
+
+std::string runtimeSocketPath(std::string_view stem, int pid)
+{
+	const std::string fileName = std::string(stem) + "-" + std::to_string(pid) + ".sock";
+	try
+	{
+		const gchar *runtimeDir = g_get_user_runtime_dir();
+		std::filesystem::path basePath = (runtimeDir != nullptr && *runtimeDir != '\0')
+			? std::filesystem::path(runtimeDir)
+			: std::filesystem::temp_directory_path();
+		basePath /= "bzperi";
+		basePath /= fileName;
+		return basePath.string();
+	}
+	catch (...)
+	{
+		return "/tmp/bzperi/" + fileName;
+	}
+}
+
+std::string prepareSocketPath(const std::string &path)
+{
+	std::error_code directoryError;
+	const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+	if (!parent.empty() && !std::filesystem::exists(parent, directoryError))
+	{
+		std::filesystem::create_directories(parent, directoryError);
+		std::filesystem::permissions(parent, std::filesystem::perms::owner_all, directoryError);
+	}
+
+	struct stat status{};
+	if (lstat(path.c_str(), &status) != 0)
+	{
+		return {};
+	}
+
+	if (!S_ISSOCK(status.st_mode))
+	{
+		return "'" + path + "' exists and is not a socket";
+	}
+
+	// Refuse to steal a socket another live process is still serving; remove it when nobody answers
+	const int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	std::memcpy(address.sun_path, path.c_str(), std::min(path.size(), sizeof(address.sun_path) - 1));
+	const bool live = probe >= 0 && connect(probe, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0;
+	if (probe >= 0)
+	{
+		close(probe);
+	}
+
+	if (live)
+	{
+		return "another process is already serving '" + path + "'";
+	}
+
+	unlink(path.c_str());
+	return {};
+}
+
+} // namespace bzp
@@ -0,0 +1,20 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Path handling shared by the Unix-socket endpoints (event stream, data plane) that live under the user's runtime directory.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace bzp {
+
+// `<runtime dir>/bzperi/<stem>-<pid>.sock`, falling back to the temp directory when XDG_RUNTIME_DIR is unset
+std::string runtimeSocketPath(std::string_view stem, int pid);
+
+// Create the owner-only parent directory and clear a stale socket at `path`; returns an error rather than
+// replacing a non-socket or a socket another live process is still serving
+std::string prepareSocketPath(const std::string &path);
+
+} // namespace bzp
@@ -235,6 +235,7 @@ Server::Server(const std::string &serviceName, const std::string &advertisingNam
 	}
 
 	this->serviceName = lowerServiceName;
+	notImplementedErrorName = getOwnedName() + ".NotImplemented";
 	this->advertisingName = advertisingName;
 	this->advertisingShortName = advertisingShortName;
 
@@ -356,10 +357,15 @@ void Server::configure(const std::function<void(DBusObject&)>& builder)
 //
 // If the interface was found, it is returned, otherwise nullptr is returned
 std::shared_ptr<const DBusInterface> Server::findInterface(const DBusObjectPath &objectPath, std::string_view interfaceName) const
+{
+	return findInterface(std::string_view(objectPath.toString()), interfaceName);
+}
+
+std::shared_ptr<const DBusInterface> Server::findInterface(std::string_view objectPath, std::string_view interfaceName) const
 {
 	for (const DBusObject &object : objects)
 	{
-		std::shared_ptr<const DBusInterface> pInterface = object.findInterface(objectPath, std::string(interfaceName));
+		std::shared_ptr<const DBusInterface> pInterface = object.findInterface(objectPath, interfaceName);
 		if (pInterface != nullptr)
 		{
 			return pInterface;
@@ -381,9 +387,16 @@ bool Server::callMethod(const DBusObjectPath &objectPath, std::string_view inter
 
 bool Server::callMethod(const DBusObjectPath &objectPath, std::string_view interfaceName, std::string_view methodName, DBusMethodCallRef methodCall) const
 {
+	return callMethod(std::string_view(objectPath.toString()), interfaceName, methodName, methodCall);
+}
+
+bool Server::callMethod(std::string_view objectPath, std::string_view interfaceName, std::string_view methodName, DBusMethodCallRef methodCall) const
+{
+	// Method names are short enough for the small-string buffer, so this copy stays off the heap
+	const std::string method(methodName);
 	for (const DBusObject &object : objects)
 	{
-		if (object.callMethod(objectPath, std::string(interfaceName), std::string(methodName), methodCall))
+		if (object.callMethod(objectPath, interfaceName, method, methodCall))
 		{
 			return true;
 		}
@@ -403,21 +416,26 @@ bool Server::callMethod(const DBusObjectPath &objectPath, std::string_view inter
 //
 // If the property was found, it is returned, otherwise nullptr is returned
 const GattProperty *Server::findProperty(const DBusObjectPath &objectPath, std::string_view interfaceName, std::string_view propertyName) const
+{
+	return findProperty(std::string_view(objectPath.toString()), interfaceName, propertyName);
+}
+
+const GattProperty *Server::findProperty(std::string_view objectPath, std::string_view interfaceName, std::string_view propertyName) const
 {
 	std::shared_ptr<const DBusInterface> pInterface = findInterface(objectPath, interfaceName);
 
 	// Try each of the GattInterface types that support properties?
 	if (std::shared_ptr<const GattInterface> pGattInterface = TRY_GET_CONST_INTERFACE_OF_TYPE(pInterface, GattInterface))
 	{
-		return pGattInterface->findProperty(std::string(propertyName));
+		return pGattInterface->findProperty(propertyName);
 	}
 	else if (std::shared_ptr<const GattService> pGattInterface = TRY_GET_CONST_INTERFACE_OF_TYPE(pInterface, GattService))
 	{
-		return pGattInterface->findProperty(std::string(propertyName));
+		return pGattInterface->findProperty(propertyName);
 	}
 	else if (std::shared_ptr<const GattCharacteristic> pGattInterface = TRY_GET_CONST_INTERFACE_OF_TYPE(pInterface, GattCharacteristic))
 	{
-		return pGattInterface->findProperty(std::string(propertyName));
+		return pGattInterface->findProperty(propertyName);
 	}
 
 	return nullptr;
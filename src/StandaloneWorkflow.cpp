@@ -2,20 +2,63 @@
 
 #include <gio/gio.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <exception>
 #include <filesystem>
+#include <functional>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <utility>
 
 namespace bzp::standalone {
 
 namespace {
 
-constexpr int kSessionFormatVersion = 2;
+constexpr int kSessionFormatVersion = 3;
+
+constexpr uint32_t kEventLogMagic = 0x42455654;    // "BEVT"
+constexpr uint16_t kEventLogVersion = 1;
+
+struct EventLogHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t recordSize;
+	uint32_t capacity;
+	int32_t writerPid;
+	std::atomic<uint64_t> head;    // number of events ever appended; the next event gets this sequence number
+	uint8_t reserved[40];
+};
+
+struct EventLogRecord
+{
+	std::atomic<uint64_t> sequence;    // sequence + 1 once the record is complete, 0 while it is being written
+	int64_t timestampMs;
+	uint8_t level;
+	uint8_t componentLength;
+	uint16_t messageLength;
+	uint32_t reserved;
+	char component[InspectEventRing::kMaxComponentLength];
+	char message[InspectEventRing::kMaxMessageLength];
+};
+
+static_assert(sizeof(EventLogHeader) == 64, "event log header layout is part of the file format");
+static_assert(sizeof(EventLogRecord) == InspectEventRing::kRecordSize, "event log record layout is part of the file format");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "event log counters are shared across processes");
 constexpr std::size_t kDefaultInspectEventDisplayCount = 8;
 constexpr std::size_t kVerboseInspectEventDisplayCount = 16;
 
@@ -40,7 +83,12 @@ void appendSection(std::ostringstream &stream, const std::string &title)
 
 void appendCheckLines(std::ostringstream &stream, const DoctorCheck &check)
 {
-	stream << verdictLabel(check.verdict) << "  " << check.label << '\n';
+	stream << verdictLabel(check.verdict) << "  " << check.label;
+	if (check.elapsedMs >= 0)
+	{
+		stream << "  (" << check.elapsedMs << " ms)";
+	}
+	stream << '\n';
 	stream << "      " << check.detail << '\n';
 }
 
@@ -165,31 +213,231 @@ void setError(std::string *errorOut, std::string message)
 
 } // namespace
 
-DoctorSnapshot collectDoctorSnapshot(const DoctorProbe &probe, const std::string &preferredAdapter, const std::string &ownedName)
+DoctorSnapshot collectDoctorSnapshot(const DoctorProbe &probe, const std::string &preferredAdapter, const std::string &ownedName,
+	int probeDeadlineMs)
 {
+	using Clock = std::chrono::steady_clock;
+
 	DoctorSnapshot snapshot;
-	snapshot.systemBusReachable = probe.checkSystemBus(&snapshot.systemBusDetail);
+	snapshot.probeDeadlineMs = std::max(probeDeadlineMs, 1);
+
+	// Workers write straight into the snapshot fields they own; everything is joined before the merge below reads them
+	const std::vector<std::pair<DoctorProbeTiming *, std::function<void()>>> probes = {
+		{&snapshot.systemBusTiming, [&] {
+			snapshot.systemBusReachable = probe.checkSystemBus(&snapshot.systemBusDetail);
+		}},
+		{&snapshot.bluezServiceTiming, [&] {
+			snapshot.bluezServiceReachable = probe.checkBluezService(&snapshot.bluezServiceDetail);
+		}},
+		{&snapshot.serviceNameTiming, [&] {
+			snapshot.serviceNameAvailable = probe.checkServiceOwnership(ownedName, &snapshot.serviceNameDetail);
+		}},
+		{&snapshot.policyTiming, [&] {
+			snapshot.policyInstalled = probe.checkPolicy(&snapshot.policyPath);
+		}},
+		{&snapshot.experimentalTiming, [&] {
+			snapshot.experimentalHelperAvailable = probe.checkExperimentalHelper(
+				&snapshot.experimentalHelperPath,
+				&snapshot.experimentalModeEnabled,
+				&snapshot.experimentalDetail);
+		}},
+		{&snapshot.adapterTiming, [&] {
+			snapshot.adapterProbeSucceeded = probe.probeAdapter(
+				preferredAdapter,
+				&snapshot.poweredAdapterAvailable,
+				&snapshot.adapterSummary,
+				&snapshot.adapterLines,
+				&snapshot.adapterProbeDetail);
+		}},
+	};
+
+	std::mutex mutex;
+	std::condition_variable finished;
+	std::size_t remaining = probes.size();
+	const auto started = Clock::now();
+
+	std::vector<std::thread> workers;
+	workers.reserve(probes.size());
+	for (const auto &entry : probes)
+	{
+		workers.emplace_back([&, timing = entry.first, body = &entry.second] {
+			try
+			{
+				(*body)();
+			}
+			catch (const std::exception &)
+			{
+				// A throwing probe simply reports its check as failed
+			}
+
+			const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - started).count();
+			std::lock_guard<std::mutex> lock(mutex);
+			timing->ran = true;
+			timing->elapsedMs = elapsed;
+			--remaining;
+			finished.notify_all();
+		});
+	}
+
+	bool anyTimedOut = false;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (!finished.wait_until(lock, started + std::chrono::milliseconds(snapshot.probeDeadlineMs), [&] { return remaining == 0; }))
+		{
+			for (const auto &entry : probes)
+			{
+				if (!entry.first->ran)
+				{
+					entry.first->timedOut = true;
+					anyTimedOut = true;
+				}
+			}
+		}
+	}
+
+	if (anyTimedOut)
+	{
+		probe.cancel();
+	}
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+	snapshot.totalElapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - started).count();
+
+	for (const auto &entry : probes)
+	{
+		if (entry.first->timedOut)
+		{
+			entry.first->elapsedMs = snapshot.probeDeadlineMs;
+		}
+	}
+
+	if (snapshot.systemBusTiming.timedOut)
+	{
+		snapshot.systemBusReachable = false;
+	}
+	if (snapshot.bluezServiceTiming.timedOut)
+	{
+		snapshot.bluezServiceReachable = false;
+	}
+	if (snapshot.serviceNameTiming.timedOut)
+	{
+		snapshot.serviceNameAvailable = false;
+	}
+	if (snapshot.policyTiming.timedOut)
+	{
+		snapshot.policyInstalled = false;
+	}
+	if (snapshot.experimentalTiming.timedOut)
+	{
+		snapshot.experimentalHelperAvailable = false;
+		snapshot.experimentalModeEnabled = false;
+	}
+	if (snapshot.adapterTiming.timedOut)
+	{
+		snapshot.adapterProbeSucceeded = false;
+		snapshot.poweredAdapterAvailable = false;
+		snapshot.adapterSummary.clear();
+		snapshot.adapterLines.clear();
+	}
+
+	// Without a system bus the bus-backed checks only repeat that failure, so report them as not run
 	if (!snapshot.systemBusReachable)
 	{
-		return snapshot;
-	}
-
-	snapshot.bluezServiceReachable = probe.checkBluezService(&snapshot.bluezServiceDetail);
-	snapshot.serviceNameAvailable = probe.checkServiceOwnership(ownedName, &snapshot.serviceNameDetail);
-	snapshot.policyInstalled = probe.checkPolicy(&snapshot.policyPath);
-	snapshot.experimentalHelperAvailable = probe.checkExperimentalHelper(
-		&snapshot.experimentalHelperPath,
-		&snapshot.experimentalModeEnabled,
-		&snapshot.experimentalDetail);
-	snapshot.adapterProbeSucceeded = probe.probeAdapter(
-		preferredAdapter,
-		&snapshot.poweredAdapterAvailable,
-		&snapshot.adapterSummary,
-		&snapshot.adapterLines,
-		&snapshot.adapterProbeDetail);
+		snapshot.bluezServiceReachable = false;
+		snapshot.bluezServiceDetail.clear();
+		snapshot.bluezServiceTiming = {};
+		snapshot.serviceNameAvailable = false;
+		snapshot.serviceNameDetail.clear();
+		snapshot.serviceNameTiming = {};
+		snapshot.adapterProbeSucceeded = false;
+		snapshot.poweredAdapterAvailable = false;
+		snapshot.adapterSummary.clear();
+		snapshot.adapterLines.clear();
+		snapshot.adapterProbeDetail.clear();
+		snapshot.adapterTiming = {};
+	}
+
 	return snapshot;
 }
 
+bool summarizeDoctorAdapters(std::vector<DoctorAdapter> adapters, const std::string &preferredAdapter,
+	bool *poweredAdapterAvailableOut,
+	std::string *summaryOut,
+	std::vector<std::string> *adapterLinesOut,
+	std::string *detailOut)
+{
+	if (poweredAdapterAvailableOut != nullptr)
+	{
+		*poweredAdapterAvailableOut = false;
+	}
+	if (adapters.empty())
+	{
+		setError(detailOut, "No BlueZ adapters available");
+		return false;
+	}
+	std::sort(adapters.begin(), adapters.end(), [](const DoctorAdapter &left, const DoctorAdapter &right) {
+		return left.path < right.path;
+	});
+
+	if (!preferredAdapter.empty())
+	{
+		const auto selected = std::find_if(adapters.begin(), adapters.end(), [&](const DoctorAdapter &adapter) {
+			return adapter.path == "/org/bluez/" + preferredAdapter || adapter.path == preferredAdapter
+				|| (!adapter.address.empty() && adapter.address == preferredAdapter);
+		});
+		if (selected == adapters.end())
+		{
+			std::string available;
+			for (const DoctorAdapter &adapter : adapters)
+			{
+				available += (available.empty() ? "" : ", ") + adapter.path;
+			}
+			setError(detailOut, "Adapter " + preferredAdapter + " not found (available: " + available + ")");
+			return false;
+		}
+		adapters = {*selected};
+	}
+
+	std::ostringstream summary;
+	bool first = true;
+	bool poweredAdapterAvailable = false;
+	for (const DoctorAdapter &adapter : adapters)
+	{
+		if (adapterLinesOut != nullptr)
+		{
+			adapterLinesOut->push_back(adapter.path + " [" + adapter.address + "] powered=" + (adapter.powered ? "yes" : "no"));
+		}
+		if (!first)
+		{
+			summary << "; ";
+		}
+		first = false;
+		summary << adapter.path << " powered=" << (adapter.powered ? "yes" : "no");
+		poweredAdapterAvailable = poweredAdapterAvailable || adapter.powered;
+	}
+
+	if (summaryOut != nullptr)
+	{
+		*summaryOut = summary.str();
+	}
+	if (poweredAdapterAvailableOut != nullptr)
+	{
+		*poweredAdapterAvailableOut = poweredAdapterAvailable;
+	}
+	if (!poweredAdapterAvailable)
+	{
+		setError(detailOut, (preferredAdapter.empty() ? "Adapters found but none are powered: " : "Adapter is not powered: ")
+			+ summary.str());
+	}
+	else
+	{
+		setError(detailOut, summary.str());
+	}
+	return true;
+}
+
 DoctorReport evaluateDoctorSnapshot(const DoctorSnapshot &snapshot, const std::string &binaryName)
 {
 	DoctorReport report;
@@ -221,6 +469,28 @@ DoctorReport evaluateDoctorSnapshot(const DoctorSnapshot &snapshot, const std::s
 				: (snapshot.experimentalDetail.empty() ? "BlueZ experimental helper not found; use manual bluetoothd --experimental guidance if needed." : snapshot.experimentalDetail)},
 	};
 
+	const DoctorProbeTiming *timings[] = {
+		&snapshot.systemBusTiming,
+		&snapshot.bluezServiceTiming,
+		&snapshot.serviceNameTiming,
+		&snapshot.adapterTiming,
+		&snapshot.policyTiming,
+		&snapshot.experimentalTiming,
+	};
+	bool anyTimedOut = false;
+	for (std::size_t i = 0; i < report.checks.size(); ++i)
+	{
+		auto &check = report.checks[i];
+		check.elapsedMs = timings[i]->ran || timings[i]->timedOut ? timings[i]->elapsedMs : -1;
+		if (timings[i]->timedOut)
+		{
+			anyTimedOut = true;
+			check.verdict = timings[i] == &snapshot.experimentalTiming ? Verdict::Warn : Verdict::Fail;
+			check.detail = "No answer within " + std::to_string(snapshot.probeDeadlineMs) + " ms; the probe was cancelled.";
+		}
+	}
+	report.totalElapsedMs = snapshot.totalElapsedMs;
+
 	const bool hasFail = std::any_of(report.checks.begin(), report.checks.end(), [](const DoctorCheck &check) {
 		return check.verdict == Verdict::Fail;
 	});
@@ -277,6 +547,11 @@ DoctorReport evaluateDoctorSnapshot(const DoctorSnapshot &snapshot, const std::s
 		}
 	}
 
+	if (anyTimedOut)
+	{
+		addNextCommand("sudo " + binaryName + " doctor --probe-timeout-ms=" + std::to_string(std::max(snapshot.probeDeadlineMs * 4, 5000)));
+	}
+
 	if (report.overall != Verdict::Fail)
 	{
 		addNextCommand(binaryName + " demo");
@@ -296,6 +571,10 @@ std::string formatDoctorReport(const DoctorReport &report, const std::string &bi
 	stream << "BzPeri Doctor\n";
 	stream << "STATUS  " << verdictLabel(report.overall) << '\n';
 	stream << "Checks the local host for the " << binaryName << " happy path.\n";
+	if (report.totalElapsedMs >= 0)
+	{
+		stream << "Probes ran in parallel and finished in " << report.totalElapsedMs << " ms.\n";
+	}
 
 	appendSection(stream, "CHECKS");
 	for (const auto &check : report.checks)
@@ -331,12 +610,288 @@ std::string verdictLabel(Verdict verdict)
 	}
 }
 
+namespace {
+
+EventLogHeader *eventLogHeader(void *mapping) noexcept
+{
+	return static_cast<EventLogHeader *>(mapping);
+}
+
+EventLogRecord *eventLogRecords(void *mapping) noexcept
+{
+	return reinterpret_cast<EventLogRecord *>(static_cast<char *>(mapping) + sizeof(EventLogHeader));
+}
+
+std::size_t eventLogFileSize(std::size_t capacity) noexcept
+{
+	return sizeof(EventLogHeader) + capacity * sizeof(EventLogRecord);
+}
+
+bool isUsableEventLogHeader(const EventLogHeader &header, std::size_t fileSize) noexcept
+{
+	return header.magic == kEventLogMagic
+		&& header.version == kEventLogVersion
+		&& header.recordSize == sizeof(EventLogRecord)
+		&& header.capacity > 0
+		&& eventLogFileSize(header.capacity) <= fileSize;
+}
+
+} // namespace
+
+InspectEventRing::~InspectEventRing()
+{
+	close();
+}
+
+bool InspectEventRing::openForWriting(const std::string &path, std::size_t capacity, std::string *errorOut)
+{
+	close();
+	capacity = std::max<std::size_t>(capacity, 1);
+
+	try
+	{
+		const std::filesystem::path filePath(path);
+		if (filePath.has_parent_path())
+		{
+			std::filesystem::create_directories(filePath.parent_path());
+		}
+	}
+	catch (const std::exception &error)
+	{
+		setError(errorOut, error.what());
+		return false;
+	}
+
+	// Replace rather than truncate: readers still mapping an older log must not fault on a shrinking file
+	::unlink(path.c_str());
+	fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+	if (fd_ < 0)
+	{
+		setError(errorOut, "Failed to create inspect event log " + path + ": " + std::strerror(errno));
+		return false;
+	}
+
+	mappingSize_ = eventLogFileSize(capacity);
+	if (ftruncate(fd_, static_cast<off_t>(mappingSize_)) != 0)
+	{
+		setError(errorOut, "Failed to size inspect event log " + path + ": " + std::strerror(errno));
+		close();
+		return false;
+	}
+
+	void *mapping = mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+	if (mapping == MAP_FAILED)
+	{
+		setError(errorOut, "Failed to map inspect event log " + path + ": " + std::strerror(errno));
+		close();
+		return false;
+	}
+	mapping_ = mapping;
+	writable_ = true;
+
+	// A fresh file is zero-filled, so every record already reads as empty
+	EventLogHeader *header = eventLogHeader(mapping_);
+	header->recordSize = static_cast<uint16_t>(sizeof(EventLogRecord));
+	header->version = kEventLogVersion;
+	header->capacity = static_cast<uint32_t>(capacity);
+	header->writerPid = static_cast<int32_t>(getpid());
+	header->head.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	header->magic = kEventLogMagic;
+	return true;
+}
+
+bool InspectEventRing::openForReading(const std::string &path, std::string *errorOut)
+{
+	close();
+
+	fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd_ < 0)
+	{
+		if (errno != ENOENT)
+		{
+			setError(errorOut, "Failed to open inspect event log " + path + ": " + std::strerror(errno));
+		}
+		return false;
+	}
+
+	struct stat fileStat = {};
+	if (fstat(fd_, &fileStat) != 0 || static_cast<std::size_t>(fileStat.st_size) < sizeof(EventLogHeader))
+	{
+		close();
+		return false;
+	}
+
+	mappingSize_ = static_cast<std::size_t>(fileStat.st_size);
+	void *mapping = mmap(nullptr, mappingSize_, PROT_READ, MAP_SHARED, fd_, 0);
+	if (mapping == MAP_FAILED)
+	{
+		setError(errorOut, "Failed to map inspect event log " + path + ": " + std::strerror(errno));
+		close();
+		return false;
+	}
+	mapping_ = mapping;
+
+	const EventLogHeader &header = *eventLogHeader(mapping_);
+	if (header.magic == 0)
+	{
+		close();    // the writer has not finished initializing it yet
+		return false;
+	}
+	if (!isUsableEventLogHeader(header, mappingSize_))
+	{
+		setError(errorOut, "Inspect event log " + path + " has an unknown layout");
+		close();
+		return false;
+	}
+	return true;
+}
+
+void InspectEventRing::close() noexcept
+{
+	if (mapping_ != nullptr)
+	{
+		munmap(mapping_, mappingSize_);
+		mapping_ = nullptr;
+	}
+	if (fd_ >= 0)
+	{
+		::close(fd_);
+		fd_ = -1;
+	}
+	mappingSize_ = 0;
+	writable_ = false;
+}
+
+std::size_t InspectEventRing::capacity() const noexcept
+{
+	return mapping_ != nullptr ? eventLogHeader(mapping_)->capacity : 0;
+}
+
+uint64_t InspectEventRing::head() const noexcept
+{
+	return mapping_ != nullptr ? eventLogHeader(mapping_)->head.load(std::memory_order_acquire) : 0;
+}
+
+void InspectEventRing::reset(uint64_t head) noexcept
+{
+	if (!writable_)
+	{
+		return;
+	}
+
+	EventLogRecord *records = eventLogRecords(mapping_);
+	for (std::size_t index = 0; index < capacity(); ++index)
+	{
+		records[index].sequence.store(0, std::memory_order_relaxed);
+	}
+	eventLogHeader(mapping_)->head.store(head, std::memory_order_release);
+}
+
+void InspectEventRing::append(const InspectEvent &event) noexcept
+{
+	if (!writable_)
+	{
+		return;
+	}
+
+	EventLogHeader *header = eventLogHeader(mapping_);
+	const uint64_t sequence = header->head.load(std::memory_order_relaxed);
+	EventLogRecord &record = eventLogRecords(mapping_)[sequence % header->capacity];
+
+	// Readers that see 0, or a sequence other than the one they asked for, treat the slot as overwritten
+	record.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	record.timestampMs = event.timestampMs;
+	record.level = static_cast<uint8_t>(event.level);
+	record.componentLength = static_cast<uint8_t>(std::min(event.component.size(), kMaxComponentLength));
+	record.messageLength = static_cast<uint16_t>(std::min(event.message.size(), kMaxMessageLength));
+	std::memcpy(record.component, event.component.data(), record.componentLength);
+	std::memcpy(record.message, event.message.data(), record.messageLength);
+
+	record.sequence.store(sequence + 1, std::memory_order_release);
+	header->head.store(sequence + 1, std::memory_order_release);
+}
+
+std::vector<InspectEvent> InspectEventRing::readSince(uint64_t *cursor, std::size_t *droppedOut) const
+{
+	std::vector<InspectEvent> events;
+	std::size_t dropped = 0;
+	if (mapping_ == nullptr || cursor == nullptr)
+	{
+		if (droppedOut != nullptr)
+		{
+			*droppedOut = 0;
+		}
+		return events;
+	}
+
+	const EventLogHeader *header = eventLogHeader(mapping_);
+	const uint64_t head = header->head.load(std::memory_order_acquire);
+	const uint64_t tail = head > header->capacity ? head - header->capacity : 0;
+	if (*cursor > head)
+	{
+		*cursor = tail;    // the log was reset underneath the reader
+	}
+	if (*cursor < tail)
+	{
+		dropped += static_cast<std::size_t>(tail - *cursor);
+		*cursor = tail;
+	}
+
+	const EventLogRecord *records = eventLogRecords(mapping_);
+	events.reserve(static_cast<std::size_t>(head - *cursor));
+	for (uint64_t sequence = *cursor; sequence < head; ++sequence)
+	{
+		const EventLogRecord &record = records[sequence % header->capacity];
+		if (record.sequence.load(std::memory_order_acquire) != sequence + 1)
+		{
+			++dropped;
+			continue;
+		}
+
+		char component[kMaxComponentLength];
+		char message[kMaxMessageLength];
+		const int64_t timestampMs = record.timestampMs;
+		const uint8_t level = record.level;
+		const std::size_t componentLength = std::min<std::size_t>(record.componentLength, kMaxComponentLength);
+		const std::size_t messageLength = std::min<std::size_t>(record.messageLength, kMaxMessageLength);
+		std::memcpy(component, record.component, componentLength);
+		std::memcpy(message, record.message, messageLength);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (record.sequence.load(std::memory_order_relaxed) != sequence + 1)
+		{
+			++dropped;    // the writer lapped us while we were copying
+			continue;
+		}
+
+		events.push_back({
+			timestampMs,
+			level <= static_cast<uint8_t>(EventLevel::Fatal) ? static_cast<EventLevel>(level) : EventLevel::Info,
+			std::string(component, componentLength),
+			std::string(message, messageLength),
+		});
+	}
+
+	*cursor = head;
+	if (droppedOut != nullptr)
+	{
+		*droppedOut = dropped;
+	}
+	return events;
+}
+
 InspectSessionStore::InspectSessionStore(std::string path, std::size_t eventLimit)
 	: path_(std::move(path)),
+	  eventLogPath_(eventLogPathForSession(path_)),
 	  eventLimit_(eventLimit)
 {
 }
 
+InspectSessionStore::~InspectSessionStore() = default;
+
 std::string InspectSessionStore::defaultSessionPath()
 {
 	try
@@ -355,6 +910,74 @@ std::string InspectSessionStore::defaultSessionPath()
 	}
 }
 
+std::string InspectSessionStore::eventLogPathForSession(const std::string &sessionPath)
+{
+	std::filesystem::path eventLogPath(sessionPath);
+	eventLogPath.replace_extension(".events");
+	return eventLogPath.string();
+}
+
+bool InspectSessionStore::ensureEventLogWritable(std::string *errorOut) const
+{
+	if (eventLog_ && eventLog_->isWritable())
+	{
+		return true;
+	}
+
+	auto eventLog = std::make_unique<InspectEventRing>();
+	if (!eventLog->openForWriting(eventLogPath_, eventLimit_, errorOut))
+	{
+		return false;
+	}
+	eventLog_ = std::move(eventLog);
+	return true;
+}
+
+bool InspectSessionStore::ensureEventLogReadable() const
+{
+	if (eventLog_ && eventLog_->isOpen())
+	{
+		return true;
+	}
+
+	auto eventLog = std::make_unique<InspectEventRing>();
+	if (!eventLog->openForReading(eventLogPath_))
+	{
+		return false;
+	}
+	eventLog_ = std::move(eventLog);
+	return true;
+}
+
+bool InspectSessionStore::appendEvent(const InspectEvent &event, std::string *errorOut) const
+{
+	if (!ensureEventLogWritable(errorOut))
+	{
+		return false;
+	}
+
+	eventLog_->append(event);
+	return true;
+}
+
+std::vector<InspectEvent> InspectSessionStore::readEventsSince(uint64_t *cursor, std::size_t *droppedOut) const
+{
+	if (!ensureEventLogReadable())
+	{
+		if (droppedOut != nullptr)
+		{
+			*droppedOut = 0;
+		}
+		return {};
+	}
+	return eventLog_->readSince(cursor, droppedOut);
+}
+
+uint64_t InspectSessionStore::eventHead() const
+{
+	return ensureEventLogReadable() ? eventLog_->head() : 0;
+}
+
 bool InspectSessionStore::save(const InspectSessionSnapshot &snapshot, std::string *errorOut) const
 {
 	try
@@ -400,14 +1023,19 @@ bool InspectSessionStore::save(const InspectSessionSnapshot &snapshot, std::stri
 	appendStringList(keyFile, "session", "selected_object_lines", snapshot.selectedObjectLines);
 	appendStringList(keyFile, "session", "warnings", snapshot.warnings);
 
-	g_key_file_set_integer(keyFile, "events", "count", static_cast<int>(snapshot.events.size()));
-	for (std::size_t index = 0; index < snapshot.events.size(); ++index)
+	// Events live in the append-only log; only rewrite it when it does not already hold this history
+	if (!ensureEventLogWritable(errorOut))
+	{
+		g_key_file_unref(keyFile);
+		return false;
+	}
+	if (eventLog_->head() != snapshot.droppedEventCount + snapshot.events.size())
 	{
-		const auto group = "event_" + std::to_string(index);
-		g_key_file_set_int64(keyFile, group.c_str(), "timestamp_ms", snapshot.events[index].timestampMs);
-		g_key_file_set_string(keyFile, group.c_str(), "level", eventLevelLabel(snapshot.events[index].level).c_str());
-		g_key_file_set_string(keyFile, group.c_str(), "component", snapshot.events[index].component.c_str());
-		g_key_file_set_string(keyFile, group.c_str(), "message", snapshot.events[index].message.c_str());
+		eventLog_->reset(snapshot.droppedEventCount);
+		for (const auto &event : snapshot.events)
+		{
+			eventLog_->append(event);
+		}
 	}
 
 	gsize dataSize = 0;
@@ -491,43 +1119,59 @@ std::optional<InspectSessionSnapshot> InspectSessionStore::load(std::string *err
 	snapshot.selectedObjectLines = loadStringList(keyFile, "session", "selected_object_lines");
 	snapshot.warnings = loadStringList(keyFile, "session", "warnings");
 
-	const int eventCount = loadIntegerValue(keyFile, "events", "count", 0);
-	for (int index = 0; index < eventCount; ++index)
+	// Inspect processes re-map on every full load so a log recreated by a new session is picked up
+	if (!eventLog_ || !eventLog_->isWritable())
 	{
-		const auto group = "event_" + std::to_string(index);
-		const auto levelText = loadStringValue(keyFile, group.c_str(), "level");
-		EventLevel level = EventLevel::Info;
-		if (levelText == "TRACE")
-		{
-			level = EventLevel::Trace;
-		}
-		else if (levelText == "DEBUG")
-		{
-			level = EventLevel::Debug;
-		}
-		else if (levelText == "STATUS")
-		{
-			level = EventLevel::Status;
-		}
-		else if (levelText == "WARN")
-		{
-			level = EventLevel::Warn;
-		}
-		else if (levelText == "ERROR")
-		{
-			level = EventLevel::Error;
-		}
-		else if (levelText == "FATAL")
+		eventLog_.reset();
+	}
+	if (ensureEventLogReadable())
+	{
+		const uint64_t head = eventLog_->head();
+		uint64_t cursor = head - std::min<uint64_t>(head, eventLimit_);
+		snapshot.events = eventLog_->readSince(&cursor);
+		snapshot.droppedEventCount = static_cast<std::size_t>(head - snapshot.events.size());
+	}
+	else
+	{
+		// Format 2 sessions kept their events inline
+		const int eventCount = loadIntegerValue(keyFile, "events", "count", 0);
+		for (int index = 0; index < eventCount; ++index)
 		{
-			level = EventLevel::Fatal;
-		}
+			const auto group = "event_" + std::to_string(index);
+			const auto levelText = loadStringValue(keyFile, group.c_str(), "level");
+			EventLevel level = EventLevel::Info;
+			if (levelText == "TRACE")
+			{
+				level = EventLevel::Trace;
+			}
+			else if (levelText == "DEBUG")
+			{
+				level = EventLevel::Debug;
+			}
+			else if (levelText == "STATUS")
+			{
+				level = EventLevel::Status;
+			}
+			else if (levelText == "WARN")
+			{
+				level = EventLevel::Warn;
+			}
+			else if (levelText == "ERROR")
+			{
+				level = EventLevel::Error;
+			}
+			else if (levelText == "FATAL")
+			{
+				level = EventLevel::Fatal;
+			}
 
-		snapshot.events.push_back({
-			loadInt64Value(keyFile, group.c_str(), "timestamp_ms", 0),
-			level,
-			loadStringValue(keyFile, group.c_str(), "component"),
-			loadStringValue(keyFile, group.c_str(), "message"),
-		});
+			snapshot.events.push_back({
+				loadInt64Value(keyFile, group.c_str(), "timestamp_ms", 0),
+				level,
+				loadStringValue(keyFile, group.c_str(), "component"),
+				loadStringValue(keyFile, group.c_str(), "message"),
+			});
+		}
 	}
 
 	g_key_file_unref(keyFile);
@@ -536,6 +1180,8 @@ std::optional<InspectSessionSnapshot> InspectSessionStore::load(std::string *err
 
 bool InspectSessionStore::clear(std::string *errorOut) const
 {
+	eventLog_.reset();
+
 	std::error_code errorCode;
 	const bool removed = std::filesystem::remove(path_, errorCode);
 	if (!removed && errorCode)
@@ -543,6 +1189,13 @@ bool InspectSessionStore::clear(std::string *errorOut) const
 		setError(errorOut, errorCode.message());
 		return false;
 	}
+
+	const bool removedEventLog = std::filesystem::remove(eventLogPath_, errorCode);
+	if (!removedEventLog && errorCode)
+	{
+		setError(errorOut, errorCode.message());
+		return false;
+	}
 	return true;
 }
 
@@ -791,4 +1444,166 @@ std::string formatStaleSessionReport(const InspectSessionSnapshot &snapshot, con
 	return stream.str();
 }
 
+BenchLatencySummary summarizeBenchLatencies(std::vector<uint32_t> latenciesUs)
+{
+	BenchLatencySummary summary;
+	summary.samples = latenciesUs.size();
+	if (latenciesUs.empty())
+	{
+		return summary;
+	}
+
+	std::sort(latenciesUs.begin(), latenciesUs.end());
+	const auto rank = [&latenciesUs](unsigned percentile) {
+		const std::size_t index = (latenciesUs.size() * percentile + 99) / 100;
+		return latenciesUs[std::max<std::size_t>(index, 1) - 1];
+	};
+	summary.p50Us = rank(50);
+	summary.p90Us = rank(90);
+	summary.p99Us = rank(99);
+	summary.maxUs = latenciesUs.back();
+	return summary;
+}
+
+std::optional<ProcessCpuTime> parseProcessCpuTime(const std::string &procStat)
+{
+	// The command name is parenthesized and may itself contain spaces or ')', so fields are counted from the last ')'
+	const auto commandEnd = procStat.rfind(')');
+	if (commandEnd == std::string::npos)
+	{
+		return std::nullopt;
+	}
+
+	std::istringstream fields(procStat.substr(commandEnd + 1));
+	std::string field;
+	ProcessCpuTime cpu;
+	for (int index = 3; fields >> field; ++index)
+	{
+		if (index == 14 || index == 15)
+		{
+			char *end = nullptr;
+			const unsigned long long ticks = std::strtoull(field.c_str(), &end, 10);
+			if (end == field.c_str() || *end != '\0')
+			{
+				return std::nullopt;
+			}
+			(index == 14 ? cpu.userTicks : cpu.systemTicks) = ticks;
+			if (index == 15)
+			{
+				return cpu;
+			}
+		}
+	}
+	return std::nullopt;
+}
+
+Verdict evaluateBenchReport(const BenchReport &report) noexcept
+{
+	uint64_t issued = 0;
+	uint64_t succeeded = 0;
+	bool degraded = !report.warnings.empty() || report.eventStreamDropped != 0;
+	for (const auto &operation : report.operations)
+	{
+		issued += operation.issued;
+		succeeded += operation.succeeded;
+		degraded = degraded || operation.failed != 0 || operation.throttled != 0;
+	}
+
+	if ((issued != 0 && succeeded == 0) || (issued == 0 && report.notificationsReceived == 0))
+	{
+		return Verdict::Fail;
+	}
+	return degraded ? Verdict::Warn : Verdict::Pass;
+}
+
+std::string formatBenchReport(const BenchReport &report, const std::string &binaryName)
+{
+	const double seconds = std::max(report.durationMs, 1LL) / 1000.0;
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(1);
+	stream << "BzPeri Bench\n";
+	stream << "STATUS  " << verdictLabel(evaluateBenchReport(report)) << '\n';
+	stream << "Drove " << report.ownedName << " on the " << report.busDescription << " for " << seconds << "s.\n";
+
+	appendSection(stream, "THROUGHPUT");
+	for (const auto &operation : report.operations)
+	{
+		stream << std::left << std::setw(12) << operation.name << std::right
+			<< "target " << operation.targetRate << "/s  achieved " << operation.succeeded / seconds << "/s  ok "
+			<< operation.succeeded << "  failed " << operation.failed << "  throttled " << operation.throttled << '\n';
+	}
+	if (report.subscriptions != 0)
+	{
+		stream << std::left << std::setw(12) << "Notify" << std::right << "received " << report.notificationsReceived
+			<< " (" << report.notificationsReceived / seconds << "/s) on " << report.subscriptions << " subscription"
+			<< (report.subscriptions == 1 ? "" : "s") << '\n';
+	}
+
+	appendSection(stream, "LATENCY");
+	for (const auto &operation : report.operations)
+	{
+		const auto latency = summarizeBenchLatencies(operation.latenciesUs);
+		stream << std::left << std::setw(12) << operation.name << std::right;
+		if (latency.samples == 0)
+		{
+			stream << "no completed calls\n";
+			continue;
+		}
+		stream << "p50 " << latency.p50Us << "us  p90 " << latency.p90Us << "us  p99 " << latency.p99Us << "us  max "
+			<< latency.maxUs << "us\n";
+	}
+
+	appendSection(stream, "SERVER");
+	stream << "pid: " << (report.serverPid > 0 ? std::to_string(report.serverPid) : std::string("unknown")) << '\n';
+	if (report.serverCpu)
+	{
+		const long ticksPerSecond = std::max(report.clockTicksPerSecond, 1L);
+		const double userMs = report.serverCpu->userTicks * 1000.0 / ticksPerSecond;
+		const double systemMs = report.serverCpu->systemTicks * 1000.0 / ticksPerSecond;
+		stream << "cpu: user " << userMs << "ms  system " << systemMs << "ms  (" << (userMs + systemMs) / (seconds * 10.0)
+			<< "% of one core)\n";
+	}
+	else
+	{
+		stream << "cpu: unavailable\n";
+	}
+	if (report.eventStreamAttached)
+	{
+		stream << "update queue: peak depth " << report.peakUpdateQueueDepth << ", processed " << report.updatesProcessed << '\n';
+		stream << "event stream drops: " << report.eventStreamDropped << '\n';
+	}
+	else
+	{
+		stream << "update queue: unavailable (the server has no event stream; see bzpStartEventStream())\n";
+	}
+
+	std::vector<std::string> warnings = report.warnings;
+	for (const auto &operation : report.operations)
+	{
+		if (!operation.firstError.empty())
+		{
+			warnings.push_back(operation.name + " failed: " + operation.firstError);
+		}
+	}
+	if (!warnings.empty())
+	{
+		appendSection(stream, "WARNINGS");
+		for (const auto &warning : warnings)
+		{
+			stream << "WARN  " << warning << '\n';
+		}
+	}
+
+	appendSection(stream, "NEXT");
+	if (report.serverPid > 0)
+	{
+		stream << "run: " << binaryName << " inspect --live --pid " << report.serverPid << '\n';
+	}
+	else
+	{
+		stream << "run: " << binaryName << " doctor\n";
+	}
+	return stream.str();
+}
+
 } // namespace bzp::standalone
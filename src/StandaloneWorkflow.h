@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -19,8 +21,18 @@ struct DoctorCheck
 	std::string label;
 	Verdict verdict = Verdict::Fail;
 	std::string detail;
+	long long elapsedMs = -1;    // how long the backing probe took; -1 when it did not run
 };
 
+struct DoctorProbeTiming
+{
+	bool ran = false;
+	bool timedOut = false;
+	long long elapsedMs = 0;
+};
+
+constexpr int kDefaultDoctorProbeDeadlineMs = 800;
+
 struct DoctorSnapshot
 {
 	bool systemBusReachable = false;
@@ -40,6 +52,16 @@ struct DoctorSnapshot
 	bool experimentalModeEnabled = false;
 	std::string experimentalHelperPath;
 	std::string experimentalDetail;
+
+	// Probes run concurrently; a probe that misses its deadline is cancelled and reported as timed out
+	int probeDeadlineMs = kDefaultDoctorProbeDeadlineMs;
+	DoctorProbeTiming systemBusTiming;
+	DoctorProbeTiming bluezServiceTiming;
+	DoctorProbeTiming serviceNameTiming;
+	DoctorProbeTiming adapterTiming;
+	DoctorProbeTiming policyTiming;
+	DoctorProbeTiming experimentalTiming;
+	long long totalElapsedMs = -1;
 };
 
 struct DoctorReport
@@ -48,8 +70,18 @@ struct DoctorReport
 	std::vector<DoctorCheck> checks;
 	std::vector<std::string> adapterLines;
 	std::vector<std::string> nextCommands;
+	long long totalElapsedMs = -1;
 };
 
+// One org.bluez.Adapter1 object as reported by BlueZ
+struct DoctorAdapter
+{
+	std::string path;
+	std::string address;
+	bool powered = false;
+};
+
+// Probe methods are called concurrently from worker threads, one thread per check.
 class DoctorProbe
 {
 public:
@@ -65,9 +97,24 @@ public:
 		std::string *detailOut) const = 0;
 	virtual bool checkPolicy(std::string *pathOut) const = 0;
 	virtual bool checkExperimentalHelper(std::string *pathOut, bool *modeEnabledOut, std::string *detailOut) const = 0;
+
+	// Called from the collecting thread once a deadline passes; probes still running should return promptly afterwards
+	virtual void cancel() const {}
 };
 
-DoctorSnapshot collectDoctorSnapshot(const DoctorProbe &probe, const std::string &preferredAdapter, const std::string &ownedName = "com.bzperi");
+// Runs every probe at once and merges the results in check order. Probes still running after `probeDeadlineMs` are
+// cancelled and marked timed out; the call returns once all of them have returned.
+DoctorSnapshot collectDoctorSnapshot(const DoctorProbe &probe, const std::string &preferredAdapter, const std::string &ownedName = "com.bzperi",
+	int probeDeadlineMs = kDefaultDoctorProbeDeadlineMs);
+
+// Fills the adapter probe results from BlueZ's adapters. A non-empty `preferredAdapter` ("hci1", "/org/bluez/hci1" or the
+// adapter's address) restricts the probe to that adapter: it fails when the adapter is missing, and reports no powered adapter
+// when that one is off, whatever the other adapters do.
+bool summarizeDoctorAdapters(std::vector<DoctorAdapter> adapters, const std::string &preferredAdapter,
+	bool *poweredAdapterAvailableOut,
+	std::string *summaryOut,
+	std::vector<std::string> *adapterLinesOut,
+	std::string *detailOut);
 DoctorReport evaluateDoctorSnapshot(const DoctorSnapshot &snapshot, const std::string &binaryName);
 int exitCodeForDoctorReport(const DoctorReport &report) noexcept;
 std::string formatDoctorReport(const DoctorReport &report, const std::string &binaryName);
@@ -94,7 +141,7 @@ struct InspectEvent
 
 struct InspectSessionSnapshot
 {
-	int formatVersion = 2;
+	int formatVersion = 3;
 	int pid = 0;
 	long long updatedAtMs = 0;
 	std::string serviceName;
@@ -123,23 +170,82 @@ struct InspectSessionSnapshot
 	std::vector<InspectEvent> events;
 };
 
+// Append-only event log backing an inspect session: a memory-mapped file holding a small header with the running event
+// count (the head) and a ring of fixed-size records. The demo process is the only writer; any number of inspect processes
+// map the same file read-only and tail it by sequence number. Records carry their own sequence so a reader that races the
+// writer wrapping around detects the overwrite instead of returning a torn event.
+class InspectEventRing
+{
+public:
+	static constexpr std::size_t kRecordSize = 256;
+	static constexpr std::size_t kMaxComponentLength = 40;
+	static constexpr std::size_t kMaxMessageLength = 192;
+
+	InspectEventRing() = default;
+	~InspectEventRing();
+	InspectEventRing(const InspectEventRing &) = delete;
+	InspectEventRing &operator=(const InspectEventRing &) = delete;
+
+	// Always starts an empty log, replacing any file already at `path`
+	bool openForWriting(const std::string &path, std::size_t capacity, std::string *errorOut = nullptr);
+	// Returns false without an error when the file does not exist
+	bool openForReading(const std::string &path, std::string *errorOut = nullptr);
+	void close() noexcept;
+
+	bool isOpen() const noexcept { return mapping_ != nullptr; }
+	bool isWritable() const noexcept { return writable_; }
+	std::size_t capacity() const noexcept;
+	uint64_t head() const noexcept;
+
+	// Writer only. reset() drops every record and continues numbering from `head`; append() never allocates or blocks.
+	void reset(uint64_t head) noexcept;
+	void append(const InspectEvent &event) noexcept;
+
+	// Events with sequence numbers in [*cursor, head), oldest first. Advances the cursor to the head; events that were
+	// overwritten before they could be read are counted in `droppedOut`.
+	std::vector<InspectEvent> readSince(uint64_t *cursor, std::size_t *droppedOut = nullptr) const;
+
+private:
+	int fd_ = -1;
+	void *mapping_ = nullptr;
+	std::size_t mappingSize_ = 0;
+	bool writable_ = false;
+};
+
+// The session is split in two files: a GKeyFile snapshot that is rewritten only when the server state changes, and an
+// InspectEventRing next to it that log lines are appended to.
 class InspectSessionStore
 {
 public:
 	explicit InspectSessionStore(std::string path = defaultSessionPath(), std::size_t eventLimit = 64);
+	~InspectSessionStore();
 
 	const std::string &path() const noexcept { return path_; }
+	const std::string &eventLogPath() const noexcept { return eventLogPath_; }
 	std::size_t eventLimit() const noexcept { return eventLimit_; }
 
+	// Writes the snapshot file. The event log is only rewritten when it disagrees with the snapshot's event history
+	// (droppedEventCount + events.size() differs from the log head), so a writer that appends every event never pays for it.
 	bool save(const InspectSessionSnapshot &snapshot, std::string *errorOut = nullptr) const;
 	std::optional<InspectSessionSnapshot> load(std::string *errorOut = nullptr) const;
 	bool clear(std::string *errorOut = nullptr) const;
 
+	// Incremental event access for the writer and for live readers
+	bool appendEvent(const InspectEvent &event, std::string *errorOut = nullptr) const;
+	std::vector<InspectEvent> readEventsSince(uint64_t *cursor, std::size_t *droppedOut = nullptr) const;
+	uint64_t eventHead() const;
+
 	static std::string defaultSessionPath();
+	static std::string eventLogPathForSession(const std::string &sessionPath);
 
 private:
+	bool ensureEventLogWritable(std::string *errorOut) const;
+	bool ensureEventLogReadable() const;
+
 	std::string path_;
+	std::string eventLogPath_;
 	std::size_t eventLimit_;
+	mutable std::unique_ptr<InspectEventRing> eventLog_;
 };
 
 long long currentTimeMs() noexcept;
@@ -151,4 +257,57 @@ std::string formatMissingSessionReport(const std::string &binaryName);
 bool isInspectSessionStale(const InspectSessionSnapshot &snapshot, bool (*isProcessAlive)(int pid)) noexcept;
 std::string formatStaleSessionReport(const InspectSessionSnapshot &snapshot, const std::string &binaryName);
 
+// `bench`: load generated against a running server over D-Bus
+struct BenchLatencySummary
+{
+	std::size_t samples = 0;
+	uint32_t p50Us = 0;
+	uint32_t p90Us = 0;
+	uint32_t p99Us = 0;
+	uint32_t maxUs = 0;
+};
+
+struct BenchOperationResult
+{
+	std::string name;               // D-Bus method, e.g. "ReadValue"
+	double targetRate = 0.0;        // operations per second
+	uint64_t issued = 0;
+	uint64_t succeeded = 0;
+	uint64_t failed = 0;
+	uint64_t throttled = 0;         // skipped because the in-flight limit was reached
+	std::vector<uint32_t> latenciesUs;
+	std::string firstError;
+};
+
+// utime/stime from /proc/<pid>/stat, in clock ticks
+struct ProcessCpuTime
+{
+	uint64_t userTicks = 0;
+	uint64_t systemTicks = 0;
+};
+
+struct BenchReport
+{
+	std::string busDescription;
+	std::string ownedName;
+	int serverPid = 0;
+	long long durationMs = 0;
+	std::vector<BenchOperationResult> operations;
+	std::size_t subscriptions = 0;
+	uint64_t notificationsReceived = 0;
+	std::optional<ProcessCpuTime> serverCpu;    // consumed during the run
+	long clockTicksPerSecond = 100;
+	bool eventStreamAttached = false;
+	uint32_t peakUpdateQueueDepth = 0;
+	uint64_t updatesProcessed = 0;
+	uint64_t eventStreamDropped = 0;
+	std::vector<std::string> warnings;
+};
+
+// Nearest-rank percentiles
+BenchLatencySummary summarizeBenchLatencies(std::vector<uint32_t> latenciesUs);
+std::optional<ProcessCpuTime> parseProcessCpuTime(const std::string &procStat);
+Verdict evaluateBenchReport(const BenchReport &report) noexcept;
+std::string formatBenchReport(const BenchReport &report, const std::string &binaryName);
+
 } // namespace bzp::standalone
@@ -0,0 +1,187 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Scheduling settings for threads BzPeri creates itself (CPU affinity, nice value, SCHED_FIFO, name, stack locking).
+
+#include "ThreadScheduling.h"
+
+#include <bzp/Logger.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+namespace bzp {
+
+namespace {
+
+constexpr std::size_t kMaxThreadNameLength = 15;
+
+std::mutex serverThreadOptionsMutex;
+ThreadSchedulingOptions serverThreadOptions;
+
+std::string errnoText(int error)
+{
+	return std::strerror(error);
+}
+
+} // namespace
+
+namespace detail {
+
+std::string validateThreadSchedulingOptions(const ThreadSchedulingOptions& options)
+{
+	if (options.nice.has_value() && (*options.nice < -20 || *options.nice > 19))
+	{
+		return "nice value must be between -20 and 19";
+	}
+
+	if (options.realtimePriority != 0)
+	{
+		const int minimum = sched_get_priority_min(SCHED_FIFO);
+		const int maximum = sched_get_priority_max(SCHED_FIFO);
+		if (options.realtimePriority < minimum || options.realtimePriority > maximum)
+		{
+			return "SCHED_FIFO priority must be 0 or between " + std::to_string(minimum) + " and " + std::to_string(maximum);
+		}
+	}
+
+	if (options.cpuAffinityMask != 0)
+	{
+		const long configuredCPUs = sysconf(_SC_NPROCESSORS_CONF);
+		if (configuredCPUs > 0 && configuredCPUs < 64 && (options.cpuAffinityMask >> configuredCPUs) != 0)
+		{
+			return "CPU affinity mask names CPUs beyond the " + std::to_string(configuredCPUs) + " configured on this host";
+		}
+	}
+
+	return {};
+}
+
+} // namespace detail
+
+ThreadSchedulingReport applyThreadSchedulingOptions(const ThreadSchedulingOptions& options)
+{
+	ThreadSchedulingReport report;
+
+	if (!options.name.empty())
+	{
+		const std::string name = options.name.substr(0, kMaxThreadNameLength);
+		const int error = pthread_setname_np(pthread_self(), name.c_str());
+		report.named = error == 0;
+		if (!report.named)
+		{
+			Logger::warn(SSTR << "Unable to name thread '" << name << "': " << errnoText(error));
+		}
+	}
+
+	if (options.cpuAffinityMask != 0)
+	{
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		for (int cpu = 0; cpu < 64; ++cpu)
+		{
+			if (options.cpuAffinityMask & (uint64_t{1} << cpu))
+			{
+				CPU_SET(cpu, &cpus);
+			}
+		}
+
+		const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+		report.pinned = error == 0;
+		if (!report.pinned)
+		{
+			Logger::warn(SSTR << "Unable to set CPU affinity 0x" << std::hex << options.cpuAffinityMask << std::dec
+				<< ": " << errnoText(error));
+		}
+	}
+
+	if (options.nice.has_value())
+	{
+		// On Linux the nice value is per thread when addressed by thread ID
+		const auto threadId = static_cast<id_t>(syscall(SYS_gettid));
+		report.niced = setpriority(PRIO_PROCESS, threadId, *options.nice) == 0;
+		if (!report.niced)
+		{
+			Logger::warn(SSTR << "Unable to set nice value " << *options.nice << ": " << errnoText(errno));
+		}
+	}
+
+	if (options.realtimePriority != 0)
+	{
+		sched_param parameters{};
+		parameters.sched_priority = options.realtimePriority;
+		const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters);
+		report.realtime = error == 0;
+		if (!report.realtime)
+		{
+			Logger::warn(SSTR << "Unable to switch to SCHED_FIFO priority " << options.realtimePriority << ": " << errnoText(error)
+				<< " (needs CAP_SYS_NICE or an RLIMIT_RTPRIO allowance)");
+		}
+	}
+
+	if (options.lockStack)
+	{
+		pthread_attr_t attributes;
+		void *stackAddress = nullptr;
+		std::size_t stackSize = 0;
+		int error = pthread_getattr_np(pthread_self(), &attributes);
+		if (error == 0)
+		{
+			error = pthread_attr_getstack(&attributes, &stackAddress, &stackSize);
+			pthread_attr_destroy(&attributes);
+		}
+
+		if (error == 0)
+		{
+			report.stackLocked = mlock(stackAddress, stackSize) == 0;
+			error = report.stackLocked ? 0 : errno;
+		}
+
+		if (!report.stackLocked)
+		{
+			Logger::warn(SSTR << "Unable to lock the thread stack in memory: " << errnoText(error)
+				<< " (check RLIMIT_MEMLOCK)");
+		}
+	}
+
+	return report;
+}
+
+void setServerThreadSchedulingOptions(const ThreadSchedulingOptions& options)
+{
+	std::lock_guard<std::mutex> lock(serverThreadOptionsMutex);
+	serverThreadOptions = options;
+}
+
+ThreadSchedulingOptions getServerThreadSchedulingOptions()
+{
+	std::lock_guard<std::mutex> lock(serverThreadOptionsMutex);
+	return serverThreadOptions;
+}
+
+ThreadSchedulingReport applyServerThreadScheduling(const char *name)
+{
+	ThreadSchedulingOptions options = getServerThreadSchedulingOptions();
+	if (name != nullptr && *name != '\0')
+	{
+		options.name = name;
+	}
+
+	const ThreadSchedulingReport report = applyThreadSchedulingOptions(options);
+	Logger::debug(SSTR << "Thread '" << options.name.substr(0, kMaxThreadNameLength) << "' scheduling:"
+		<< " affinity=" << (options.cpuAffinityMask == 0 ? "inherited" : (report.pinned ? "pinned" : "failed"))
+		<< " nice=" << (!options.nice.has_value() ? "inherited" : (report.niced ? std::to_string(*options.nice) : "failed"))
+		<< " policy=" << (options.realtimePriority == 0 ? "inherited" : (report.realtime ? "SCHED_FIFO" : "failed"))
+		<< " stack=" << (!options.lockStack ? "pageable" : (report.stackLocked ? "locked" : "failed")));
+	return report;
+}
+
+} // namespace bzp
@@ -0,0 +1,52 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Scheduling settings for threads BzPeri creates itself (CPU affinity, nice value, SCHED_FIFO, name, stack locking).
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace bzp {
+
+struct ThreadSchedulingOptions
+{
+	std::string name = "bzp-server";    // truncated to the 15 bytes Linux keeps
+	uint64_t cpuAffinityMask = 0;       // bit N allows CPU N; 0 keeps the inherited affinity
+	std::optional<int> nice;            // -20..19
+	int realtimePriority = 0;           // 1..99 selects SCHED_FIFO; 0 keeps the inherited policy
+	bool lockStack = false;             // mlock() the thread's stack so it never faults under memory pressure
+
+	bool operator==(const ThreadSchedulingOptions&) const = default;
+};
+
+// What actually took effect; unprivileged hosts typically lose the realtime policy, negative nice values and stack locking
+struct ThreadSchedulingReport
+{
+	bool named = false;
+	bool pinned = false;
+	bool niced = false;
+	bool realtime = false;
+	bool stackLocked = false;
+};
+
+namespace detail {
+
+// Returns an empty string when the options are usable, otherwise a description of the first invalid field
+[[nodiscard]] std::string validateThreadSchedulingOptions(const ThreadSchedulingOptions& options);
+
+} // namespace detail
+
+// Apply `options` to the calling thread. Each setting is attempted independently and failures are logged as warnings.
+ThreadSchedulingReport applyThreadSchedulingOptions(const ThreadSchedulingOptions& options);
+
+// Options used for the internal server thread and any other thread BzPeri starts on its own behalf
+void setServerThreadSchedulingOptions(const ThreadSchedulingOptions& options);
+[[nodiscard]] ThreadSchedulingOptions getServerThreadSchedulingOptions();
+
+// Convenience for BzPeri-owned threads: apply the configured server options, renamed to `name` when given
+ThreadSchedulingReport applyServerThreadScheduling(const char *name = nullptr);
+
+} // namespace bzp
@@ -0,0 +1,292 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// See the discussion at the top of UpdateQueue.h
+
+#include "UpdateQueue.h"
+
+#include <bzp/Logger.h>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace bzp {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kLaneCount = 3;
+constexpr BZPUpdateSchedule kDefaultSchedule{BZP_UPDATE_SCHEDULE_STRICT, 8, 4, 1, 500};
+
+struct Entry
+{
+	std::string objectPath;
+	std::string interfaceName;
+	Clock::time_point queuedAt;
+};
+
+struct Lane
+{
+	std::deque<Entry> entries;
+	unsigned int credit = 0;    // weighted mode: entries left in this round
+	BZPUpdateLaneStats stats{};
+};
+
+struct PathHash
+{
+	using is_transparent = void;
+	std::size_t operator()(std::string_view path) const noexcept { return std::hash<std::string_view>{}(path); }
+};
+
+struct Selection
+{
+	std::size_t lane = 0;
+	bool promoted = false;
+};
+
+std::mutex queueMutex;
+std::array<Lane, kLaneCount> lanes;
+std::size_t queuedCount = 0;
+BZPUpdateSchedule schedule = kDefaultSchedule;
+bool lastWasPromoted = false;
+std::unordered_map<std::string, BZPUpdatePriority, PathHash, std::equal_to<>> priorities;
+
+bool isValidPriority(BZPUpdatePriority priority)
+{
+	return priority >= BZP_UPDATE_PRIORITY_CRITICAL && priority <= BZP_UPDATE_PRIORITY_BULK;
+}
+
+unsigned int laneWeight(std::size_t lane)
+{
+	const unsigned int weights[kLaneCount] = {schedule.criticalWeight, schedule.normalWeight, schedule.bulkWeight};
+	return std::max(weights[lane], 1u);
+}
+
+// Pure: the caller commits the choice only when it actually pops
+std::optional<Selection> selectLane(Clock::time_point now)
+{
+	if (queuedCount == 0)
+	{
+		return std::nullopt;
+	}
+
+	if (schedule.maxWaitMS != 0 && !lastWasPromoted)
+	{
+		const Clock::time_point overdueBefore = now - std::chrono::milliseconds(schedule.maxWaitMS);
+		std::optional<std::size_t> oldest;
+		for (std::size_t lane = 0; lane < kLaneCount; ++lane)
+		{
+			const auto &entries = lanes[lane].entries;
+			if (!entries.empty() && entries.front().queuedAt <= overdueBefore
+				&& (!oldest || entries.front().queuedAt < lanes[*oldest].entries.front().queuedAt))
+			{
+				oldest = lane;
+			}
+		}
+		if (oldest)
+		{
+			return Selection{*oldest, true};
+		}
+	}
+
+	std::optional<std::size_t> firstNonEmpty;
+	for (std::size_t lane = 0; lane < kLaneCount; ++lane)
+	{
+		if (lanes[lane].entries.empty())
+		{
+			continue;
+		}
+		if (schedule.mode == BZP_UPDATE_SCHEDULE_STRICT || lanes[lane].credit > 0)
+		{
+			return Selection{lane, false};
+		}
+		firstNonEmpty = firstNonEmpty.value_or(lane);
+	}
+
+	// Every waiting lane has used up its round; the pop starts a new one
+	return Selection{*firstNonEmpty, false};
+}
+
+void commit(const Selection &selection, Clock::time_point now)
+{
+	Lane &lane = lanes[selection.lane];
+	if (schedule.mode == BZP_UPDATE_SCHEDULE_WEIGHTED && !selection.promoted)
+	{
+		if (lane.credit == 0)
+		{
+			for (std::size_t index = 0; index < kLaneCount; ++index)
+			{
+				lanes[index].credit = laneWeight(index);
+			}
+		}
+		lane.credit -= 1;
+	}
+	lastWasPromoted = selection.promoted;
+
+	const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(now - lane.entries.front().queuedAt).count();
+	const unsigned long long latencyUS = latency > 0 ? static_cast<unsigned long long>(latency) : 0;
+	lane.stats.processed += 1;
+	lane.stats.promoted += selection.promoted ? 1 : 0;
+	lane.stats.totalLatencyUS += latencyUS;
+	lane.stats.maxLatencyUS = std::max(lane.stats.maxLatencyUS, latencyUS);
+
+	lane.entries.pop_front();
+	queuedCount -= 1;
+}
+
+} // namespace
+
+void setUpdatePriority(std::string_view objectPath, BZPUpdatePriority priority)
+{
+	if (!isValidPriority(priority))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(queueMutex);
+	if (priority == BZP_UPDATE_PRIORITY_NORMAL)
+	{
+		if (const auto found = priorities.find(objectPath); found != priorities.end())
+		{
+			priorities.erase(found);
+		}
+		return;
+	}
+	priorities.insert_or_assign(std::string(objectPath), priority);
+}
+
+BZPUpdatePriority updatePriority(std::string_view objectPath)
+{
+	std::lock_guard<std::mutex> guard(queueMutex);
+	const auto found = priorities.find(objectPath);
+	return found != priorities.end() ? found->second : BZP_UPDATE_PRIORITY_NORMAL;
+}
+
+bool setUpdateSchedule(const BZPUpdateSchedule &newSchedule)
+{
+	if (newSchedule.mode != BZP_UPDATE_SCHEDULE_STRICT && newSchedule.mode != BZP_UPDATE_SCHEDULE_WEIGHTED)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> guard(queueMutex);
+	schedule = newSchedule;
+	for (Lane &lane : lanes)
+	{
+		lane.credit = 0;
+	}
+	return true;
+}
+
+BZPUpdateSchedule updateSchedule()
+{
+	std::lock_guard<std::mutex> guard(queueMutex);
+	return schedule;
+}
+
+bool pushUpdate(std::string_view objectPath, std::string_view interfaceName, Clock::time_point now)
+{
+	std::lock_guard<std::mutex> guard(queueMutex);
+	const auto priority = priorities.find(objectPath);
+	const std::size_t laneIndex = priority != priorities.end() ? priority->second : BZP_UPDATE_PRIORITY_NORMAL;
+	Lane &lane = lanes[laneIndex];
+
+	if (queuedCount >= kMaxUpdateQueueSize)
+	{
+		// The entry's own lane or a lower one gives up its oldest entry; higher lanes are never touched
+		const auto candidatesEnd = lanes.rend() - static_cast<std::ptrdiff_t>(laneIndex);
+		const auto victim = std::find_if(lanes.rbegin(), candidatesEnd, [](const Lane &candidate) { return !candidate.entries.empty(); });
+		if (victim == candidatesEnd)
+		{
+			Logger::warn("Update queue full of higher-priority entries — refusing new entry");
+			lane.stats.dropped += 1;
+			return false;
+		}
+		Logger::warn("Update queue full — dropping oldest entry");
+		victim->entries.pop_front();
+		victim->stats.dropped += 1;
+		queuedCount -= 1;
+	}
+
+	lane.entries.push_back(Entry{std::string(objectPath), std::string(interfaceName), now});
+	lane.stats.enqueued += 1;
+	lane.stats.highWatermark = std::max(lane.stats.highWatermark, static_cast<unsigned int>(lane.entries.size()));
+	queuedCount += 1;
+	return true;
+}
+
+BZPUpdateQueueResult popUpdate(std::string &entry, bool keep, std::size_t capacity, Clock::time_point now)
+{
+	std::lock_guard<std::mutex> guard(queueMutex);
+	const std::optional<Selection> selection = selectLane(now);
+	if (!selection)
+	{
+		return BZP_UPDATE_QUEUE_EMPTY;
+	}
+
+	const Entry &next = lanes[selection->lane].entries.front();
+	if (next.objectPath.size() + 1 + next.interfaceName.size() >= capacity)
+	{
+		return BZP_UPDATE_QUEUE_BUFFER_TOO_SMALL;
+	}
+	entry = next.objectPath + "|" + next.interfaceName;
+	if (!keep)
+	{
+		commit(*selection, now);
+	}
+	return BZP_UPDATE_QUEUE_OK;
+}
+
+std::size_t updateQueueSize()
+{
+	std::lock_guard<std::mutex> guard(queueMutex);
+	return queuedCount;
+}
+
+std::size_t clearUpdateQueue()
+{
+	std::lock_guard<std::mutex> guard(queueMutex);
+	const std::size_t cleared = queuedCount;
+	for (Lane &lane : lanes)
+	{
+		lane.entries.clear();
+		lane.credit = 0;
+	}
+	queuedCount = 0;
+	lastWasPromoted = false;
+	return cleared;
+}
+
+BZPUpdateLaneStats updateLaneStats(BZPUpdatePriority priority)
+{
+	std::lock_guard<std::mutex> guard(queueMutex);
+	if (!isValidPriority(priority))
+	{
+		return {};
+	}
+
+	BZPUpdateLaneStats stats = lanes[priority].stats;
+	stats.depth = static_cast<unsigned int>(lanes[priority].entries.size());
+	return stats;
+}
+
+void resetUpdateQueue()
+{
+	std::lock_guard<std::mutex> guard(queueMutex);
+	for (Lane &lane : lanes)
+	{
+		lane = Lane{};
+	}
+	queuedCount = 0;
+	lastWasPromoted = false;
+	schedule = kDefaultSchedule;
+	priorities.clear();
+}
+
+} // namespace bzp
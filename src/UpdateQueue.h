@@ -0,0 +1,55 @@
+// Copyright (c) 2025 BzPeri Contributors
+// Licensed under MIT License (see LICENSE file)
+//
+// Prioritized update queue behind `bzpNotifyUpdatedCharacteristic()`, `bzpPopUpdateQueue()` and friends.
+//
+// Any thread may queue an update; the server loop takes them off one at a time and emits them right away. Instead of a single
+// FIFO, every object path maps to a priority class (critical, normal or bulk) with its own FIFO lane. Strict scheduling always
+// serves the highest non-empty lane; weighted scheduling gives each lane a number of entries per round. Either way a starvation
+// guard serves an entry that has waited longer than `maxWaitMS` ahead of its turn, but never twice in a row, so a backlog of
+// overdue bulk entries cannot in turn hold up critical ones.
+//
+// Choosing the next entry does not change any state, and popUpdate() chooses, checks the caller's capacity and removes the entry
+// under one lock with one timestamp, so an entry that does not fit stays queued and the entry handed out is the one removed.
+// A peek (`keep`) is only a snapshot: another thread may push a more urgent entry before the next pop. When the queue is full,
+// the oldest entry of the lowest non-empty lane at or below the new entry's lane makes room, so with a single lane the queue
+// keeps its newest entries. Only when every queued entry sits in a higher lane is the new entry refused, so a flood of bulk
+// updates can never evict a critical one.
+
+#pragma once
+
+#include <BzPeri.h>
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace bzp {
+
+inline constexpr std::size_t kMaxUpdateQueueSize = 1024;
+
+void setUpdatePriority(std::string_view objectPath, BZPUpdatePriority priority);
+[[nodiscard]] BZPUpdatePriority updatePriority(std::string_view objectPath);
+
+[[nodiscard]] bool setUpdateSchedule(const BZPUpdateSchedule &schedule);
+[[nodiscard]] BZPUpdateSchedule updateSchedule();
+
+// Returns false when the queue is full of higher-priority entries and the new one was refused
+bool pushUpdate(std::string_view objectPath, std::string_view interfaceName,
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+// Writes the next entry as "path|interface" into `entry` and removes it unless `keep` is set. An entry that needs `capacity`
+// bytes or more including its terminator is left queued and yields BZP_UPDATE_QUEUE_BUFFER_TOO_SMALL.
+BZPUpdateQueueResult popUpdate(std::string &entry, bool keep, std::size_t capacity = std::numeric_limits<std::size_t>::max(),
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+[[nodiscard]] std::size_t updateQueueSize();
+std::size_t clearUpdateQueue();
+[[nodiscard]] BZPUpdateLaneStats updateLaneStats(BZPUpdatePriority priority);
+
+// Forgets priorities, schedule and lane counters (tests)
+void resetUpdateQueue();
+
+} // namespace bzp
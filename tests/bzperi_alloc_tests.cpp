@@ -0,0 +1,482 @@
+// Allocation budgets for the steady-state hot paths.
+//
+// This binary replaces malloc and friends (and the global operator new) with versions that count every call on the calling
+// thread, then drives scripted operations through the real dispatch entry points: the GDBus vtable handlers `onMethodCall()` and
+// `onGetProperty()`, and `GattCharacteristic::sendChangeNotificationVariantChecked()` over a peer-to-peer connection. After a
+// warm-up, each operation has to stay within its budget. Two counts are kept apart:
+//
+//   - C++ allocations (operator new) come from BzPeri itself, and the budget for those is zero on every path below.
+//   - Heap allocations cover everything, GLib included. Dispatch that only hands out existing variants must not touch the heap;
+//     a notification builds a message, so it gets a fixed ceiling instead.
+//
+// ReadValue is measured twice. Called with no invocation, `onMethodCall()` covers object lookup and the handler, and the
+// handler's reply is discarded before any message is built. The round trip over the peer connection carries a real
+// `GDBusMethodInvocation`, so it also covers the reply; GLib builds both messages on this thread, which gets a ceiling.
+//
+// It is a separate executable because the replacement allocator applies to the whole process.
+
+#include <gio/gio.h>
+
+#include <BzPeri.h>
+#include <BzPeriConfigurator.h>
+#include <bzp/DBusObject.h>
+#include <bzp/GattCharacteristic.h>
+#include <bzp/GattService.h>
+#include <bzp/GattUuid.h>
+#include <bzp/Server.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace bzp {
+void onMethodCall(GDBusConnection *pConnection, const gchar *pSender, const gchar *pObjectPath, const gchar *pInterfaceName,
+	const gchar *pMethodName, GVariant *pParameters, GDBusMethodInvocation *pInvocation, gpointer pUserData);
+GVariant *onGetProperty(GDBusConnection *pConnection, const gchar *pSender, const gchar *pObjectPath, const gchar *pInterfaceName,
+	const gchar *pPropertyName, GError **ppError, gpointer pUserData);
+}
+
+namespace {
+
+// Trivially constructible, so the counters live in static TLS and touching them never allocates
+struct AllocationCounters
+{
+	std::size_t heap;
+	std::size_t cxx;
+};
+
+thread_local AllocationCounters threadAllocations;
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Counting allocator (glibc exports its own implementation under the __libc_ names)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+extern "C" {
+
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *pointer, std::size_t size);
+void *__libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void *pointer);
+
+void *malloc(std::size_t size) noexcept
+{
+	threadAllocations.heap += 1;
+	return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size) noexcept
+{
+	threadAllocations.heap += 1;
+	return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, std::size_t size) noexcept
+{
+	threadAllocations.heap += 1;
+	return __libc_realloc(pointer, size);
+}
+
+void *memalign(std::size_t alignment, std::size_t size) noexcept
+{
+	threadAllocations.heap += 1;
+	return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(std::size_t alignment, std::size_t size) noexcept
+{
+	threadAllocations.heap += 1;
+	return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **ppPointer, std::size_t alignment, std::size_t size) noexcept
+{
+	threadAllocations.heap += 1;
+	void *pointer = __libc_memalign(alignment, size);
+	if (pointer == nullptr)
+	{
+		return ENOMEM;
+	}
+	*ppPointer = pointer;
+	return 0;
+}
+
+} // extern "C"
+
+namespace {
+
+void *countedNew(std::size_t size, std::size_t alignment = 0)
+{
+	threadAllocations.cxx += 1;
+	threadAllocations.heap += 1;
+	void *pointer = alignment != 0 ? __libc_memalign(alignment, size != 0 ? size : 1) : __libc_malloc(size != 0 ? size : 1);
+	if (pointer == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+} // namespace
+
+void *operator new(std::size_t size) { return countedNew(size); }
+void *operator new[](std::size_t size) { return countedNew(size); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return countedNew(size, static_cast<std::size_t>(alignment)); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return countedNew(size, static_cast<std::size_t>(alignment)); }
+void operator delete(void *pointer) noexcept { __libc_free(pointer); }
+void operator delete[](void *pointer) noexcept { __libc_free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { __libc_free(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept { __libc_free(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { __libc_free(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { __libc_free(pointer); }
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { __libc_free(pointer); }
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept { __libc_free(pointer); }
+
+namespace {
+
+using bzp::DBusMethodCallRef;
+using bzp::DBusObject;
+using bzp::DBusPropertyCallRef;
+using bzp::DBusVariantRef;
+using bzp::GattCharacteristic;
+using bzp::GattUuid;
+using bzp::Server;
+
+constexpr int kShutdownDriveTimeoutMS = 500;
+constexpr std::size_t kWarmupIterations = 16;
+constexpr std::size_t kMeasuredIterations = 256;
+constexpr const char *kCharacteristicInterface = "org.bluez.GattCharacteristic1";
+constexpr const char *kSender = ":1.42";
+
+class TestFailure : public std::runtime_error
+{
+public:
+	using std::runtime_error::runtime_error;
+};
+
+void require(bool condition, const std::string &message)
+{
+	if (!condition)
+	{
+		throw TestFailure(message);
+	}
+}
+
+const void *nullGetter(const char *)
+{
+	return nullptr;
+}
+
+int acceptingSetter(const char *, const void *)
+{
+	return 1;
+}
+
+struct AllocationBudget
+{
+	std::size_t heap;    // per operation, GLib included
+	std::size_t cxx;     // per operation, operator new only
+};
+
+// Runs `operation` through a warm-up, then checks the allocations of the measured iterations against `budget`
+void requireWithinBudget(const char *name, AllocationBudget budget, const std::function<void()> &operation)
+{
+	for (std::size_t iteration = 0; iteration < kWarmupIterations; ++iteration)
+	{
+		operation();
+	}
+
+	const AllocationCounters before = threadAllocations;
+	for (std::size_t iteration = 0; iteration < kMeasuredIterations; ++iteration)
+	{
+		operation();
+	}
+	const std::size_t heap = threadAllocations.heap - before.heap;
+	const std::size_t cxx = threadAllocations.cxx - before.cxx;
+
+	std::cout << "  " << name << ": " << static_cast<double>(heap) / kMeasuredIterations << " heap / "
+		<< static_cast<double>(cxx) / kMeasuredIterations << " C++ allocations per operation\n";
+	require(cxx <= budget.cxx * kMeasuredIterations, std::string(name) + ": " + std::to_string(cxx) + " C++ allocations over "
+		+ std::to_string(kMeasuredIterations) + " operations exceed the budget of " + std::to_string(budget.cxx) + " each");
+	require(heap <= budget.heap * kMeasuredIterations, std::string(name) + ": " + std::to_string(heap) + " heap allocations over "
+		+ std::to_string(kMeasuredIterations) + " operations exceed the budget of " + std::to_string(budget.heap) + " each");
+}
+
+// Both ends of an authenticated peer-to-peer D-Bus connection over a socket pair, so notifications take GDBus's real send path
+// without a bus daemon
+struct PeerConnection
+{
+	GDBusConnection *pServer = nullptr;
+	GDBusConnection *pClient = nullptr;
+
+	PeerConnection()
+	{
+		int fds[2] = {-1, -1};
+		require(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) == 0, "socketpair should succeed");
+		GIOStream *pServerStream = streamFor(fds[0]);
+		GIOStream *pClientStream = streamFor(fds[1]);
+
+		// The server end authenticates on a worker thread while the client end blocks; its result arrives on this context
+		GMainContext *pContext = g_main_context_new();
+		g_main_context_push_thread_default(pContext);
+		gchar *pGuid = g_dbus_generate_guid();
+		g_dbus_connection_new(pServerStream, pGuid, G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_SERVER, nullptr, nullptr,
+			[](GObject *, GAsyncResult *pResult, gpointer pUserData) {
+				auto &self = *static_cast<PeerConnection *>(pUserData);
+				self.pServer = g_dbus_connection_new_finish(pResult, nullptr);
+				self.serverReady = true;
+			}, this);
+		pClient = g_dbus_connection_new_sync(pClientStream, nullptr, G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT, nullptr,
+			nullptr, nullptr);
+		while (!serverReady)
+		{
+			g_main_context_iteration(pContext, TRUE);
+		}
+		g_main_context_pop_thread_default(pContext);
+		g_main_context_unref(pContext);
+		g_free(pGuid);
+		g_object_unref(pServerStream);
+		g_object_unref(pClientStream);
+
+		require(pServer != nullptr && pClient != nullptr, "Peer-to-peer D-Bus connection should authenticate");
+	}
+
+	~PeerConnection()
+	{
+		for (GDBusConnection *pConnection : {pClient, pServer})
+		{
+			if (pConnection != nullptr)
+			{
+				g_dbus_connection_close_sync(pConnection, nullptr, nullptr);
+				g_object_unref(pConnection);
+			}
+		}
+	}
+
+	PeerConnection(const PeerConnection &) = delete;
+	PeerConnection &operator=(const PeerConnection &) = delete;
+
+private:
+	static GIOStream *streamFor(int fd)
+	{
+		GSocket *pSocket = g_socket_new_from_fd(fd, nullptr);
+		require(pSocket != nullptr, "g_socket_new_from_fd should wrap the socket pair");
+		GIOStream *pStream = G_IO_STREAM(g_socket_connection_factory_create_connection(pSocket));
+		g_object_unref(pSocket);
+		return pStream;
+	}
+
+	bool serverReady = false;
+};
+
+struct HotPathFixture
+{
+	static constexpr guint8 kLevel = 42;
+
+	GVariant *pValue = g_variant_ref_sink(g_variant_new_byte(kLevel));
+	GVariant *pReadReply = g_variant_ref_sink(g_variant_new("(@ay)", g_variant_new_fixed_array(G_VARIANT_TYPE_BYTE, &kLevel, 1, 1)));
+	const GattCharacteristic *pCharacteristic = nullptr;
+	std::string characteristicPath;
+	int reads = 0;
+	int gets = 0;
+
+	HotPathFixture()
+	{
+		bzp::registerServiceConfigurator([this](Server &server) {
+			server.configure([this](DBusObject &root) {
+				GattCharacteristic &characteristic = root.gattServiceBegin("battery", GattUuid("180F"))
+					.gattCharacteristicBegin("level", GattUuid("2A19"), {"read", "notify"});
+				characteristic.onReadValue([this](const GattCharacteristic &, const std::string &, DBusMethodCallRef methodCall) {
+					reads += 1;
+					methodCall.returnValue(DBusVariantRef(pReadReply));
+				});
+				characteristic.addProperty<GattCharacteristic>("Value", DBusVariantRef(pValue),
+					[this](DBusPropertyCallRef) -> DBusVariantRef {
+						gets += 1;
+						return DBusVariantRef(g_variant_ref(pValue));
+					});
+				pCharacteristic = &characteristic;
+				characteristicPath = characteristic.getPath().toString();
+			});
+		});
+
+		require(bzpStartManual("bzperi.tests.alloc", "", "", &nullGetter, &acceptingSetter) != 0,
+			"bzpStartManual should install the server the dispatch handlers use");
+		require(pCharacteristic != nullptr, "The service configurator should have run");
+	}
+
+	~HotPathFixture()
+	{
+		bzpTriggerShutdown();
+		bzpRunLoopDriveUntilShutdown(kShutdownDriveTimeoutMS);
+		bzp::clearServiceConfigurators();
+		g_variant_unref(pReadReply);
+		g_variant_unref(pValue);
+	}
+
+	HotPathFixture(const HotPathFixture &) = delete;
+	HotPathFixture &operator=(const HotPathFixture &) = delete;
+};
+
+void testReadValueDispatch(HotPathFixture &fixture)
+{
+	GVariant *pOptions = g_variant_ref_sink(g_variant_new("(a{sv})", nullptr));
+	const int readsBefore = fixture.reads;
+
+	// No invocation: lookup and handler only, the reply is dropped before a message would be built
+	requireWithinBudget("ReadValue lookup and handler", {0, 0}, [&] {
+		bzp::onMethodCall(nullptr, kSender, fixture.characteristicPath.c_str(), kCharacteristicInterface, "ReadValue", pOptions,
+			nullptr, nullptr);
+	});
+
+	g_variant_unref(pOptions);
+	require(fixture.reads - readsBefore == static_cast<int>(kWarmupIterations + kMeasuredIterations),
+		"Every ReadValue call should reach the characteristic handler");
+}
+
+void testReadValueRoundTrip(HotPathFixture &fixture)
+{
+	static const char kIntrospection[] =
+		"<node><interface name='org.bluez.GattCharacteristic1'><method name='ReadValue'>"
+		"<arg name='options' type='a{sv}' direction='in'/><arg name='value' type='ay' direction='out'/>"
+		"</method></interface></node>";
+	static const GDBusInterfaceVTable kVTable = {bzp::onMethodCall, nullptr, nullptr, {}};
+
+	PeerConnection peer;
+
+	// Incoming calls and the client's reply callback both run on the context that is thread-default when they are set up
+	GMainContext *pContext = g_main_context_new();
+	g_main_context_push_thread_default(pContext);
+	GDBusNodeInfo *pNode = g_dbus_node_info_new_for_xml(kIntrospection, nullptr);
+	require(pNode != nullptr, "ReadValue introspection should parse");
+	const guint registrationId = g_dbus_connection_register_object(peer.pServer, fixture.characteristicPath.c_str(),
+		pNode->interfaces[0], &kVTable, nullptr, nullptr, nullptr);
+	require(registrationId != 0, "The characteristic should register on the server end of the peer connection");
+
+	GVariant *pOptions = g_variant_ref_sink(g_variant_new("(a{sv})", nullptr));
+	const int readsBefore = fixture.reads;
+	int failed = 0;
+
+	// Client call, reply and their messages are GLib's work; the ceiling catches anything that scales with more than that
+	requireWithinBudget("ReadValue round trip", {256, 0}, [&] {
+		int outcome = 0;
+		g_dbus_connection_call(peer.pClient, nullptr, fixture.characteristicPath.c_str(), kCharacteristicInterface, "ReadValue",
+			pOptions, G_VARIANT_TYPE("(ay)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr,
+			[](GObject *pSource, GAsyncResult *pResult, gpointer pUserData) {
+				GVariant *pReply = g_dbus_connection_call_finish(G_DBUS_CONNECTION(pSource), pResult, nullptr);
+				*static_cast<int *>(pUserData) = pReply != nullptr ? 1 : -1;
+				if (pReply != nullptr)
+				{
+					g_variant_unref(pReply);
+				}
+			}, &outcome);
+		while (outcome == 0)
+		{
+			g_main_context_iteration(pContext, TRUE);
+		}
+		failed += outcome < 0 ? 1 : 0;
+	});
+
+	g_variant_unref(pOptions);
+	g_dbus_connection_unregister_object(peer.pServer, registrationId);
+	g_dbus_node_info_unref(pNode);
+	g_main_context_pop_thread_default(pContext);
+	g_main_context_unref(pContext);
+
+	require(failed == 0, "Every ReadValue round trip should get the handler's reply");
+	require(fixture.reads - readsBefore == static_cast<int>(kWarmupIterations + kMeasuredIterations),
+		"Every ReadValue round trip should reach the characteristic handler");
+}
+
+void testPropertyGetDispatch(HotPathFixture &fixture)
+{
+	const int getsBefore = fixture.gets;
+	int mismatches = 0;
+
+	requireWithinBudget("Property get dispatch", {0, 0}, [&] {
+		GError *pError = nullptr;
+		GVariant *pResult = bzp::onGetProperty(nullptr, kSender, fixture.characteristicPath.c_str(), kCharacteristicInterface,
+			"Value", &pError, nullptr);
+		mismatches += pResult != fixture.pValue || pError != nullptr ? 1 : 0;
+		if (pResult != nullptr)
+		{
+			g_variant_unref(pResult);
+		}
+		g_clear_error(&pError);
+	});
+
+	require(mismatches == 0, "Property get should return the getter's variant");
+	require(fixture.gets - getsBefore == static_cast<int>(kWarmupIterations + kMeasuredIterations),
+		"Every property get should reach the getter");
+}
+
+void testNotificationSend(HotPathFixture &fixture)
+{
+	PeerConnection peer;
+	int refused = 0;
+
+	// Building the PropertiesChanged body and the D-Bus message is GLib's work; the ceiling catches anything that scales with
+	// more than the message itself
+	requireWithinBudget("Change notification", {128, 0}, [&] {
+		const bool sent = fixture.pCharacteristic->sendChangeNotificationVariantChecked(bzp::DBusNotificationRef(
+			bzp::DBusConnectionRef(peer.pClient), DBusVariantRef(fixture.pValue)));
+		refused += sent ? 0 : 1;
+	});
+
+	g_dbus_connection_flush_sync(peer.pClient, nullptr, nullptr);
+	require(refused == 0, "Every notification should be accepted for sending");
+}
+
+struct TestCase
+{
+	const char *name;
+	void (*run)(HotPathFixture &);
+};
+
+} // namespace
+
+int main()
+{
+	const std::vector<TestCase> tests = {
+		{"ReadValue dispatch allocations", testReadValueDispatch},
+		{"ReadValue round trip allocations", testReadValueRoundTrip},
+		{"Property get allocations", testPropertyGetDispatch},
+		{"Change notification allocations", testNotificationSend},
+	};
+
+	int failures = 0;
+	try
+	{
+		HotPathFixture fixture;
+		for (const auto &testCase : tests)
+		{
+			try
+			{
+				testCase.run(fixture);
+				std::cout << "[PASS] " << testCase.name << '\n';
+			}
+			catch (const std::exception &error)
+			{
+				std::cerr << "[FAIL] " << testCase.name << ": " << error.what() << '\n';
+				failures += 1;
+			}
+		}
+	}
+	catch (const std::exception &error)
+	{
+		std::cerr << "[FAIL] Hot path fixture: " << error.what() << '\n';
+		failures += 1;
+	}
+
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -2,6 +2,7 @@
 #include "config.h"
 
 #include <BzPeri.h>
+#include <BzPeriDataPlaneProducer.h>
 #include <bzp/BluezAdapter.h>
 #include <bzp/DBusMethod.h>
 #include <bzp/DBusInterface.h>
@@ -9,30 +10,54 @@
 #include <bzp/GattProperty.h>
 #include <bzp/GattService.h>
 #include <bzp/GattUuid.h>
+#include <bzp/IngestReader.h>
+#include <bzp/Loopback.h>
 #include <bzp/Server.h>
 
 #include "../src/BluezAdvertisingSupport.h"
 #include "../src/BluezAdapterCompat.h"
+#include "../src/BluezSignalFilter.h"
+#include "../src/DeviceEventBatch.h"
+#include "../src/DataPlane.h"
+#include "../src/AcquiredNotify.h"
+#include "../src/EventStream.h"
+#include "../src/IngestRing.h"
 #include "../src/ServerCompat.h"
 #include "../src/StandaloneWorkflow.h"
 #include "../src/ServerUtils.h"
+#include "../src/RunLoopTimers.h"
 #include "../src/StructuredLogger.h"
+#include "../src/ThreadScheduling.h"
+#include "../src/UpdateQueue.h"
 
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <exception>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <span>
 #include <string_view>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 namespace bzp {
 void setServerRunState(BZPServerRunState newState);
@@ -65,7 +90,11 @@ using bzp::GattCharacteristic;
 using bzp::GattProperty;
 using bzp::GattService;
 using bzp::GattUuid;
+using bzp::IndicationResult;
+using bzp::IndicationStats;
 using bzp::Logger;
+using bzp::LoopbackReply;
+using bzp::LoopbackTransport;
 using bzp::Server;
 using bzp::StructuredLogger;
 using bzp::Utils;
@@ -74,8 +103,21 @@ using bzp::setActiveServerForRuntime;
 using bzp::setActiveBluezAdapterForRuntime;
 using bzp::makeRuntimeBluezAdapterPtr;
 using bzp::detail::canUseExtendedAdvertising;
+using bzp::detail::checkAdvertisingPayloadBudget;
 using bzp::detail::collectGattServiceUUIDs;
-using bzp::detail::selectAdvertisementServiceUUIDs;
+using bzp::detail::estimateAdvertisingPayloadLength;
+using bzp::detail::normalizeAdvertisingServiceDataUuid;
+using bzp::detail::normalizeAdvertisingSetConfig;
+using bzp::detail::AdvertisingPackInput;
+using bzp::detail::packAdvertisingPayload;
+using bzp::detail::ResumeRestoreTracker;
+using bzp::detail::selectAdvertisingRotationSlice;
+using bzp::detail::validateAdvertisingBurstPolicy;
+using bzp::detail::validateAdvertisingParameters;
+using bzp::AdvertisingBurstPolicy;
+using bzp::AdvertisingData;
+using bzp::AdvertisingParameters;
+using bzp::AdvertisingSetConfig;
 using bzp::BluezCapabilities;
 
 class TestFailure : public std::runtime_error
@@ -187,7 +229,9 @@ struct FakeDoctorProbe final : bzp::standalone::DoctorProbe
 	bool experimentalModeEnabled = false;
 	std::string helperPath;
 	std::string helperDetail;
+	int adapterDelayMs = 0;    // simulated D-Bus stall; cut short by cancel()
 	mutable std::string lastPreferredAdapter;
+	mutable std::atomic<bool> cancelled{false};
 
 	bool checkSystemBus(std::string *detailOut) const override
 	{
@@ -223,6 +267,11 @@ struct FakeDoctorProbe final : bzp::standalone::DoctorProbe
 		std::string *detailOut) const override
 	{
 		lastPreferredAdapter = preferredAdapter;
+		const auto stallUntil = std::chrono::steady_clock::now() + std::chrono::milliseconds(adapterDelayMs);
+		while (!cancelled.load() && std::chrono::steady_clock::now() < stallUntil)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
 		if (poweredAdapterAvailableOut != nullptr)
 		{
 			*poweredAdapterAvailableOut = poweredAdapterAvailable;
@@ -267,6 +316,11 @@ struct FakeDoctorProbe final : bzp::standalone::DoctorProbe
 		}
 		return helperAvailable;
 	}
+
+	void cancel() const override
+	{
+		cancelled.store(true);
+	}
 };
 
 std::vector<std::string> capturedInfoLogs;
@@ -685,6 +739,125 @@ void testCharacteristicAndPropertyWrappers()
 	g_variant_unref(setterCallValue);
 }
 
+void testLoopbackTransport()
+{
+	Server server("bzperi.tests.loopback", "", "", &nullGetter, &acceptingSetter);
+	std::string characteristicPath;
+	std::string rootPath;
+	std::string lastWrite;
+	std::string getterSender;
+	int reads = 0;
+
+	server.configure([&](DBusObject &root) {
+		rootPath = root.getPath().toString();
+
+		GattCharacteristic &characteristic = root.gattServiceBegin("svc", GattUuid("1234"))
+			.gattCharacteristicBegin("value", GattUuid("1235"), {"read", "write"});
+		characteristicPath = characteristic.getPath().toString();
+
+		characteristic.onReadValue([&reads](const GattCharacteristic &self, const std::string &, DBusMethodCallRef methodCall) {
+			reads += 1;
+			self.methodReturnValue(DBusReplyRef(methodCall), "loop", true);
+		});
+		characteristic.onWriteValue([&lastWrite](const GattCharacteristic &self, const std::string &, DBusMethodCallRef methodCall) {
+			GVariant *bytes = g_variant_get_child_value(methodCall.parameters().get(), 0);
+			lastWrite = g_variant_get_bytestring(bytes);
+			g_variant_unref(bytes);
+			self.methodReturnVariant(DBusReplyRef(methodCall), DBusVariantRef());
+		});
+
+		characteristic.addProperty<GattCharacteristic>(
+			"Caller",
+			DBusVariantRef(g_variant_new_string("seed")),
+			[&getterSender](DBusPropertyCallRef call) -> DBusVariantRef {
+				getterSender = std::string(call.sender());
+				return DBusVariantRef(g_variant_new_string("computed"));
+			},
+			[](DBusPropertyCallRef call) -> bool {
+				g_set_error(call.error().get(), G_DBUS_ERROR, G_DBUS_ERROR_ACCESS_DENIED, "Caller is read-only");
+				return false;
+			});
+
+		auto interface = root.addInterface(std::make_shared<DBusInterface>(root, "com.example.Loopback"));
+		static const char *inArgs[] = {nullptr};
+		interface->addMethod("Untupled", inArgs, "s", [](const DBusInterface &, const std::string &, DBusMethodCallRef methodCall) {
+			methodCall.returnValue(DBusVariantRef(g_variant_new_string("bare")));
+		});
+		interface->addMethod("Twice", inArgs, "", [](const DBusInterface &, const std::string &, DBusMethodCallRef methodCall) {
+			methodCall.returnDbusError("com.example.Error.First", "first");
+			methodCall.returnValue(DBusVariantRef());
+		});
+		interface->addMethod("Deferred", inArgs, "", [](const DBusInterface &, const std::string &, DBusMethodCallRef methodCall) {
+			g_timeout_add(0, [](gpointer pUserData) -> gboolean {
+				auto *pDeferred = static_cast<DBusMethodCallRef *>(pUserData);
+				pDeferred->returnValue(DBusVariantRef());
+				delete pDeferred;
+				return G_SOURCE_REMOVE;
+			}, new DBusMethodCallRef(methodCall));
+		});
+	});
+
+	LoopbackTransport loopback(server);
+	const char *characteristicInterface = "org.bluez.GattCharacteristic1";
+
+	const LoopbackReply &readReply = loopback.callMethod(characteristicPath.c_str(), characteristicInterface, "ReadValue",
+		g_variant_new("(a{sv})", nullptr));
+	require(reads == 1, "Loopback ReadValue should reach the characteristic handler");
+	require(readReply.hasValue() && readReply.replyCount() == 1, "Loopback ReadValue should capture one value reply");
+	require(g_variant_is_of_type(readReply.value().get(), G_VARIANT_TYPE("(ay)")), "Loopback ReadValue reply should be the (ay) tuple");
+	GVariant *readBytes = g_variant_get_child_value(readReply.value().get(), 0);
+	gsize readSize = 0;
+	const auto *readData = static_cast<const char *>(g_variant_get_fixed_array(readBytes, &readSize, 1));
+	require(std::string(readData, readSize) == "loop", "Loopback ReadValue reply should carry the handler's bytes");
+	g_variant_unref(readBytes);
+
+	const LoopbackReply &writeReply = loopback.callMethod(characteristicPath.c_str(), characteristicInterface, "WriteValue",
+		g_variant_new("(@aya{sv})", g_variant_new_bytestring("ping"), nullptr));
+	require(lastWrite == "ping", "Loopback WriteValue should pass the argument tuple to the handler");
+	require(writeReply.hasValue() && !writeReply.value(), "Loopback WriteValue should capture an empty reply");
+
+	const LoopbackReply &missing = loopback.callMethod(characteristicPath.c_str(), characteristicInterface, "Missing");
+	require(missing.hasError() && missing.errorName() == server.getNotImplementedErrorName(),
+		"Loopback calls to unknown methods should get the server's NotImplemented error");
+
+	const LoopbackReply &untupled = loopback.callMethod(rootPath.c_str(), "com.example.Loopback", "Untupled");
+	require(untupled.hasError() && untupled.errorName() == "org.freedesktop.DBus.Error.InvalidArgs",
+		"Loopback should reject a reply a bus would refuse to send");
+
+	const LoopbackReply &twice = loopback.callMethod(rootPath.c_str(), "com.example.Loopback", "Twice");
+	require(twice.replyCount() == 2 && twice.hasError() && twice.errorMessage() == "first",
+		"Loopback should count repeated replies and keep the first");
+
+	const LoopbackReply &deferred = loopback.callMethod(rootPath.c_str(), "com.example.Loopback", "Deferred");
+	require(deferred.status() == LoopbackReply::Status::None, "A handler that has not replied should leave no reply");
+	for (int iteration = 0; iteration < 100 && loopback.lateReplyCount() == 0; ++iteration)
+	{
+		g_main_context_iteration(nullptr, FALSE);
+	}
+	require(loopback.lateReplyCount() == 1 && loopback.reply().status() == LoopbackReply::Status::None
+		&& loopback.reply().replyCount() == 0, "A reply from a timer after the call returned should be dropped and counted");
+
+	const LoopbackReply &uuid = loopback.getProperty(characteristicPath.c_str(), characteristicInterface, "UUID");
+	require(uuid.hasValue(), "Loopback property get should return stored property values");
+	expectVariantString(uuid.value().get(), GattUuid("1235").toString128(), "loopback UUID property value");
+
+	const LoopbackReply &caller = loopback.getProperty(characteristicPath.c_str(), characteristicInterface, "Caller");
+	require(caller.hasValue(), "Loopback property get should run getter handlers");
+	expectVariantString(caller.value().get(), "computed", "loopback computed property value");
+	require(getterSender == ":1.loopback", "Loopback property getters should see the transport's sender");
+
+	const LoopbackReply &denied = loopback.setProperty(characteristicPath.c_str(), characteristicInterface, "Caller",
+		g_variant_new_string("changed"));
+	require(denied.hasError() && denied.errorName() == "org.freedesktop.DBus.Error.AccessDenied"
+		&& denied.errorMessage() == "Caller is read-only",
+		"Loopback property set should report the setter's GError as a D-Bus error");
+
+	const LoopbackReply &unknown = loopback.getProperty(characteristicPath.c_str(), characteristicInterface, "Unknown");
+	require(unknown.hasError() && unknown.errorMessage().find("Property(get) not found") != std::string::npos,
+		"Loopback property get should report unknown properties");
+	require(!unknown.value(), "Loopback replies should be reset between calls");
+}
+
 void testBluezAdapterAccessors()
 {
 	decltype(auto) adapter = getActiveBluezAdapter();
@@ -901,17 +1074,280 @@ void testAdvertisingServiceUuidSelection()
 	legacyCaps.maxAdvertisingDataLength = 31;
 	require(!canUseExtendedAdvertising(legacyCaps), "31-byte advertising budget should remain on the legacy path");
 
-	const auto legacySelected = selectAdvertisementServiceUUIDs(collected, legacyCaps);
-	require(legacySelected.size() == 2, "Legacy advertising should only keep standard short UUIDs");
-	require(legacySelected[0] == "180f", "Legacy advertising should shorten standard 16-bit UUIDs");
-	require(legacySelected[1] == "12345678", "Legacy advertising should shorten standard 32-bit UUIDs");
+	AdvertisingPackInput input;
+	input.serviceUUIDs = collected;
+	auto pack = packAdvertisingPayload(input, legacyCaps);
+	// Flags (3) + 16-bit list (2 + 2) + 32-bit list (2 + 4) + 128-bit list (2 + 16) fills the legacy PDU exactly
+	require(pack.advertisingDataLength == 31 && pack.complete(), "All three service UUIDs should fit the legacy advertising data");
+	require(pack.serviceUUIDs == std::vector<std::string>({"180f", "12345678", collected[2]}),
+		"Packed UUIDs should use their shortest advertisable form, custom UUIDs included");
+
+	input.serviceUUIDs.push_back("00000002-1E3C-FAD4-74E2-97A033F1BFAA");
+	input.data.manufacturerData[0x0059] = std::vector<uint8_t>(4, 0xAB);
+	input.includeLocalName = true;
+	input.localName = "BzPeri Sensor";
+	pack = packAdvertisingPayload(input, legacyCaps);
+	require(pack.scanResponseServiceUUIDs == std::vector<std::string>({"00000002-1e3c-fad4-74e2-97a033f1bfaa"}),
+		"A UUID that does not fit the advertising data should spill into the scan response");
+	require(pack.scanResponseData.manufacturerData.count(0x0059) == 1, "Overflowing manufacturer data should follow it");
+	require(pack.scanResponseLength == 31, "The local name should be shortened to the remaining scan response space");
+	require(pack.complete(), "A shortened local name should not make the layout incomplete");
+	require(pack.report() == packAdvertisingPayload(input, legacyCaps).report(), "The packing report should be deterministic");
+	require(pack.report().find("local-name-shortened(5)") != std::string::npos, "The report should flag the shortened name");
+
+	input.data.manufacturerData[0x0059] = std::vector<uint8_t>(40, 0xAB);
+	pack = packAdvertisingPayload(input, legacyCaps);
+	require(!pack.complete() && pack.report().find("dropped: manufacturer-data:0x0059(44)") != std::string::npos,
+		"Structures that fit nowhere should be reported as dropped");
 
 	BluezCapabilities extendedCaps;
 	extendedCaps.maxAdvertisingDataLength = 251;
 	require(canUseExtendedAdvertising(extendedCaps), "Extended advertising should activate when MaxAdvLen exceeds 31 bytes");
 
-	const auto extendedSelected = selectAdvertisementServiceUUIDs(collected, extendedCaps);
-	require(extendedSelected == collected, "Extended advertising should keep the full 128-bit service UUID set");
+	pack = packAdvertisingPayload(input, extendedCaps);
+	require(pack.advertisingDataLimit == 251 && pack.scanResponseServiceUUIDs.empty() && pack.data.manufacturerData.count(0x0059) == 1,
+		"Extended advertising should keep the whole payload in the advertising data");
+}
+
+void testAdvertisingPayloadBudget()
+{
+	require(normalizeAdvertisingServiceDataUuid("0000FEAA-0000-1000-8000-00805F9B34FB") == "feaa",
+		"Base service data UUIDs should be stored in their 16-bit form");
+	require(normalizeAdvertisingServiceDataUuid("00000001-1E3C-FAD4-74E2-97A033F1BFAA") == "00000001-1e3c-fad4-74e2-97a033f1bfaa",
+		"Custom service data UUIDs should keep their lower-cased 128-bit form");
+	require(normalizeAdvertisingServiceDataUuid("not-a-uuid").empty(), "Unparseable service data UUIDs should be rejected");
+
+	AdvertisingData data;
+	require(estimateAdvertisingPayloadLength({}, data, false) == 3, "An empty advertisement should only carry the Flags structure");
+
+	data.manufacturerData[0x0059] = std::vector<uint8_t>(4, 0xAB);
+	data.serviceData["feaa"] = {0x10, 0x20};
+	// Flags (3) + 16-bit UUID list (2 + 2) + manufacturer data (2 + 2 + 4) + service data (2 + 2 + 2) + TX power (3)
+	require(estimateAdvertisingPayloadLength({"180f"}, data, true) == 24,
+		"Payload estimate should count every AD structure header and body");
+
+	BluezCapabilities legacyCaps;
+	legacyCaps.maxAdvertisingDataLength = 31;
+	require(checkAdvertisingPayloadBudget({"180f"}, data, true, legacyCaps).isSuccess(),
+		"A 24-byte payload should fit the legacy advertising budget");
+
+	data.manufacturerData[0x0059] = std::vector<uint8_t>(12, 0xAB);
+	const auto overBudget = checkAdvertisingPayloadBudget({"180f"}, data, true, legacyCaps);
+	require(overBudget.hasError() && overBudget.error() == bzp::BluezError::PayloadTooLarge,
+		"A 32-byte payload should be rejected by the legacy advertising budget");
+
+	BluezCapabilities extendedCaps;
+	extendedCaps.maxAdvertisingDataLength = 251;
+	require(checkAdvertisingPayloadBudget({"180f"}, data, true, extendedCaps).isSuccess(),
+		"Extended advertising should accept payloads beyond 31 bytes");
+}
+
+void testAdvertisingDataStore()
+{
+	auto runtimeAdapter = makeRuntimeBluezAdapterPtr();
+
+	require(runtimeAdapter->setAdvertisingManufacturerData(0xFFFF, std::vector<uint8_t>(24, 0x01)).isSuccess(),
+		"Manufacturer data filling the legacy budget exactly should be accepted");
+	require(runtimeAdapter->setAdvertisingServiceData("180F", {0x64}).isSuccess(),
+		"Service data that overflows the advertising data should spill into the scan response");
+	require(runtimeAdapter->setAdvertisingServiceData("181A", std::vector<uint8_t>(30, 0x01)).error() == bzp::BluezError::PayloadTooLarge,
+		"Service data that fits neither the advertising data nor the scan response should be rejected");
+	require(runtimeAdapter->getAdvertisingData().serviceData.count("181a") == 0,
+		"Rejected service data should leave the stored payload unchanged");
+
+	require(runtimeAdapter->setAdvertisingManufacturerData(0xFFFF, {0x01, 0x02}).isSuccess(),
+		"Replacing manufacturer data with a smaller payload should succeed");
+	require(runtimeAdapter->setAdvertisingServiceData("0000180F-0000-1000-8000-00805F9B34FB", {0x64}).isSuccess(),
+		"Service data within budget should be accepted");
+
+	const auto stored = runtimeAdapter->getAdvertisingData();
+	require(stored.manufacturerData.at(0xFFFF) == std::vector<uint8_t>({0x01, 0x02}),
+		"Stored manufacturer data should reflect the latest update");
+	require(stored.serviceData.count("180f") == 1, "Stored service data should be keyed by the normalized UUID");
+
+	require(runtimeAdapter->removeAdvertisingServiceData("180f").isSuccess(), "Removing service data should succeed");
+	require(runtimeAdapter->setAdvertisingServiceData("zz", {0x01}).error() == bzp::BluezError::InvalidArgs,
+		"Unparseable service data UUIDs should be rejected");
+	runtimeAdapter->clearAdvertisingData();
+	require(runtimeAdapter->getAdvertisingData().empty(), "Clearing advertising data should remove every entry");
+
+	const unsigned char payload[] = {0x01, 0x02};
+	require(bzpSetAdvertisingManufacturerDataEx(0x0059, nullptr, 2) == BZP_ADVERTISING_DATA_INVALID_ARGUMENT,
+		"C API should reject a null buffer with a non-zero length");
+	require(bzpSetAdvertisingServiceDataEx(nullptr, payload, 2) == BZP_ADVERTISING_DATA_INVALID_ARGUMENT,
+		"C API should reject a null service data UUID");
+	require(bzpSetAdvertisingManufacturerDataEx(0x0059, payload, 2) == BZP_ADVERTISING_DATA_NOT_RUNNING,
+		"C API should report not-running before startup");
+	require(bzpClearAdvertisingDataEx() == BZP_ADVERTISING_DATA_NOT_RUNNING,
+		"Clearing advertising data should report not-running before startup");
+}
+
+void testAdvertisingParametersAndBurst()
+{
+	AdvertisingParameters parameters;
+	require(validateAdvertisingParameters(parameters).isSuccess(), "Default advertising parameters should defer to the controller");
+
+	parameters.minIntervalMs = 100;
+	parameters.maxIntervalMs = 150;
+	parameters.txPower = -4;
+	require(validateAdvertisingParameters(parameters).isSuccess(), "A 100-150 ms interval with -4 dBm should be accepted");
+
+	parameters.minIntervalMs = 10;
+	require(validateAdvertisingParameters(parameters).hasError(), "Intervals below 20 ms should be rejected");
+	parameters.minIntervalMs = 200;
+	require(validateAdvertisingParameters(parameters).hasError(), "MinInterval above MaxInterval should be rejected");
+	parameters.minIntervalMs = 100;
+	parameters.txPower = 42;
+	require(validateAdvertisingParameters(parameters).hasError(), "TX power above 20 dBm should be rejected");
+
+	AdvertisingBurstPolicy policy;
+	require(validateAdvertisingBurstPolicy(policy).isSuccess(), "The default burst policy should be valid");
+	policy.burstDurationMs = 0;
+	require(validateAdvertisingBurstPolicy(policy).hasError(), "A zero-length burst should be rejected");
+
+	auto runtimeAdapter = makeRuntimeBluezAdapterPtr();
+	require(runtimeAdapter->triggerAdvertisingBurst().hasError(), "Triggering a burst without a policy should fail");
+
+	policy = AdvertisingBurstPolicy{};
+	require(runtimeAdapter->setAdvertisingBurstPolicy(policy).isSuccess(), "Setting a valid burst policy should succeed");
+	require(runtimeAdapter->getAdvertisingParameters().minIntervalMs == policy.relaxedMinIntervalMs,
+		"An idle burst policy should start on the relaxed interval");
+
+	require(runtimeAdapter->triggerAdvertisingBurst().isSuccess(), "Triggering a configured burst should succeed");
+	require(runtimeAdapter->isAdvertisingBurstActive(), "Triggering a burst should arm the relax timer");
+	require(runtimeAdapter->getAdvertisingParameters().maxIntervalMs == policy.burstMaxIntervalMs,
+		"A running burst should use the fast interval");
+
+	AdvertisingParameters explicitParameters;
+	explicitParameters.minIntervalMs = 500;
+	explicitParameters.maxIntervalMs = 500;
+	require(runtimeAdapter->setAdvertisingParameters(explicitParameters).isSuccess(), "Explicit parameters should be accepted");
+	require(!runtimeAdapter->isAdvertisingBurstActive(), "Explicit intervals should cancel a running burst");
+
+	runtimeAdapter->clearAdvertisingBurstPolicy();
+	require(runtimeAdapter->getAdvertisingParameters().minIntervalMs == 0,
+		"Clearing the burst policy should return the interval choice to the controller");
+
+	require(bzpSetAdvertisingParametersEx(nullptr) == BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT,
+		"C API should reject null advertising parameters");
+	require(bzpSetAdvertisingBurstPolicyEx(20, 30, 1000, 1200, 0) == BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT,
+		"C API should reject a zero-length burst");
+	require(bzpTriggerAdvertisingBurstEx() == BZP_ADVERTISING_CONTROL_NOT_RUNNING,
+		"C API should report not-running before startup");
+}
+
+void testResumeRestoreTracker()
+{
+	using Clock = ResumeRestoreTracker::Clock;
+	const auto resumedAt = Clock::now();
+	int completions = 0;
+	bzp::ResumeReport delivered;
+	ResumeRestoreTracker tracker(resumedAt, [&](const bzp::ResumeReport& report) {
+		++completions;
+		delivered = report;
+	});
+
+	// All restore calls go out before any reply arrives
+	tracker.begin();
+	tracker.begin();
+	tracker.begin();
+	tracker.seal(resumedAt);
+	require(completions == 0, "The report should wait for every outstanding restore call");
+
+	tracker.finish("RegisterAdvertisement", bzp::BluezResult<void>(), true, resumedAt + std::chrono::milliseconds(40));
+	tracker.finish("Set Pairable", bzp::BluezResult<void>(bzp::BluezError::Failed, "busy"), false,
+		resumedAt + std::chrono::milliseconds(55));
+	require(completions == 0, "One outstanding call should still hold the report back");
+	tracker.finish("Set Powered", bzp::BluezResult<void>(), false, resumedAt + std::chrono::milliseconds(70));
+
+	require(completions == 1, "The report should be delivered once the last call settles");
+	require(delivered.restoreCalls == 3 && delivered.failedCalls == 1, "The report should count issued and failed calls");
+	require(delivered.advertisingRestored && delivered.timeToAdvertiseMs == 40,
+		"Time-to-advertise should be measured when the primary advertisement is accepted, not when the batch finishes");
+	require(delivered.totalMs == 70, "The total should cover the slowest restore call");
+	require(delivered.firstError == "Set Pairable: busy", "The first failure should be named in the report");
+
+	tracker.finish("Set Powered", bzp::BluezResult<void>(), false, resumedAt + std::chrono::milliseconds(90));
+	tracker.seal(resumedAt + std::chrono::milliseconds(90));
+	require(completions == 1, "Late or duplicate replies should not deliver a second report");
+
+	int emptyCompletions = 0;
+	ResumeRestoreTracker empty(resumedAt, [&](const bzp::ResumeReport& report) {
+		++emptyCompletions;
+		require(report.restoreCalls == 0 && report.timeToAdvertiseMs == -1 && !report.advertisingRestored,
+			"Resuming without a snapshot should report that nothing was restored");
+	});
+	empty.seal(resumedAt);
+	require(emptyCompletions == 1 && empty.completed(), "Sealing with nothing outstanding should complete immediately");
+}
+
+void testAdvertisingSetRotation()
+{
+	// Equal priorities alternate evenly across two free instances
+	std::vector<int64_t> credits;
+	std::vector<int> onAir(4, 0);
+	for (int slice = 0; slice < 8; ++slice)
+	{
+		const auto selected = selectAdvertisingRotationSlice({1, 1, 1, 1}, credits, 2);
+		require(selected.size() == 2, "Each slice should fill every free instance");
+		for (auto index : selected)
+		{
+			++onAir[index];
+		}
+	}
+	require(onAir == std::vector<int>({4, 4, 4, 4}), "Equal priorities should share airtime evenly");
+
+	// Priorities 1:1:2 on a single instance give a 25/25/50 split
+	credits.clear();
+	onAir.assign(3, 0);
+	for (int slice = 0; slice < 8; ++slice)
+	{
+		const auto selected = selectAdvertisingRotationSlice({1, 1, 2}, credits, 1);
+		require(selected.size() == 1, "A single free instance should carry one set per slice");
+		++onAir[selected.front()];
+	}
+	require(onAir == std::vector<int>({2, 2, 4}), "Airtime should follow set priorities");
+
+	credits.clear();
+	require(selectAdvertisingRotationSlice({1, 5}, credits, 3).size() == 2, "Sets that fit the free instances should all stay on air");
+	require(selectAdvertisingRotationSlice({1, 1}, credits, 0).empty(), "No sets go on air without a free instance");
+
+	BluezCapabilities legacyCapabilities;
+	AdvertisingSetConfig beacon;
+	beacon.name = "beacon";
+	beacon.data.serviceData["0000feaa-0000-1000-8000-00805f9b34fb"] = {0x10, 0x00};
+	auto normalized = normalizeAdvertisingSetConfig(beacon, legacyCapabilities);
+	require(normalized.isSuccess(), "A small broadcast set should be accepted");
+	require(normalized.value().data.serviceData.count("feaa") == 1, "Advertising set service data keys should be normalized");
+
+	beacon.type = "beacon";
+	require(normalizeAdvertisingSetConfig(beacon, legacyCapabilities).hasError(), "Unknown advertisement types should be rejected");
+	beacon.type = "broadcast";
+	beacon.data.manufacturerData[0xFFFF] = std::vector<uint8_t>(40, 0xAB);
+	require(normalizeAdvertisingSetConfig(beacon, legacyCapabilities).hasError(), "Oversized set payloads should be rejected");
+
+	auto runtimeAdapter = makeRuntimeBluezAdapterPtr();
+	AdvertisingSetConfig telemetry;
+	telemetry.name = "telemetry";
+	require(runtimeAdapter->setAdvertisingSet(telemetry).isSuccess(), "Adding an advertising set before initialization should succeed");
+	telemetry.priority = 3;
+	require(runtimeAdapter->setAdvertisingSet(telemetry).isSuccess(), "Updating an advertising set by name should succeed");
+	require(runtimeAdapter->getAdvertisingSetNames() == std::vector<std::string>({"telemetry"}), "Updates should not duplicate sets");
+	require(runtimeAdapter->getOnAirAdvertisingSets().empty(), "Sets should stay off air until the adapter is initialized");
+	require(!runtimeAdapter->isAdvertisingRotationActive(), "Rotation should not run before initialization");
+	require(runtimeAdapter->setAdvertisingRotationSlice(100).hasError(), "Very short rotation slices should be rejected");
+	require(runtimeAdapter->removeAdvertisingSet("telemetry").isSuccess(), "Removing an existing set should succeed");
+	require(runtimeAdapter->removeAdvertisingSet("telemetry").error() == bzp::BluezError::NotFound, "Removing a missing set should report NotFound");
+	require(runtimeAdapter->getAdvertisingSetNames().empty(), "Removed sets should no longer be listed");
+	require(runtimeAdapter->setAdvertisingSet(telemetry).isSuccess(), "A removed set should be accepted again");
+	runtimeAdapter->shutdown();
+	require(runtimeAdapter->getAdvertisingSetNames().empty(), "Shutdown should drop the advertising sets");
+
+	BZPAdvertisingSet set{};
+	require(bzpSetAdvertisingSetEx(&set) == BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT, "C API should reject unnamed advertising sets");
+	set.pName = "beacon";
+	require(bzpSetAdvertisingSetEx(&set) == BZP_ADVERTISING_CONTROL_NOT_RUNNING, "C API should report not-running before startup");
+	require(bzpSetAdvertisingRotationSliceEx(0) == BZP_ADVERTISING_CONTROL_INVALID_ARGUMENT, "C API should reject a zero rotation slice");
 }
 
 void testManagedObjectsPayloadBuilder()
@@ -1480,6 +1916,835 @@ void testRunLoopPollApi()
 		"bzpRunLoopDriveUntilShutdown should still clean up after hidden poll API use");
 }
 
+void testRunLoopEventFD()
+{
+	struct RestoreState
+	{
+		std::shared_ptr<Server> activeServer = getActiveServer();
+		BZPServerRunState runState = bzpGetServerRunState();
+		BZPServerHealth health = bzpGetServerHealth();
+
+		~RestoreState()
+		{
+			if (bzpGetServerRunState() != EStopped && bzpGetServerRunState() != EUninitialized)
+			{
+				bzpTriggerShutdown();
+				bzpRunLoopDriveUntilShutdown(kShutdownDriveTimeoutMS);
+			}
+
+			setActiveServer(activeServer);
+			bzp::setServerHealth(health);
+			bzp::setServerRunState(runState);
+		}
+	} restore;
+
+	int fd = 0;
+	require(bzpRunLoopGetFDEx(&fd) == BZP_RUN_LOOP_NOT_MANUAL_MODE && fd == -1,
+		"bzpRunLoopGetFDEx should report NOT_MANUAL_MODE before manual startup");
+	require(bzpRunLoopDispatchPending(1) == -1,
+		"bzpRunLoopDispatchPending should fail before manual startup");
+	require(bzpStartManual("bzperi.tests.manual-eventfd", "", "", &nullGetter, &acceptingSetter) != 0,
+		"bzpStartManual should initialize the run loop before event-fd testing");
+	require(bzpRunLoopDispatchPendingEx(0, nullptr) == BZP_RUN_LOOP_INVALID_ARGUMENT,
+		"bzpRunLoopDispatchPendingEx should reject a non-positive budget");
+
+	fd = bzpRunLoopGetFD();
+	require(fd >= 0, "bzpRunLoopGetFD should return a descriptor after manual startup");
+	require(bzpRunLoopIsCurrentThreadOwner() != 0,
+		"bzpRunLoopGetFD should bind the manual run loop to the calling thread");
+	require(bzpRunLoopGetFD() == fd, "bzpRunLoopGetFD should keep returning the same descriptor");
+
+	auto waitReadable = [fd](int timeoutMS) {
+		pollfd pfd{fd, POLLIN, 0};
+		return poll(&pfd, 1, timeoutMS) == 1 && (pfd.revents & POLLIN) != 0;
+	};
+
+	// Drain startup work so the invoke below is what makes the descriptor readable
+	for (int attempt = 0; attempt < 100 && waitReadable(0); ++attempt)
+	{
+		bzpRunLoopDispatchPending(16);
+	}
+
+	RunLoopInvokeState state;
+	require(bzpRunLoopInvoke(&runLoopInvokeHandler, &state) != 0,
+		"bzpRunLoopInvoke should queue work on the manual run loop");
+	require(waitReadable(1000), "The run-loop descriptor should become readable when work is queued");
+	require(!state.called, "Queued work should wait for bzpRunLoopDispatchPending");
+	for (int attempt = 0; attempt < 100 && !state.called; ++attempt)
+	{
+		if (waitReadable(10))
+		{
+			require(bzpRunLoopDispatchPending(8) >= 0, "bzpRunLoopDispatchPending should succeed while work is pending");
+		}
+	}
+	require(state.called, "bzpRunLoopDispatchPending should dispatch the queued callback");
+	require(state.callbackThread == std::this_thread::get_id(),
+		"Event-fd dispatch should run callbacks on the owner thread");
+
+	RunLoopInvokeState crossThread;
+	std::thread producer([&crossThread] {
+		bzpRunLoopInvoke(&runLoopInvokeHandler, &crossThread);
+	});
+	producer.join();
+	for (int attempt = 0; attempt < 100 && !crossThread.called; ++attempt)
+	{
+		if (waitReadable(10))
+		{
+			bzpRunLoopDispatchPending(8);
+		}
+	}
+	require(crossThread.called, "Work queued from another thread should wake the run-loop descriptor");
+
+	bzpTriggerShutdown();
+	for (int attempt = 0; attempt < 1000 && bzpGetServerRunState() != EStopped; ++attempt)
+	{
+		waitReadable(10);
+		bzpRunLoopDispatchPending(16);
+	}
+	require(bzpGetServerRunState() == EStopped, "Shutdown should complete when driven through the run-loop descriptor");
+	require(bzpRunLoopGetFDEx(&fd) == BZP_RUN_LOOP_NOT_MANUAL_MODE,
+		"The run-loop descriptor should be released once the manual loop has stopped");
+}
+
+void testRunLoopTimerWheel()
+{
+	GMainContext *context = g_main_context_new();
+	auto queryTimeout = [context]() {
+		gint maxPriority = 0;
+		gint timeoutMS = 0;
+		require(g_main_context_acquire(context), "The test context should be acquirable");
+		g_main_context_prepare(context, &maxPriority);
+		g_main_context_query(context, maxPriority, &timeoutMS, nullptr, 0);
+		g_main_context_release(context);
+		return timeoutMS;
+	};
+
+	struct FireLog
+	{
+		std::vector<int> order;
+		int repeats = 0;
+		guint selfRemovingId = 0;
+	} log;
+	struct Tagged
+	{
+		FireLog *log;
+		int tag;
+	};
+	Tagged first{&log, 1};
+	Tagged second{&log, 2};
+	Tagged third{&log, 3};
+	auto recordFire = [](gpointer data) -> gboolean {
+		auto *tagged = static_cast<Tagged *>(data);
+		tagged->log->order.push_back(tagged->tag);
+		return G_SOURCE_REMOVE;
+	};
+
+	require(bzp::runLoopTimerNextDeadline(context) == -1, "A context without timers should have no deadline");
+	require(bzp::addRunLoopTimer(context, 30, recordFire, &third) != 0, "Timers should be armed on the shared source");
+	require(bzp::addRunLoopTimer(context, 10, recordFire, &first) != 0, "Timers should be armed on the shared source");
+	require(bzp::addRunLoopTimer(context, 20, recordFire, &second) != 0, "Timers should be armed on the shared source");
+	const guint cancelled = bzp::addRunLoopTimer(context, 15, recordFire, &third);
+	require(bzp::runLoopTimerCount(context) == 4, "All armed timers should be tracked");
+	require(bzp::removeRunLoopTimer(cancelled), "A pending timer should be removable");
+	require(!bzp::removeRunLoopTimer(cancelled), "Removing a timer twice should report that it is gone");
+	const int armedTimeout = queryTimeout();
+	require(armedTimeout >= 0 && armedTimeout <= 10, "The context timeout should follow the earliest deadline only");
+
+	for (int attempt = 0; attempt < 200 && log.order.size() < 3; ++attempt)
+	{
+		g_main_context_iteration(context, TRUE);
+	}
+	require(log.order == std::vector<int>({1, 2, 3}), "Timers should fire in deadline order");
+	require(bzp::runLoopTimerCount(context) == 0, "One-shot timers should be released after firing");
+	require(bzp::runLoopTimerNextDeadline(context) == -1 && queryTimeout() == -1,
+		"With no pending deadline the shared source should not wake the context at all");
+
+	const uint64_t idleWakeups = bzp::runLoopTimerWakeups(context);
+	for (int iteration = 0; iteration < 20; ++iteration)
+	{
+		g_main_context_iteration(context, FALSE);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	require(bzp::runLoopTimerWakeups(context) == idleWakeups, "An idle timer wheel should produce no wakeups");
+
+	auto repeatThenStop = [](gpointer data) -> gboolean {
+		auto *fireLog = static_cast<FireLog *>(data);
+		return ++fireLog->repeats < 3 ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+	};
+	auto removeSelf = [](gpointer data) -> gboolean {
+		auto *fireLog = static_cast<FireLog *>(data);
+		bzp::removeRunLoopTimer(fireLog->selfRemovingId);
+		fireLog->order.push_back(99);
+		return G_SOURCE_CONTINUE;
+	};
+	require(bzp::addRunLoopTimer(context, 1, repeatThenStop, &log) != 0, "Repeating timers should be accepted");
+	log.selfRemovingId = bzp::addRunLoopTimer(context, 1, removeSelf, &log);
+	for (int attempt = 0; attempt < 200 && (log.repeats < 3 || bzp::runLoopTimerCount(context) != 0); ++attempt)
+	{
+		g_main_context_iteration(context, TRUE);
+	}
+	require(log.repeats == 3, "A timer returning G_SOURCE_CONTINUE should re-arm until it returns G_SOURCE_REMOVE");
+	require(std::count(log.order.begin(), log.order.end(), 99) == 1,
+		"A timer removed from its own callback should not re-arm even when it asks to continue");
+
+	require(bzp::addRunLoopTimerSeconds(context, 60, recordFire, &first) != 0, "Second-granularity timers should be accepted");
+	require(bzp::runLoopTimerNextDeadline(context) % 1000000 == 0, "Second-granularity deadlines should align to whole seconds");
+	g_main_context_unref(context);
+	require(bzp::runLoopTimerCount(context) == 0, "Destroying a context should release its timers");
+}
+
+// A server with one GATT service ("svc") for driving characteristic handlers without a bus
+struct CharacteristicHarness
+{
+	Server server;
+
+	CharacteristicHarness(const char *serviceName, const std::function<void(GattService &)> &configure)
+	: server(serviceName, "", "", &nullGetter, &acceptingSetter)
+	{
+		server.configure([&](DBusObject &root) { configure(root.gattServiceBegin("svc", GattUuid("1234"))); });
+	}
+
+	std::shared_ptr<const GattCharacteristic> find(const DBusObjectPath &path) const
+	{
+		auto characteristic = std::dynamic_pointer_cast<const GattCharacteristic>(server.findInterface(path, "org.bluez.GattCharacteristic1"));
+		require(characteristic != nullptr, "Configured characteristics should be discoverable");
+		return characteristic;
+	}
+
+	// Calls a method without arguments the way BlueZ would; returns whether a handler took it
+	bool call(const DBusObjectPath &path, const char *methodName) const
+	{
+		GVariant *parameters = g_variant_ref_sink(g_variant_new("()"));
+		const bool handled = server.callMethod(path, "org.bluez.GattCharacteristic1", methodName,
+			DBusMethodCallRef(DBusConnectionRef(), DBusVariantRef(parameters), DBusMethodInvocationRef(), nullptr));
+		g_variant_unref(parameters);
+		return handled;
+	}
+};
+
+void testPeriodicPublisher()
+{
+	GMainContext *context = g_main_context_new();
+	g_main_context_push_thread_default(context);
+
+	struct ProducerState
+	{
+		std::vector<int> values{10, 10, 12, 20, 20, 20};
+		std::size_t calls = 0;
+	} producerState;
+
+	DBusObjectPath characteristicPath;
+	CharacteristicHarness harness("bzperi.tests.publisher", [&](GattService &service) {
+		GattCharacteristic &characteristic = service.gattCharacteristicBegin("level", GattUuid("2a19"), {"read", "notify"});
+		characteristicPath = characteristic.getPath();
+		characteristic.publishEvery(std::chrono::milliseconds(5), [&producerState]() -> uint8_t {
+			const int value = producerState.values[std::min(producerState.calls, producerState.values.size() - 1)];
+			producerState.calls += 1;
+			return static_cast<uint8_t>(value);
+		}, {.deadband = 5.0});
+	});
+
+	auto characteristic = harness.find(characteristicPath);
+	auto notify = [&](const char *methodName) {
+		require(harness.call(characteristicPath, methodName), "publishEvery() should answer StartNotify and StopNotify");
+	};
+	auto runUntilSamples = [&](uint64_t samples) {
+		for (int attempt = 0; attempt < 500 && characteristic->publishStats().samples < samples; ++attempt)
+		{
+			g_main_context_iteration(context, TRUE);
+		}
+	};
+
+	for (int iteration = 0; iteration < 5; ++iteration)
+	{
+		g_main_context_iteration(context, FALSE);
+	}
+	require(bzp::runLoopTimerCount(context) == 0 && producerState.calls == 0,
+		"Without a subscriber the publisher should neither arm a timer nor sample");
+
+	notify("StartNotify");
+	require(characteristic->publishStats().subscribed, "StartNotify should subscribe the publisher");
+	require(bzp::runLoopTimerCount(context) == 1, "A subscribed publisher should arm one shared-wheel timer");
+	require(bzp::runLoopTimerNextDeadline(context) % 5000 == 0, "Publisher deadlines should sit on the fixed-rate grid");
+
+	runUntilSamples(5);
+	bzp::PublishStats stats = characteristic->publishStats();
+	require(stats.samples == 5, "The publisher should sample once per period while subscribed");
+	require(stats.published == 2, "Only the first sample and the one beyond the deadband should be sent");
+	require(stats.suppressed == 3, "Unchanged samples and samples inside the deadband should be suppressed");
+
+	notify("StopNotify");
+	require(!characteristic->publishStats().subscribed && bzp::runLoopTimerCount(context) == 0,
+		"StopNotify should remove the publisher's timer");
+	const std::size_t callsAfterStop = producerState.calls;
+	for (int iteration = 0; iteration < 5; ++iteration)
+	{
+		g_main_context_iteration(context, FALSE);
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+	require(producerState.calls == callsAfterStop, "An unsubscribed publisher should not call its producer");
+
+	notify("StartNotify");
+	runUntilSamples(6);
+	stats = characteristic->publishStats();
+	require(stats.published == 3, "The first sample after a new subscription should be sent even when unchanged");
+
+	g_main_context_pop_thread_default(context);
+	g_main_context_unref(context);
+}
+
+void testIndicationFlowControl()
+{
+	GMainContext *context = g_main_context_new();
+	g_main_context_push_thread_default(context);
+
+	DBusObjectPath queuedPath;
+	DBusObjectPath coalescedPath;
+	CharacteristicHarness harness("bzperi.tests.indications", [&](GattService &service) {
+		GattCharacteristic &queued = service.gattCharacteristicBegin("queued", GattUuid("2a05"), {"indicate"});
+		queuedPath = queued.getPath();
+		queued.enableIndications({.maxQueued = 2, .timeout = std::chrono::milliseconds(20)});
+
+		GattCharacteristic &coalesced = service.gattCharacteristicBegin("coalesced", GattUuid("2a06"), {"indicate"});
+		coalescedPath = coalesced.getPath();
+		coalesced.enableIndications({.coalesce = true});
+	});
+
+	auto confirm = [&](const DBusObjectPath &path) {
+		require(harness.call(path, "Confirm"), "enableIndications() should answer Confirm");
+	};
+
+	std::vector<std::pair<int, IndicationResult>> results;
+	auto record = [&results](int tag) {
+		return [&results, tag](IndicationResult result) { results.emplace_back(tag, result); };
+	};
+
+	auto queued = harness.find(queuedPath);
+	require(queued->indicationsEnabled(), "enableIndications() should enable the queue");
+	require(queued->indicateValue(DBusConnectionRef(), uint8_t(1), record(1)), "The first indication should go out right away");
+	require(queued->indicateValue(DBusConnectionRef(), uint8_t(2), record(2)), "Indications should queue behind the one in flight");
+	require(queued->indicateValue(DBusConnectionRef(), uint8_t(3), record(3)), "Indications should queue up to maxQueued");
+	require(!queued->indicateValue(DBusConnectionRef(), uint8_t(4), record(4)), "A full queue should refuse further indications");
+	IndicationStats stats = queued->indicationStats();
+	require(stats.sent == 1 && stats.inFlight && stats.queued == 2 && stats.rejected == 1,
+		"Only one indication should be in flight while the rest wait");
+
+	confirm(queuedPath);
+	require(results == std::vector<std::pair<int, IndicationResult>>({{1, IndicationResult::Confirmed}}),
+		"Confirm should complete the indication in flight");
+	require(queued->indicationStats().sent == 2 && queued->indicationStats().queued == 1, "Confirm should release the next indication");
+	confirm(queuedPath);
+	require(results.size() == 2 && results[1] == std::make_pair(2, IndicationResult::Confirmed), "Indications should complete in order");
+
+	for (int attempt = 0; attempt < 200 && results.size() < 3; ++attempt)
+	{
+		g_main_context_iteration(context, TRUE);
+	}
+	require(results.size() == 3 && results[2] == std::make_pair(3, IndicationResult::TimedOut),
+		"An unconfirmed indication should time out");
+	confirm(queuedPath);
+	stats = queued->indicationStats();
+	require(results.size() == 3 && stats.confirmed == 2 && stats.timedOut == 1 && stats.strayConfirms == 1 && !stats.inFlight,
+		"A Confirm with nothing in flight should be ignored and counted");
+	require(bzp::runLoopTimerCount(context) == 0, "No timeout should stay armed once the queue drains");
+
+	results.clear();
+	auto coalesced = harness.find(coalescedPath);
+	require(coalesced->indicateValue(DBusConnectionRef(), std::string("a"), record(1)), "Coalescing queues still send right away");
+	require(coalesced->indicateValue(DBusConnectionRef(), std::string("b"), record(2)), "Coalescing queues should accept a waiting value");
+	require(coalesced->indicateValue(DBusConnectionRef(), std::string("c"), record(3)), "Coalescing queues should accept newer values");
+	require(results == std::vector<std::pair<int, IndicationResult>>({{2, IndicationResult::Superseded}}),
+		"A newer value should supersede the one waiting");
+	require(coalesced->indicationStats().queued == 1, "A coalescing queue should hold only the newest waiting value");
+	confirm(coalescedPath);
+	confirm(coalescedPath);
+	require(results.size() == 3 && results[1] == std::make_pair(1, IndicationResult::Confirmed)
+		&& results[2] == std::make_pair(3, IndicationResult::Confirmed), "The newest value should follow the one in flight");
+
+	g_main_context_pop_thread_default(context);
+	g_main_context_unref(context);
+}
+
+void testAcquiredNotifyBudgets()
+{
+	GMainContext *context = g_main_context_new();
+	g_main_context_push_thread_default(context);
+	{
+		bzp::AcquiredNotifier notifier("/com/example/svc/stream", {.bytesPerSecond = 1000, .burstBytes = 100, .maxQueued = 4});
+		std::vector<bool> states;
+		notifier.setStateCallback([&states](bool acquired) { states.push_back(acquired); });
+
+		const std::vector<std::uint8_t> packet(50, 0xab);
+		require(!notifier.enqueue(packet) && notifier.stats().refused == 1,
+			"Notifications should be refused while no device is subscribed");
+
+		const int socket = notifier.acquire(53);
+		require(socket >= 0 && notifier.acquired() && states == std::vector<bool>{true},
+			"AcquireNotify should hand out a socket and report the acquired state");
+
+		auto drain = [](int fd) {
+			std::size_t packets = 0;
+			std::array<std::uint8_t, 512> buffer{};
+			while (recv(fd, buffer.data(), buffer.size(), MSG_DONTWAIT) > 0)
+			{
+				packets += 1;
+			}
+			return packets;
+		};
+
+		for (int index = 0; index < 3; ++index)
+		{
+			require(notifier.enqueue(packet), "Notifications should be queued while a socket is acquired");
+		}
+		require(drain(socket) == 2, "Only the burst should go out at once");
+		require(notifier.stats().queued == 1 && bzp::runLoopTimerCount(context) == 1,
+			"Notifications over budget should wait on a refill timer");
+
+		notifier.service(g_get_monotonic_time() + 50000);
+		require(drain(socket) == 1, "The bucket should refill at the configured byte rate");
+
+		const std::vector<std::uint8_t> large(100, 0x01);
+		require(!notifier.enqueue(large) && notifier.stats().oversized == 1, "Notifications beyond the MTU should be refused");
+		for (int index = 0; index < 6; ++index)
+		{
+			notifier.enqueue(packet);
+		}
+		bzp::AcquiredNotifyStats stats = notifier.stats();
+		require(stats.queued == 4 && stats.dropped == 2 && stats.sent == 3, "A full queue should drop its oldest notifications");
+
+		notifier.setBudget(0, 0);
+		notifier.service(g_get_monotonic_time());
+		require(drain(socket) == 4 && notifier.stats().queued == 0, "An unlimited budget should send the backlog right away");
+
+		close(socket);
+		for (int attempt = 0; attempt < 100 && notifier.acquired(); ++attempt)
+		{
+			g_main_context_iteration(context, TRUE);
+		}
+		require(!notifier.acquired() && states == std::vector<bool>({true, false}),
+			"The socket should be released once BlueZ closes its end");
+
+		const int again = notifier.acquire(0);
+		stats = notifier.stats();
+		require(again >= 0 && stats.acquisitions == 2 && stats.mtu == 23, "BlueZ should be able to acquire again later");
+		require(notifier.enqueue(std::vector<std::uint8_t>(20, 0x02)) && drain(again) == 1,
+			"The new socket should carry notifications up to the default MTU");
+		close(again);
+	}
+	require(bzp::runLoopTimerCount(context) == 0, "Destroying the notifier should cancel its timers");
+	g_main_context_pop_thread_default(context);
+	g_main_context_unref(context);
+}
+
+void testAcquiredNotifyExcludesPublishEvery()
+{
+	DBusObjectPath publishedPath;
+	DBusObjectPath acquiredPath;
+	CharacteristicHarness harness("bzperi.tests.acquired", [&](GattService &service) {
+		GattCharacteristic &published = service.gattCharacteristicBegin("published", GattUuid("2a19"), {"notify"});
+		publishedPath = published.getPath();
+		published.publishEvery(std::chrono::seconds(1), []() -> uint8_t { return 1; });
+		published.enableAcquiredNotify();
+
+		GattCharacteristic &acquired = service.gattCharacteristicBegin("acquired", GattUuid("2a1a"), {"notify"});
+		acquiredPath = acquired.getPath();
+		acquired.enableAcquiredNotify();
+		acquired.publishEvery(std::chrono::seconds(1), []() -> uint8_t { return 1; });
+	});
+
+	auto notifyAcquired = [](const GattCharacteristic &characteristic) -> const GattProperty * {
+		for (const GattProperty &property : characteristic.getProperties())
+		{
+			if (property.getName() == "NotifyAcquired")
+			{
+				return &property;
+			}
+		}
+		return nullptr;
+	};
+
+	auto published = harness.find(publishedPath);
+	require(notifyAcquired(*published) == nullptr, "enableAcquiredNotify() should refuse a characteristic that publishes");
+	auto acquired = harness.find(acquiredPath);
+	const GattProperty *pNotifyAcquired = notifyAcquired(*acquired);
+	require(pNotifyAcquired != nullptr && !g_variant_get_boolean(pNotifyAcquired->getValueRef().get()),
+		"enableAcquiredNotify() should publish NotifyAcquired as false until BlueZ acquires");
+
+	require(!harness.call(acquiredPath, "StartNotify"), "publishEvery() should refuse a characteristic that notifies through AcquireNotify");
+	require(!acquired->notifyAcquired(std::vector<std::uint8_t>{1}), "Nothing should be sent before BlueZ acquires");
+
+	LoopbackTransport loopback(harness.server);
+	const LoopbackReply &reply = loopback.callMethod(acquiredPath.c_str(), "org.bluez.GattCharacteristic1", "AcquireNotify",
+		g_variant_new("(a{sv})", nullptr));
+	require(reply.hasError() && reply.errorName() == "org.bluez.Error.NotSupported",
+		"AcquireNotify over loopback should answer NotSupported");
+	require(acquired->acquiredNotifyStats().acquisitions == 0 && !g_variant_get_boolean(pNotifyAcquired->getValueRef().get()),
+		"AcquireNotify over loopback should not acquire a socket");
+}
+
+GVariant *makePropertiesChanged(const char *interfaceName, const char *key, GVariant *value)
+{
+	GVariantBuilder changed;
+	g_variant_builder_init(&changed, G_VARIANT_TYPE("a{sv}"));
+	g_variant_builder_add(&changed, "{sv}", key, value);
+	GVariantBuilder invalidated;
+	g_variant_builder_init(&invalidated, G_VARIANT_TYPE("as"));
+	return g_variant_ref_sink(g_variant_new("(sa{sv}as)", interfaceName, &changed, &invalidated));
+}
+
+void testBluezSignalFilter()
+{
+	require(bzp::detail::devicePropertiesMatchRule("/org/bluez/hci0") ==
+		"type='signal',sender='org.bluez',interface='org.freedesktop.DBus.Properties',member='PropertiesChanged',"
+		"arg0='org.bluez.Device1',path_namespace='/org/bluez/hci0'",
+		"Device property match rule should be scoped to the adapter's path namespace");
+	require(bzp::detail::devicePropertiesMatchRule("").find("path_namespace") == std::string::npos,
+		"Match rule without an adapter should not restrict the path");
+
+	require(bzp::detail::isAdapterObjectPath("/org/bluez/hci0", "/org/bluez/hci0"), "Adapter object should be on the adapter");
+	require(bzp::detail::isAdapterObjectPath("/org/bluez/hci0/dev_00_11_22_33_44_55", "/org/bluez/hci0"),
+		"Device below the adapter should be accepted");
+	require(!bzp::detail::isAdapterObjectPath("/org/bluez/hci1/dev_00_11_22_33_44_55", "/org/bluez/hci0"),
+		"Device of another adapter should be rejected");
+	require(!bzp::detail::isAdapterObjectPath("/org/bluez/hci01", "/org/bluez/hci0"),
+		"Adapter with a longer name should not match by prefix");
+	require(bzp::detail::isAdapterObjectPath("/org/bluez/hci1", ""), "No selected adapter should accept every object");
+
+	GVariant *connected = makePropertiesChanged("org.bluez.Device1", "Connected", g_variant_new_boolean(TRUE));
+	GVariant *rssi = makePropertiesChanged("org.bluez.Device1", "RSSI", g_variant_new_int16(-60));
+	GVariant *lookalike = makePropertiesChanged("org.bluez.Device1", "ConnectedSince", g_variant_new_uint32(5));
+	require(bzp::detail::mayChangeConnected(connected), "Connected change should pass the fast path");
+	require(!bzp::detail::mayChangeConnected(rssi), "RSSI change should be rejected without unpacking");
+	require(!bzp::detail::mayChangeConnected(lookalike), "Longer keys starting with Connected should be rejected");
+	GVariant *invalidated = g_variant_ref_sink(g_variant_new_parsed(
+		"('org.bluez.Device1', @a{sv} {'RSSI': <int16 -60>}, ['Connected'])"));
+	require(bzp::detail::mayChangeConnected(invalidated), "An invalidated Connected property should pass the fast path");
+	g_variant_unref(invalidated);
+	g_variant_unref(connected);
+	g_variant_unref(rssi);
+	g_variant_unref(lookalike);
+
+	BZPBluezSignalStats stats{};
+	require(bzpGetBluezSignalStats(nullptr) == BZP_QUERY_INVALID_ARGUMENT, "Signal stats should reject a null pointer");
+	require(bzpGetBluezSignalStats(&stats) == BZP_QUERY_FAILED, "Signal stats should need a running server");
+}
+
+void testUpdateQueuePriorityLanes()
+{
+	using namespace std::chrono_literals;
+	bzp::resetUpdateQueue();
+	const auto t0 = std::chrono::steady_clock::now();
+	constexpr std::size_t kAnyLength = std::numeric_limits<std::size_t>::max();
+	const auto popPath = [](std::chrono::steady_clock::time_point now) {
+		std::string entry;
+		require(bzp::popUpdate(entry, false, kAnyLength, now) == BZP_UPDATE_QUEUE_OK, "Update queue should have an entry to pop");
+		return entry.substr(0, entry.find('|'));
+	};
+
+	bzp::setUpdatePriority("/alarm", BZP_UPDATE_PRIORITY_CRITICAL);
+	bzp::setUpdatePriority("/log", BZP_UPDATE_PRIORITY_BULK);
+	require(bzp::updatePriority("/alarm") == BZP_UPDATE_PRIORITY_CRITICAL && bzp::updatePriority("/other") == BZP_UPDATE_PRIORITY_NORMAL,
+		"Unregistered paths should default to the normal lane");
+
+	// Strict: the alarm overtakes everything queued before it, each lane stays FIFO
+	for (int index = 0; index < 3; ++index)
+	{
+		bzp::pushUpdate("/log", "org.bluez.GattCharacteristic1", t0);
+	}
+	bzp::pushUpdate("/telemetry", "org.bluez.GattCharacteristic1", t0);
+	bzp::pushUpdate("/alarm", "org.bluez.GattCharacteristic1", t0 + 1ms);
+	std::string peeked;
+	require(bzp::popUpdate(peeked, true, kAnyLength, t0 + 1ms) == BZP_UPDATE_QUEUE_OK && peeked == "/alarm|org.bluez.GattCharacteristic1",
+		"Peeking should show the critical entry first");
+	std::string tooLong;
+	require(bzp::popUpdate(tooLong, false, peeked.size(), t0 + 1ms) == BZP_UPDATE_QUEUE_BUFFER_TOO_SMALL && tooLong.empty()
+		&& bzp::updateQueueSize() == 5, "An entry that does not fit the caller's buffer should stay queued");
+	char shortBuffer[8] = {};
+	require(bzpPopUpdateQueueEx(shortBuffer, sizeof(shortBuffer), 0) == BZP_UPDATE_QUEUE_BUFFER_TOO_SMALL && bzp::updateQueueSize() == 5,
+		"bzpPopUpdateQueueEx should leave an entry that does not fit queued");
+	require(popPath(t0 + 1ms) == "/alarm", "A pop after a peek should return the peeked entry");
+	require(popPath(t0 + 1ms) == "/telemetry", "Normal entries should go before bulk ones");
+	require(popPath(t0 + 1ms) == "/log" && bzp::updateQueueSize() == 2, "Bulk entries should drain last");
+	bzp::clearUpdateQueue();
+
+	// Starvation guard: overdue bulk entries get every other slot, never two in a row
+	bzp::pushUpdate("/log", "org.bluez.GattCharacteristic1", t0);
+	bzp::pushUpdate("/log", "org.bluez.GattCharacteristic1", t0);
+	bzp::pushUpdate("/alarm", "org.bluez.GattCharacteristic1", t0 + 600ms);
+	bzp::pushUpdate("/alarm", "org.bluez.GattCharacteristic1", t0 + 600ms);
+	const auto later = t0 + 600ms;
+	require(popPath(later) == "/log" && popPath(later) == "/alarm" && popPath(later) == "/log" && popPath(later) == "/alarm",
+		"Overdue bulk entries should alternate with critical ones");
+
+	const BZPUpdateLaneStats bulk = bzp::updateLaneStats(BZP_UPDATE_PRIORITY_BULK);
+	require(bulk.enqueued == 5 && bulk.processed == 3 && bulk.promoted == 2 && bulk.depth == 0,
+		"Bulk lane counters should track enqueues, pops, promotions and depth");
+	require(bulk.maxLatencyUS >= 600000 && bulk.highWatermark == 3, "Bulk lane should record its worst latency and depth");
+
+	// Weighted round-robin: 2 critical, then 1 normal, then 1 bulk per round
+	require(bzp::setUpdateSchedule({BZP_UPDATE_SCHEDULE_WEIGHTED, 2, 1, 1, 0}), "Weighted schedule should be accepted");
+	for (int index = 0; index < 4; ++index)
+	{
+		bzp::pushUpdate("/alarm", "org.bluez.GattCharacteristic1", t0);
+	}
+	for (int index = 0; index < 2; ++index)
+	{
+		bzp::pushUpdate("/telemetry", "org.bluez.GattCharacteristic1", t0);
+		bzp::pushUpdate("/log", "org.bluez.GattCharacteristic1", t0);
+	}
+	std::string order;
+	while (bzp::updateQueueSize() != 0)
+	{
+		order += popPath(t0).substr(1, 1);
+	}
+	require(order == "aatlaatl", "Weighted schedule should serve lanes in proportion to their weights");
+
+	// A full queue makes room from the bulk lane first
+	bzp::pushUpdate("/log", "org.bluez.GattCharacteristic1", t0);
+	for (std::size_t index = 1; index < bzp::kMaxUpdateQueueSize; ++index)
+	{
+		bzp::pushUpdate("/telemetry", "org.bluez.GattCharacteristic1", t0);
+	}
+	bzp::pushUpdate("/alarm", "org.bluez.GattCharacteristic1", t0);
+	require(bzp::updateQueueSize() == bzp::kMaxUpdateQueueSize && bzp::updateLaneStats(BZP_UPDATE_PRIORITY_BULK).dropped == 1
+		&& bzp::updateLaneStats(BZP_UPDATE_PRIORITY_BULK).depth == 0, "A full queue should evict the oldest bulk entry");
+	require(!bzp::pushUpdate("/log", "org.bluez.GattCharacteristic1", t0)
+		&& bzp::updateLaneStats(BZP_UPDATE_PRIORITY_BULK).dropped == 2 && bzp::updateLaneStats(BZP_UPDATE_PRIORITY_BULK).depth == 0
+		&& bzp::updateLaneStats(BZP_UPDATE_PRIORITY_CRITICAL).depth == 1,
+		"A full queue with nothing below the new entry's lane should drop the new entry");
+
+	BZPUpdateLaneStats stats{};
+	require(bzpSetUpdatePriority(nullptr, BZP_UPDATE_PRIORITY_CRITICAL) == 0, "bzpSetUpdatePriority should reject a null path");
+	require(bzpSetUpdateSchedule(nullptr) == 0, "bzpSetUpdateSchedule should reject a null schedule");
+	require(bzpGetUpdateLaneStats(static_cast<BZPUpdatePriority>(3), &stats) == BZP_QUERY_INVALID_ARGUMENT,
+		"bzpGetUpdateLaneStats should reject unknown lanes");
+	require(bzpGetUpdateLaneStats(BZP_UPDATE_PRIORITY_NORMAL, &stats) == BZP_QUERY_OK && stats.depth == bzp::kMaxUpdateQueueSize - 1,
+		"bzpGetUpdateLaneStats should report the lane depth");
+	bzp::resetUpdateQueue();
+
+	// With every path in the normal lane a full queue keeps its newest entries, as the single FIFO did
+	bzp::pushUpdate("/first", "org.bluez.GattCharacteristic1", t0);
+	for (std::size_t index = 1; index < bzp::kMaxUpdateQueueSize; ++index)
+	{
+		bzp::pushUpdate("/telemetry", "org.bluez.GattCharacteristic1", t0);
+	}
+	require(bzp::pushUpdate("/latest", "org.bluez.GattCharacteristic1", t0) && bzp::updateQueueSize() == bzp::kMaxUpdateQueueSize
+		&& bzp::updateLaneStats(BZP_UPDATE_PRIORITY_NORMAL).dropped == 1, "A full normal-only queue should evict its oldest entry");
+	require(popPath(t0) == "/telemetry", "The oldest entry should be the one evicted");
+	std::string newest;
+	while (bzp::popUpdate(newest, false, kAnyLength, t0) == BZP_UPDATE_QUEUE_OK && bzp::updateQueueSize() != 0)
+	{
+	}
+	require(newest == "/latest|org.bluez.GattCharacteristic1", "The newest entry should get through a full queue");
+	bzp::resetUpdateQueue();
+}
+
+void testDeviceEventBatching()
+{
+	using bzp::detail::DeviceEvent;
+	const std::string first = "/org/bluez/hci0/dev_00_00_00_00_00_01";
+	const std::string second = "/org/bluez/hci0/dev_00_00_00_00_00_02";
+	const std::string third = "/org/bluez/hci0/dev_00_00_00_00_00_03";
+
+	std::unordered_map<std::string, bzp::DeviceInfo> devices;
+	devices[third].path = third;
+	devices[third].connected = true;
+
+	bzp::detail::ConnectionChanges changes = bzp::detail::applyDeviceEvents(devices, {
+		{first, DeviceEvent::Connected},
+		{second, DeviceEvent::Connected},
+		{first, DeviceEvent::Connected},
+		{third, DeviceEvent::Disconnected},
+	});
+	require(changes.added == std::vector<std::string>{first, second}, "A batch should report each new connection once, in order");
+	require(changes.removed == std::vector<std::string>{third}, "A batch should report the dropped connection");
+	require(devices.at(first).connected && devices.at(second).connected && !devices.at(third).connected,
+		"Device map should reflect the batch");
+
+	changes = bzp::detail::applyDeviceEvents(devices, {
+		{third, DeviceEvent::Connected},
+		{third, DeviceEvent::Removed},
+		{first, DeviceEvent::Disconnected},
+		{first, DeviceEvent::Connected},
+	});
+	require(changes.added.empty() && changes.removed.empty(), "Changes that cancel out within a batch should not be reported");
+	require(devices.count(third) == 0, "Removed devices should leave the map");
+
+	changes = bzp::detail::applyDeviceEvents(devices, {{second, DeviceEvent::Removed}, {third, DeviceEvent::Disconnected}});
+	require(changes.removed == std::vector<std::string>{second}, "Removing a connected device should report it as disconnected");
+	require(changes.added.empty(), "Disconnecting an unknown device should change nothing");
+}
+
+void testServerThreadScheduling()
+{
+	struct RestoreOptions
+	{
+		~RestoreOptions() { bzpSetServerThreadOptions(nullptr); }
+	} restore;
+
+	BZPServerThreadOptions options{};
+	options.setNice = 1;
+	options.nice = 25;
+	require(bzpSetServerThreadOptionsEx(&options) == BZP_SERVER_THREAD_OPTIONS_SET_INVALID_OPTIONS,
+		"Server thread options should reject nice values outside -20..19");
+	options = BZPServerThreadOptions{};
+	options.realtimePriority = 1000;
+	require(bzpSetServerThreadOptionsEx(&options) == BZP_SERVER_THREAD_OPTIONS_SET_INVALID_OPTIONS,
+		"Server thread options should reject SCHED_FIFO priorities outside the policy range");
+	require(bzp::getServerThreadSchedulingOptions() == bzp::ThreadSchedulingOptions{},
+		"Rejected server thread options should leave the previous configuration untouched");
+
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	require(sched_getaffinity(0, sizeof(allowed), &allowed) == 0, "The test thread affinity should be readable");
+	int firstCPU = -1;
+	for (int cpu = 0; cpu < 64 && firstCPU < 0; ++cpu)
+	{
+		if (CPU_ISSET(cpu, &allowed))
+		{
+			firstCPU = cpu;
+		}
+	}
+	require(firstCPU >= 0, "The test thread should be allowed on at least one of the first 64 CPUs");
+
+	options = BZPServerThreadOptions{};
+	options.pName = "bzp-worker-with-a-long-name";
+	options.cpuAffinityMask = 1ULL << firstCPU;
+	options.setNice = 1;
+	options.nice = 5;
+	require(bzpSetServerThreadOptionsEx(&options) == BZP_SERVER_THREAD_OPTIONS_SET_OK,
+		"Valid server thread options should be accepted");
+
+	bzp::ThreadSchedulingReport report;
+	char threadName[32] = {};
+	cpu_set_t applied;
+	CPU_ZERO(&applied);
+	std::thread worker([&] {
+		report = bzp::applyServerThreadScheduling();
+		pthread_getname_np(pthread_self(), threadName, sizeof(threadName));
+		sched_getaffinity(0, sizeof(applied), &applied);
+	});
+	worker.join();
+
+	require(report.named && std::string(threadName) == "bzp-worker-with",
+		"Server thread scheduling should apply the thread name truncated to 15 bytes");
+	require(report.pinned && CPU_COUNT(&applied) == 1 && CPU_ISSET(firstCPU, &applied),
+		"Server thread scheduling should pin the thread to the configured CPU mask");
+	require(report.niced, "Raising the nice value should not need privileges");
+	require(!report.realtime && !report.stackLocked, "Settings that were not requested should not be reported as applied");
+
+	bzpSetServerThreadOptions(nullptr);
+	require(bzp::getServerThreadSchedulingOptions() == bzp::ThreadSchedulingOptions{},
+		"Passing NULL should restore the default server thread options");
+}
+
+void testRunLoopInvokeBatch()
+{
+	struct RestoreState
+	{
+		std::shared_ptr<Server> activeServer = getActiveServer();
+		BZPServerRunState runState = bzpGetServerRunState();
+		BZPServerHealth health = bzpGetServerHealth();
+
+		~RestoreState()
+		{
+			bzpRunLoopSetInvokeCapacity(0);
+			if (bzpGetServerRunState() != EStopped && bzpGetServerRunState() != EUninitialized)
+			{
+				bzpTriggerShutdown();
+				bzpRunLoopDriveUntilShutdown(kShutdownDriveTimeoutMS);
+			}
+
+			setActiveServer(activeServer);
+			bzp::setServerHealth(health);
+			bzp::setServerRunState(runState);
+		}
+	} restore;
+
+	struct OrderEntry
+	{
+		std::vector<int> *order;
+		int value;
+	};
+	std::vector<int> order;
+	OrderEntry entries[4] = {{&order, 1}, {&order, 2}, {&order, 3}, {&order, 4}};
+	auto recordOrder = [](void *userData) {
+		auto *entry = static_cast<OrderEntry *>(userData);
+		entry->order->push_back(entry->value);
+	};
+	const BZPRunLoopInvocation batch[3] = {{recordOrder, &entries[1]}, {recordOrder, &entries[2]}, {recordOrder, &entries[3]}};
+
+	require(bzpRunLoopInvokeBatchEx(batch, 3) == BZP_RUN_LOOP_NOT_ACTIVE,
+		"bzpRunLoopInvokeBatchEx should fail before the run loop is started");
+	require(bzpRunLoopSetInvokeCapacityEx(-1) == BZP_RUN_LOOP_INVALID_ARGUMENT,
+		"bzpRunLoopSetInvokeCapacityEx should reject a negative capacity");
+	require(bzpStartManual("bzperi.tests.manual-invoke-batch", "", "", &nullGetter, &acceptingSetter) != 0,
+		"bzpStartManual should initialize the run loop before batch invoke testing");
+	require(bzpRunLoopInvokeBatchEx(nullptr, 1) == BZP_RUN_LOOP_INVALID_ARGUMENT,
+		"bzpRunLoopInvokeBatchEx should reject a null invocation array");
+
+	require(bzpRunLoopInvoke(recordOrder, &entries[0]) != 0, "bzpRunLoopInvoke should queue a single callback");
+	require(bzpRunLoopInvokeBatch(batch, 3) != 0, "bzpRunLoopInvokeBatch should queue the whole batch");
+	for (int attempt = 0; attempt < 100 && order.size() < 4; ++attempt)
+	{
+		bzpRunLoopIterationFor(10);
+	}
+	require(order == std::vector<int>({1, 2, 3, 4}), "Queued invocations should run in submission order");
+
+	order.clear();
+	require(bzpRunLoopSetInvokeCapacity(2) != 0, "bzpRunLoopSetInvokeCapacity should accept a positive bound");
+	require(bzpRunLoopInvoke(recordOrder, &entries[0]) != 0, "Invoke should succeed below the capacity");
+	require(bzpRunLoopInvokeBatchEx(batch, 3) == BZP_RUN_LOOP_QUEUE_FULL,
+		"A batch that would exceed the capacity should be refused as a whole");
+	require(bzpRunLoopInvoke(recordOrder, &entries[1]) != 0, "Invoke should succeed up to the capacity");
+	require(bzpRunLoopInvokeEx(recordOrder, &entries[2]) == BZP_RUN_LOOP_QUEUE_FULL,
+		"Invoke should report QUEUE_FULL once the capacity is reached");
+	for (int attempt = 0; attempt < 100 && order.size() < 2; ++attempt)
+	{
+		bzpRunLoopIterationFor(10);
+	}
+	require(order == std::vector<int>({1, 2}), "Refused invocations should never run");
+	require(bzpRunLoopInvoke(recordOrder, &entries[2]) != 0, "Draining the queue should free capacity again");
+	require(bzpRunLoopSetInvokeCapacity(0) != 0, "bzpRunLoopSetInvokeCapacity(0) should remove the bound");
+
+	constexpr int kProducers = 4;
+	constexpr int kInvocationsPerProducer = 250;
+	std::atomic<int> received{0};
+	auto countInvocation = [](void *userData) {
+		static_cast<std::atomic<int> *>(userData)->fetch_add(1);
+	};
+	std::vector<std::thread> producers;
+	for (int producer = 0; producer < kProducers; ++producer)
+	{
+		producers.emplace_back([&received, countInvocation] {
+			for (int index = 0; index < kInvocationsPerProducer; ++index)
+			{
+				bzpRunLoopInvoke(countInvocation, &received);
+			}
+		});
+	}
+	for (std::thread &producer : producers)
+	{
+		producer.join();
+	}
+	for (int attempt = 0; attempt < 1000 && received.load() < kProducers * kInvocationsPerProducer; ++attempt)
+	{
+		bzpRunLoopIterationFor(10);
+	}
+	require(received.load() == kProducers * kInvocationsPerProducer,
+		"Every invocation queued from concurrent producers should run exactly once");
+
+	order.clear();
+	require(bzpRunLoopInvoke(recordOrder, &entries[3]) != 0, "Invoke should succeed right before shutdown");
+	bzpTriggerShutdown();
+	require(bzpRunLoopDriveUntilShutdown(kShutdownDriveTimeoutMS) != 0,
+		"bzpRunLoopDriveUntilShutdown should clean up after batch invoke use");
+	require(order == std::vector<int>({4}), "Invocations accepted before shutdown should still run");
+	require(bzpRunLoopInvokeEx(recordOrder, &entries[0]) == BZP_RUN_LOOP_NOT_ACTIVE,
+		"Invoke should be refused once the run loop has shut down");
+	require(order == std::vector<int>({4}), "Refused invocations should never run");
+}
+
 void testRunLoopExResults()
 {
 	struct RestoreState
@@ -2279,6 +3544,95 @@ void testStandaloneDoctorProbeCollection()
 	require(probe.lastPreferredAdapter == "hci1", "Doctor probe collection should pass the preferred adapter through the seam");
 }
 
+void testStandaloneDoctorAdapterSelection()
+{
+	using bzp::standalone::DoctorAdapter;
+	const std::vector<DoctorAdapter> adapters = {
+		{"/org/bluez/hci1", "00:11:22:33:44:02", false},
+		{"/org/bluez/hci0", "00:11:22:33:44:01", true},
+	};
+
+	bool powered = false;
+	std::string summary;
+	std::vector<std::string> lines;
+	std::string detail;
+	require(!bzp::standalone::summarizeDoctorAdapters(adapters, "hci7", &powered, &summary, &lines, &detail),
+		"The adapter probe should fail when the requested adapter does not exist");
+	require(!powered && lines.empty() && detail == "Adapter hci7 not found (available: /org/bluez/hci0, /org/bluez/hci1)",
+		"A missing adapter should be reported with the adapters that do exist");
+
+	require(bzp::standalone::summarizeDoctorAdapters(adapters, "hci1", &powered, &summary, &lines, &detail),
+		"The adapter probe should find the requested adapter");
+	require(!powered && summary == "/org/bluez/hci1 powered=no" && lines.size() == 1,
+		"Another powered adapter should not make an unpowered requested adapter pass");
+	require(detail == "Adapter is not powered: /org/bluez/hci1 powered=no", "An unpowered requested adapter should say so");
+
+	lines.clear();
+	require(bzp::standalone::summarizeDoctorAdapters(adapters, "00:11:22:33:44:01", &powered, &summary, &lines, &detail)
+		&& powered && summary == "/org/bluez/hci0 powered=yes", "The requested adapter can also be named by its address");
+
+	lines.clear();
+	require(bzp::standalone::summarizeDoctorAdapters(adapters, "", &powered, &summary, &lines, &detail) && powered
+		&& summary == "/org/bluez/hci0 powered=yes; /org/bluez/hci1 powered=no" && lines.size() == 2,
+		"Without a requested adapter every adapter should be listed");
+	require(!bzp::standalone::summarizeDoctorAdapters({}, "", &powered, &summary, &lines, &detail)
+		&& detail == "No BlueZ adapters available", "No adapters at all should fail the probe");
+
+	bzp::standalone::DoctorSnapshot snapshot;
+	snapshot.systemBusReachable = true;
+	snapshot.bluezServiceReachable = true;
+	snapshot.serviceNameAvailable = true;
+	snapshot.policyInstalled = true;
+	snapshot.adapterProbeSucceeded = bzp::standalone::summarizeDoctorAdapters(adapters, "hci7",
+		&snapshot.poweredAdapterAvailable, &snapshot.adapterSummary, &snapshot.adapterLines, &snapshot.adapterProbeDetail);
+	const auto report = bzp::standalone::evaluateDoctorSnapshot(snapshot, "bzp-standalone");
+	require(report.overall == bzp::standalone::Verdict::Fail, "A missing requested adapter should fail the doctor report");
+}
+
+void testStandaloneDoctorProbeDeadlines()
+{
+	FakeDoctorProbe probe;
+	probe.systemBusReachable = true;
+	probe.bluezServiceReachable = true;
+	probe.serviceNameAvailable = true;
+	probe.adapterProbeSucceeded = true;
+	probe.poweredAdapterAvailable = true;
+	probe.adapterSummary = "/org/bluez/hci0 powered=yes";
+	probe.policyInstalled = true;
+	probe.policyPath = "/etc/dbus-1/system.d/com.bzperi.conf";
+	probe.adapterDelayMs = 10000;
+
+	const auto started = std::chrono::steady_clock::now();
+	const auto snapshot = bzp::standalone::collectDoctorSnapshot(probe, "", "com.bzperi", 50);
+	const auto elapsed = std::chrono::steady_clock::now() - started;
+	require(elapsed < std::chrono::seconds(5), "A stalled doctor probe should be cancelled at its deadline");
+	require(probe.cancelled.load(), "Doctor collection should cancel probes that miss their deadline");
+	require(snapshot.adapterTiming.timedOut && !snapshot.adapterProbeSucceeded && snapshot.adapterLines.empty(),
+		"A timed-out adapter probe should not contribute results");
+	require(snapshot.systemBusReachable && snapshot.bluezServiceReachable && snapshot.serviceNameAvailable && snapshot.policyInstalled,
+		"Probes that finished in time should keep their results");
+	require(snapshot.systemBusTiming.ran && !snapshot.systemBusTiming.timedOut && snapshot.systemBusTiming.elapsedMs >= 0,
+		"Doctor collection should record per-probe timing");
+
+	const auto report = bzp::standalone::evaluateDoctorSnapshot(snapshot, "bzp-standalone");
+	require(report.overall == bzp::standalone::Verdict::Fail, "A timed-out adapter probe should fail the doctor report");
+	require(report.checks[3].detail.find("No answer within 50 ms") != std::string::npos && report.checks[3].elapsedMs == 50,
+		"Timed-out checks should say which deadline they missed");
+	require(std::find(report.nextCommands.begin(), report.nextCommands.end(),
+		"sudo bzp-standalone doctor --probe-timeout-ms=5000") != report.nextCommands.end(),
+		"Doctor report should suggest a longer probe deadline after a timeout");
+	const auto rendered = bzp::standalone::formatDoctorReport(report, "bzp-standalone");
+	require(rendered.find("FAIL  Adapter readiness  (50 ms)") != std::string::npos, "Rendered doctor checks should include probe timing");
+
+	FakeDoctorProbe noBus;
+	noBus.systemBusDetail = "Connection refused";
+	noBus.bluezServiceReachable = true;
+	noBus.bluezServiceDetail = "org.bluez present.";
+	const auto noBusSnapshot = bzp::standalone::collectDoctorSnapshot(noBus, "");
+	require(!noBusSnapshot.bluezServiceReachable && noBusSnapshot.bluezServiceDetail.empty() && !noBusSnapshot.bluezServiceTiming.ran,
+		"Bus-backed checks should be reported as not run when the system bus is unreachable");
+}
+
 void testInspectSessionStoreRoundTrip()
 {
 	const auto sessionPath = (std::filesystem::temp_directory_path() / "bzperi-inspect-session-test.ini").string();
@@ -2357,6 +3711,66 @@ void testInspectSessionStoreRoundTrip()
 	require(!missing.has_value(), "Cleared inspect session should no longer load");
 }
 
+void testInspectEventLog()
+{
+	const auto sessionPath = (std::filesystem::temp_directory_path() / "bzperi-inspect-event-log-test.ini").string();
+	bzp::standalone::InspectSessionStore writer(sessionPath, 4);
+	std::string error;
+	require(writer.clear(&error), "Inspect event log test should start from a clean session: " + error);
+
+	bzp::standalone::InspectSessionSnapshot snapshot;
+	snapshot.pid = 4242;
+	snapshot.serviceName = "bzperi";
+	require(writer.save(snapshot, &error), "Inspect session should save without error: " + error);
+	require(std::filesystem::exists(writer.eventLogPath()), "Saving a session should create the event log next to it");
+	const auto snapshotWrite = std::filesystem::last_write_time(sessionPath);
+
+	bzp::standalone::InspectSessionStore reader(sessionPath, 4);
+	uint64_t cursor = reader.eventHead();
+	require(cursor == 0, "A fresh event log should start empty");
+
+	for (int index = 0; index < 3; ++index)
+	{
+		const bzp::standalone::InspectEvent event{2000 + index, bzp::standalone::EventLevel::Warn, "Server",
+			"event " + std::to_string(index)};
+		bzp::standalone::appendInspectEvent(snapshot, event, writer.eventLimit());
+		require(writer.appendEvent(event, &error), "Appending an event should not fail: " + error);
+	}
+	require(std::filesystem::last_write_time(sessionPath) == snapshotWrite,
+		"Appending events should leave the snapshot file untouched");
+
+	std::size_t dropped = 0;
+	auto tailed = reader.readEventsSince(&cursor, &dropped);
+	require(tailed.size() == 3 && dropped == 0 && cursor == 3, "A reader should tail every new event exactly once");
+	require(tailed.back().message == "event 2" && tailed.back().level == bzp::standalone::EventLevel::Warn,
+		"Tailed events should round-trip their fields");
+	require(reader.readEventsSince(&cursor, &dropped).empty(), "Nothing new should be returned once the reader is caught up");
+
+	// Lap the four-record ring while the reader is idle
+	for (int index = 3; index < 9; ++index)
+	{
+		const bzp::standalone::InspectEvent event{2000 + index, bzp::standalone::EventLevel::Info, "Server",
+			std::string(300, 'x')};
+		bzp::standalone::appendInspectEvent(snapshot, event, writer.eventLimit());
+		require(writer.appendEvent(event, &error), "Appending an event should not fail: " + error);
+	}
+	tailed = reader.readEventsSince(&cursor, &dropped);
+	require(tailed.size() == 4 && dropped == 2, "A lapped reader should get the retained records and a count of the lost ones");
+	require(tailed.front().timestampMs == 2005, "The oldest retained record should follow the overwritten ones");
+	require(tailed.front().message.size() == bzp::standalone::InspectEventRing::kMaxMessageLength,
+		"Oversized messages should be truncated to the fixed record size");
+
+	// The writer's in-memory history matches the log, so saving the snapshot must not rewrite it
+	require(writer.save(snapshot, &error), "Inspect session should save without error: " + error);
+	require(reader.eventHead() == 9, "Saving an in-sync snapshot should keep the event log head");
+	const auto loaded = reader.load(&error);
+	require(loaded.has_value() && loaded->events.size() == 4 && loaded->droppedEventCount == 5,
+		"A full load should take the newest events and the dropped count from the event log");
+
+	require(writer.clear(&error), "Inspect session store should clear without error: " + error);
+	require(!std::filesystem::exists(writer.eventLogPath()), "Clearing a session should remove its event log");
+}
+
 bool alwaysAliveForTest(int)
 {
 	return true;
@@ -2384,6 +3798,378 @@ void testInspectSessionStaleDetection()
 		"Rendered stale inspect report should explain the stale session");
 }
 
+void testStandaloneBenchReport()
+{
+	std::vector<uint32_t> latencies;
+	for (uint32_t value = 100; value >= 1; --value)
+	{
+		latencies.push_back(value * 10);
+	}
+	const auto latency = bzp::standalone::summarizeBenchLatencies(latencies);
+	require(latency.samples == 100 && latency.p50Us == 500 && latency.p90Us == 900 && latency.p99Us == 990 && latency.maxUs == 1000,
+		"Bench latency percentiles should use nearest-rank over the sorted samples");
+	require(bzp::standalone::summarizeBenchLatencies({}).samples == 0, "Empty bench latency summary should stay zeroed");
+
+	const auto cpu = bzp::standalone::parseProcessCpuTime(
+		"4242 (bzp standalone) S 1 4242 4242 0 -1 4194560 900 0 0 0 37 12 0 0 20 0 3 0 1000 0 0");
+	require(cpu && cpu->userTicks == 37 && cpu->systemTicks == 12,
+		"Process CPU time should come from utime/stime even when the command name contains spaces");
+	require(!bzp::standalone::parseProcessCpuTime("4242 (truncated) S 1").has_value(),
+		"A truncated /proc stat line should not yield CPU time");
+
+	bzp::standalone::BenchReport report;
+	report.busDescription = "system bus";
+	report.ownedName = "com.bzperi";
+	report.serverPid = 4242;
+	report.durationMs = 2000;
+	bzp::standalone::BenchOperationResult reads;
+	reads.name = "ReadValue";
+	reads.targetRate = 50.0;
+	reads.issued = 100;
+	reads.succeeded = 100;
+	reads.latenciesUs = latencies;
+	report.operations.push_back(reads);
+	report.serverCpu = bzp::standalone::ProcessCpuTime{10, 5};
+	require(bzp::standalone::evaluateBenchReport(report) == bzp::standalone::Verdict::Pass,
+		"A bench run with only successful calls should pass");
+
+	const auto rendered = bzp::standalone::formatBenchReport(report, "bzp-standalone");
+	require(rendered.find("achieved 50.0/s") != std::string::npos && rendered.find("p99 990us") != std::string::npos,
+		"Bench report should show achieved throughput and latency percentiles");
+	require(rendered.find("inspect --live --pid 4242") != std::string::npos,
+		"Bench report should point at the server's event stream");
+
+	report.operations[0].failed = 3;
+	report.operations[0].firstError = "org.freedesktop.DBus.Error.NoReply";
+	require(bzp::standalone::evaluateBenchReport(report) == bzp::standalone::Verdict::Warn,
+		"Failed bench calls should downgrade the verdict");
+	report.operations[0].succeeded = 0;
+	require(bzp::standalone::evaluateBenchReport(report) == bzp::standalone::Verdict::Fail,
+		"A bench run where no call succeeded should fail");
+}
+
+void testEventStream()
+{
+	bzp::EventStreamEvent dispatch;
+	dispatch.type = bzp::EventStreamFrameType::Dispatch;
+	dispatch.timestampUs = 1234567890123ULL;
+	dispatch.dispatchKind = bzp::EventStreamDispatchKind::SetProperty;
+	dispatch.succeeded = false;
+	dispatch.durationUs = 250;
+	dispatch.objectPath = "/com/bzperi/battery";
+	dispatch.interfaceName = "org.bluez.GattCharacteristic1";
+	dispatch.member = "Value";
+
+	// Deliver the frame in two pieces to exercise partial-frame buffering
+	const std::string frame = bzp::detail::encodeEventStreamFrame(dispatch);
+	std::string received = frame.substr(0, 7);
+	require(bzp::detail::decodeEventStreamFrames(received).empty(), "A partial event frame should not decode");
+	received += frame.substr(7);
+	auto decoded = bzp::detail::decodeEventStreamFrames(received);
+	require(decoded.size() == 1 && received.empty(), "A completed event frame should decode and be consumed");
+	require(decoded[0].type == bzp::EventStreamFrameType::Dispatch
+		&& decoded[0].timestampUs == dispatch.timestampUs
+		&& decoded[0].dispatchKind == bzp::EventStreamDispatchKind::SetProperty
+		&& !decoded[0].succeeded
+		&& decoded[0].durationUs == 250
+		&& decoded[0].objectPath == dispatch.objectPath
+		&& decoded[0].interfaceName == dispatch.interfaceName
+		&& decoded[0].member == dispatch.member,
+		"Dispatch event fields should survive an encode/decode round trip");
+
+	const auto socketPath = (std::filesystem::temp_directory_path() / "bzperi-event-stream-test.sock").string();
+	const std::string error = bzp::startEventStream(socketPath, 1024);
+	require(error.empty(), "Event stream should start: " + error);
+	require(!bzp::startEventStream(socketPath, 1024).empty(), "Starting the event stream twice should fail");
+
+	const int client = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", socketPath.c_str());
+	require(client >= 0 && connect(client, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0,
+		"Inspector should be able to connect to the event stream");
+
+	std::string buffer;
+	std::vector<bzp::EventStreamEvent> events;
+	const auto readAvailable = [&](int timeoutMS) {
+		pollfd descriptor{client, POLLIN, 0};
+		while (poll(&descriptor, 1, timeoutMS) > 0)
+		{
+			char chunk[4096];
+			const ssize_t count = recv(client, chunk, sizeof(chunk), 0);
+			if (count <= 0)
+			{
+				return;
+			}
+			buffer.append(chunk, static_cast<std::size_t>(count));
+			for (auto &event : bzp::detail::decodeEventStreamFrames(buffer))
+			{
+				events.push_back(std::move(event));
+			}
+		}
+	};
+
+	while (events.size() < 2)
+	{
+		readAvailable(1000);
+		require(!events.empty() || bzp::hasEventStreamSubscribers(), "Event stream should greet new subscribers");
+	}
+	require(events[0].type == bzp::EventStreamFrameType::Hello
+		&& events[0].pid == static_cast<uint32_t>(getpid())
+		&& events[0].protocolVersion == bzp::kEventStreamProtocolVersion,
+		"The first frame should identify the serving process");
+	require(events[1].type == bzp::EventStreamFrameType::State, "Subscribers should receive the current state on attach");
+	events.clear();
+
+	// Outrun the reader: the server must keep publishing and account for what this subscriber lost
+	constexpr uint32_t kBurst = 20000;
+	for (uint32_t index = 0; index < kBurst; ++index)
+	{
+		bzp::publishDispatchEvent(bzp::EventStreamDispatchKind::Method, "/com/bzperi", "com.bzperi.Test", "Ping", true, index);
+	}
+	readAvailable(200);
+	bzp::publishQueueStatsEvent(7, 3);
+	while (events.empty() || events.back().type != bzp::EventStreamFrameType::QueueStats)
+	{
+		const std::size_t before = events.size();
+		readAvailable(1000);
+		require(events.size() > before, "Event stream should deliver the marker after the burst");
+	}
+
+	uint64_t delivered = 0;
+	uint64_t dropped = 0;
+	for (const auto &event : events)
+	{
+		delivered += event.type == bzp::EventStreamFrameType::Dispatch ? 1 : 0;
+		dropped += event.type == bzp::EventStreamFrameType::Dropped ? event.droppedCount : 0;
+	}
+	require(dropped > 0, "A subscriber that stops reading should lose events instead of stalling the publisher");
+	require(delivered + dropped == kBurst, "Delivered plus reported drops should account for every published event");
+	require(events.back().updateQueueDepth == 7 && events.back().updatesProcessed == 3,
+		"Queue stats should survive the stream");
+
+	close(client);
+	bzp::stopEventStream();
+	require(!bzp::isEventStreamActive() && !std::filesystem::exists(socketPath),
+		"Stopping the event stream should remove its socket");
+}
+
+void testDataPlane()
+{
+	require(!bzp::validateDataPlaneSlots({{"battery/level", "", 0}}).empty(), "Data plane slots need a capacity");
+	require(!bzp::validateDataPlaneSlots({{"a", "", 4}, {"a", "", 4}}).empty(), "Data plane slot names should be unique");
+	require(!bzp::validateDataPlaneSlots({{std::string(BZP_DATA_PLANE_NAME_BYTES, 'x'), "", 4}}).empty(),
+		"Data plane slot names must fit the shared descriptor");
+
+	const auto socketPath = (std::filesystem::temp_directory_path() / "bzperi-data-plane-test.sock").string();
+	const std::vector<bzp::DataPlaneSlotConfig> slots{
+		{"battery/level", "/com/bzperi/battery/level", 1},
+		{"text/string", "", 64},
+	};
+	const std::string error = bzp::startDataPlane(socketPath, slots);
+	require(error.empty(), "Data plane should start: " + error);
+	require(!bzp::startDataPlane(socketPath, slots).empty(), "Starting the data plane twice should fail");
+	require(bzp::readDataPlaneValue("battery/level", nullptr, 0) == -1, "Unwritten slots should read as unavailable");
+	require(bzp::refreshDataPlaneValue("missing") == nullptr, "Unknown slots should read as unavailable");
+
+	BZPDataPlaneProducer *producer = bzpDataPlaneAttach(socketPath.c_str());
+	require(producer != nullptr, "Producer should attach to the data plane");
+	const int level = bzpDataPlaneFindSlot(producer, "battery/level");
+	const int text = bzpDataPlaneFindSlot(producer, "text/string");
+	require(level >= 0 && text >= 0 && bzpDataPlaneFindSlot(producer, "missing") == -1,
+		"Producer should find declared slots by name");
+	require(bzpDataPlaneSlotCapacity(producer, text) == 64, "Producer should see the declared capacity");
+	require(bzpDataPlanePublish(producer, level, "ab", 2) == -1, "Publishing past a slot's capacity should fail");
+
+	// Several samples before the consumer runs should collapse into at most one change per slot and pass
+	for (uint8_t sample = 1; sample <= 50; ++sample)
+	{
+		require(bzpDataPlanePublish(producer, level, &sample, 1) == 0, "Producer should publish within capacity");
+	}
+	require(bzpDataPlanePublish(producer, text, "hello", 5) == 0, "Producer should publish text");
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (bzp::dataPlaneStats().changedSlots < 2 && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	const bzp::DataPlaneStats stats = bzp::dataPlaneStats();
+	require(stats.producersServed == 1 && stats.doorbells >= 1, "The doorbell should wake the consumer");
+	require(stats.changedSlots >= 2 && stats.changedSlots <= 51, "Consumer passes should count each changed slot once");
+
+	uint8_t value = 0;
+	require(bzp::readDataPlaneValue("battery/level", &value, sizeof(value)) == 1 && value == 50,
+		"Reads should return the newest sample");
+	std::size_t length = 0;
+	const auto *snapshot = static_cast<const char *>(bzp::refreshDataPlaneValue("text/string", &length));
+	require(snapshot != nullptr && length == 5 && std::string(snapshot) == "hello",
+		"Refreshed values should be NUL-terminated copies");
+
+	bzpDataPlaneDetach(producer);
+	bzp::stopDataPlane();
+	require(!bzp::isDataPlaneActive() && !std::filesystem::exists(socketPath),
+		"Stopping the data plane should remove its socket");
+	require(bzp::readDataPlaneValue("battery/level", &value, sizeof(value)) == -1,
+		"Values should be gone once the data plane stops");
+}
+
+void testTypedDataStore()
+{
+	require(bzpDataRegister(nullptr, BZP_DATA_SLOT_FIXED, 1, nullptr) == -1, "Data slots need a name");
+	require(bzpDataRegister("test/store/none", BZP_DATA_SLOT_FIXED, 0, nullptr) == -1, "Data slots need a size");
+	require(bzpDataRegister("test/store/huge", BZP_DATA_SLOT_TEXT, 513, nullptr) == -1, "Data slots are capped at 512 bytes");
+
+	const int level = bzpDataRegister("test/store/level", BZP_DATA_SLOT_FIXED, sizeof(uint16_t), "/com/bzperi/test/level");
+	require(level >= 0, "Fixed data slots should register");
+	require(bzpDataRegister("test/store/level", BZP_DATA_SLOT_FIXED, sizeof(uint16_t), "/com/bzperi/test/level") == level,
+		"Registering the same slot again should return its handle");
+	int conflicting = 0;
+	require(bzpDataRegisterEx("test/store/level", BZP_DATA_SLOT_FIXED, sizeof(uint32_t), nullptr, &conflicting)
+			== BZP_DATA_STORE_CONFLICT && conflicting == -1,
+		"Registering a name with a different shape should conflict");
+	require(bzpDataFind("test/store/level") == level && bzpDataFind("test/store/missing") == -1,
+		"Handles should be found by name");
+	require(bzpDataSize(level) == sizeof(uint16_t) && bzpDataSize(-1) == 0, "Slot sizes should be reported per handle");
+
+	uint16_t value = 0;
+	unsigned int length = 0;
+	require(bzpDataReadEx(level, &value, sizeof(value), &length) == BZP_DATA_STORE_EMPTY, "Unwritten slots should read as empty");
+	const uint8_t narrow = 1;
+	require(bzpDataWriteEx(level, &narrow, sizeof(narrow)) == BZP_DATA_STORE_SIZE_MISMATCH,
+		"Fixed slots should reject values of another size");
+	require(bzpDataWriteEx(9999, &narrow, sizeof(narrow)) == BZP_DATA_STORE_UNKNOWN_HANDLE,
+		"Writes to unknown handles should fail");
+
+	// Bound slots store the value even while no server is running to take the notification
+	const uint16_t written = 4242;
+	require(bzpDataWrite(level, &written, sizeof(written)) != 0, "Fixed slots should accept values of their size");
+	require(bzpDataRead(level, &value, sizeof(value)) == sizeof(value) && value == written, "Reads should return the stored value");
+	require(*static_cast<const uint16_t *>(bzpDataStoreGetter("test/store/level")) == written,
+		"The legacy getter should serve the stored value");
+	const uint16_t replaced = 7;
+	require(bzpDataStoreSetter("test/store/level", &replaced) == 1
+			&& bzpDataRead(level, &value, sizeof(value)) == sizeof(value) && value == replaced,
+		"The legacy setter should store fixed values at their registered size");
+
+	const int text = bzpDataRegister("test/store/text", BZP_DATA_SLOT_TEXT, 8, nullptr);
+	require(text >= 0 && text != level, "Text data slots should register");
+	require(bzpDataStoreSetter("test/store/text", "hello") == 1, "The legacy setter should store strings");
+	require(std::string(static_cast<const char *>(bzpDataStoreGetter("test/store/text"))) == "hello",
+		"The legacy getter should return NUL-terminated text");
+	require(bzpDataStoreSetter("test/store/text", "much too long") == 0, "Strings longer than the slot should be rejected");
+	require(bzpDataWrite(text, "hi", 2) != 0
+			&& std::string(static_cast<const char *>(bzpDataStoreGetter("test/store/text"))) == "hi",
+		"Shorter text should replace the previous value entirely");
+	require(bzpDataStoreGetter("test/store/missing") == nullptr && bzpDataStoreSetter("test/store/missing", "x") == 0,
+		"The legacy adapter should reject unknown names");
+
+	// Readers must never see a value torn between two writes
+	const int pair = bzpDataRegister("test/store/pair", BZP_DATA_SLOT_FIXED, 2 * sizeof(uint64_t), nullptr);
+	require(pair >= 0, "Pair slot should register");
+	std::atomic<bool> done{false};
+	std::thread writer([&]() {
+		for (uint64_t index = 0; index < 200000; ++index)
+		{
+			const uint64_t values[2] = {index, ~index};
+			bzpDataWrite(pair, values, sizeof(values));
+		}
+		done.store(true, std::memory_order_release);
+	});
+	while (!done.load(std::memory_order_acquire))
+	{
+		uint64_t values[2] = {};
+		if (bzpDataRead(pair, values, sizeof(values)) == static_cast<int>(sizeof(values)))
+		{
+			require(values[1] == ~values[0], "Seqlock reads should never return a torn value");
+		}
+	}
+	writer.join();
+	uint64_t last[2] = {};
+	require(bzpDataRead(pair, last, sizeof(last)) == static_cast<int>(sizeof(last)) && last[0] == 199999 && last[1] == ~last[0],
+		"The last write should win");
+}
+
+void testWriteIngestRing()
+{
+	require(bzpRegisterIngest("test/ingest/bad", 65537, 0) == -1, "Ingest rings are capped at 65536 packets");
+	const int handle = bzpRegisterIngest("test/ingest/rx", 6, 16);
+	require(handle >= 0, "Ingest rings should register");
+	require(bzpRegisterIngest("test/ingest/rx", 8, 16) == handle, "Packet counts should round up to a power of two");
+	require(bzpRegisterIngest("test/ingest/rx", 8, 32) == -1, "Re-registering with another packet size should conflict");
+	require(bzpFindIngest("test/ingest/rx") == handle && bzpFindIngest("test/ingest/missing") == -1,
+		"Ingest rings should be found by name");
+
+	const int fd = bzpGetIngestFD(handle);
+	pollfd descriptor{fd, POLLIN, 0};
+	require(fd >= 0 && poll(&descriptor, 1, 0) == 0, "A fresh ring should not be readable");
+
+	bzp::IngestReader<4> reader(handle);
+	require(!reader.next(), "An empty ring should yield no batch");
+	const char oversized[17] = {};
+	require(bzp::pushIngestPacket(handle, oversized, sizeof(oversized)) == BZP_INGEST_PACKET_TOO_LARGE,
+		"Packets larger than the ring's packet size should be rejected");
+	for (uint8_t index = 0; index < 10; ++index)
+	{
+		const uint8_t packet[2] = {index, static_cast<uint8_t>(~index)};
+		const BZPIngestResult result = bzp::pushIngestPacket(handle, packet, sizeof(packet));
+		require(result == (index < 8 ? BZP_INGEST_OK : BZP_INGEST_RING_FULL), "A full ring should drop new packets");
+	}
+	require(poll(&descriptor, 1, 0) == 1, "The first packet after a drain should ring the eventfd");
+
+	std::vector<uint8_t> seen;
+	while (reader.next())
+	{
+		require(reader.size() <= 4, "Batches should respect the reader's size");
+		for (std::span<const std::uint8_t> packet : reader)
+		{
+			require(packet.size() == 2 && packet[1] == static_cast<uint8_t>(~packet[0]), "Packets should arrive intact");
+			seen.push_back(packet[0]);
+		}
+	}
+	require(seen == std::vector<uint8_t>({0, 1, 2, 3, 4, 5, 6, 7}), "Packets should arrive in order");
+	require(poll(&descriptor, 1, 0) == 0, "Draining the ring should clear the eventfd");
+
+	BZPIngestStats stats{};
+	require(bzpGetIngestStats(handle, &stats) == BZP_INGEST_OK, "Ingest stats should be available");
+	require(stats.received == 8 && stats.dropped == 2 && stats.oversized == 1 && stats.queued == 0
+			&& stats.highWatermark == 8 && stats.capacity == 8,
+		"Ingest stats should count accepted, dropped and oversized packets");
+
+	// Producer on another thread, consumer sleeping on the eventfd between batches: nothing may be lost or reordered
+	constexpr uint32_t kPackets = 100000;
+	std::thread producer([&]() {
+		for (uint32_t index = 0; index < kPackets;)
+		{
+			if (bzp::pushIngestPacket(handle, &index, sizeof(index)) == BZP_INGEST_OK)
+			{
+				++index;
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+	uint32_t expected = 0;
+	while (expected < kPackets)
+	{
+		if (!reader.next())
+		{
+			require(poll(&descriptor, 1, 5000) == 1, "The consumer should be woken for new packets");
+			continue;
+		}
+		for (std::span<const std::uint8_t> packet : reader)
+		{
+			uint32_t value = 0;
+			std::memcpy(&value, packet.data(), sizeof(value));
+			require(packet.size() == sizeof(value) && value == expected, "Packets should arrive in order across threads");
+			++expected;
+		}
+	}
+	producer.join();
+	require(!reader.next(), "The ring should be drained");
+}
+
 void testUpdateEnqueueExHelpers()
 {
 	bzpUpdateQueueClear();
@@ -2449,12 +4235,18 @@ int main()
 		{"Legacy raw callback compatibility", testLegacyRawCallbacksRemainCompatible},
 #endif
 		{"Characteristic/property wrapper dispatch", testCharacteristicAndPropertyWrappers},
+		{"Loopback transport", testLoopbackTransport},
 		{"BlueZ adapter accessors", testBluezAdapterAccessors},
 		{"BlueZ adapter runtime ownership", testBluezAdapterRuntimeOwnership},
 		{"Server accessor compatibility storage", testServerAccessorCompatibilityStorage},
 		{"Server runtime ownership", testServerRuntimeOwnership},
 		{"Utils wrapper variants", testUtilsVariantWrappers},
 		{"Advertising service UUID selection", testAdvertisingServiceUuidSelection},
+		{"Advertising payload budget", testAdvertisingPayloadBudget},
+		{"Advertising data store", testAdvertisingDataStore},
+		{"Advertising parameters and burst schedule", testAdvertisingParametersAndBurst},
+		{"Advertising set rotation", testAdvertisingSetRotation},
+		{"Resume restore tracker", testResumeRestoreTracker},
 		{"Managed objects payload builder", testManagedObjectsPayloadBuilder},
 		{"Wait helper APIs", testWaitHelpers},
 		{"Manual run-loop lifecycle", testManualRunLoopLifecycle},
@@ -2464,6 +4256,17 @@ int main()
 		{"Run-loop attach/detach", testRunLoopAttachDetach},
 		{"Run-loop drive helpers", testRunLoopDriveHelpers},
 		{"Run-loop hidden poll API", testRunLoopPollApi},
+		{"Run-loop event descriptor", testRunLoopEventFD},
+		{"Run-loop batched invoke", testRunLoopInvokeBatch},
+		{"Server thread scheduling", testServerThreadScheduling},
+		{"Run-loop timer wheel", testRunLoopTimerWheel},
+		{"Periodic publisher", testPeriodicPublisher},
+		{"Indication flow control", testIndicationFlowControl},
+		{"Acquired notification budgets", testAcquiredNotifyBudgets},
+		{"Acquired notifications exclude publishEvery", testAcquiredNotifyExcludesPublishEvery},
+		{"BlueZ signal filter", testBluezSignalFilter},
+		{"Device event batching", testDeviceEventBatching},
+		{"Update queue priority lanes", testUpdateQueuePriorityLanes},
 		{"Run-loop Ex result helpers", testRunLoopExResults},
 		{"Shutdown trigger Ex helper", testShutdownTriggerEx},
 		{"Generic query Ex helpers", testQueryExHelpers},
@@ -2474,8 +4277,16 @@ int main()
 		{"Standalone doctor report evaluation", testStandaloneDoctorReportEvaluation},
 		{"Standalone doctor report warns when experimental mode is disabled", testStandaloneDoctorReportWarnsWhenExperimentalModeIsDisabled},
 		{"Standalone doctor probe collection", testStandaloneDoctorProbeCollection},
+		{"Standalone doctor adapter selection", testStandaloneDoctorAdapterSelection},
+		{"Standalone doctor probe deadlines", testStandaloneDoctorProbeDeadlines},
 		{"Inspect session store round-trip", testInspectSessionStoreRoundTrip},
+		{"Inspect event log", testInspectEventLog},
 		{"Inspect session stale detection", testInspectSessionStaleDetection},
+		{"Standalone bench report", testStandaloneBenchReport},
+		{"Event stream", testEventStream},
+		{"Data plane", testDataPlane},
+		{"Typed data store", testTypedDataStore},
+		{"Write ingest ring", testWriteIngestRing},
 		{"Update enqueue Ex helpers", testUpdateEnqueueExHelpers},
 	};
 